@@ -33,6 +33,8 @@ import vulkan_hpp;
 #define TINYOBJLOADER_IMPLEMENTATION
 #include <tiny_obj_loader.h>
 
+#include "simple_engine/mesh_optimizer.h"
+
 constexpr uint32_t WIDTH                = 800;
 constexpr uint32_t HEIGHT               = 600;
 const std::string  MODEL_PATH           = "models/viking_room.obj";
@@ -715,8 +717,6 @@ class HelloTriangleApplication
 			throw std::runtime_error(warn + err);
 		}
 
-		std::unordered_map<Vertex, uint32_t> uniqueVertices{};
-
 		for (const auto &shape : shapes)
 		{
 			for (const auto &index : shape.mesh.indices)
@@ -734,15 +734,15 @@ class HelloTriangleApplication
 
 				vertex.color = {1.0f, 1.0f, 1.0f};
 
-				if (!uniqueVertices.contains(vertex))
-				{
-					uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
-					vertices.push_back(vertex);
-				}
-
-				indices.push_back(uniqueVertices[vertex]);
+				vertices.push_back(vertex);
 			}
 		}
+
+		// Weld identical vertices and reorder triangles and vertices for the GPU caches
+		MeshOptimizationStats stats = MeshOptimizer::OptimizeMesh(vertices, indices, offsetof(Vertex, pos));
+		std::cout << "Mesh optimized: " << stats.verticesBefore << " -> " << stats.verticesAfter << " vertices, ACMR "
+		          << stats.cacheBefore.acmr << " -> " << stats.cacheAfter.acmr << ", ATVR "
+		          << stats.cacheBefore.atvr << " -> " << stats.cacheAfter.atvr << std::endl;
 	}
 
 	void createVertexBuffer()
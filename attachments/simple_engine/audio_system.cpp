@@ -25,6 +25,7 @@
 
 #include "renderer.h"
 #include "engine.h"
+#include "profiler.h"
 
 // OpenAL error checking utility
 static void CheckOpenALError(const std::string& operation) {
@@ -583,6 +584,7 @@ bool AudioSystem::Initialize(Engine* engine, Renderer* renderer) {
 }
 
 void AudioSystem::Update(std::chrono::milliseconds deltaTime) {
+    PROFILE_SCOPE("AudioSystem::Update");
     if (!initialized) {
         return;
     }
@@ -2,6 +2,9 @@
 
 #include "entity.h"
 
+#include <algorithm>
+#include <cmath>
+
 // Most of the CameraComponent class implementation is in the header file
 // This file is mainly for any methods that might need additional implementation
 //
@@ -58,3 +61,13 @@ void CameraComponent::UpdateProjectionMatrix() {
     }
     projectionMatrixDirty = false;
 }
+
+// Projects a world-space error to pixels: perspective divides by the distance,
+// orthographic projection maps the view height to the viewport directly
+float CameraComponent::GetScreenSpaceError(float error, float distance, float viewportHeight) const {
+    if (projectionType == ProjectionType::Perspective) {
+        float pixelsPerUnit = viewportHeight / (2.0f * std::tan(glm::radians(fieldOfView) * 0.5f));
+        return error * pixelsPerUnit / std::max(distance, nearPlane);
+    }
+    return orthoHeight > 0.0f ? error * viewportHeight / orthoHeight : 0.0f;
+}
@@ -198,6 +198,15 @@ public:
         return up;
     }
 
+    /**
+     * @brief Project a world-space error onto the screen.
+     * @param error The error in world units.
+     * @param distance The distance from the camera in world units.
+     * @param viewportHeight The viewport height in pixels.
+     * @return The projected error in pixels.
+     */
+    float GetScreenSpaceError(float error, float distance, float viewportHeight) const;
+
     /**
      * @brief Force view matrix recalculation without modifying camera orientation.
      * This is used when the camera's transform position changes externally (e.g., from GLTF loading).
@@ -9,6 +9,11 @@
 #include <unordered_map>
 #include <functional>
 #include <ctime>
+#include <cstdio>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <vector>
 
 /**
  * @brief Enum for different log levels.
@@ -21,14 +26,38 @@ enum class LogLevel {
     Fatal
 };
 
+/**
+ * @brief A log message queued for the background writer.
+ *
+ * The text is formatted once on the calling thread as "[LEVEL] [tag] message";
+ * only the timestamp prefix is added by the writer.
+ */
+struct LogRecord {
+    std::atomic<LogRecord*> next{nullptr};
+    LogLevel level = LogLevel::Info;
+    std::chrono::system_clock::time_point time;
+    std::string text;
+    uint32_t tagOffset = 0;
+    uint32_t tagLength = 0;
+    uint32_t messageOffset = 0;
+};
+
 /**
  * @brief Class for managing debugging and logging.
  *
+ * Log calls only format their record and push it onto a lock-free
+ * multi-producer queue. A background writer thread drains the queue in
+ * batches, writes console and file output without per-message flushes
+ * (the file is flushed periodically and immediately for errors), and runs
+ * the registered callbacks outside of any lock taken by producers.
+ *
  * This class implements the debugging system as described in the Tooling chapter:
  * @see en/Building_a_Simple_Engine/Tooling/03_debugging_and_renderdoc.adoc
  */
 class DebugSystem {
 public:
+    using LogCallback = std::function<void(LogLevel, const std::string&, const std::string&)>;
+
     /**
      * @brief Get the singleton instance of the debug system.
      * @return Reference to the debug system instance.
@@ -44,19 +73,21 @@ public:
      * @return True if initialization was successful, false otherwise.
      */
     bool Initialize(const std::string& logFilePath = "engine.log") {
-        std::lock_guard<std::mutex> lock(mutex);
-
-        // Open log file
-        logFile.open(logFilePath, std::ios::out | std::ios::trunc);
-        if (!logFile.is_open()) {
-            std::cerr << "Failed to open log file: " << logFilePath << std::endl;
-            return false;
+        {
+            std::lock_guard<std::mutex> lock(sinkMutex);
+
+            // Open log file
+            logFile.open(logFilePath, std::ios::out | std::ios::trunc);
+            if (!logFile.is_open()) {
+                std::cerr << "Failed to open log file: " << logFilePath << std::endl;
+                return false;
+            }
         }
 
+        initialized = true;
+
         // Log initialization
         Log(LogLevel::Info, "DebugSystem", "Debug system initialized");
-
-        initialized = true;
         return true;
     }
 
@@ -64,13 +95,13 @@ public:
      * @brief Clean up debug system resources.
      */
     void Cleanup() {
-        std::lock_guard<std::mutex> lock(mutex);
-
         if (initialized) {
-            // Log cleanup
+            // Log cleanup and make sure everything queued so far reaches the file
             Log(LogLevel::Info, "DebugSystem", "Debug system shutting down");
+            Flush();
 
             // Close log file
+            std::lock_guard<std::mutex> lock(sinkMutex);
             if (logFile.is_open()) {
                 logFile.close();
             }
@@ -79,6 +110,23 @@ public:
         }
     }
 
+    /**
+     * @brief Set the minimum level that is logged at runtime.
+     * @param level The minimum log level.
+     */
+    void SetMinLogLevel(LogLevel level) {
+        minLogLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Check if messages of the given level are logged.
+     * @param level The log level.
+     * @return True if enabled, false otherwise.
+     */
+    bool IsLevelEnabled(LogLevel level) const {
+        return static_cast<int>(level) >= minLogLevel.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief Log a message.
      * @param level The log level.
@@ -86,76 +134,86 @@ public:
      * @param message The log message.
      */
     void Log(LogLevel level, const std::string& tag, const std::string& message) {
-        std::lock_guard<std::mutex> lock(mutex);
-
-        // Get current time
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-
-        char timeStr[20];
-        std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", std::localtime(&time));
-
-        // Format log message
-        std::string levelStr;
-        switch (level) {
-            case LogLevel::Debug:
-                levelStr = "DEBUG";
-                break;
-            case LogLevel::Info:
-                levelStr = "INFO";
-                break;
-            case LogLevel::Warning:
-                levelStr = "WARNING";
-                break;
-            case LogLevel::Error:
-                levelStr = "ERROR";
-                break;
-            case LogLevel::Fatal:
-                levelStr = "FATAL";
-                break;
+        if (!IsLevelEnabled(level)) {
+            return;
         }
-
-        std::string formattedMessage =
-            std::string(timeStr) + "." + std::to_string(ms.count()) +
-            " [" + levelStr + "] " +
-            "[" + tag + "] " +
-            message;
-
-        // Write to console
+        startWriter();
+
+        const char* levelStr = GetLevelName(level);
+
+        // Preformat the record so the writer only prepends the timestamp
+        auto* record = new LogRecord();
+        record->level = level;
+        record->time = std::chrono::system_clock::now();
+        record->text.reserve(std::char_traits<char>::length(levelStr) + tag.size() + message.size() + 6);
+        record->text += '[';
+        record->text += levelStr;
+        record->text += "] [";
+        record->tagOffset = static_cast<uint32_t>(record->text.size());
+        record->tagLength = static_cast<uint32_t>(tag.size());
+        record->text += tag;
+        record->text += "] ";
+        record->messageOffset = static_cast<uint32_t>(record->text.size());
+        record->text += message;
+
+        enqueuedCount.fetch_add(1, std::memory_order_relaxed);
+        pushRecord(record);
+
+        // Warnings and errors are written promptly; everything else waits for the next batch
         if (level >= LogLevel::Warning) {
-            std::cerr << formattedMessage << std::endl;
-        } else {
-            std::cout << formattedMessage << std::endl;
+            wakeWriter(level >= LogLevel::Error);
         }
 
-        // Write to log file
-        if (logFile.is_open()) {
-            logFile << formattedMessage << std::endl;
-            logFile.flush();
+        // If fatal, make sure the message is out before triggering the crash handler
+        if (level == LogLevel::Fatal) {
+            Flush();
+            std::function<void(const std::string&)> handler;
+            {
+                std::lock_guard<std::mutex> lock(callbackMutex);
+                handler = crashHandler;
+            }
+            if (handler) {
+                handler("[" + std::string(levelStr) + "] [" + tag + "] " + message);
+            }
         }
+    }
 
-        // Call registered callbacks
-        for (const auto& kv : logCallbacks) {
-            kv.second(level, tag, message);
+    /**
+     * @brief Block until every message logged so far has been written and flushed.
+     */
+    void Flush() {
+        if (!writerRunning.load(std::memory_order_acquire)) {
+            return;
         }
-
-        // If fatal, trigger crash handler
-        if (level == LogLevel::Fatal && crashHandler) {
-            crashHandler(formattedMessage);
+        if (onWriterThread) {
+            // Logged from a callback: waiting for the writer would wait for this thread, so write directly
+            writeBatch(true);
+            return;
         }
+        uint64_t target = enqueuedCount.load(std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(writerMutex);
+        writerWakeRequested = true;
+        fileFlushRequested = true;
+        writerCv.notify_one();
+        flushCv.wait(lock, [this, target] {
+            return writtenCount.load(std::memory_order_acquire) >= target || !writerRunning.load(std::memory_order_acquire);
+        });
     }
 
     /**
      * @brief Register a log callback.
+     * Callbacks run on the log writer thread.
      * @param callback The callback function to be called when a log message is generated.
      * @return An ID that can be used to unregister the callback.
      */
-    int RegisterLogCallback(std::function<void(LogLevel, const std::string&, const std::string&)> callback) {
-        std::lock_guard<std::mutex> lock(mutex);
+    int RegisterLogCallback(LogCallback callback) {
+        std::lock_guard<std::mutex> lock(callbackMutex);
 
+        // Copy-on-write so the writer can invoke callbacks without holding the lock
+        auto updated = std::make_shared<std::unordered_map<int, LogCallback>>(*logCallbacks);
         int id = nextCallbackId++;
-        logCallbacks[id] = callback;
+        (*updated)[id] = std::move(callback);
+        logCallbacks = std::move(updated);
         return id;
     }
 
@@ -164,9 +222,11 @@ public:
      * @param id The ID of the callback to unregister.
      */
     void UnregisterLogCallback(int id) {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::mutex> lock(callbackMutex);
 
-        logCallbacks.erase(id);
+        auto updated = std::make_shared<std::unordered_map<int, LogCallback>>(*logCallbacks);
+        updated->erase(id);
+        logCallbacks = std::move(updated);
     }
 
     /**
@@ -174,7 +234,7 @@ public:
      * @param handler The crash handler function.
      */
     void SetCrashHandler(std::function<void(const std::string&)> handler) {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::mutex> lock(callbackMutex);
 
         crashHandler = handler;
     }
@@ -184,7 +244,7 @@ public:
      * @param name The name of the measurement.
      */
     void StartMeasurement(const std::string& name) {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::mutex> lock(measurementMutex);
 
         auto now = std::chrono::high_resolution_clock::now();
         measurements[name] = now;
@@ -196,57 +256,298 @@ public:
      */
     void StopMeasurement(const std::string& name) {
         auto now = std::chrono::high_resolution_clock::now();
-        std::lock_guard<std::mutex> lock(mutex);
-
-        auto it = measurements.find(name);
+        std::chrono::high_resolution_clock::time_point start;
+        bool found = false;
+        {
+            std::lock_guard<std::mutex> lock(measurementMutex);
+
+            auto it = measurements.find(name);
+            if (it != measurements.end()) {
+                start = it->second;
+                measurements.erase(it);
+                found = true;
+            }
+        }
 
-        if (it != measurements.end()) {
-            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - it->second).count();
+        // Log outside the lock
+        if (found) {
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
             Log(LogLevel::Debug, "Performance", name + ": " + std::to_string(duration) + " us");
-            measurements.erase(it);
         } else {
             Log(LogLevel::Error, "Performance", "No measurement started with name: " + name);
         }
     }
 
+    /**
+     * @brief Get the display name of a log level.
+     * @param level The log level.
+     * @return The level name.
+     */
+    static const char* GetLevelName(LogLevel level) {
+        switch (level) {
+            case LogLevel::Debug:
+                return "DEBUG";
+            case LogLevel::Info:
+                return "INFO";
+            case LogLevel::Warning:
+                return "WARNING";
+            case LogLevel::Error:
+                return "ERROR";
+            case LogLevel::Fatal:
+                return "FATAL";
+        }
+        return "UNKNOWN";
+    }
 
 protected:
     // Protected constructor for inheritance
     DebugSystem() = default;
-    virtual ~DebugSystem() = default;
+
+    virtual ~DebugSystem() {
+        // Drain and stop the writer; anything still queued is written before exit
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            stopRequested = true;
+        }
+        writerCv.notify_one();
+        if (writerThread.joinable()) {
+            writerThread.join();
+        }
+    }
 
     // Delete copy constructor and assignment operator
     DebugSystem(const DebugSystem&) = delete;
     DebugSystem& operator=(const DebugSystem&) = delete;
 
-    // Mutex for thread safety
-    std::mutex mutex;
-
-    // Log file
+    // Log file (written by the writer thread)
+    std::mutex sinkMutex;
     std::ofstream logFile;
 
     // Initialization flag
-    bool initialized = false;
+    std::atomic<bool> initialized{false};
 
-    // Log callbacks
-    std::unordered_map<int, std::function<void(LogLevel, const std::string&, const std::string&)>> logCallbacks;
-    int nextCallbackId = 0;
+    // Runtime level filter
+    std::atomic<int> minLogLevel{static_cast<int>(LogLevel::Debug)};
 
-    // Crash handler
+    // Log callbacks and crash handler
+    std::mutex callbackMutex;
+    std::shared_ptr<const std::unordered_map<int, LogCallback>> logCallbacks = std::make_shared<std::unordered_map<int, LogCallback>>();
+    int nextCallbackId = 0;
     std::function<void(const std::string&)> crashHandler;
 
     // Performance measurements
+    std::mutex measurementMutex;
     std::unordered_map<std::string, std::chrono::high_resolution_clock::time_point> measurements;
 
-};
+private:
+    static constexpr auto WRITER_INTERVAL = std::chrono::milliseconds(10);
+    static constexpr auto FILE_FLUSH_INTERVAL = std::chrono::milliseconds(250);
+
+    // Intrusive MPSC queue (Vyukov): producers exchange the head, the writer pops from the tail
+    LogRecord queueStub;
+    std::atomic<LogRecord*> queueHead{&queueStub};
+    LogRecord* queueTail = &queueStub;
+    std::atomic<uint64_t> enqueuedCount{0};
+    std::atomic<uint64_t> writtenCount{0};
+
+    // Writer thread
+    std::once_flag writerStarted;
+    std::thread writerThread;
+    std::atomic<bool> writerRunning{false};
+    std::mutex writerMutex;
+    std::condition_variable writerCv;
+    std::condition_variable flushCv;
+    bool writerWakeRequested = false;
+    bool fileFlushRequested = false;
+    bool stopRequested = false;
+    static inline thread_local bool onWriterThread = false;
+
+    void startWriter() {
+        std::call_once(writerStarted, [this]() {
+            writerRunning.store(true, std::memory_order_release);
+            writerThread = std::thread(&DebugSystem::writerLoop, this);
+        });
+    }
+
+    void wakeWriter(bool flushFile) {
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            writerWakeRequested = true;
+            fileFlushRequested = fileFlushRequested || flushFile;
+        }
+        writerCv.notify_one();
+    }
+
+    void pushRecord(LogRecord* record) {
+        record->next.store(nullptr, std::memory_order_relaxed);
+        LogRecord* previous = queueHead.exchange(record, std::memory_order_acq_rel);
+        previous->next.store(record, std::memory_order_release);
+    }
+
+    // Pop one record (writer thread only); returns nullptr if empty or a push is still in progress
+    LogRecord* popRecord() {
+        LogRecord* tail = queueTail;
+        LogRecord* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &queueStub) {
+            if (!next) {
+                return nullptr;
+            }
+            queueTail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            queueTail = next;
+            return tail;
+        }
+        if (tail != queueHead.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        pushRecord(&queueStub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            queueTail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    void writerLoop() {
+        onWriterThread = true;
+        auto lastFileFlush = std::chrono::steady_clock::now();
+        bool stopping = false;
+        while (!stopping) {
+            bool flushFile = false;
+            {
+                std::unique_lock<std::mutex> lock(writerMutex);
+                writerCv.wait_for(lock, WRITER_INTERVAL, [this] { return writerWakeRequested || stopRequested; });
+                writerWakeRequested = false;
+                flushFile = fileFlushRequested;
+                fileFlushRequested = false;
+                stopping = stopRequested;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastFileFlush >= FILE_FLUSH_INTERVAL || stopping) {
+                flushFile = true;
+            }
+            writeBatch(flushFile);
+            if (flushFile) {
+                lastFileFlush = now;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(writerMutex);
+            }
+            flushCv.notify_all();
+        }
+
+        writerRunning.store(false, std::memory_order_release);
+        flushCv.notify_all();
+    }
+
+    void writeBatch(bool flushFile) {
+        std::vector<LogRecord*> batch;
+        while (LogRecord* record = popRecord()) {
+            batch.push_back(record);
+        }
+
+        if (!batch.empty()) {
+            std::string consoleOut;
+            std::string consoleErr;
+            std::string fileOut;
+            std::time_t cachedSecond = -1;
+            char timeStr[20] = {};
+
+            for (LogRecord* record : batch) {
+                // Timestamps are formatted here, once per second of log time
+                std::time_t second = std::chrono::system_clock::to_time_t(record->time);
+                if (second != cachedSecond) {
+                    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", std::localtime(&second));
+                    cachedSecond = second;
+                }
+                auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(record->time.time_since_epoch()).count() % 1000;
+                char msStr[8];
+                std::snprintf(msStr, sizeof(msStr), ".%03d ", static_cast<int>(ms));
+
+                std::string& console = record->level >= LogLevel::Warning ? consoleErr : consoleOut;
+                for (std::string* out : {&console, &fileOut}) {
+                    out->append(timeStr);
+                    out->append(msStr);
+                    out->append(record->text);
+                    out->push_back('\n');
+                }
+                flushFile = flushFile || record->level >= LogLevel::Error;
+            }
+
+            if (!consoleOut.empty()) {
+                std::cout.write(consoleOut.data(), static_cast<std::streamsize>(consoleOut.size()));
+                std::cout.flush();
+            }
+            if (!consoleErr.empty()) {
+                std::cerr.write(consoleErr.data(), static_cast<std::streamsize>(consoleErr.size()));
+                std::cerr.flush();
+            }
+            {
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                if (logFile.is_open()) {
+                    logFile.write(fileOut.data(), static_cast<std::streamsize>(fileOut.size()));
+                }
+            }
 
-// Convenience macros for logging
-#define LOG_DEBUG(tag, message) DebugSystem::GetInstance().Log(LogLevel::Debug, tag, message)
-#define LOG_INFO(tag, message) DebugSystem::GetInstance().Log(LogLevel::Info, tag, message)
-#define LOG_WARNING(tag, message) DebugSystem::GetInstance().Log(LogLevel::Warning, tag, message)
-#define LOG_ERROR(tag, message) DebugSystem::GetInstance().Log(LogLevel::Error, tag, message)
-#define LOG_FATAL(tag, message) DebugSystem::GetInstance().Log(LogLevel::Fatal, tag, message)
+            // Call registered callbacks without holding any lock
+            std::shared_ptr<const std::unordered_map<int, LogCallback>> callbacks;
+            {
+                std::lock_guard<std::mutex> lock(callbackMutex);
+                callbacks = logCallbacks;
+            }
+            if (!callbacks->empty()) {
+                for (LogRecord* record : batch) {
+                    std::string tag = record->text.substr(record->tagOffset, record->tagLength);
+                    std::string message = record->text.substr(record->messageOffset);
+                    for (const auto& kv : *callbacks) {
+                        kv.second(record->level, tag, message);
+                    }
+                }
+            }
+        }
+
+        if (flushFile) {
+            std::lock_guard<std::mutex> lock(sinkMutex);
+            if (logFile.is_open()) {
+                logFile.flush();
+            }
+        }
+
+        uint64_t written = batch.size();
+        for (LogRecord* record : batch) {
+            delete record;
+        }
+        writtenCount.fetch_add(written, std::memory_order_release);
+    }
+};
 
-// Convenience macros for performance measurement
+// Compile-time floor for the logging macros (0 = Debug ... 4 = Fatal); lower levels compile to nothing
+#ifndef SIMPLE_ENGINE_LOG_LEVEL
+#define SIMPLE_ENGINE_LOG_LEVEL 0
+#endif
+
+// Convenience macros for logging. The message expression is only evaluated if the level is enabled.
+#define LOG_AT_LEVEL(level, tag, message) \
+    do { \
+        if constexpr (static_cast<int>(level) >= SIMPLE_ENGINE_LOG_LEVEL) { \
+            if (DebugSystem::GetInstance().IsLevelEnabled(level)) { \
+                DebugSystem::GetInstance().Log(level, tag, message); \
+            } \
+        } \
+    } while (0)
+#define LOG_DEBUG(tag, message) LOG_AT_LEVEL(LogLevel::Debug, tag, message)
+#define LOG_INFO(tag, message) LOG_AT_LEVEL(LogLevel::Info, tag, message)
+#define LOG_WARNING(tag, message) LOG_AT_LEVEL(LogLevel::Warning, tag, message)
+#define LOG_ERROR(tag, message) LOG_AT_LEVEL(LogLevel::Error, tag, message)
+#define LOG_FATAL(tag, message) LOG_AT_LEVEL(LogLevel::Fatal, tag, message)
+
+// Convenience macros for one-off performance measurements logged through DebugSystem.
+// Per-frame hot paths should use PROFILE_SCOPE from profiler.h instead, which does not lock or log.
 #define MEASURE_START(name) DebugSystem::GetInstance().StartMeasurement(name)
 #define MEASURE_END(name) DebugSystem::GetInstance().StopMeasurement(name)
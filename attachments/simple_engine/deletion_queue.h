@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Defers the release of GPU objects until no submitted frame can use them anymore.
+ *
+ * Objects are retired with the serial of the last frame that may reference them
+ * and released in bulk once that frame's fence has signaled (Collect). Retired
+ * objects are either destroyed (Vulkan RAII handles) or handed to a release
+ * function (e.g. returning a MemoryPool::Allocation to its pool). Entries are
+ * released in retirement order: an entry is never released early, but one
+ * retired after an entry with a later serial waits for that entry.
+ *
+ * Holds no Vulkan objects itself, so it can be driven with simulated serials.
+ */
+class DeletionQueue {
+public:
+    /**
+     * @brief Destroy an object once a frame serial has completed.
+     * @tparam T The object type (moved into the queue).
+     * @param serial The last frame serial that may use the object.
+     * @param object The object.
+     */
+    template<typename T>
+    void Retire(uint64_t serial, T&& object) {
+        static_assert(!std::is_lvalue_reference_v<T>, "Retire takes ownership; pass an rvalue");
+        push(serial, std::make_unique<Held<std::decay_t<T>>>(std::move(object)));
+    }
+
+    /**
+     * @brief Call a release function once a frame serial has completed.
+     * @tparam F A callable (may be move-only, e.g. owning the objects it releases).
+     * @param serial The last frame serial that may use the released objects.
+     * @param release The function.
+     */
+    template<typename F>
+    void RetireWith(uint64_t serial, F&& release) {
+        push(serial, std::make_unique<Callback<std::decay_t<F>>>(std::forward<F>(release)));
+    }
+
+    /**
+     * @brief Release everything retired with a serial up to the completed one.
+     * @param completedSerial The newest frame serial whose fence has signaled.
+     * @return The number of entries released.
+     */
+    size_t Collect(uint64_t completedSerial) {
+        // Release outside the lock; release functions may retire further objects
+        std::deque<Entry> released;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (!entries.empty() && entries.front().serial <= completedSerial) {
+                released.push_back(std::move(entries.front()));
+                entries.pop_front();
+            }
+            releasedTotal += released.size();
+        }
+        return released.size();
+    }
+
+    /**
+     * @brief Release everything regardless of serials (after the device is idle).
+     * @return The number of entries released.
+     */
+    size_t Flush() { return Collect(UINT64_MAX); }
+
+    /**
+     * @brief Get the number of entries waiting for their frame.
+     * @return The number of entries.
+     */
+    size_t GetPendingCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+    /**
+     * @brief Get the number of entries released since startup.
+     * @return The number of entries.
+     */
+    uint64_t GetReleasedTotal() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return releasedTotal;
+    }
+
+private:
+    struct Retired {
+        virtual ~Retired() = default;
+    };
+    template<typename T>
+    struct Held final : Retired {
+        explicit Held(T&& object) : object(std::move(object)) {}
+        T object;
+    };
+    template<typename F>
+    struct Callback final : Retired {
+        explicit Callback(F release) : release(std::move(release)) {}
+        ~Callback() override { release(); }
+        F release;
+    };
+    struct Entry {
+        uint64_t serial = 0;
+        std::unique_ptr<Retired> object;
+    };
+
+    mutable std::mutex mutex;
+    std::deque<Entry> entries;
+    uint64_t releasedTotal = 0;
+
+    void push(uint64_t serial, std::unique_ptr<Retired> object) {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.push_back({ serial, std::move(object) });
+    }
+};
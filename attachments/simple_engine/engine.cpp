@@ -1,6 +1,7 @@
 #include "engine.h"
 #include "scene_loading.h"
 #include "mesh_component.h"
+#include "profiler.h"
 
 #include <chrono>
 #include <algorithm>
@@ -8,26 +9,44 @@
 #include <stdexcept>
 #include <iostream>
 #include <random>
+#include <limits>
 
 // This implementation corresponds to the Engine_Architecture chapter in the tutorial:
 // @see en/Building_a_Simple_Engine/Engine_Architecture/02_architectural_patterns.adoc
 
 Engine::Engine()
     : resourceManager(std::make_unique<ResourceManager>()) {
+    entityRegistry.SetDestroyCallback([this](Entity* entity) {
+        if (activeCamera && activeCamera->GetOwner() == entity) {
+            activeCamera = nullptr;
+        }
+        // GPU resources are retired until the frames still drawing the entity have finished
+        if (renderer) {
+            renderer->ReleaseEntityResources(entity);
+        }
+    });
 }
 
 Engine::~Engine() {
     Cleanup();
 }
 
-bool Engine::Initialize(const std::string& appName, int width, int height, bool enableValidationLayers) {
+bool Engine::Initialize(const std::string& appName, int width, int height, bool enableValidationLayers, bool headless) {
+    // Start the CPU profiler first so initialization work on worker threads is captured too
+    Profiler::GetInstance().Initialize();
+    PROFILE_THREAD_NAME("Main");
+
     // Create platform
 #if defined(PLATFORM_ANDROID)
     // For Android, the platform is created with the android_app
     // This will be handled in the android_main function
     return false;
 #else
-    platform = CreatePlatform();
+    if (headless) {
+        platform = std::make_unique<HeadlessPlatform>();
+    } else {
+        platform = CreatePlatform();
+    }
     if (!platform->Initialize(appName, width, height)) {
         return false;
     }
@@ -56,6 +75,7 @@ bool Engine::Initialize(const std::string& appName, int width, int height, bool
 
     // Create renderer
     renderer = std::make_unique<Renderer>(platform.get());
+    renderer->SetUsePackedVertices(usePackedVertices);
     if (!renderer->Initialize(appName, enableValidationLayers)) {
         return false;
     }
@@ -100,6 +120,8 @@ void Engine::Run() {
 
     // Main loop
     while (running) {
+        PROFILE_FRAME_MARK();
+
         // Process platform events
         if (!platform->ProcessEvents()) {
             running = false;
@@ -145,7 +167,136 @@ void Engine::Run() {
     }
 }
 
+bool Engine::RunBenchmark(FrameBenchmark& benchmark) {
+    if (!initialized) {
+        throw std::runtime_error("Engine not initialized");
+    }
+
+    const BenchmarkConfig& config = benchmark.GetConfig();
+    const TimeDelta fixedStep(config.frameStepMs);
+    uint32_t warmupRemaining = config.warmupFrames;
+    bool cameraPathReady = false;
+    uint64_t loadingFrames = 0;
+
+    running = true;
+    while (running && !benchmark.IsComplete()) {
+        PROFILE_FRAME_MARK();
+
+        if (!platform->ProcessEvents()) {
+            running = false;
+            break;
+        }
+
+        // Record once the whole scene is in, not at the first interactive frame
+        bool loading = renderer->IsLoading() || IsSceneStreaming();
+
+        // The default orbit depends on the scene bounds, so build it once loading has finished
+        if (!loading && !cameraPathReady) {
+            if (!benchmark.HasCameraPath()) {
+                glm::vec3 boundsMin(-10.0f), boundsMax(10.0f);
+                ComputeSceneBounds(boundsMin, boundsMax);
+                benchmark.GenerateOrbitPath(boundsMin, boundsMax);
+            }
+            ModelLoadStats loadStats = modelLoader->GetLoadStats(config.scenePath);
+            benchmark.SetSceneLoadTime(loadStats.loadMs, loadStats.meshStageMs, loadStats.fromMeshCache);
+            benchmark.SetLodGenerationStats(loadStats.meshOptimization);
+            benchmark.SetPipelineCreationTime(renderer->GetPipelineCreationMs(), renderer->IsPipelineCacheWarm());
+            cameraPathReady = true;
+            std::cout << "Benchmark: scene ready after " << loadingFrames << " loading frames (model load "
+                      << loadStats.loadMs << " ms, mesh stage " << loadStats.meshStageMs << " ms, "
+                      << (loadStats.fromMeshCache ? "warm" : "cold") << "; interactive after "
+                      << sceneStreamingStats.firstInteractiveMs << " ms, complete after "
+                      << sceneStreamingStats.completeMs << " ms)" << std::endl;
+        }
+
+        auto cpuStart = std::chrono::steady_clock::now();
+
+        // Fixed time step keeps physics/animation identical between runs
+        Update(fixedStep);
+
+        // Drive the camera after Update so manual camera controls cannot override the path
+        float cameraTime = 0.0f;
+        if (cameraPathReady && activeCamera) {
+            if (warmupRemaining == 0) {
+                cameraTime = static_cast<float>(benchmark.GetSamples().size()) * static_cast<float>(config.frameStepMs) * 0.001f;
+            }
+            glm::vec3 position, target;
+            if (benchmark.SampleCamera(cameraTime, position, target)) {
+                if (auto* cameraTransform = activeCamera->GetOwner()->GetComponent<TransformComponent>()) {
+                    cameraTransform->SetPosition(position);
+                }
+                activeCamera->SetTarget(target);
+            }
+        }
+
+        Render();
+
+        double cpuFrameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cpuStart).count();
+        frameCount++;
+
+        if (loading) {
+            loadingFrames++;
+            continue;
+        }
+        if (warmupRemaining > 0) {
+            warmupRemaining--;
+            continue;
+        }
+        if (!config.tracePath.empty() && !Profiler::GetInstance().IsCapturing() && benchmark.GetSamples().empty()) {
+            Profiler::GetInstance().StartCapture();
+        }
+        OpaquePassStats opaqueStats = renderer->GetOpaquePassStats();
+        benchmark.RecordFrame(cameraTime, cpuFrameMs, renderer->GetLastGpuFrameTimeMs(),
+                              opaqueStats.trianglesTotal, opaqueStats.trianglesSubmitted,
+                              static_cast<uint32_t>(opaqueStats.drawCalls), opaqueStats.recordMs,
+                              opaqueStats.uniformBytesWritten, opaqueStats.uniformUpdateMs,
+                              renderer->GetTextureStreamingStats().uploads, renderer->GetTextureStreamingStats().uploadMs);
+    }
+
+    renderer->WaitIdle();
+    if (Profiler::GetInstance().IsCapturing()) {
+        Profiler::GetInstance().StopCaptureAndWrite(config.tracePath);
+    }
+    return benchmark.WriteResults();
+}
+
+bool Engine::ComputeSceneBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const {
+    bool found = false;
+    glm::vec3 minB(std::numeric_limits<float>::max());
+    glm::vec3 maxB(std::numeric_limits<float>::lowest());
+
+    for (const auto& entity : entityRegistry.GetEntities()) {
+        if (!entity || !entity->IsActive()) continue;
+        auto* mesh = entity->GetComponent<MeshComponent>();
+        auto* transform = entity->GetComponent<TransformComponent>();
+        if (!mesh || !transform || !mesh->HasLocalAABB()) continue;
+
+        // Transform all eight corners of the local AABB into world space
+        glm::mat4 model = transform->GetModelMatrix();
+        glm::vec3 localMin = mesh->GetLocalAABBMin();
+        glm::vec3 localMax = mesh->GetLocalAABBMax();
+        for (int corner = 0; corner < 8; ++corner) {
+            glm::vec3 p((corner & 1) ? localMax.x : localMin.x,
+                        (corner & 2) ? localMax.y : localMin.y,
+                        (corner & 4) ? localMax.z : localMin.z);
+            glm::vec3 world = glm::vec3(model * glm::vec4(p, 1.0f));
+            minB = glm::min(minB, world);
+            maxB = glm::max(maxB, world);
+        }
+        found = true;
+    }
+
+    if (found) {
+        boundsMin = minB;
+        boundsMax = maxB;
+    }
+    return found;
+}
+
 void Engine::Cleanup() {
+    // A loader thread waiting to hand over entities must not wait for a frame that never comes
+    sceneStream.Cancel();
+
     if (initialized) {
         // Wait for the device to be idle before cleaning up
         if (renderer) {
@@ -153,8 +304,7 @@ void Engine::Cleanup() {
         }
 
         // Clear entities
-        entities.clear();
-        entityMap.clear();
+        entityRegistry.Clear();
 
         // Clean up subsystems in reverse order of creation
         imguiSystem.reset();
@@ -166,63 +316,133 @@ void Engine::Cleanup() {
 
         initialized = false;
     }
+
+    Profiler::GetInstance().Shutdown();
 }
 
 Entity* Engine::CreateEntity(const std::string& name) {
-    // Always allow duplicate names; map stores a representative entity
-    // Create the entity
-    auto entity = std::make_unique<Entity>(name);
-    // Add to the vector and map
-    entities.push_back(std::move(entity));
-    Entity* rawPtr = entities.back().get();
-    // Update the map to point to the most recently created entity with this name
-    entityMap[name] = rawPtr;
+    // Always allow duplicate names; lookups by name return the most recently created entity
+    return entityRegistry.Create(name);
+}
 
-    return rawPtr;
+void Engine::BeginSceneStreaming() {
+    sceneStream.Open();
+    sceneStreamingStats = {};
+    sceneStreamingStart = std::chrono::steady_clock::now();
+    sceneStreamingReported = false;
 }
 
-Entity* Engine::GetEntity(const std::string& name) {
-    auto it = entityMap.find(name);
-    if (it != entityMap.end()) {
-        return it->second;
-    }
-    return nullptr;
+bool Engine::StreamSceneEntity(std::unique_ptr<Entity> entity, bool staticCollider) {
+    return sceneStream.Push({std::move(entity), staticCollider});
 }
 
-bool Engine::RemoveEntity(Entity* entity) {
-    if (!entity) {
-        return false;
+bool Engine::StreamSceneSetup(std::function<void()> setup) {
+    return sceneStream.PushSetup(std::move(setup));
+}
+
+void Engine::activateStreamedEntities() {
+    if (sceneStreamingReported) {
+        return;
+    }
+    auto elapsedMs = [this] {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sceneStreamingStart).count();
+    };
+    const bool loading = renderer && renderer->IsLoading();
+    if (sceneStreamingStats.firstInteractiveMs == 0.0 && !loading) {
+        sceneStreamingStats.firstInteractiveMs = elapsedMs();
     }
 
-    // Remember the name before erasing ownership
-    std::string name = entity->GetName();
+    for (auto& setup : sceneStream.PopSetups()) {
+        setup();
+    }
 
-    // Find the entity in the vector
-    auto it = std::ranges::find_if(entities,
-                                   [entity](const std::unique_ptr<Entity>& e) {
-                                       return e.get() == entity;
-                                   });
+    std::vector<StreamedEntity> batch = sceneStream.PopBatch(sceneActivationBatch);
+    if (!batch.empty()) {
+        PROFILE_SCOPE("ActivateStreamedEntities");
 
-    if (it != entities.end()) {
-        // Remove from the vector (ownership)
-        entities.erase(it);
+        // Upload the batch's meshes in one submission before any of them can be drawn
+        std::vector<Entity*> entities;
+        entities.reserve(batch.size());
+        for (const StreamedEntity& streamed : batch) {
+            entities.push_back(streamed.entity.get());
+        }
+        // A failed batch is rolled back as a whole; retry its entities one at a time and
+        // drop the ones that still fail rather than adopting entities that cannot be drawn
+        const bool batchAllocated = !renderer || renderer->preAllocateEntityResourcesBatch(entities);
+        size_t activated = 0;
+        for (StreamedEntity& streamed : batch) {
+            if (!batchAllocated && !renderer->preAllocateEntityResources(streamed.entity.get())) {
+                std::cerr << "Failed to pre-allocate resources for streamed entity " << streamed.entity->GetName()
+                          << ", dropping it" << std::endl;
+                sceneStreamingStats.entitiesDropped++;
+                continue;
+            }
+            Entity* entity = entityRegistry.Adopt(std::move(streamed.entity));
+            activated++;
+            if (streamed.staticCollider && physicsSystem) {
+                physicsSystem->EnqueueRigidBodyCreation(
+                    entity,
+                    CollisionShape::Mesh,
+                    0.0f,            // mass 0 = static
+                    true,            // kinematic
+                    0.15f,           // restitution
+                    0.5f             // friction
+                );
+            }
+        }
+        sceneStreamingStats.entitiesActivated += activated;
+        sceneStreamingStats.batches++;
+    }
 
-        // Update the map: point to another entity with the same name if one exists
-        auto remainingIt = std::ranges::find_if(entities,
-                                                [&name](const std::unique_ptr<Entity>& e) {
-                                                    return e->GetName() == name;
-                                                });
+    if (sceneStream.IsActive() || loading) {
+        return;
+    }
+    sceneStreamingStats.completeMs = elapsedMs();
+    sceneStreamingReported = true;
+    std::cout << "Scene streaming: " << sceneStreamingStats.entitiesActivated << " entities activated in "
+              << sceneStreamingStats.batches << " batches; interactive after " << sceneStreamingStats.firstInteractiveMs
+              << " ms, complete after " << sceneStreamingStats.completeMs << " ms";
+    if (sceneStreamingStats.entitiesDropped > 0) {
+        std::cout << "; " << sceneStreamingStats.entitiesDropped << " entities dropped";
+    }
+    std::cout << std::endl;
 
-        if (remainingIt != entities.end()) {
-            entityMap[name] = remainingIt->get();
-        } else {
-            entityMap.erase(name);
+    if (renderer) {
+        GeometrySharingStats sharing = renderer->GetGeometrySharingStats();
+        std::cout << "Mesh geometry: " << sharing.residentMeshes << " resident meshes for " << sharing.meshReferences
+                  << " entities, " << sharing.deviceBytes / 1024 << " KB in device memory, "
+                  << sharing.duplicateBytesAvoided / 1024 << " KB of duplicate uploads avoided" << std::endl;
+
+        const EntityBatchStats& batches = renderer->GetEntityBatchStats();
+        std::cout << "Entity resources: " << batches.entities << " entities in " << batches.batches << " batches, "
+                  << batches.meshUploads << " meshes uploaded through " << batches.stagingBytes / 1024 << " KB of staging, "
+                  << batches.buffersCreated << " buffers created, " << batches.submissions << " transfer submissions" << std::endl;
+
+        if (renderer->IsUsingPackedVertices()) {
+            VertexPackingStats packing = renderer->GetVertexPackingStats();
+            if (packing.vertexCount > 0) {
+                std::cout << "Packed vertices: " << packing.vertexCount << " vertices in " << packing.meshCount << " meshes, "
+                          << packing.packedBytes / 1024 << " KB (vs " << packing.unpackedBytes / 1024 << " KB unpacked), "
+                          << "max position error " << packing.maxPositionError << ", max normal error "
+                          << packing.maxNormalErrorDegrees << " deg" << std::endl;
+            }
         }
-
-        return true;
     }
+}
 
-    return false;
+Entity* Engine::GetEntity(const std::string& name) {
+    return entityRegistry.Find(name);
+}
+
+Entity* Engine::GetEntity(EntityId id) {
+    return entityRegistry.Get(id);
+}
+
+bool Engine::RemoveEntity(Entity* entity) {
+    if (!entity) {
+        return false;
+    }
+    return entityRegistry.Destroy(entity->GetId());
 }
 
 bool Engine::RemoveEntity(const std::string& name) {
@@ -368,17 +588,29 @@ void Engine::handleKeyInput(uint32_t key, bool pressed) {
 }
 
 void Engine::Update(TimeDelta deltaTime) {
-    // During background scene loading we avoid touching the live entity
-    // list from the main thread. This lets the loading thread construct
-    // entities/components safely while the main thread only drives the
-    // UI/loading overlay.
+    PROFILE_SCOPE("Engine::Update");
+
+    // Destroy the resources unloaded last frame; no ResourceHandle::Get() result outlives a frame
+    resourceManager->CollectRetiredResources();
+
+    // While the loader thread parses the scene the main thread drives the
+    // UI/loading overlay and only brings in the entities (and the camera and
+    // light setup) streamed so far, so their uploads overlap the parse. The
+    // rest of the update waits until the loading screen is gone.
     if (renderer && renderer->IsLoading()) {
+        activateStreamedEntities();
         if (imguiSystem) {
             imguiSystem->NewFrame();
         }
         return;
     }
 
+    // Destroy the entities removed since the last update in one batch
+    entityRegistry.FlushDestroyed();
+
+    // Bring in the scene entities the loader has built since the last update
+    activateStreamedEntities();
+
     // Process pending ball creations (outside rendering loop to avoid memory pool constraints)
     ProcessPendingBalls();
 
@@ -402,7 +634,8 @@ void Engine::Update(TimeDelta deltaTime) {
     }
 
     // Update all entities (guard against null unique_ptrs)
-    for (auto& entity : entities) {
+    PROFILE_SCOPE("Entities::Update");
+    for (auto& entity : entityRegistry.GetEntities()) {
         if (!entity) { continue; }
         if (!entity->IsActive()) { continue; }
         entity->Update(deltaTime);
@@ -421,7 +654,7 @@ void Engine::Render() {
     }
 
     // Render the scene (ImGui will be rendered within the render pass)
-    renderer->Render(entities, activeCamera, imguiSystem.get());
+    renderer->Render(entityRegistry.GetEntities(), activeCamera, imguiSystem.get());
 }
 
 std::chrono::milliseconds Engine::CalculateDeltaTimeMs() {
@@ -477,8 +710,8 @@ void Engine::UpdateCameraControls(TimeDelta deltaTime) const {
     // Check if camera tracking is enabled
     if (imguiSystem && imguiSystem->IsCameraTrackingEnabled()) {
         // Find the first active ball entity
-        auto ballEntityIt = std::ranges::find_if( entities, []( auto const & entity ){ return entity->IsActive() && ( entity->GetName().find( "Ball_" ) != std::string::npos ); } );
-        Entity* ballEntity = ballEntityIt != entities.end() ? ballEntityIt->get() : nullptr;
+        auto ballEntityIt = std::ranges::find_if( entityRegistry.GetEntities(), []( auto const & entity ){ return entity->IsActive() && ( entity->GetName().find( "Ball_" ) != std::string::npos ); } );
+        Entity* ballEntity = ballEntityIt != entityRegistry.GetEntities().end() ? ballEntityIt->get() : nullptr;
 
         if (ballEntity) {
             // Get ball's transform component
@@ -712,9 +945,11 @@ void Engine::ProcessPendingBalls() {
             std::cerr << "Failed to add MeshComponent to ball: " << pendingBall.ballName << std::endl;
             continue;
         }
-        // Create tennis ball-sized, bright red sphere
-        glm::vec3 brightRed(1.0f, 0.0f, 0.0f);
-        mesh->CreateSphere(0.0335f, brightRed, 32); // Tennis ball radius, bright color, high detail
+        // Tennis ball-sized sphere, generated once and shared so all balls draw from one upload
+        if (!ballGeometry) {
+            ballGeometry = MeshGeometry::CreateSphere(0.0335f, 32); // Tennis ball radius, high detail
+        }
+        mesh->SetGeometry(ballGeometry);
         mesh->SetTexturePath(renderer->SHARED_BRIGHT_RED_ID); // Use bright red texture for visibility
 
         // Verify mesh geometry was created
@@ -758,6 +993,9 @@ void Engine::HandleMouseHover(float mouseX, float mouseY) {
 #if defined(PLATFORM_ANDROID)
 // Android-specific implementation
 bool Engine::InitializeAndroid(android_app* app, const std::string& appName, bool enableValidationLayers) {
+    Profiler::GetInstance().Initialize();
+    PROFILE_THREAD_NAME("Main");
+
     // Create platform
     platform = CreatePlatform(app);
     if (!platform->Initialize(appName, 0, 0)) {
@@ -808,6 +1046,7 @@ bool Engine::InitializeAndroid(android_app* app, const std::string& appName, boo
 
     // Create renderer
     renderer = std::make_unique<Renderer>(platform.get());
+    renderer->SetUsePackedVertices(usePackedVertices);
     if (!renderer->Initialize(appName, enableValidationLayers)) {
         return false;
     }
@@ -867,6 +1106,8 @@ void Engine::RunAndroid() {
     // Main loop is handled by the platform
     // We just need to update and render when the platform is ready
 
+    PROFILE_FRAME_MARK();
+
     // Calculate delta time
     deltaTimeMs = CalculateDeltaTimeMs();
 
@@ -5,16 +5,20 @@
 #include <memory>
 #include <unordered_map>
 #include <chrono>
+#include <functional>
 
 #include "platform.h"
 #include "renderer.h"
 #include "resource_manager.h"
 #include "entity.h"
+#include "entity_registry.h"
 #include "camera_component.h"
 #include "model_loader.h"
 #include "audio_system.h"
 #include "physics_system.h"
 #include "imgui_system.h"
+#include "frame_benchmark.h"
+#include "scene_streaming.h"
 
 /**
  * @brief Main engine class that manages the game loop and subsystems.
@@ -41,15 +45,35 @@ public:
      * @param width The width of the window.
      * @param height The height of the window.
      * @param enableValidationLayers Whether to enable Vulkan validation layers.
+     * @param headless Whether to render into offscreen images without a window.
      * @return True if initialization was successful, false otherwise.
      */
-    bool Initialize(const std::string& appName, int width, int height, bool enableValidationLayers = true);
+    bool Initialize(const std::string& appName, int width, int height, bool enableValidationLayers = true, bool headless = false);
+
+    /**
+     * @brief Upload mesh geometry in the quantized PackedVertex layout.
+     * Must be called before Initialize().
+     * @param enable Whether to use packed vertices.
+     */
+    void SetUsePackedVertices(bool enable) { usePackedVertices = enable; }
 
     /**
      * @brief Run the main game loop.
      */
     void Run();
 
+    /**
+     * @brief Run the scripted frame-time benchmark instead of the interactive loop.
+     *
+     * Waits for scene loading to finish, renders the configured warmup frames,
+     * then replays the camera path with a fixed time step and records CPU/GPU
+     * frame times until the requested number of frames has been captured.
+     *
+     * @param benchmark The benchmark to drive and record into.
+     * @return True if the results were written successfully, false otherwise.
+     */
+    bool RunBenchmark(FrameBenchmark& benchmark);
+
     /**
      * @brief Clean up engine resources.
      */
@@ -69,20 +93,79 @@ public:
      */
     Entity* GetEntity(const std::string& name);
 
+    /**
+     * @brief Get an entity by ID.
+     * @param id The entity ID.
+     * @return A pointer to the entity, or nullptr if it has been destroyed.
+     */
+    Entity* GetEntity(EntityId id);
+
     /**
      * @brief Remove an entity.
+     *
+     * The entity is deactivated immediately and destroyed at the start of the next update.
+     *
      * @param entity The entity to remove.
-     * @return True if the entity was removed, false otherwise.
+     * @return True if the entity was queued for removal, false otherwise.
      */
     bool RemoveEntity(Entity* entity);
 
     /**
      * @brief Remove an entity by name.
      * @param name The name of the entity to remove.
-     * @return True if the entity was removed, false otherwise.
+     * @return True if the entity was queued for removal, false otherwise.
      */
     bool RemoveEntity(const std::string& name);
 
+    /**
+     * @brief Start a staged scene load.
+     *
+     * The loader thread hands built entities to StreamSceneEntity and calls
+     * EndSceneStreaming when done. Update uploads and activates up to
+     * SetSceneActivationBatch entities per frame, also while the loading
+     * screen is up, so uploads overlap the parse and the scene becomes
+     * interactive before all of its entities have arrived.
+     */
+    void BeginSceneStreaming();
+
+    /**
+     * @brief Hand a built entity to the main thread (thread safe; waits while the hand-off is full).
+     * @param entity The entity, not yet part of the scene.
+     * @param staticCollider Whether to create a static mesh collider for the entity.
+     * @return False if streaming was cancelled (the entity is dropped).
+     */
+    bool StreamSceneEntity(std::unique_ptr<Entity> entity, bool staticCollider);
+
+    /**
+     * @brief Hand scene setup that touches the live scene (camera, lights) to the main thread (thread safe).
+     * @param setup The work, run by the next Update.
+     * @return False if streaming was cancelled (the work is dropped).
+     */
+    bool StreamSceneSetup(std::function<void()> setup);
+
+    /**
+     * @brief Mark the end of the staged scene load (thread safe).
+     */
+    void EndSceneStreaming() { sceneStream.Close(); }
+
+    /**
+     * @brief Check whether streamed entities are still to be activated.
+     * @return True until the last streamed entity is part of the scene.
+     */
+    bool IsSceneStreaming() const { return sceneStream.IsActive(); }
+
+    /**
+     * @brief Set the number of streamed entities activated per frame.
+     * @param count The number of entities (0 = all that have arrived).
+     */
+    void SetSceneActivationBatch(size_t count) { sceneActivationBatch = count; }
+
+    /**
+     * @brief Get the progress of the staged scene load.
+     * @return The activation counts and timings.
+     */
+    const SceneStreamingStats& GetSceneStreamingStats() const { return sceneStreamingStats; }
+
     /**
      * @brief Set the active camera.
      * @param cameraComponent The camera component to set as active.
@@ -192,8 +275,14 @@ private:
     std::unique_ptr<ImGuiSystem> imguiSystem;
 
     // Entities
-    std::vector<std::unique_ptr<Entity>> entities;
-    std::unordered_map<std::string, Entity*> entityMap;
+    EntityRegistry entityRegistry;
+
+    // Staged scene load: entities built by the loader thread wait here for activation
+    SceneStreamQueue sceneStream;
+    size_t sceneActivationBatch = 32;
+    SceneStreamingStats sceneStreamingStats;
+    std::chrono::steady_clock::time_point sceneStreamingStart;
+    bool sceneStreamingReported = true;
 
     // Active camera
     CameraComponent* activeCamera = nullptr;
@@ -201,6 +290,7 @@ private:
     // Engine state
     bool initialized = false;
     bool running = false;
+    bool usePackedVertices = false;
 
     // Delta time calculation
     // deltaTimeMs: time since last frame in milliseconds (for clarity)
@@ -248,6 +338,9 @@ private:
 
     BallMaterial ballMaterial;
 
+    // Sphere geometry shared by all thrown balls (created with the first ball)
+    std::shared_ptr<const MeshGeometry> ballGeometry;
+
     // Physics scaling configuration
     // The bistro scene spans roughly 20 game units and represents a realistic cafe/bistro space
     // Based on issue feedback: game units should NOT equal 1m and need proper scaling
@@ -348,6 +441,19 @@ private:
      */
     void ProcessPendingBalls();
 
+    /**
+     * @brief Upload and activate the next batch of streamed scene entities.
+     */
+    void activateStreamedEntities();
+
+    /**
+     * @brief Compute the world-space bounds of all mesh entities.
+     * @param boundsMin Receives the minimum corner.
+     * @param boundsMax Receives the maximum corner.
+     * @return True if at least one mesh contributed to the bounds, false otherwise.
+     */
+    bool ComputeSceneBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const;
+
     /**
      * @brief Handle mouse hover to track current mouse position.
      * @param mouseX The x-coordinate of the mouse position.
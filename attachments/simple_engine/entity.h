@@ -6,9 +6,16 @@
 #include <algorithm>
 #include <chrono>
 #include <type_traits>
+#include <cstdint>
 
 #include "component.h"
 
+/**
+ * @brief Generational entity ID (slot index and generation), see EntityRegistry.
+ */
+using EntityId = uint32_t;
+constexpr EntityId INVALID_ENTITY_ID = 0;
+
 /**
  * @brief Entity class that can have multiple components attached to it.
  *
@@ -19,8 +26,11 @@ class Entity {
 private:
     std::string name;
     bool active = true;
+    EntityId id = INVALID_ENTITY_ID; // Assigned by the EntityRegistry that owns the entity
     std::vector<std::unique_ptr<Component>> components;
 
+    friend class EntityRegistry;
+
 public:
     /**
      * @brief Constructor with a name.
@@ -39,6 +49,12 @@ public:
      */
     const std::string& GetName() const { return name; }
 
+    /**
+     * @brief Get the ID of the entity.
+     * @return The generational ID, or INVALID_ENTITY_ID if no registry owns the entity.
+     */
+    EntityId GetId() const { return id; }
+
     /**
      * @brief Check if the entity is active.
      * @return True if the entity is active, false otherwise.
@@ -0,0 +1,205 @@
+#include "entity_registry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+
+Entity* EntityRegistry::Create(const std::string& name) {
+    return Adopt(std::make_unique<Entity>(name));
+}
+
+Entity* EntityRegistry::Adopt(std::unique_ptr<Entity> entity) {
+    if (!entity) {
+        return nullptr;
+    }
+    uint32_t slotIndex;
+    if (!freeSlots.empty()) {
+        slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        if (slots.size() > INDEX_MASK) {
+            throw std::runtime_error("Too many entities: " + entity->GetName());
+        }
+        slotIndex = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+
+    Slot& slot = slots[slotIndex];
+    slot.denseIndex = static_cast<uint32_t>(dense.size());
+    slot.pendingDestroy = false;
+
+    entity->id = (slot.generation << INDEX_BITS) | slotIndex;
+    Entity* rawPtr = entity.get();
+    dense.push_back(std::move(entity));
+    denseToSlot.push_back(slotIndex);
+
+    if (indexNames) {
+        idsByName[rawPtr->GetName()].push_back(rawPtr->id);
+    }
+    return rawPtr;
+}
+
+bool EntityRegistry::Destroy(EntityId id) {
+    Entity* entity = Get(id);
+    if (!entity) {
+        return false;
+    }
+    Slot& slot = slots[id & INDEX_MASK];
+    if (slot.pendingDestroy) {
+        return false;
+    }
+    // Systems skip inactive entities, so the entity is gone for them from now on
+    slot.pendingDestroy = true;
+    entity->SetActive(false);
+    pendingDestroy.push_back(id);
+    return true;
+}
+
+size_t EntityRegistry::FlushDestroyed() {
+    // Callbacks may queue further entities; those are flushed in the next call
+    std::vector<EntityId> batch;
+    batch.swap(pendingDestroy);
+
+    for (EntityId id : batch) {
+        const uint32_t slotIndex = id & INDEX_MASK;
+        Slot& slot = slots[slotIndex];
+        const uint32_t denseIndex = slot.denseIndex;
+        Entity* entity = dense[denseIndex].get();
+
+        if (destroyCallback) {
+            destroyCallback(entity);
+        }
+        if (indexNames) {
+            removeName(entity->GetName(), id);
+        }
+
+        // Swap with the last entity and pop
+        const uint32_t last = static_cast<uint32_t>(dense.size() - 1);
+        if (denseIndex != last) {
+            dense[denseIndex] = std::move(dense[last]);
+            denseToSlot[denseIndex] = denseToSlot[last];
+            slots[denseToSlot[denseIndex]].denseIndex = denseIndex;
+        }
+        dense.pop_back();
+        denseToSlot.pop_back();
+
+        // A new generation invalidates outstanding IDs of the slot
+        slot.generation = (slot.generation + 1) & GENERATION_MASK;
+        if (slot.generation == 0) {
+            slot.generation = 1;
+        }
+        slot.pendingDestroy = false;
+        freeSlots.push_back(slotIndex);
+    }
+    return batch.size();
+}
+
+Entity* EntityRegistry::Find(const std::string& name) const {
+    auto it = idsByName.find(name);
+    if (it == idsByName.end() || it->second.empty()) {
+        return nullptr;
+    }
+    return Get(it->second.back());
+}
+
+void EntityRegistry::removeName(const std::string& name, EntityId id) {
+    auto it = idsByName.find(name);
+    if (it == idsByName.end()) {
+        return;
+    }
+    // Names are nearly always unique, so the list is short
+    auto& ids = it->second;
+    auto idIt = std::ranges::find(ids, id);
+    if (idIt != ids.end()) {
+        ids.erase(idIt);
+    }
+    if (ids.empty()) {
+        idsByName.erase(it);
+    }
+}
+
+void EntityRegistry::Clear() {
+    dense.clear();
+    denseToSlot.clear();
+    slots.clear();
+    freeSlots.clear();
+    pendingDestroy.clear();
+    idsByName.clear();
+}
+
+EntityChurnBenchmark EntityRegistry::BenchmarkChurn(size_t entityCount, size_t churnPerRound, size_t rounds) {
+    EntityChurnBenchmark result;
+    result.entityCount = std::max<size_t>(entityCount, 1);
+    result.churnPerRound = std::min(churnPerRound, result.entityCount);
+    result.rounds = rounds;
+
+    // Thrown balls: unique names, random despawn order
+    size_t nameCounter = 0;
+    auto nextName = [&nameCounter]() { return "Ball_" + std::to_string(nameCounter++); };
+    std::mt19937 rng(42);
+
+    {
+        EntityRegistry registry;
+        std::vector<EntityId> live;
+        for (size_t i = 0; i < result.entityCount; ++i) {
+            live.push_back(registry.Create(nextName())->GetId());
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < rounds; ++round) {
+            for (size_t i = 0; i < result.churnPerRound; ++i) {
+                size_t pick = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+                registry.Destroy(live[pick]);
+                live[pick] = live.back();
+                live.pop_back();
+            }
+            registry.FlushDestroyed();
+            for (size_t i = 0; i < result.churnPerRound; ++i) {
+                live.push_back(registry.Create(nextName())->GetId());
+            }
+        }
+        result.registryMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    {
+        // The previous Engine::CreateEntity/RemoveEntity
+        std::vector<std::unique_ptr<Entity>> entities;
+        std::unordered_map<std::string, Entity*> entityMap;
+        auto create = [&](const std::string& name) {
+            entities.push_back(std::make_unique<Entity>(name));
+            entityMap[name] = entities.back().get();
+            return entities.back().get();
+        };
+        auto remove = [&](Entity* entity) {
+            std::string name = entity->GetName();
+            auto it = std::ranges::find_if(entities, [entity](const std::unique_ptr<Entity>& e) { return e.get() == entity; });
+            if (it == entities.end()) return;
+            entities.erase(it);
+            auto remainingIt = std::ranges::find_if(entities, [&name](const std::unique_ptr<Entity>& e) { return e->GetName() == name; });
+            if (remainingIt != entities.end()) {
+                entityMap[name] = remainingIt->get();
+            } else {
+                entityMap.erase(name);
+            }
+        };
+
+        std::vector<Entity*> live;
+        for (size_t i = 0; i < result.entityCount; ++i) {
+            live.push_back(create(nextName()));
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < rounds; ++round) {
+            for (size_t i = 0; i < result.churnPerRound; ++i) {
+                size_t pick = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+                remove(live[pick]);
+                live[pick] = live.back();
+                live.pop_back();
+            }
+            for (size_t i = 0; i < result.churnPerRound; ++i) {
+                live.push_back(create(nextName()));
+            }
+        }
+        result.legacyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    return result;
+}
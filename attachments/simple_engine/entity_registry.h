@@ -0,0 +1,147 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+
+#include "entity.h"
+
+/**
+ * @brief Spawn/despawn timing of the entity registry, see EntityRegistry::BenchmarkChurn.
+ */
+struct EntityChurnBenchmark {
+    size_t entityCount = 0;      // Live entities kept in the registry
+    size_t churnPerRound = 0;    // Entities destroyed and spawned again each round
+    size_t rounds = 0;
+    double registryMs = 0.0;     // Total time with the registry
+    double legacyMs = 0.0;       // Total time with vector erase and name map repair
+};
+
+/**
+ * @brief Owns the entities of the engine.
+ *
+ * Entities are stored densely in a vector of unique_ptrs (so the renderer and
+ * systems iterate them without holes) and addressed by 32-bit generational IDs
+ * that map to their dense index in O(1). Destroying an entity deactivates it
+ * immediately and queues it; FlushDestroyed() removes all queued entities once
+ * per frame by swapping each with the last element, so removal order does not
+ * matter and no element is shifted. IDs of destroyed entities stop resolving
+ * even after their slot is reused.
+ *
+ * Entities can optionally be indexed by name; with duplicate names the most
+ * recently created live entity is returned.
+ *
+ * Not thread safe; the engine creates and destroys entities from one thread at a time.
+ */
+class EntityRegistry {
+public:
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+    /**
+     * @brief Constructor.
+     * @param indexNames True to maintain the name index used by Find(name).
+     */
+    explicit EntityRegistry(bool indexNames = true) : indexNames(indexNames) {}
+
+    /**
+     * @brief Create an entity.
+     * @param name The name of the entity (need not be unique).
+     * @return A pointer to the entity; stable until the entity is flushed.
+     */
+    Entity* Create(const std::string& name);
+
+    /**
+     * @brief Add an entity that was built outside the registry (e.g. by a loader thread).
+     * @param entity The entity; it must not belong to a registry yet.
+     * @return A pointer to the entity (the same object), or nullptr if entity is null.
+     */
+    Entity* Adopt(std::unique_ptr<Entity> entity);
+
+    /**
+     * @brief Queue an entity for destruction and deactivate it.
+     * @param id The entity ID.
+     * @return True if the entity was queued, false if the ID is stale or already queued.
+     */
+    bool Destroy(EntityId id);
+
+    /**
+     * @brief Destroy all queued entities.
+     * @return The number of entities destroyed.
+     */
+    size_t FlushDestroyed();
+
+    /**
+     * @brief Set a function called for each entity right before it is destroyed.
+     * @param callback The function.
+     */
+    void SetDestroyCallback(std::function<void(Entity*)> callback) { destroyCallback = std::move(callback); }
+
+    /**
+     * @brief Get an entity by ID.
+     * @param id The entity ID.
+     * @return A pointer to the entity, or nullptr if the ID is stale.
+     */
+    Entity* Get(EntityId id) const {
+        const uint32_t index = id & INDEX_MASK;
+        if (id == INVALID_ENTITY_ID || index >= slots.size() || slots[index].generation != (id >> INDEX_BITS)) {
+            return nullptr;
+        }
+        return dense[slots[index].denseIndex].get();
+    }
+
+    /**
+     * @brief Get an entity by name.
+     * @param name The name of the entity.
+     * @return The most recently created live entity with that name, or nullptr if none or names are not indexed.
+     */
+    Entity* Find(const std::string& name) const;
+
+    /**
+     * @brief Get all live entities (including those queued for destruction until the next flush).
+     * @return The entities in dense storage order.
+     */
+    const std::vector<std::unique_ptr<Entity>>& GetEntities() const { return dense; }
+
+    /**
+     * @brief Get the number of entities queued for destruction.
+     * @return The number of entities.
+     */
+    size_t GetPendingDestroyCount() const { return pendingDestroy.size(); }
+
+    /**
+     * @brief Destroy all entities immediately (no callbacks).
+     */
+    void Clear();
+
+    /**
+     * @brief Time spawn/despawn churn against the previous vector erase and linear name repair.
+     * @param entityCount The number of live entities.
+     * @param churnPerRound The number of random entities destroyed and spawned again per round.
+     * @param rounds The number of rounds.
+     * @return The total time of each approach.
+     */
+    static EntityChurnBenchmark BenchmarkChurn(size_t entityCount, size_t churnPerRound, size_t rounds);
+
+private:
+    struct Slot {
+        uint32_t denseIndex = 0;
+        uint32_t generation = 1; // Never 0, so no live ID equals INVALID_ENTITY_ID
+        bool pendingDestroy = false;
+    };
+
+    bool indexNames;
+    std::vector<std::unique_ptr<Entity>> dense;
+    std::vector<uint32_t> denseToSlot;   // Slot index of each dense entity
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    std::vector<EntityId> pendingDestroy;
+    std::unordered_map<std::string, std::vector<EntityId>> idsByName; // Creation order per name
+    std::function<void(Entity*)> destroyCallback;
+
+    void removeName(const std::string& name, EntityId id);
+};
@@ -0,0 +1,262 @@
+#include "frame_benchmark.h"
+#include "profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+FrameBenchmark::FrameBenchmark(BenchmarkConfig config)
+    : config(std::move(config)) {
+    samples.reserve(this->config.frameCount);
+}
+
+bool FrameBenchmark::LoadCameraPath(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open camera path file: " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<CameraPathKeyframe> loaded;
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        // Skip blank lines and comments
+        auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+
+        std::istringstream stream(line);
+        CameraPathKeyframe key;
+        if (!(stream >> key.time >> key.position.x >> key.position.y >> key.position.z
+                     >> key.target.x >> key.target.y >> key.target.z)) {
+            std::cerr << "Invalid camera path keyframe at " << filename << ":" << lineNumber << std::endl;
+            return false;
+        }
+        if (!loaded.empty() && key.time <= loaded.back().time) {
+            std::cerr << "Camera path keyframes must be sorted by time (" << filename << ":" << lineNumber << ")" << std::endl;
+            return false;
+        }
+        loaded.push_back(key);
+    }
+
+    if (loaded.size() < 2) {
+        std::cerr << "Camera path needs at least two keyframes: " << filename << std::endl;
+        return false;
+    }
+
+    cameraPath = std::move(loaded);
+    std::cout << "Loaded camera path with " << cameraPath.size() << " keyframes ("
+              << cameraPath.back().time - cameraPath.front().time << "s)" << std::endl;
+    return true;
+}
+
+void FrameBenchmark::GenerateOrbitPath(const glm::vec3& boundsMin, const glm::vec3& boundsMax, float durationSeconds) {
+    cameraPath.clear();
+
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    glm::vec3 extent = glm::max(boundsMax - boundsMin, glm::vec3(1.0f));
+    // Orbit inside the horizontal footprint so interiors (e.g., Bistro) are seen from within
+    float radius = 0.35f * std::max(extent.x, extent.z);
+    float height = boundsMin.y + 0.25f * extent.y;
+
+    constexpr uint32_t keyCount = 32;
+    for (uint32_t i = 0; i <= keyCount; ++i) {
+        float t = static_cast<float>(i) / static_cast<float>(keyCount);
+        float angle = t * 2.0f * static_cast<float>(M_PI);
+        CameraPathKeyframe key;
+        key.time = t * durationSeconds;
+        key.position = glm::vec3(center.x + radius * std::cos(angle), height, center.z + radius * std::sin(angle));
+        key.target = glm::vec3(center.x, height, center.z);
+        cameraPath.push_back(key);
+    }
+
+    std::cout << "Generated default orbit camera path (radius " << radius << ", "
+              << durationSeconds << "s)" << std::endl;
+}
+
+bool FrameBenchmark::SampleCamera(float time, glm::vec3& position, glm::vec3& target) const {
+    if (!HasCameraPath()) {
+        return false;
+    }
+
+    float start = cameraPath.front().time;
+    float duration = cameraPath.back().time - start;
+    float localTime = start + (duration > 0.0f ? std::fmod(std::max(time, 0.0f), duration) : 0.0f);
+
+    // Find the first keyframe after localTime
+    auto next = std::ranges::upper_bound(cameraPath, localTime, {}, &CameraPathKeyframe::time);
+    if (next == cameraPath.begin()) {
+        position = cameraPath.front().position;
+        target = cameraPath.front().target;
+        return true;
+    }
+    if (next == cameraPath.end()) {
+        position = cameraPath.back().position;
+        target = cameraPath.back().target;
+        return true;
+    }
+
+    const CameraPathKeyframe& a = *(next - 1);
+    const CameraPathKeyframe& b = *next;
+    float alpha = (localTime - a.time) / (b.time - a.time);
+    position = glm::mix(a.position, b.position, alpha);
+    target = glm::mix(a.target, b.target, alpha);
+    return true;
+}
+
+void FrameBenchmark::RecordFrame(float cameraTime, double cpuFrameMs, double gpuFrameMs,
+                                 uint64_t trianglesTotal, uint64_t trianglesSubmitted,
+                                 uint32_t opaqueDrawCalls, double opaqueRecordMs,
+                                 uint64_t uniformBytes, double uniformUpdateMs,
+                                 uint32_t textureUploads, double textureStreamMs) {
+    FrameTimingSample sample;
+    sample.frameIndex = static_cast<uint32_t>(samples.size());
+    sample.cameraTime = cameraTime;
+    sample.cpuFrameMs = cpuFrameMs;
+    sample.gpuFrameMs = gpuFrameMs;
+    sample.trianglesTotal = trianglesTotal;
+    sample.trianglesSubmitted = trianglesSubmitted;
+    sample.opaqueDrawCalls = opaqueDrawCalls;
+    sample.opaqueRecordMs = opaqueRecordMs;
+    sample.uniformBytes = uniformBytes;
+    sample.uniformUpdateMs = uniformUpdateMs;
+    sample.textureUploads = textureUploads;
+    sample.textureStreamMs = textureStreamMs;
+    samples.push_back(sample);
+}
+
+double FrameBenchmark::Percentile(std::vector<double> values, double percentile) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::ranges::sort(values);
+
+    double rank = std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(values.size() - 1);
+    auto lower = static_cast<size_t>(std::floor(rank));
+    size_t upper = std::min(lower + 1, values.size() - 1);
+    double fraction = rank - static_cast<double>(lower);
+    return values[lower] + (values[upper] - values[lower]) * fraction;
+}
+
+std::string FrameBenchmark::summarizeToJson(const std::vector<double>& values) {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(4);
+    if (values.empty()) {
+        json << "{ \"count\": 0 }";
+        return json.str();
+    }
+
+    double sum = std::accumulate(values.begin(), values.end(), 0.0);
+    auto [minIt, maxIt] = std::ranges::minmax_element(values);
+    json << "{ \"count\": " << values.size()
+         << ", \"mean\": " << sum / static_cast<double>(values.size())
+         << ", \"min\": " << *minIt
+         << ", \"max\": " << *maxIt
+         << ", \"p50\": " << Percentile(values, 50.0)
+         << ", \"p90\": " << Percentile(values, 90.0)
+         << ", \"p95\": " << Percentile(values, 95.0)
+         << ", \"p99\": " << Percentile(values, 99.0)
+         << " }";
+    return json.str();
+}
+
+bool FrameBenchmark::WriteResults() const {
+    const std::string csvPath = config.outputPrefix + ".csv";
+    const std::string jsonPath = config.outputPrefix + ".json";
+
+    std::ofstream csv(csvPath);
+    if (!csv.is_open()) {
+        std::cerr << "Failed to open benchmark output: " << csvPath << std::endl;
+        return false;
+    }
+    csv << "frame,camera_time_s,cpu_ms,gpu_ms,triangles_total,triangles_submitted,opaque_draw_calls,opaque_record_ms,uniform_bytes,uniform_ms,texture_uploads,texture_stream_ms\n";
+    csv << std::fixed << std::setprecision(4);
+    for (const auto& sample : samples) {
+        csv << sample.frameIndex << ',' << sample.cameraTime << ','
+            << sample.cpuFrameMs << ',' << sample.gpuFrameMs << ','
+            << sample.trianglesTotal << ',' << sample.trianglesSubmitted << ','
+            << sample.opaqueDrawCalls << ',' << sample.opaqueRecordMs << ','
+            << sample.uniformBytes << ',' << sample.uniformUpdateMs << ','
+            << sample.textureUploads << ',' << sample.textureStreamMs << '\n';
+    }
+
+    std::vector<double> cpuTimes;
+    std::vector<double> gpuTimes;
+    std::vector<double> trianglesTotal;
+    std::vector<double> trianglesSubmitted;
+    std::vector<double> opaqueDrawCalls;
+    std::vector<double> opaqueRecordTimes;
+    std::vector<double> uniformBytes;
+    std::vector<double> uniformUpdateTimes;
+    std::vector<double> textureStreamTimes;
+    cpuTimes.reserve(samples.size());
+    gpuTimes.reserve(samples.size());
+    trianglesTotal.reserve(samples.size());
+    trianglesSubmitted.reserve(samples.size());
+    opaqueDrawCalls.reserve(samples.size());
+    opaqueRecordTimes.reserve(samples.size());
+    uniformBytes.reserve(samples.size());
+    uniformUpdateTimes.reserve(samples.size());
+    textureStreamTimes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        cpuTimes.push_back(sample.cpuFrameMs);
+        trianglesTotal.push_back(static_cast<double>(sample.trianglesTotal));
+        trianglesSubmitted.push_back(static_cast<double>(sample.trianglesSubmitted));
+        opaqueDrawCalls.push_back(static_cast<double>(sample.opaqueDrawCalls));
+        opaqueRecordTimes.push_back(sample.opaqueRecordMs);
+        uniformBytes.push_back(static_cast<double>(sample.uniformBytes));
+        uniformUpdateTimes.push_back(sample.uniformUpdateMs);
+        textureStreamTimes.push_back(sample.textureStreamMs);
+        // A zero GPU time means timestamps were unavailable for that frame
+        if (sample.gpuFrameMs > 0.0) {
+            gpuTimes.push_back(sample.gpuFrameMs);
+        }
+    }
+
+    // Per worker thread; zero on a mesh cache hit
+    double lodTrianglesPerSecond = lodGeneration.lodMs > 0.0 ?
+        static_cast<double>(lodGeneration.lodSourceTriangles) / (lodGeneration.lodMs * 1e-3) : 0.0;
+
+    std::ofstream json(jsonPath);
+    if (!json.is_open()) {
+        std::cerr << "Failed to open benchmark output: " << jsonPath << std::endl;
+        return false;
+    }
+    json << "{\n"
+         << "  \"scene\": \"" << Profiler::EscapeJson(config.scenePath) << "\",\n"
+         << "  \"cameraPath\": \"" << (config.cameraPathFile.empty() ? "orbit" : Profiler::EscapeJson(config.cameraPathFile)) << "\",\n"
+         << "  \"warmupFrames\": " << config.warmupFrames << ",\n"
+         << "  \"frameStepMs\": " << config.frameStepMs << ",\n"
+         << "  \"sceneLoadMs\": " << sceneLoadMs << ",\n"
+         << "  \"meshStageMs\": " << sceneMeshStageMs << ",\n"
+         << "  \"meshCacheHit\": " << (sceneFromMeshCache ? "true" : "false") << ",\n"
+         << "  \"pipelineCreateMs\": " << pipelineCreateMs << ",\n"
+         << "  \"pipelineCacheHit\": " << (pipelineCacheWarm ? "true" : "false") << ",\n"
+         << "  \"lodLevels\": " << lodGeneration.lodCount << ",\n"
+         << "  \"lodTrianglesPerSecond\": " << lodTrianglesPerSecond << ",\n"
+         << "  \"lodMaxRelativeError\": " << lodGeneration.maxLodRelativeError << ",\n"
+         << "  \"frames\": " << samples.size() << ",\n"
+         << "  \"cpuFrameMs\": " << summarizeToJson(cpuTimes) << ",\n"
+         << "  \"gpuFrameMs\": " << summarizeToJson(gpuTimes) << ",\n"
+         << "  \"trianglesTotal\": " << summarizeToJson(trianglesTotal) << ",\n"
+         << "  \"trianglesSubmitted\": " << summarizeToJson(trianglesSubmitted) << ",\n"
+         << "  \"opaqueDrawCalls\": " << summarizeToJson(opaqueDrawCalls) << ",\n"
+         << "  \"opaqueRecordMs\": " << summarizeToJson(opaqueRecordTimes) << ",\n"
+         << "  \"uniformBytes\": " << summarizeToJson(uniformBytes) << ",\n"
+         << "  \"uniformUpdateMs\": " << summarizeToJson(uniformUpdateTimes) << ",\n"
+         << "  \"textureStreamMs\": " << summarizeToJson(textureStreamTimes) << "\n"
+         << "}\n";
+
+    std::cout << "Benchmark results written to " << csvPath << " and " << jsonPath
+              << " (CPU p50 " << Percentile(cpuTimes, 50.0) << " ms, p99 " << Percentile(cpuTimes, 99.0)
+              << " ms; GPU p50 " << Percentile(gpuTimes, 50.0) << " ms, p99 " << Percentile(gpuTimes, 99.0)
+              << " ms)" << std::endl;
+    return true;
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "mesh_optimizer.h"
+
+/**
+ * @brief A single keyframe of a scripted benchmark camera path.
+ */
+struct CameraPathKeyframe {
+    float time = 0.0f;                      // Seconds from the start of the path
+    glm::vec3 position = glm::vec3(0.0f);   // Camera position in world space
+    glm::vec3 target = glm::vec3(0.0f);     // Point the camera looks at
+};
+
+/**
+ * @brief Per-frame timing sample captured by the benchmark.
+ */
+struct FrameTimingSample {
+    uint32_t frameIndex = 0;
+    float cameraTime = 0.0f;   // Position along the camera path in seconds
+    double cpuFrameMs = 0.0;   // Wall time spent in Update + Render on the main thread
+    double gpuFrameMs = 0.0;   // GPU time of the frame command buffer (timestamp queries)
+    uint64_t trianglesTotal = 0;     // Opaque triangles before meshlet culling
+    uint64_t trianglesSubmitted = 0; // Opaque triangles actually drawn
+    uint32_t opaqueDrawCalls = 0;    // Draw commands recorded by the opaque pass (direct or indirect)
+    double opaqueRecordMs = 0.0;     // CPU time spent recording the opaque pass
+    uint64_t uniformBytes = 0;       // Global uniform, light and object data written to mapped memory
+    double uniformUpdateMs = 0.0;    // CPU time spent writing them
+    uint32_t textureUploads = 0;     // Streamed textures uploaded during the frame
+    double textureStreamMs = 0.0;    // CPU time spent uploading them
+};
+
+/**
+ * @brief Configuration for a benchmark run.
+ */
+struct BenchmarkConfig {
+    std::string scenePath;                  // glTF scene to load
+    std::string cameraPathFile;             // Optional keyframe file; an orbit around the scene is used if empty
+    std::string outputPrefix = "benchmark"; // Results are written to <prefix>.csv and <prefix>.json
+    std::string tracePath;                  // Optional Chrome trace of the recorded frames (profiler capture)
+    uint32_t warmupFrames = 60;             // Frames rendered after loading before recording starts
+    uint32_t frameCount = 1000;             // Number of frames to record
+    uint32_t frameStepMs = 16;              // Fixed simulation step so runs are reproducible
+};
+
+/**
+ * @brief Scripted frame-time benchmark.
+ *
+ * Replays a camera path over a loaded scene with a fixed time step and records
+ * per-frame CPU and GPU timings. Results are written as a per-frame CSV and a
+ * JSON summary with percentiles so runs can be compared across renderer changes.
+ */
+class FrameBenchmark {
+public:
+    /**
+     * @brief Constructor with a benchmark configuration.
+     * @param config The configuration for the run.
+     */
+    explicit FrameBenchmark(BenchmarkConfig config);
+
+    /**
+     * @brief Load a camera path from a text file.
+     *
+     * Each non-empty line that does not start with '#' contains seven numbers:
+     * time px py pz tx ty tz. Keyframes must be sorted by time.
+     *
+     * @param filename The path to the camera path file.
+     * @return True if at least two keyframes were loaded, false otherwise.
+     */
+    bool LoadCameraPath(const std::string& filename);
+
+    /**
+     * @brief Generate a default orbit path around the given scene bounds.
+     * @param boundsMin The minimum corner of the scene bounds.
+     * @param boundsMax The maximum corner of the scene bounds.
+     * @param durationSeconds The time needed for one full orbit.
+     */
+    void GenerateOrbitPath(const glm::vec3& boundsMin, const glm::vec3& boundsMax, float durationSeconds = 20.0f);
+
+    /**
+     * @brief Check if a camera path is available.
+     * @return True if the path has at least two keyframes, false otherwise.
+     */
+    bool HasCameraPath() const { return cameraPath.size() >= 2; }
+
+    /**
+     * @brief Sample the camera path at the given time (wraps around at the end of the path).
+     * @param time The time in seconds.
+     * @param position Receives the interpolated camera position.
+     * @param target Receives the interpolated camera target.
+     * @return True if the path could be sampled, false otherwise.
+     */
+    bool SampleCamera(float time, glm::vec3& position, glm::vec3& target) const;
+
+    /**
+     * @brief Record the timings of one frame.
+     * @param cameraTime The camera path time of the frame.
+     * @param cpuFrameMs The CPU frame time in milliseconds.
+     * @param gpuFrameMs The GPU frame time in milliseconds.
+     * @param trianglesTotal The opaque triangle count before meshlet culling.
+     * @param trianglesSubmitted The opaque triangle count actually drawn.
+     * @param opaqueDrawCalls The number of draw calls recorded by the opaque pass.
+     * @param opaqueRecordMs The CPU time spent recording the opaque pass in milliseconds.
+     * @param uniformBytes The bytes of uniform and object data written for the frame.
+     * @param uniformUpdateMs The CPU time spent writing them in milliseconds.
+     * @param textureUploads The number of streamed textures uploaded during the frame.
+     * @param textureStreamMs The CPU time spent uploading them in milliseconds.
+     */
+    void RecordFrame(float cameraTime, double cpuFrameMs, double gpuFrameMs,
+                     uint64_t trianglesTotal = 0, uint64_t trianglesSubmitted = 0,
+                     uint32_t opaqueDrawCalls = 0, double opaqueRecordMs = 0.0,
+                     uint64_t uniformBytes = 0, double uniformUpdateMs = 0.0,
+                     uint32_t textureUploads = 0, double textureStreamMs = 0.0);
+
+    /**
+     * @brief Record how long the scene took to load.
+     * @param loadMs The model load time in milliseconds.
+     * @param meshStageMs The geometry extraction part of the load in milliseconds.
+     * @param fromMeshCache True if the model was read from the mesh cache.
+     */
+    void SetSceneLoadTime(double loadMs, double meshStageMs, bool fromMeshCache) {
+        sceneLoadMs = loadMs;
+        sceneMeshStageMs = meshStageMs;
+        sceneFromMeshCache = fromMeshCache;
+    }
+
+    /**
+     * @brief Record how long the renderer took to create its pipelines at startup.
+     * @param createMs The pipeline creation wall time in milliseconds.
+     * @param cacheWarm True if the pipeline cache was loaded from disk.
+     */
+    void SetPipelineCreationTime(double createMs, bool cacheWarm) {
+        pipelineCreateMs = createMs;
+        pipelineCacheWarm = cacheWarm;
+    }
+
+    /**
+     * @brief Record the level of detail generation results of the scene load.
+     * @param stats The mesh optimization totals of the load (empty on a mesh cache hit).
+     */
+    void SetLodGenerationStats(const MeshOptimizationStats& stats) {
+        lodGeneration = stats;
+    }
+
+    /**
+     * @brief Check if all requested frames have been recorded.
+     * @return True if the run is complete, false otherwise.
+     */
+    bool IsComplete() const { return samples.size() >= config.frameCount; }
+
+    /**
+     * @brief Write the per-frame CSV and the JSON summary.
+     * @return True if both files were written, false otherwise.
+     */
+    bool WriteResults() const;
+
+    /**
+     * @brief Get the benchmark configuration.
+     * @return The configuration.
+     */
+    const BenchmarkConfig& GetConfig() const { return config; }
+
+    /**
+     * @brief Get the recorded samples.
+     * @return The per-frame samples.
+     */
+    const std::vector<FrameTimingSample>& GetSamples() const { return samples; }
+
+    /**
+     * @brief Compute a percentile using linear interpolation between closest ranks.
+     * @param values The values (copied, then sorted).
+     * @param percentile The percentile in [0, 100].
+     * @return The percentile value, or 0 if values is empty.
+     */
+    static double Percentile(std::vector<double> values, double percentile);
+
+private:
+    BenchmarkConfig config;
+    std::vector<CameraPathKeyframe> cameraPath;
+    std::vector<FrameTimingSample> samples;
+    double sceneLoadMs = 0.0;
+    double sceneMeshStageMs = 0.0;
+    bool sceneFromMeshCache = false;
+    double pipelineCreateMs = 0.0;
+    bool pipelineCacheWarm = false;
+    MeshOptimizationStats lodGeneration;
+
+    /**
+     * @brief Write the summary statistics of one per-frame series as a JSON object.
+     * @param values The per-frame values (milliseconds or counts).
+     * @return The JSON object text.
+     */
+    static std::string summarizeToJson(const std::vector<double>& values);
+};
@@ -0,0 +1,214 @@
+#include "gpu_profiler.h"
+
+#include <algorithm>
+#include <iostream>
+
+bool GpuProfiler::Initialize(const vk::raii::Device& device, const vk::raii::PhysicalDevice& physicalDevice,
+                             uint32_t graphicsFamily, uint32_t computeFamily, uint32_t maxZones) {
+    try {
+        Cleanup();
+
+        // Timestamps are optional: skip GPU timing if the graphics queue cannot write them
+        vk::PhysicalDeviceProperties properties = physicalDevice.getProperties();
+        std::vector<vk::QueueFamilyProperties> queueFamilies = physicalDevice.getQueueFamilyProperties();
+        uint32_t validBits = queueFamilies[graphicsFamily].timestampValidBits;
+        if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f) {
+            std::cout << "Timestamp queries not supported on the graphics queue; GPU timings unavailable" << std::endl;
+            return true;
+        }
+
+        timestampPeriodNs = static_cast<double>(properties.limits.timestampPeriod);
+        timestampMask = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1ull);
+        computeTimestamps = queueFamilies[computeFamily].timestampValidBits != 0;
+
+        vk::QueryPoolCreateInfo poolInfo{
+            .queryType = vk::QueryType::eTimestamp,
+            .queryCount = 2 * maxZones
+        };
+        queryPool = vk::raii::QueryPool(device, poolInfo);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        zones.assign(maxZones, Zone{});
+        nextZone = 0;
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create GPU timestamp queries: " << e.what() << std::endl;
+        queryPool = nullptr;
+        return false;
+    }
+}
+
+void GpuProfiler::Cleanup() {
+    std::lock_guard<std::mutex> lock(mutex);
+    queryPool = nullptr;
+    zones.clear();
+    nextZone = 0;
+    zoneOrder.clear();
+    stats.clear();
+    gpuToCpuOffsetValid = false;
+}
+
+uint32_t GpuProfiler::BeginZone(const vk::raii::CommandBuffer& commandBuffer, const char* name, bool computeQueue) {
+    if (!IsEnabled() || (computeQueue && !computeTimestamps)) {
+        return INVALID_ZONE;
+    }
+
+    uint32_t zone = INVALID_ZONE;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto zoneCount = static_cast<uint32_t>(zones.size());
+        for (uint32_t i = 0; i < zoneCount; ++i) {
+            uint32_t candidate = (nextZone + i) % zoneCount;
+            if (zones[candidate].state == ZoneState::Free) {
+                zone = candidate;
+                break;
+            }
+        }
+        if (zone == INVALID_ZONE) {
+            // Every pair is still in flight; drop this zone rather than stall
+            return INVALID_ZONE;
+        }
+        nextZone = (zone + 1) % zoneCount;
+        zones[zone].name = name;
+        zones[zone].state = ZoneState::Recording;
+        zones[zone].commandBuffer = *commandBuffer;
+        zones[zone].serial = UNTRACKED_SERIAL;
+        zones[zone].recordTime = std::chrono::steady_clock::now();
+
+        // The pair is free, so no submitted GPU work can still write it
+        queryPool.reset(zone * 2, 2);
+    }
+
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, *queryPool, zone * 2);
+    return zone;
+}
+
+void GpuProfiler::EndZone(const vk::raii::CommandBuffer& commandBuffer, uint32_t zone) {
+    if (zone == INVALID_ZONE || !IsEnabled()) {
+        return;
+    }
+
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *queryPool, zone * 2 + 1);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (zone < zones.size() && zones[zone].state == ZoneState::Recording) {
+        zones[zone].state = ZoneState::Recorded;
+    }
+}
+
+void GpuProfiler::SubmitZones(vk::CommandBuffer commandBuffer, uint64_t serial) {
+    if (!IsEnabled()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (Zone& entry : zones) {
+        if (entry.commandBuffer == static_cast<VkCommandBuffer>(commandBuffer) &&
+            (entry.state == ZoneState::Recording || entry.state == ZoneState::Recorded)) {
+            entry.state = ZoneState::Pending;
+            entry.serial = serial;
+        }
+    }
+}
+
+void GpuProfiler::CollectResults(uint64_t completedSerial) {
+    if (!IsEnabled()) {
+        return;
+    }
+
+    struct ResolvedZone {
+        const char* name;
+        uint64_t begin;
+        uint64_t end;
+        std::chrono::steady_clock::time_point recordTime;
+    };
+    std::vector<ResolvedZone> resolved;
+
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    for (uint32_t zone = 0; zone < zones.size(); ++zone) {
+        Zone& entry = zones[zone];
+        if (entry.state == ZoneState::Free) {
+            continue;
+        }
+
+        // Command buffers that were recorded but never submitted (e.g., swapchain recreation)
+        // leave their zones behind; the GPU never sees them, so recycle them after a timeout
+        if (entry.state != ZoneState::Pending) {
+            if (now - entry.recordTime > std::chrono::seconds(2)) {
+                entry.state = ZoneState::Free;
+            }
+            continue;
+        }
+
+        // Non-blocking read: each query yields its value followed by an availability word
+        auto [queryResult, data] = queryPool.getResults<uint64_t>(
+            zone * 2, 2, 4 * sizeof(uint64_t), 2 * sizeof(uint64_t),
+            vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability);
+        bool available = (queryResult == vk::Result::eSuccess || queryResult == vk::Result::eNotReady) &&
+                         data.size() == 4 && data[1] != 0 && data[3] != 0;
+        if (!available) {
+            // Submitted zones are never recycled on a timeout: a slow GPU may still write them.
+            // Once the submission's fence has signaled, nothing writes the pair anymore.
+            if (entry.serial != UNTRACKED_SERIAL && entry.serial <= completedSerial) {
+                entry.state = ZoneState::Free;
+            }
+            continue;
+        }
+
+        resolved.push_back({entry.name, data[0] & timestampMask, data[2] & timestampMask, entry.recordTime});
+        entry.state = ZoneState::Free;
+    }
+
+    if (resolved.empty()) {
+        return;
+    }
+
+    // A zone's commands cannot start executing before they were recorded, so the largest
+    // (record time - GPU begin) seen is the tightest estimate of the GPU->CPU clock offset.
+    // It decays slowly so drift between the two clocks is followed.
+    for (const auto& zone : resolved) {
+        double gpuBeginNs = static_cast<double>(zone.begin) * timestampPeriodNs;
+        double recordNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(zone.recordTime.time_since_epoch()).count());
+        double observedOffsetNs = recordNs - gpuBeginNs;
+        gpuToCpuOffsetNs = gpuToCpuOffsetValid ? std::max(gpuToCpuOffsetNs, observedOffsetNs) : observedOffsetNs;
+        gpuToCpuOffsetValid = true;
+    }
+    gpuToCpuOffsetNs -= 1000.0;
+
+    Profiler& cpuProfiler = Profiler::GetInstance();
+    for (const auto& zone : resolved) {
+        double gpuBeginNs = static_cast<double>(zone.begin) * timestampPeriodNs;
+        double durationMs = zone.end >= zone.begin ? static_cast<double>(zone.end - zone.begin) * timestampPeriodNs * 1e-6 : 0.0;
+
+        auto it = stats.find(zone.name);
+        if (it == stats.end()) {
+            zoneOrder.emplace_back(zone.name);
+            it = stats.emplace(zone.name, GpuZoneStats{zone.name, durationMs, durationMs}).first;
+        }
+        it->second.lastMs = durationMs;
+        it->second.averageMs += (durationMs - it->second.averageMs) * 0.05;
+
+        if (cpuProfiler.IsEnabled()) {
+            auto cpuBegin = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(static_cast<int64_t>(gpuBeginNs + gpuToCpuOffsetNs)));
+            auto cpuEnd = cpuBegin + std::chrono::nanoseconds(static_cast<int64_t>(durationMs * 1e6));
+            cpuProfiler.RecordTrackZone("GPU", zone.name, cpuProfiler.SteadyTimeToTicks(cpuBegin), cpuProfiler.SteadyTimeToTicks(cpuEnd));
+        }
+    }
+}
+
+double GpuProfiler::GetLastZoneMs(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = stats.find(name);
+    return it != stats.end() ? it->second.lastMs : 0.0;
+}
+
+std::vector<GpuZoneStats> GpuProfiler::GetZoneStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<GpuZoneStats> result;
+    result.reserve(zoneOrder.size());
+    for (const auto& name : zoneOrder) {
+        result.push_back(stats.at(name));
+    }
+    return result;
+}
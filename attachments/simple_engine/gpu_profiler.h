@@ -0,0 +1,174 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan_raii.hpp>
+
+#include "profiler.h"
+
+/**
+ * @brief Timing statistics of one GPU zone.
+ */
+struct GpuZoneStats {
+    std::string name;
+    double averageMs = 0.0; // Exponential moving average of the zone duration
+    double lastMs = 0.0;    // Duration of the most recently resolved instance
+};
+
+/**
+ * @brief GPU timing layer built on a timestamp query pool.
+ *
+ * Zones take a pair of queries from a ring that is reset from the host when a
+ * pair is handed out, so any command buffer on the graphics or compute queue can
+ * be instrumented regardless of which frame in flight or thread records it.
+ * Results are polled without waiting once per frame; pairs whose commands have
+ * not finished yet simply stay pending. Resolved zones update the overlay
+ * statistics and are placed on a "GPU" track of the CPU profiler timeline.
+ *
+ * A pair is only handed out again once the GPU can no longer write it: after its
+ * results became available, or after the frame it was submitted with completed.
+ * Pairs of command buffers that were recorded but never submitted are recycled
+ * after a timeout.
+ */
+class GpuProfiler {
+public:
+    static constexpr uint32_t INVALID_ZONE = UINT32_MAX;
+    static constexpr uint64_t UNTRACKED_SERIAL = UINT64_MAX;
+
+    /**
+     * @brief Default constructor.
+     */
+    GpuProfiler() = default;
+
+    /**
+     * @brief Create the query pool.
+     * Requires the hostQueryReset device feature; GPU timing stays disabled otherwise.
+     * @param device The Vulkan device.
+     * @param physicalDevice The physical device.
+     * @param graphicsFamily The graphics queue family index.
+     * @param computeFamily The compute queue family index.
+     * @param maxZones The number of zones that may be in flight at once.
+     * @return True if initialization succeeded (or timing is unsupported), false on error.
+     */
+    bool Initialize(const vk::raii::Device& device, const vk::raii::PhysicalDevice& physicalDevice,
+                    uint32_t graphicsFamily, uint32_t computeFamily, uint32_t maxZones = 256);
+
+    /**
+     * @brief Destroy the query pool.
+     */
+    void Cleanup();
+
+    /**
+     * @brief Check if GPU timing is available.
+     * @return True if zones are recorded, false otherwise.
+     */
+    bool IsEnabled() const { return *queryPool != VK_NULL_HANDLE; }
+
+    /**
+     * @brief Write the begin timestamp of a zone.
+     * @param commandBuffer The command buffer being recorded.
+     * @param name The zone name (must have static storage duration).
+     * @param computeQueue True if the command buffer is submitted to the compute queue.
+     * @return The zone handle, or INVALID_ZONE if the zone is not recorded.
+     */
+    uint32_t BeginZone(const vk::raii::CommandBuffer& commandBuffer, const char* name, bool computeQueue = false);
+
+    /**
+     * @brief Write the end timestamp of a zone.
+     * @param commandBuffer The command buffer being recorded.
+     * @param zone The handle returned by BeginZone.
+     */
+    void EndZone(const vk::raii::CommandBuffer& commandBuffer, uint32_t zone);
+
+    /**
+     * @brief Mark the zones recorded into a command buffer as submitted.
+     * Call right after the command buffer was submitted.
+     * @param commandBuffer The submitted command buffer.
+     * @param serial The frame serial whose fence covers the submission, or UNTRACKED_SERIAL
+     *               if the zones may only be recycled once their results are available.
+     */
+    void SubmitZones(vk::CommandBuffer commandBuffer, uint64_t serial = UNTRACKED_SERIAL);
+
+    /**
+     * @brief Resolve finished zones without waiting on the GPU.
+     * Call once per frame from the render thread.
+     * @param completedSerial The newest frame serial whose fence has signaled.
+     */
+    void CollectResults(uint64_t completedSerial);
+
+    /**
+     * @brief Get the duration of the most recently resolved instance of a zone.
+     * @param name The zone name.
+     * @return The duration in milliseconds, or 0 if the zone has not been resolved yet.
+     */
+    double GetLastZoneMs(const std::string& name) const;
+
+    /**
+     * @brief Get the statistics of all zones in the order they were first seen.
+     * @return The zone statistics.
+     */
+    std::vector<GpuZoneStats> GetZoneStats() const;
+
+private:
+    // Recording: begin written; Recorded: end written, not submitted; Pending: submitted
+    enum class ZoneState { Free, Recording, Recorded, Pending };
+
+    struct Zone {
+        const char* name = nullptr;
+        ZoneState state = ZoneState::Free;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        uint64_t serial = UNTRACKED_SERIAL; // Frame serial of the submission (Pending only)
+        std::chrono::steady_clock::time_point recordTime;
+    };
+
+    vk::raii::QueryPool queryPool = nullptr;
+    double timestampPeriodNs = 0.0;
+    uint64_t timestampMask = ~0ull;
+    bool computeTimestamps = false;
+
+    mutable std::mutex mutex;
+    std::vector<Zone> zones;
+    uint32_t nextZone = 0;
+
+    // Overlay statistics
+    std::vector<std::string> zoneOrder;
+    std::unordered_map<std::string, GpuZoneStats> stats;
+
+    // Offset mapping GPU timestamps (ns) onto steady_clock (ns); see CollectResults()
+    double gpuToCpuOffsetNs = 0.0;
+    bool gpuToCpuOffsetValid = false;
+};
+
+/**
+ * @brief RAII helper that brackets the commands recorded in its scope with a GPU zone.
+ */
+class GpuProfileScope {
+public:
+    GpuProfileScope(GpuProfiler& profiler, const vk::raii::CommandBuffer& commandBuffer, const char* name, bool computeQueue = false)
+        : profiler(profiler), commandBuffer(commandBuffer), zone(profiler.BeginZone(commandBuffer, name, computeQueue)) {}
+
+    ~GpuProfileScope() {
+        profiler.EndZone(commandBuffer, zone);
+    }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    GpuProfiler& profiler;
+    const vk::raii::CommandBuffer& commandBuffer;
+    uint32_t zone;
+};
+
+// Convenience macros for GPU zones. Compiled out together with the CPU profiler macros.
+#if defined(SIMPLE_ENGINE_DISABLE_PROFILER)
+#define GPU_PROFILE_ZONE(profiler, commandBuffer, name) ((void)0)
+#define GPU_PROFILE_COMPUTE_ZONE(profiler, commandBuffer, name) ((void)0)
+#else
+#define GPU_PROFILE_ZONE(profiler, commandBuffer, name) GpuProfileScope PROFILE_CONCAT(gpuProfileScope_, __LINE__)(profiler, commandBuffer, name)
+#define GPU_PROFILE_COMPUTE_ZONE(profiler, commandBuffer, name) GpuProfileScope PROFILE_CONCAT(gpuProfileScope_, __LINE__)(profiler, commandBuffer, name, true)
+#endif
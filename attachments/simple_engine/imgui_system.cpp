@@ -1,6 +1,7 @@
 #include "imgui_system.h"
 #include "renderer.h"
 #include "audio_system.h"
+#include "profiler.h"
 
 // Include ImGui headers
 #include "imgui/imgui.h"
@@ -439,6 +440,69 @@ void ImGuiSystem::NewFrame() {
     }
 
     ImGui::End();
+
+    // CPU profiler: per-zone averages over the recent frame window
+    Profiler& profiler = Profiler::GetInstance();
+    if (profiler.IsEnabled()) {
+        ImGui::Begin("Profiler");
+        double frameMs = profiler.GetAverageFrameMs();
+        ImGui::Text("CPU frame: %.2f ms (%.0f FPS)", frameMs, frameMs > 0.0 ? 1000.0 / frameMs : 0.0);
+
+        if (!profiler.IsCapturing()) {
+            if (ImGui::Button("Start Capture")) {
+                profiler.StartCapture();
+            }
+        } else if (ImGui::Button("Stop Capture (cpu_trace.json)")) {
+            profiler.StopCaptureAndWrite("cpu_trace.json");
+        }
+
+        ImGui::Separator();
+        ImGui::Columns(4, "ProfilerZones");
+        ImGui::Text("Zone");
+        ImGui::NextColumn();
+        ImGui::Text("Avg ms");
+        ImGui::NextColumn();
+        ImGui::Text("Max ms");
+        ImGui::NextColumn();
+        ImGui::Text("Calls");
+        ImGui::NextColumn();
+        ImGui::Separator();
+        for (const auto& zone : profiler.GetZoneStats()) {
+            ImGui::Text("%*s%s", static_cast<int>(zone.depth * 2), "", zone.name.c_str());
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", zone.averageMs);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", zone.maxMs);
+            ImGui::NextColumn();
+            ImGui::Text("%.1f", zone.callsPerFrame);
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+
+        // GPU zones resolved from timestamp queries (a few frames behind the CPU)
+        if (renderer && renderer->GetGpuProfiler().IsEnabled()) {
+            ImGui::Separator();
+            ImGui::Text("GPU frame: %.2f ms", renderer->GetLastGpuFrameTimeMs());
+            ImGui::Columns(3, "GpuProfilerZones");
+            ImGui::Text("GPU zone");
+            ImGui::NextColumn();
+            ImGui::Text("Avg ms");
+            ImGui::NextColumn();
+            ImGui::Text("Last ms");
+            ImGui::NextColumn();
+            ImGui::Separator();
+            for (const auto& zone : renderer->GetGpuProfiler().GetZoneStats()) {
+                ImGui::Text("%s", zone.name.c_str());
+                ImGui::NextColumn();
+                ImGui::Text("%.3f", zone.averageMs);
+                ImGui::NextColumn();
+                ImGui::Text("%.3f", zone.lastMs);
+                ImGui::NextColumn();
+            }
+            ImGui::Columns(1);
+        }
+        ImGui::End();
+    }
 }
 
 void ImGuiSystem::Render(vk::raii::CommandBuffer & commandBuffer, uint32_t frameIndex) {
@@ -971,7 +1035,7 @@ bool ImGuiSystem::createPipeline() {
         pipelineInfo.basePipelineHandle = nullptr;
 
         const vk::raii::Device& device = renderer->GetRaiiDevice();
-        pipeline = vk::raii::Pipeline(device, nullptr, pipelineInfo);
+        pipeline = vk::raii::Pipeline(device, renderer->GetPipelineCache(), pipelineInfo);
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Failed to create graphics pipeline: " << e.what() << std::endl;
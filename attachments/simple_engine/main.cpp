@@ -5,6 +5,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <string>
 #include <thread>
 
 // Constants
@@ -15,13 +16,15 @@ constexpr bool ENABLE_VALIDATION_LAYERS = false;
 #else
 constexpr bool ENABLE_VALIDATION_LAYERS = true;
 #endif
+constexpr const char* DEFAULT_SCENE_PATH = "../Assets/bistro/bistro.gltf";
 
 
 /**
  * @brief Set up a simple scene with a camera and some objects.
  * @param engine The engine to set up the scene in.
+ * @param scenePath The glTF scene to load in the background.
  */
-void SetupScene(Engine* engine) {
+void SetupScene(Engine* engine, const std::string& scenePath = DEFAULT_SCENE_PATH) {
     // Create a camera entity
     Entity* cameraEntity = engine->CreateEntity("Camera");
     if (!cameraEntity) {
@@ -34,20 +37,28 @@ void SetupScene(Engine* engine) {
 
     // Add a camera component to the camera entity
     auto* camera = cameraEntity->AddComponent<CameraComponent>();
-    camera->SetAspectRatio(static_cast<float>(WINDOW_WIDTH) / static_cast<float>(WINDOW_HEIGHT));
+    float aspectRatio = static_cast<float>(WINDOW_WIDTH) / static_cast<float>(WINDOW_HEIGHT);
+    if (const Platform* platform = engine->GetPlatform()) {
+        if (platform->GetWindowWidth() > 0 && platform->GetWindowHeight() > 0) {
+            aspectRatio = static_cast<float>(platform->GetWindowWidth()) / static_cast<float>(platform->GetWindowHeight());
+        }
+    }
+    camera->SetAspectRatio(aspectRatio);
 
     // Set the camera as the active camera
     engine->SetActiveCamera(camera);
 
     // Kick off GLTF model loading on a background thread so the main loop
     // can start and render the UI/progress bar while the scene is being
-    // constructed. Engine::Update will avoid updating entities while
-    // loading is in progress to prevent data races.
+    // constructed. The loader streams each mesh as soon as it is decoded and
+    // Engine::Update activates the streamed entities in batches, already
+    // while the rest of the model is parsed.
     if (auto* renderer = engine->GetRenderer()) {
         renderer->SetLoading(true);
     }
-    std::thread([engine]{
-        LoadGLTFModel(engine, "../Assets/bistro/bistro.gltf");
+    engine->BeginSceneStreaming();
+    std::thread([engine, scenePath]{
+        LoadGLTFModel(engine, scenePath);
     }).detach();
 }
 
@@ -76,22 +87,202 @@ void android_main(android_app* app) {
     }
 }
 #else
+/**
+ * @brief Command-line options for the desktop entry point.
+ */
+struct CommandLineOptions {
+    bool headless = false;
+    bool benchmark = false;
+    bool resourceBenchmark = false;
+    bool entityBenchmark = false;
+    bool defragSimulation = false;
+    bool meshCache = true;
+    bool meshOptimization = true;
+    bool packedVertices = false;
+    bool meshletCulling = true;
+    bool lod = true;
+    bool indirectDraw = true;
+    uint64_t textureBudgetMB = 0;
+    double textureStreamBudgetMs = 2.0;
+    uint64_t memoryDefragKB = 256;
+    size_t sceneBatch = 32;
+    int width = WINDOW_WIDTH;
+    int height = WINDOW_HEIGHT;
+    BenchmarkConfig benchmarkConfig;
+};
+
+/**
+ * @brief Parse desktop command-line options.
+ *
+ * Supported options:
+ *   --headless                 Render offscreen without a window (e.g., with lavapipe on CI)
+ *   --benchmark                Run the scripted frame-time benchmark and exit
+ *   --resource-benchmark       Time resource handle lookups against string lookups and exit
+ *   --entity-benchmark         Time entity spawn/despawn churn and exit
+ *   --defrag-simulation        Compact simulated memory blocks after allocation churn and exit
+ *   --scene <path>             glTF scene to load
+ *   --camera-path <file>       Benchmark camera keyframes (time px py pz tx ty tz per line)
+ *   --frames <n>               Number of frames to record
+ *   --warmup <n>               Frames to render after loading before recording
+ *   --output <prefix>          Write results to <prefix>.csv and <prefix>.json
+ *   --trace <file>             Write a Chrome trace of the recorded frames
+ *   --no-mesh-cache            Always parse glTF files (for cold-load measurements)
+ *   --no-mesh-optimization     Keep glTF vertex/index order (no welding or cache reordering)
+ *   --packed-vertices          Upload geometry in the quantized 20-byte vertex layout
+ *   --no-meshlet-culling       Draw whole meshes instead of the visible meshlets
+ *   --no-lod                   Always draw the base level of detail
+ *   --no-indirect              Record opaque draws directly instead of via indirect buffers
+ *   --texture-budget <MB>      Evict textures beyond this much device memory (simulates a smaller GPU)
+ *   --texture-stream-ms <ms>   Time per frame spent uploading streamed textures (default 2)
+ *   --memory-defrag-kb <kb>    Bytes per frame moved to compact the memory pool (default 256, 0 = off)
+ *   --scene-batch <n>          Scene entities activated per frame while streaming in (default 32, 0 = all)
+ *   --width <w> / --height <h> Render resolution
+ *
+ * @param argc The argument count.
+ * @param argv The argument values.
+ * @return The parsed options.
+ */
+CommandLineOptions ParseCommandLine(int argc, char* argv[]) {
+    CommandLineOptions options;
+    options.benchmarkConfig.scenePath = DEFAULT_SCENE_PATH;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto nextValue = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Missing value for option " + arg);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--benchmark") {
+            options.benchmark = true;
+        } else if (arg == "--resource-benchmark") {
+            options.resourceBenchmark = true;
+        } else if (arg == "--entity-benchmark") {
+            options.entityBenchmark = true;
+        } else if (arg == "--defrag-simulation") {
+            options.defragSimulation = true;
+        } else if (arg == "--scene") {
+            options.benchmarkConfig.scenePath = nextValue();
+        } else if (arg == "--camera-path") {
+            options.benchmarkConfig.cameraPathFile = nextValue();
+        } else if (arg == "--frames") {
+            options.benchmarkConfig.frameCount = static_cast<uint32_t>(std::stoul(nextValue()));
+        } else if (arg == "--warmup") {
+            options.benchmarkConfig.warmupFrames = static_cast<uint32_t>(std::stoul(nextValue()));
+        } else if (arg == "--output") {
+            options.benchmarkConfig.outputPrefix = nextValue();
+        } else if (arg == "--trace") {
+            options.benchmarkConfig.tracePath = nextValue();
+        } else if (arg == "--no-mesh-cache") {
+            options.meshCache = false;
+        } else if (arg == "--no-mesh-optimization") {
+            options.meshOptimization = false;
+        } else if (arg == "--packed-vertices") {
+            options.packedVertices = true;
+        } else if (arg == "--no-meshlet-culling") {
+            options.meshletCulling = false;
+        } else if (arg == "--no-lod") {
+            options.lod = false;
+        } else if (arg == "--no-indirect") {
+            options.indirectDraw = false;
+        } else if (arg == "--texture-budget") {
+            options.textureBudgetMB = std::stoull(nextValue());
+        } else if (arg == "--texture-stream-ms") {
+            options.textureStreamBudgetMs = std::stod(nextValue());
+        } else if (arg == "--memory-defrag-kb") {
+            options.memoryDefragKB = std::stoull(nextValue());
+        } else if (arg == "--scene-batch") {
+            options.sceneBatch = std::stoull(nextValue());
+        } else if (arg == "--width") {
+            options.width = std::stoi(nextValue());
+        } else if (arg == "--height") {
+            options.height = std::stoi(nextValue());
+        } else {
+            throw std::runtime_error("Unknown option: " + arg);
+        }
+    }
+    return options;
+}
+
 /**
  * @brief Desktop entry point.
+ * @param argc The argument count.
+ * @param argv The argument values.
  * @return The exit code.
  */
-int main(int, char*[]) {
+int main(int argc, char* argv[]) {
     try {
+        CommandLineOptions options = ParseCommandLine(argc, argv);
+
+        if (options.resourceBenchmark) {
+            // CPU-only micro-benchmark; no window or device needed
+            for (size_t count : {100u, 10000u, 100000u}) {
+                ResourceLookupBenchmark result = ResourceManager::BenchmarkLookups(count, 1000000);
+                std::cout << "Resource lookups (" << result.resourceCount << " resources): handle "
+                          << result.handleNs << " ns, string " << result.stringNs << " ns, previous string map "
+                          << result.legacyStringNs << " ns" << std::endl;
+            }
+            return 0;
+        }
+        if (options.entityBenchmark) {
+            // CPU-only micro-benchmark; no window or device needed
+            for (size_t count : {1000u, 5000u, 20000u}) {
+                EntityChurnBenchmark result = EntityRegistry::BenchmarkChurn(count, count / 10, 20);
+                std::cout << "Entity churn (" << result.entityCount << " live, " << result.churnPerRound << " per round, "
+                          << result.rounds << " rounds): registry " << result.registryMs << " ms, vector erase "
+                          << result.legacyMs << " ms" << std::endl;
+            }
+            return 0;
+        }
+
+        if (options.defragSimulation) {
+            // CPU-only simulation of 16 MB blocks with 64-byte units (the host-visible pool)
+            for (uint64_t budgetKB : {64u, 256u, 1024u}) {
+                DefragmentationSimulation result = DefragmentationPlanner::Simulate(8, 16 * 1024 * 1024 / 64, budgetKB * 1024 / 64, 42);
+                std::cout << "Defragmentation (" << result.blockCount << " blocks, " << result.liveAllocations << " live allocations, "
+                          << budgetKB << " KB per frame): empty blocks " << result.emptyBlocksBefore << " -> " << result.emptyBlocksAfter
+                          << ", free ranges " << result.freeRangesBefore << " -> " << result.freeRangesAfter << ", "
+                          << result.unitsMoved * 64 / 1024 << " KB in " << result.moves << " moves over " << result.frames
+                          << " frames" << std::endl;
+            }
+            return 0;
+        }
+
         // Create the engine
         Engine engine;
+        engine.SetUsePackedVertices(options.packedVertices);
 
         // Initialize the engine
-        if (!engine.Initialize("Simple Engine", WINDOW_WIDTH, WINDOW_HEIGHT, ENABLE_VALIDATION_LAYERS)) {
+        if (!engine.Initialize("Simple Engine", options.width, options.height, ENABLE_VALIDATION_LAYERS, options.headless)) {
             throw std::runtime_error("Failed to initialize engine");
         }
 
+        engine.GetModelLoader()->SetMeshCacheEnabled(options.meshCache);
+        engine.GetModelLoader()->SetMeshOptimizationEnabled(options.meshOptimization);
+        engine.GetRenderer()->SetMeshletCullingEnabled(options.meshletCulling);
+        engine.GetRenderer()->SetLodEnabled(options.lod);
+        engine.GetRenderer()->SetIndirectDrawEnabled(options.indirectDraw);
+        engine.GetRenderer()->SetTextureMemoryBudget(options.textureBudgetMB * 1024 * 1024);
+        engine.GetRenderer()->SetTextureStreamingBudgetMs(options.textureStreamBudgetMs);
+        engine.GetRenderer()->SetMemoryDefragmentationBudget(options.memoryDefragKB * 1024);
+        engine.SetSceneActivationBatch(options.sceneBatch);
+
         // Set up the scene
-        SetupScene(&engine);
+        SetupScene(&engine, options.benchmarkConfig.scenePath);
+
+        if (options.benchmark) {
+            // Run the scripted benchmark instead of the interactive loop
+            FrameBenchmark benchmark(options.benchmarkConfig);
+            if (!options.benchmarkConfig.cameraPathFile.empty() &&
+                !benchmark.LoadCameraPath(options.benchmarkConfig.cameraPathFile)) {
+                throw std::runtime_error("Failed to load benchmark camera path");
+            }
+            return engine.RunBenchmark(benchmark) ? 0 : 1;
+        }
 
         // Run the engine
         engine.Run();
@@ -0,0 +1,87 @@
+#include "memory_defragmenter.h"
+
+#include <random>
+#include <tuple>
+
+namespace {
+    // Free ranges and empty blocks of simulated blocks
+    std::pair<uint64_t, size_t> measure(const std::vector<std::vector<bool>>& blocks) {
+        FreeRangeStats stats;
+        size_t emptyBlocks = 0;
+        for (const auto& block : blocks) {
+            stats.Add(DefragmentationPlanner::CollectFreeRanges(block));
+            if (std::ranges::count(block, false) == 0) {
+                emptyBlocks++;
+            }
+        }
+        return {stats.rangeCount, emptyBlocks};
+    }
+}
+
+DefragmentationSimulation DefragmentationPlanner::Simulate(size_t blockCount, uint64_t unitsPerBlock, uint64_t unitBudget, uint32_t seed) {
+    DefragmentationSimulation result;
+    result.blockCount = std::max<size_t>(blockCount, 2);
+    unitsPerBlock = std::max<uint64_t>(unitsPerBlock, 64);
+
+    std::vector<std::vector<bool>> blocks(result.blockCount, std::vector<bool>(unitsPerBlock, true));
+    std::vector<Allocation> allocations;
+    std::mt19937 rng(seed);
+
+    // First fit, like MemoryPool::findSuitableBlock; nothing is freed while filling,
+    // so the first fit is the end of the filled part of the first block with room
+    std::vector<uint64_t> filled(result.blockCount, 0);
+    auto place = [&](uint64_t unitCount, uint64_t alignmentUnits) {
+        for (uint32_t b = 0; b < blocks.size(); ++b) {
+            uint64_t aligned = (filled[b] + alignmentUnits - 1) / alignmentUnits * alignmentUnits;
+            if (aligned + unitCount > unitsPerBlock) continue;
+            std::fill_n(blocks[b].begin() + static_cast<std::ptrdiff_t>(aligned), unitCount, false);
+            allocations.push_back({b, aligned, unitCount, alignmentUnits});
+            filled[b] = aligned + unitCount;
+            return true;
+        }
+        return false;
+    };
+
+    // Fill to ~80% with instance-buffer-like sizes, then despawn most of them at random
+    std::uniform_int_distribution<uint64_t> sizeDis(1, std::max<uint64_t>(unitsPerBlock / 64, 2));
+    std::uniform_int_distribution<uint64_t> alignDis(0, 2);
+    const uint64_t target = unitsPerBlock * result.blockCount * 8 / 10;
+    uint64_t placed = 0;
+    while (placed < target) {
+        uint64_t unitCount = sizeDis(rng);
+        if (!place(unitCount, uint64_t(1) << alignDis(rng))) break;
+        placed += unitCount;
+    }
+    std::ranges::shuffle(allocations, rng);
+    allocations.resize(allocations.size() * 3 / 10);
+    for (auto& block : blocks) {
+        std::fill(block.begin(), block.end(), true);
+    }
+    for (const Allocation& allocation : allocations) {
+        std::fill_n(blocks[allocation.block].begin() + static_cast<std::ptrdiff_t>(allocation.firstUnit), allocation.unitCount, false);
+    }
+    result.liveAllocations = allocations.size();
+    std::tie(result.freeRangesBefore, result.emptyBlocksBefore) = measure(blocks);
+
+    // One plan per frame; the sources are freed right away (the engine frees them a few frames later)
+    for (size_t frame = 0; frame < 100000; ++frame) {
+        std::vector<Move> moves = Plan(blocks, allocations, unitBudget);
+        if (moves.empty()) {
+            break;
+        }
+        result.frames++;
+        for (const Move& move : moves) {
+            Allocation& allocation = allocations[move.allocation];
+            auto& destination = blocks[move.block];
+            std::fill_n(destination.begin() + static_cast<std::ptrdiff_t>(move.firstUnit), allocation.unitCount, false);
+            std::fill_n(blocks[allocation.block].begin() + static_cast<std::ptrdiff_t>(allocation.firstUnit), allocation.unitCount, true);
+            allocation.block = move.block;
+            allocation.firstUnit = move.firstUnit;
+            result.unitsMoved += allocation.unitCount;
+            result.moves++;
+        }
+    }
+
+    std::tie(result.freeRangesAfter, result.emptyBlocksAfter) = measure(blocks);
+    return result;
+}
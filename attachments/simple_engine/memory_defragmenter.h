@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Free space of one or more memory blocks, in allocation units.
+ */
+struct FreeRangeStats {
+    static constexpr size_t HISTOGRAM_BUCKETS = 16;
+
+    uint64_t freeUnits = 0;
+    uint64_t largestFreeRange = 0;
+    uint64_t rangeCount = 0;
+    // Ranges of [2^i, 2^(i+1)) units; the last bucket also holds everything larger
+    std::array<uint64_t, HISTOGRAM_BUCKETS> histogram{};
+
+    /**
+     * @brief Add the free ranges of a block.
+     * @param ranges The (first unit, unit count) ranges, see DefragmentationPlanner::CollectFreeRanges.
+     */
+    void Add(const std::vector<std::pair<uint64_t, uint64_t>>& ranges) {
+        for (const auto& range : ranges) {
+            const uint64_t count = range.second;
+            freeUnits += count;
+            largestFreeRange = std::max(largestFreeRange, count);
+            rangeCount++;
+            size_t bucket = 0;
+            while (bucket + 1 < HISTOGRAM_BUCKETS && (count >> (bucket + 1)) != 0) {
+                bucket++;
+            }
+            histogram[bucket]++;
+        }
+    }
+};
+
+/**
+ * @brief Result of DefragmentationPlanner::Simulate.
+ */
+struct DefragmentationSimulation {
+    size_t blockCount = 0;
+    size_t liveAllocations = 0;        // After the churn
+    uint64_t freeRangesBefore = 0;     // Free ranges over all blocks
+    uint64_t freeRangesAfter = 0;
+    size_t emptyBlocksBefore = 0;
+    size_t emptyBlocksAfter = 0;
+    uint64_t unitsMoved = 0;
+    size_t moves = 0;
+    size_t frames = 0;                 // Plans until nothing was left to move
+};
+
+/**
+ * @brief Plans the incremental compaction of a memory pool.
+ *
+ * Works on unit occupancy only (no Vulkan objects), so the same planning runs
+ * against MemoryPool blocks and against simulated blocks. Each plan picks the
+ * sparsest block whose live allocations are all relocatable and moves them into
+ * free ranges of the other non-empty blocks (best fit, densest block on ties)
+ * until the unit budget is spent. Once evacuated the block is empty and can be
+ * released. Plans are stateless: calling Plan once per frame with the current
+ * occupancy spreads the compaction over frames.
+ */
+class DefragmentationPlanner {
+public:
+    // Blocks more occupied than this are not worth evacuating
+    static constexpr double MAX_SOURCE_OCCUPANCY = 0.5;
+
+    struct Allocation {
+        uint32_t block = 0;
+        uint64_t firstUnit = 0;
+        uint64_t unitCount = 0;
+        uint64_t alignmentUnits = 1;   // Destination first unit must be a multiple of this
+    };
+
+    struct Move {
+        size_t allocation = 0;         // Index into the relocatable allocations
+        uint32_t block = 0;            // Destination
+        uint64_t firstUnit = 0;
+    };
+
+    /**
+     * @brief Get the free ranges of a block.
+     * @param freeUnits The occupancy of the block (true = free).
+     * @return The (first unit, unit count) ranges in address order.
+     */
+    static std::vector<std::pair<uint64_t, uint64_t>> CollectFreeRanges(const std::vector<bool>& freeUnits) {
+        std::vector<std::pair<uint64_t, uint64_t>> ranges;
+        uint64_t i = 0;
+        const uint64_t total = freeUnits.size();
+        while (i < total) {
+            if (!freeUnits[i]) {
+                i++;
+                continue;
+            }
+            uint64_t first = i;
+            while (i < total && freeUnits[i]) {
+                i++;
+            }
+            ranges.emplace_back(first, i - first);
+        }
+        return ranges;
+    }
+
+    /**
+     * @brief Plan one compaction step.
+     * @param blocks The occupancy of each block of the pool (true = free).
+     * @param allocations The live allocations that may be moved.
+     * @param unitBudget The number of units to move at most; one larger allocation may be moved alone.
+     * @return The moves, whose destinations do not overlap each other or live allocations.
+     */
+    static std::vector<Move> Plan(const std::vector<std::vector<bool>>& blocks, const std::vector<Allocation>& allocations,
+                                  uint64_t unitBudget) {
+        std::vector<Move> moves;
+        if (blocks.size() < 2 || unitBudget == 0) {
+            return moves;
+        }
+
+        std::vector<uint64_t> usedUnits(blocks.size(), 0);
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            usedUnits[b] = static_cast<uint64_t>(std::ranges::count(blocks[b], false));
+        }
+        std::vector<uint64_t> relocatableUnits(blocks.size(), 0);
+        for (const Allocation& allocation : allocations) {
+            if (allocation.block < blocks.size()) {
+                relocatableUnits[allocation.block] += allocation.unitCount;
+            }
+        }
+
+        // Source: the sparsest block that can be emptied completely
+        uint32_t source = UINT32_MAX;
+        for (uint32_t b = 0; b < blocks.size(); ++b) {
+            if (usedUnits[b] == 0 || relocatableUnits[b] != usedUnits[b] ||
+                static_cast<double>(usedUnits[b]) > MAX_SOURCE_OCCUPANCY * static_cast<double>(blocks[b].size())) {
+                continue;
+            }
+            if (source == UINT32_MAX || usedUnits[b] < usedUnits[source]) {
+                source = b;
+            }
+        }
+        if (source == UINT32_MAX) {
+            return moves;
+        }
+
+        // Destinations: the other blocks that are in use (moving into an empty block gains nothing)
+        std::vector<std::vector<std::pair<uint64_t, uint64_t>>> freeRanges(blocks.size());
+        uint64_t destinationFree = 0;
+        for (uint32_t b = 0; b < blocks.size(); ++b) {
+            if (b == source || usedUnits[b] == 0) continue;
+            freeRanges[b] = CollectFreeRanges(blocks[b]);
+            destinationFree += blocks[b].size() - usedUnits[b];
+        }
+        if (destinationFree < usedUnits[source]) {
+            return moves;
+        }
+
+        // Largest allocations first, while the free ranges are least split
+        std::vector<size_t> order;
+        for (size_t i = 0; i < allocations.size(); ++i) {
+            if (allocations[i].block == source) {
+                order.push_back(i);
+            }
+        }
+        std::ranges::sort(order, [&allocations](size_t a, size_t b) { return allocations[a].unitCount > allocations[b].unitCount; });
+
+        uint64_t spent = 0;
+        for (size_t index : order) {
+            const Allocation& allocation = allocations[index];
+            if (spent + allocation.unitCount > unitBudget && !moves.empty()) {
+                break;
+            }
+
+            // Best fit: the smallest range that holds the allocation at its alignment
+            uint32_t bestBlock = UINT32_MAX;
+            size_t bestRange = 0;
+            uint64_t bestFirst = 0;
+            uint64_t bestLength = UINT64_MAX;
+            for (uint32_t b = 0; b < blocks.size(); ++b) {
+                for (size_t r = 0; r < freeRanges[b].size(); ++r) {
+                    const auto [first, length] = freeRanges[b][r];
+                    const uint64_t alignment = std::max<uint64_t>(allocation.alignmentUnits, 1);
+                    const uint64_t aligned = (first + alignment - 1) / alignment * alignment;
+                    if (aligned + allocation.unitCount > first + length) continue;
+                    if (length < bestLength || (length == bestLength && usedUnits[b] > usedUnits[bestBlock])) {
+                        bestBlock = b;
+                        bestRange = r;
+                        bestFirst = aligned;
+                        bestLength = length;
+                    }
+                }
+            }
+            if (bestBlock == UINT32_MAX) {
+                break;
+            }
+
+            // Split the range around the placed allocation
+            auto& ranges = freeRanges[bestBlock];
+            const auto [first, length] = ranges[bestRange];
+            ranges.erase(ranges.begin() + static_cast<std::ptrdiff_t>(bestRange));
+            const uint64_t tail = first + length - (bestFirst + allocation.unitCount);
+            if (tail > 0) {
+                ranges.insert(ranges.begin() + static_cast<std::ptrdiff_t>(bestRange), {bestFirst + allocation.unitCount, tail});
+            }
+            if (bestFirst > first) {
+                ranges.insert(ranges.begin() + static_cast<std::ptrdiff_t>(bestRange), {first, bestFirst - first});
+            }
+            usedUnits[bestBlock] += allocation.unitCount;
+
+            moves.push_back({index, bestBlock, bestFirst});
+            spent += allocation.unitCount;
+        }
+        return moves;
+    }
+
+    /**
+     * @brief Fragment simulated blocks with allocation churn and compact them with Plan.
+     *
+     * Allocations are placed first fit, as MemoryPool does. This only measures
+     * the effect of compaction; the correctness of the plans is covered by
+     * tests/memory_defragmenter_test.cpp.
+     * @param blockCount The number of blocks.
+     * @param unitsPerBlock The allocation units per block.
+     * @param unitBudget The units moved per frame at most.
+     * @param seed The random seed.
+     * @return The fragmentation before and after compaction.
+     */
+    static DefragmentationSimulation Simulate(size_t blockCount, uint64_t unitsPerBlock, uint64_t unitBudget, uint32_t seed);
+};
@@ -1,6 +1,8 @@
 #include "memory_pool.h"
+#include "debug_system.h"
 #include <iostream>
 #include <algorithm>
+#include <unordered_map>
 #include <vulkan/vulkan.hpp>
 
 MemoryPool::MemoryPool(const vk::raii::Device& device, const vk::raii::PhysicalDevice& physicalDevice)
@@ -136,7 +138,8 @@ std::unique_ptr<MemoryPool::MemoryBlock> MemoryPool::createMemoryBlock(PoolType
         .isMapped = false,
         .mappedPtr = nullptr,
         .freeList = {},
-        .allocationUnit = config.allocationUnit
+        .allocationUnit = config.allocationUnit,
+        .emptySinceFrame = currentFrame
     });
 
     // Map memory if it's host-visible
@@ -183,7 +186,8 @@ std::unique_ptr<MemoryPool::MemoryBlock> MemoryPool::createMemoryBlockWithType(P
         .isMapped = false,
         .mappedPtr = nullptr,
         .freeList = {},
-        .allocationUnit = config.allocationUnit
+        .allocationUnit = config.allocationUnit,
+        .emptySinceFrame = currentFrame
     });
 
     block->isMapped = (typeProps & vk::MemoryPropertyFlagBits::eHostVisible) != vk::MemoryPropertyFlags{};
@@ -249,8 +253,7 @@ std::pair<MemoryPool::MemoryBlock*, size_t> MemoryPool::findSuitableBlock(PoolTy
     try {
         auto newBlock = createMemoryBlock(poolType, alignedSize);
         poolBlocks.push_back(std::move(newBlock));
-        std::cout << "Created new memory block (pool type: "
-                  << static_cast<int>(poolType) << ")" << std::endl;
+        LOG_DEBUG("MemoryPool", "Created new memory block (pool type: " + std::to_string(static_cast<int>(poolType)) + ")");
         return {poolBlocks.back().get(), 0};
     } catch (const std::exception& e) {
         std::cerr << "Failed to create new memory block: " << e.what() << std::endl;
@@ -266,28 +269,31 @@ std::unique_ptr<MemoryPool::Allocation> MemoryPool::allocate(PoolType poolType,
         return nullptr;
     }
 
-    const PoolConfig& config = poolConfigs[poolType];
-
-    // Calculate required units (accounting for alignment)
+    // Calculate the size (accounting for alignment)
     const vk::DeviceSize alignedSize = ((size + alignment - 1) / alignment) * alignment;
-    const size_t requiredUnits = (alignedSize + config.allocationUnit - 1) / config.allocationUnit;
+    return makeAllocation(*block, startUnit, alignedSize);
+}
 
-    // Mark units as used
-    for (size_t i = startUnit; i < startUnit + requiredUnits; ++i) {
-        block->freeList[i] = false;
+std::unique_ptr<MemoryPool::Allocation> MemoryPool::makeAllocation(MemoryBlock& block, size_t startUnit, vk::DeviceSize size) const {
+    const size_t requiredUnits = static_cast<size_t>((size + block.allocationUnit - 1) / block.allocationUnit);
+
+    // Mark units as used (a trailing partial unit has no entry)
+    const size_t endUnit = std::min(startUnit + requiredUnits, block.freeList.size());
+    for (size_t i = startUnit; i < endUnit; ++i) {
+        block.freeList[i] = false;
     }
 
     // Create allocation info
     auto allocation = std::make_unique<Allocation>();
-    allocation->memory = *block->memory;
-    allocation->offset = startUnit * config.allocationUnit;
-    allocation->size = alignedSize;
-    allocation->memoryTypeIndex = block->memoryTypeIndex;
-    allocation->isMapped = block->isMapped;
-    allocation->mappedPtr = block->isMapped ?
-        static_cast<char*>(block->mappedPtr) + allocation->offset : nullptr;
+    allocation->memory = *block.memory;
+    allocation->offset = startUnit * block.allocationUnit;
+    allocation->size = size;
+    allocation->memoryTypeIndex = block.memoryTypeIndex;
+    allocation->isMapped = block.isMapped;
+    allocation->mappedPtr = block.isMapped ?
+        static_cast<char*>(block.mappedPtr) + allocation->offset : nullptr;
 
-    block->used += alignedSize;
+    block.used += size;
 
     return allocation;
 }
@@ -317,6 +323,9 @@ void MemoryPool::deallocate(std::unique_ptr<Allocation> allocation) {
                 }
 
                 block->used -= allocation->size;
+                if (block->used == 0) {
+                    block->emptySinceFrame = currentFrame;
+                }
                 return;
             }
         }
@@ -407,26 +416,21 @@ std::pair<vk::raii::Image, std::unique_ptr<MemoryPool::Allocation>> MemoryPool::
             poolIt = pools.try_emplace(PoolType::TEXTURE_IMAGE).first;
         }
         auto& poolBlocks = poolIt->second;
-        auto block = createMemoryBlockWithType(PoolType::TEXTURE_IMAGE, memRequirements.size, memoryTypeIndex);
-
-        // Prepare allocation that uses the new block from offset 0
-        allocation = std::make_unique<Allocation>();
-        allocation->memory = *block->memory;
-        allocation->offset = 0;
-        allocation->size = memRequirements.size;
-        allocation->memoryTypeIndex = memoryTypeIndex;
-        allocation->isMapped = block->isMapped;
-        allocation->mappedPtr = block->mappedPtr;
-
-        // Mark the entire block as used
-        block->used = memRequirements.size;
-        const size_t units = block->freeList.size();
-        for (size_t i = 0; i < units; ++i) {
-            block->freeList[i] = false;
+
+        // Streamed textures come and go; reuse an empty block that is not much larger
+        auto reuseIt = std::ranges::find_if(poolBlocks, [&](const std::unique_ptr<MemoryBlock>& candidate) {
+            return candidate->used == 0 && candidate->memoryTypeIndex == memoryTypeIndex &&
+                   candidate->size >= memRequirements.size && candidate->size <= memRequirements.size * 2;
+        });
+        if (reuseIt == poolBlocks.end()) {
+            // Keep the block owned by the pool for lifetime management and deallocation support
+            poolBlocks.push_back(createMemoryBlockWithType(PoolType::TEXTURE_IMAGE, memRequirements.size, memoryTypeIndex));
+            reuseIt = std::prev(poolBlocks.end());
         }
 
-        // Keep the block owned by the pool for lifetime management and deallocation support
-        poolBlocks.push_back(std::move(block));
+        // The allocation covers the entire block from offset 0
+        MemoryBlock& block = **reuseIt;
+        allocation = makeAllocation(block, 0, block.size);
     }
 
     // Bind memory to image
@@ -470,6 +474,104 @@ std::pair<vk::DeviceSize, vk::DeviceSize> MemoryPool::getTotalMemoryUsage() cons
     return {totalUsed, totalAllocated};
 }
 
+MemoryPool::FragmentationStats MemoryPool::getFragmentationStats(PoolType poolType) const {
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    FragmentationStats stats;
+    auto poolIt = pools.find(poolType);
+    if (poolIt == pools.end()) {
+        return stats;
+    }
+
+    FreeRangeStats freeRanges;
+    vk::DeviceSize unit = 1;
+    for (const auto& block : poolIt->second) {
+        stats.blockCount++;
+        stats.emptyBlocks += block->used == 0 ? 1 : 0;
+        stats.totalBytes += block->size;
+        stats.usedBytes += block->used;
+        freeRanges.Add(DefragmentationPlanner::CollectFreeRanges(block->freeList));
+        unit = block->allocationUnit;
+    }
+    stats.largestFreeRange = freeRanges.largestFreeRange * unit;
+    stats.freeRangeCount = freeRanges.rangeCount;
+    stats.freeRangeHistogram = freeRanges.histogram;
+    return stats;
+}
+
+vk::DeviceSize MemoryPool::releaseEmptyBlocks(uint64_t frame) {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    currentFrame = frame;
+
+    vk::DeviceSize released = 0;
+    for (auto& [poolType, poolBlocks] : pools) {
+        // Dedicated image blocks are only reused for similar sizes; no spare is kept for them
+        auto configIt = poolConfigs.find(poolType);
+        bool spareKept = poolType == PoolType::TEXTURE_IMAGE || configIt == poolConfigs.end();
+
+        std::erase_if(poolBlocks, [&](const std::unique_ptr<MemoryBlock>& block) {
+            if (block->used != 0) {
+                return false;
+            }
+            // Oversized blocks (e.g. a large batch's staging data) are not kept as the spare
+            if (!spareKept && block->size >= configIt->second.blockSize && block->size < configIt->second.blockSize * 2) {
+                spareKept = true;
+                return false;
+            }
+            if (block->emptySinceFrame + EMPTY_BLOCK_RELEASE_FRAMES > frame) {
+                return false;
+            }
+            released += block->size;
+            return true;
+        });
+    }
+    return released;
+}
+
+std::vector<MemoryPool::Relocation> MemoryPool::planRelocations(PoolType poolType, const std::vector<RelocationCandidate>& candidates,
+                                                                vk::DeviceSize byteBudget) {
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    std::vector<Relocation> relocations;
+    auto poolIt = pools.find(poolType);
+    if (poolIt == pools.end() || poolIt->second.size() < 2) {
+        return relocations;
+    }
+    auto& poolBlocks = poolIt->second;
+    const vk::DeviceSize unit = poolConfigs[poolType].allocationUnit;
+
+    std::vector<std::vector<bool>> blocks;
+    std::unordered_map<VkDeviceMemory, uint32_t> blockByMemory;
+    for (const auto& block : poolBlocks) {
+        blockByMemory.emplace(static_cast<VkDeviceMemory>(*block->memory), static_cast<uint32_t>(blocks.size()));
+        blocks.push_back(block->freeList);
+    }
+
+    std::vector<DefragmentationPlanner::Allocation> allocations;
+    std::vector<uint64_t> ids;
+    for (const RelocationCandidate& candidate : candidates) {
+        if (!candidate.allocation) continue;
+        auto blockIt = blockByMemory.find(static_cast<VkDeviceMemory>(candidate.allocation->memory));
+        if (blockIt == blockByMemory.end()) continue;
+        // Offsets are unit multiples, so a unit-multiple alignment is expressed in units
+        const vk::DeviceSize alignment = std::max<vk::DeviceSize>(candidate.alignment, 1);
+        allocations.push_back({
+            .block = blockIt->second,
+            .firstUnit = candidate.allocation->offset / unit,
+            .unitCount = (candidate.allocation->size + unit - 1) / unit,
+            .alignmentUnits = alignment > unit ? (alignment + unit - 1) / unit : 1
+        });
+        ids.push_back(candidate.id);
+    }
+
+    for (const auto& move : DefragmentationPlanner::Plan(blocks, allocations, byteBudget / unit)) {
+        const DefragmentationPlanner::Allocation& source = allocations[move.allocation];
+        MemoryBlock& destination = *poolBlocks[move.block];
+        relocations.push_back({ids[move.allocation], makeAllocation(destination, move.firstUnit, source.unitCount * unit)});
+    }
+    return relocations;
+}
+
 bool MemoryPool::preAllocatePools() {
     std::lock_guard<std::mutex> lock(poolMutex);
 
@@ -7,6 +7,9 @@
 #include <mutex>
 #include <cstdint>
 #include <utility>
+#include <array>
+
+#include "memory_defragmenter.h"
 
 /**
  * @brief Memory pool allocator for Vulkan resources
@@ -52,8 +55,43 @@ public:
         void* mappedPtr;                // Mapped pointer (if applicable)
         std::vector<bool> freeList;     // Free list for sub-allocations
         vk::DeviceSize allocationUnit;  // Size of each allocation unit
+        uint64_t emptySinceFrame = 0;   // Frame the block became empty (meaningless while used)
+    };
+
+    /**
+     * @brief Fragmentation of a pool's blocks
+     */
+    struct FragmentationStats {
+        size_t blockCount = 0;
+        size_t emptyBlocks = 0;
+        vk::DeviceSize totalBytes = 0;
+        vk::DeviceSize usedBytes = 0;
+        vk::DeviceSize largestFreeRange = 0;  // Largest allocation that fits without a new block
+        uint64_t freeRangeCount = 0;
+        // Free ranges of [2^i, 2^(i+1)) allocation units; the last bucket also holds everything larger
+        std::array<uint64_t, FreeRangeStats::HISTOGRAM_BUCKETS> freeRangeHistogram{};
+    };
+
+    /**
+     * @brief An allocation the caller can move to another place in its pool
+     */
+    struct RelocationCandidate {
+        uint64_t id;                    // Caller's identifier, returned with the destination
+        const Allocation* allocation;
+        vk::DeviceSize alignment;       // Offset alignment the resource requires
+    };
+
+    /**
+     * @brief A reserved destination for a relocation candidate
+     */
+    struct Relocation {
+        uint64_t id;
+        std::unique_ptr<Allocation> destination;
     };
 
+    // Frames an empty block is kept for reuse before it is released
+    static constexpr uint64_t EMPTY_BLOCK_RELEASE_FRAMES = 120;
+
 private:
     const vk::raii::Device& device;
     const vk::raii::PhysicalDevice& physicalDevice;
@@ -77,12 +115,16 @@ private:
     // Optional rendering state flag (no allocation restrictions enforced)
     bool renderingActive = false;
 
+    // Frame of the last releaseEmptyBlocks call, stamped on blocks that become empty
+    uint64_t currentFrame = 0;
+
     // Helper methods
     uint32_t findMemoryType(uint32_t typeFilter, vk::MemoryPropertyFlags properties) const;
     std::unique_ptr<MemoryBlock> createMemoryBlock(PoolType poolType, vk::DeviceSize size);
     // Create a memory block with an explicit memory type index (used for images requiring a specific type)
     std::unique_ptr<MemoryBlock> createMemoryBlockWithType(PoolType poolType, vk::DeviceSize size, uint32_t memoryTypeIndex);
     std::pair<MemoryBlock*, size_t> findSuitableBlock(PoolType poolType, vk::DeviceSize size, vk::DeviceSize alignment);
+    std::unique_ptr<Allocation> makeAllocation(MemoryBlock& block, size_t startUnit, vk::DeviceSize size) const;
 
 public:
     /**
@@ -163,6 +205,38 @@ public:
      */
     std::pair<vk::DeviceSize, vk::DeviceSize> getTotalMemoryUsage() const;
 
+    /**
+     * @brief Get the fragmentation of a pool
+     * @param poolType Type of pool to query
+     * @return Block counts, free space and free-range histogram
+     */
+    FragmentationStats getFragmentationStats(PoolType poolType) const;
+
+    /**
+     * @brief Release blocks that stayed empty for EMPTY_BLOCK_RELEASE_FRAMES
+     *
+     * Sub-allocating pools keep one empty block of the configured size as a spare,
+     * so allocation churn around a block boundary does not reallocate device memory.
+     * @param frame The current frame number
+     * @return The number of bytes released
+     */
+    vk::DeviceSize releaseEmptyBlocks(uint64_t frame);
+
+    /**
+     * @brief Plan one defragmentation step for a pool and reserve the destinations
+     *
+     * Evacuates the sparsest block whose allocations are all candidates (see
+     * DefragmentationPlanner). The caller copies each moved resource to a new
+     * resource bound at its destination and deallocates the old allocation once
+     * the GPU no longer uses it; the emptied block is then released like any other.
+     * @param poolType Type of pool to compact
+     * @param candidates The allocations the caller can move
+     * @param byteBudget The number of bytes to move at most
+     * @return The reserved destinations
+     */
+    std::vector<Relocation> planRelocations(PoolType poolType, const std::vector<RelocationCandidate>& candidates,
+                                            vk::DeviceSize byteBudget);
+
     /**
      * @brief Configure a specific pool type
      * @param poolType Type of pool to configure
@@ -0,0 +1,520 @@
+#include "mesh_cache.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+#if defined(_WIN32)
+  #ifndef NOMINMAX
+  #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+static_assert(std::is_trivially_copyable_v<Vertex>, "Vertex must be trivially copyable to be cached");
+static_assert(std::is_trivially_copyable_v<InstanceData>, "InstanceData must be trivially copyable to be cached");
+
+namespace {
+
+constexpr char CACHE_MAGIC[8] = {'S', 'E', 'M', 'E', 'S', 'H', 'C', '\0'};
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t vertexStride;
+    uint32_t instanceStride;
+    uint32_t reserved;
+    uint64_t sourceHash;
+    uint64_t payloadSize;
+};
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// FNV-style hash of a whole file, 8 bytes per step. The rotation mixes the high bits of
+// each product back into the low bits the next word is combined with.
+uint64_t HashWords(uint64_t hash, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    size_t wordBytes = size & ~size_t{7};
+    for (size_t i = 0; i < wordBytes; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = std::rotl(hash ^ word, 29) * FNV_PRIME;
+    }
+    return HashBytes(hash, bytes + wordBytes, size - wordBytes);
+}
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) return;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) return;
+        data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (data) size = static_cast<size_t>(fileSize.QuadPart);
+#else
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size == 0) return;
+        void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) return;
+        data = static_cast<const uint8_t*>(mapped);
+        size = static_cast<size_t>(st.st_size);
+        // The whole file is consumed front to back
+        madvise(mapped, size, MADV_SEQUENTIAL);
+#endif
+    }
+
+    ~MappedFile() {
+#if defined(_WIN32)
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (data) munmap(const_cast<uint8_t*>(data), size);
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool IsValid() const { return data != nullptr; }
+    const uint8_t* Data() const { return data; }
+    size_t Size() const { return size; }
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+/**
+ * @brief Appends POD values, strings and arrays to a byte buffer.
+ */
+class CacheWriter {
+public:
+    template<typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto* bytes = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void WriteString(const std::string& value) {
+        Write(static_cast<uint32_t>(value.size()));
+        buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+
+    template<typename T>
+    void WriteArray(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write(static_cast<uint64_t>(values.size()));
+        const auto* bytes = reinterpret_cast<const char*>(values.data());
+        buffer.insert(buffer.end(), bytes, bytes + values.size() * sizeof(T));
+    }
+
+    const std::vector<char>& GetBuffer() const { return buffer; }
+
+private:
+    std::vector<char> buffer;
+};
+
+/**
+ * @brief Bounds-checked reader over a mapped cache payload.
+ * Any overrun marks the reader as failed; callers check IsValid() once at the end.
+ */
+class CacheReader {
+public:
+    CacheReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    template<typename T>
+    T Read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        if (!require(sizeof(T))) return value;
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    std::string ReadString() {
+        auto length = Read<uint32_t>();
+        if (!require(length)) return {};
+        std::string value(reinterpret_cast<const char*>(data + offset), length);
+        offset += length;
+        return value;
+    }
+
+    template<typename T>
+    void ReadArray(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        auto count = Read<uint64_t>();
+        if (!valid || count > (size - offset) / sizeof(T)) {
+            valid = false;
+            return;
+        }
+        values.resize(static_cast<size_t>(count));
+        std::memcpy(values.data(), data + offset, static_cast<size_t>(count) * sizeof(T));
+        offset += static_cast<size_t>(count) * sizeof(T);
+    }
+
+    bool IsValid() const { return valid; }
+    bool AtEnd() const { return offset == size; }
+
+private:
+    bool require(size_t bytes) {
+        if (!valid || bytes > size - offset) {
+            valid = false;
+            return false;
+        }
+        return true;
+    }
+
+    const uint8_t* data;
+    size_t size;
+    size_t offset = 0;
+    bool valid = true;
+};
+
+void WriteMaterial(CacheWriter& writer, const Material& material) {
+    writer.WriteString(material.GetName());
+    writer.Write(material.albedo);
+    writer.Write(material.metallic);
+    writer.Write(material.roughness);
+    writer.Write(material.ao);
+    writer.Write(material.emissive);
+    writer.Write(material.ior);
+    writer.Write(material.emissiveStrength);
+    writer.Write(material.alpha);
+    writer.Write(material.transmissionFactor);
+    writer.Write(static_cast<uint8_t>(material.useSpecularGlossiness));
+    writer.Write(material.specularFactor);
+    writer.Write(material.glossinessFactor);
+    writer.WriteString(material.specGlossTexturePath);
+    writer.WriteString(material.alphaMode);
+    writer.Write(material.alphaCutoff);
+    writer.WriteString(material.albedoTexturePath);
+    writer.WriteString(material.normalTexturePath);
+    writer.WriteString(material.metallicRoughnessTexturePath);
+    writer.WriteString(material.occlusionTexturePath);
+    writer.WriteString(material.emissiveTexturePath);
+    writer.Write(static_cast<uint8_t>(material.isGlass));
+    writer.Write(static_cast<uint8_t>(material.isLiquid));
+}
+
+std::unique_ptr<Material> ReadMaterial(CacheReader& reader) {
+    auto material = std::make_unique<Material>(reader.ReadString());
+    material->albedo = reader.Read<glm::vec3>();
+    material->metallic = reader.Read<float>();
+    material->roughness = reader.Read<float>();
+    material->ao = reader.Read<float>();
+    material->emissive = reader.Read<glm::vec3>();
+    material->ior = reader.Read<float>();
+    material->emissiveStrength = reader.Read<float>();
+    material->alpha = reader.Read<float>();
+    material->transmissionFactor = reader.Read<float>();
+    material->useSpecularGlossiness = reader.Read<uint8_t>() != 0;
+    material->specularFactor = reader.Read<glm::vec3>();
+    material->glossinessFactor = reader.Read<float>();
+    material->specGlossTexturePath = reader.ReadString();
+    material->alphaMode = reader.ReadString();
+    material->alphaCutoff = reader.Read<float>();
+    material->albedoTexturePath = reader.ReadString();
+    material->normalTexturePath = reader.ReadString();
+    material->metallicRoughnessTexturePath = reader.ReadString();
+    material->occlusionTexturePath = reader.ReadString();
+    material->emissiveTexturePath = reader.ReadString();
+    material->isGlass = reader.Read<uint8_t>() != 0;
+    material->isLiquid = reader.Read<uint8_t>() != 0;
+    return material;
+}
+
+void WriteMaterialMesh(CacheWriter& writer, const MaterialMesh& mesh) {
+    writer.Write(static_cast<int32_t>(mesh.materialIndex));
+    writer.WriteString(mesh.materialName);
+    writer.WriteArray(mesh.GetVertices());
+    writer.WriteArray(mesh.GetIndices());
+    writer.WriteArray(mesh.GetMeshlets());
+    writer.WriteArray(mesh.GetLodIndices());
+    writer.WriteArray(mesh.GetLods());
+    writer.WriteString(mesh.texturePath);
+    writer.WriteString(mesh.baseColorTexturePath);
+    writer.WriteString(mesh.normalTexturePath);
+    writer.WriteString(mesh.metallicRoughnessTexturePath);
+    writer.WriteString(mesh.occlusionTexturePath);
+    writer.WriteString(mesh.emissiveTexturePath);
+    writer.WriteArray(mesh.instances);
+    writer.Write(static_cast<uint8_t>(mesh.isInstanced));
+}
+
+void ReadMaterialMesh(CacheReader& reader, MaterialMesh& mesh) {
+    mesh.materialIndex = reader.Read<int32_t>();
+    mesh.materialName = reader.ReadString();
+    reader.ReadArray(mesh.vertices);
+    reader.ReadArray(mesh.indices);
+    reader.ReadArray(mesh.meshlets);
+    reader.ReadArray(mesh.lodIndices);
+    reader.ReadArray(mesh.lods);
+    mesh.texturePath = reader.ReadString();
+    mesh.baseColorTexturePath = reader.ReadString();
+    mesh.normalTexturePath = reader.ReadString();
+    mesh.metallicRoughnessTexturePath = reader.ReadString();
+    mesh.occlusionTexturePath = reader.ReadString();
+    mesh.emissiveTexturePath = reader.ReadString();
+    reader.ReadArray(mesh.instances);
+    mesh.isInstanced = reader.Read<uint8_t>() != 0;
+}
+
+void WriteLight(CacheWriter& writer, const ExtractedLight& light) {
+    writer.Write(static_cast<uint32_t>(light.type));
+    writer.Write(light.position);
+    writer.Write(light.direction);
+    writer.Write(light.color);
+    writer.Write(light.intensity);
+    writer.Write(light.range);
+    writer.Write(light.innerConeAngle);
+    writer.Write(light.outerConeAngle);
+    writer.WriteString(light.sourceMaterial);
+}
+
+ExtractedLight ReadLight(CacheReader& reader) {
+    ExtractedLight light;
+    light.type = static_cast<ExtractedLight::Type>(reader.Read<uint32_t>());
+    light.position = reader.Read<glm::vec3>();
+    light.direction = reader.Read<glm::vec3>();
+    light.color = reader.Read<glm::vec3>();
+    light.intensity = reader.Read<float>();
+    light.range = reader.Read<float>();
+    light.innerConeAngle = reader.Read<float>();
+    light.outerConeAngle = reader.Read<float>();
+    light.sourceMaterial = reader.ReadString();
+    return light;
+}
+
+void WriteCamera(CacheWriter& writer, const CameraData& camera) {
+    writer.WriteString(camera.name);
+    writer.Write(static_cast<uint8_t>(camera.isPerspective));
+    writer.Write(camera.fov);
+    writer.Write(camera.aspectRatio);
+    writer.Write(camera.orthographicSize);
+    writer.Write(camera.nearPlane);
+    writer.Write(camera.farPlane);
+    writer.Write(camera.position);
+    writer.Write(camera.rotation);
+}
+
+CameraData ReadCamera(CacheReader& reader) {
+    CameraData camera;
+    camera.name = reader.ReadString();
+    camera.isPerspective = reader.Read<uint8_t>() != 0;
+    camera.fov = reader.Read<float>();
+    camera.aspectRatio = reader.Read<float>();
+    camera.orthographicSize = reader.Read<float>();
+    camera.nearPlane = reader.Read<float>();
+    camera.farPlane = reader.Read<float>();
+    camera.position = reader.Read<glm::vec3>();
+    camera.rotation = reader.Read<glm::quat>();
+    return camera;
+}
+
+} // namespace
+
+std::string MeshCache::GetCachePath(const std::string& sourcePath) {
+    return sourcePath + ".meshcache";
+}
+
+bool MeshCache::ComputeSourceHash(const std::string& sourcePath, uint64_t& hash) {
+    MappedFile source(sourcePath);
+    if (!source.IsValid()) {
+        return false;
+    }
+
+    hash = HashBytes(FNV_OFFSET, &VERSION, sizeof(VERSION));
+    hash = HashWords(hash, source.Data(), source.Size());
+
+    // Hashing large external buffers would cost as much as parsing them; their
+    // size and timestamp are enough to notice a re-export
+    std::filesystem::path path(sourcePath);
+    if (path.extension() == ".gltf") {
+        std::error_code ec;
+        std::vector<std::filesystem::path> buffers;
+        for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::absolute(path).parent_path(), ec)) {
+            if (entry.is_regular_file(ec) && entry.path().extension() == ".bin") {
+                buffers.push_back(entry.path());
+            }
+        }
+        std::ranges::sort(buffers);
+        for (const auto& buffer : buffers) {
+            std::string name = buffer.filename().string();
+            auto fileSize = static_cast<uint64_t>(std::filesystem::file_size(buffer, ec));
+            auto writeTime = static_cast<int64_t>(std::filesystem::last_write_time(buffer, ec).time_since_epoch().count());
+            hash = HashBytes(hash, name.data(), name.size());
+            hash = HashBytes(hash, &fileSize, sizeof(fileSize));
+            hash = HashBytes(hash, &writeTime, sizeof(writeTime));
+        }
+    }
+    return true;
+}
+
+bool MeshCache::Read(const std::string& cachePath, uint64_t sourceHash, MeshCacheContents& contents) {
+    try {
+        MappedFile file(cachePath);
+        if (!file.IsValid() || file.Size() < sizeof(CacheHeader)) {
+            return false;
+        }
+
+        CacheHeader header{};
+        std::memcpy(&header, file.Data(), sizeof(header));
+        if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+            header.version != VERSION ||
+            header.vertexStride != sizeof(Vertex) ||
+            header.instanceStride != sizeof(InstanceData)) {
+            std::cout << "Mesh cache format mismatch, ignoring: " << cachePath << std::endl;
+            return false;
+        }
+        if (header.sourceHash != sourceHash) {
+            std::cout << "Mesh cache is out of date, ignoring: " << cachePath << std::endl;
+            return false;
+        }
+        if (header.payloadSize != file.Size() - sizeof(CacheHeader)) {
+            std::cerr << "Mesh cache is truncated: " << cachePath << std::endl;
+            return false;
+        }
+
+        CacheReader reader(file.Data() + sizeof(CacheHeader), static_cast<size_t>(header.payloadSize));
+        MeshCacheContents result;
+        result.hasEmissiveStrengthExtension = reader.Read<uint8_t>() != 0;
+        result.lightScale = reader.Read<float>();
+
+        auto meshCount = reader.Read<uint32_t>();
+        for (uint32_t i = 0; i < meshCount && reader.IsValid(); ++i) {
+            ReadMaterialMesh(reader, result.materialMeshes.emplace_back());
+        }
+        auto materialCount = reader.Read<uint32_t>();
+        for (uint32_t i = 0; i < materialCount && reader.IsValid(); ++i) {
+            result.materials.push_back(ReadMaterial(reader));
+        }
+        auto lightCount = reader.Read<uint32_t>();
+        for (uint32_t i = 0; i < lightCount && reader.IsValid(); ++i) {
+            result.lights.push_back(ReadLight(reader));
+        }
+        auto cameraCount = reader.Read<uint32_t>();
+        for (uint32_t i = 0; i < cameraCount && reader.IsValid(); ++i) {
+            result.cameras.push_back(ReadCamera(reader));
+        }
+        auto textureCount = reader.Read<uint32_t>();
+        for (uint32_t i = 0; i < textureCount && reader.IsValid(); ++i) {
+            MeshCacheTexture texture;
+            texture.aliasId = reader.ReadString();
+            texture.filePath = reader.ReadString();
+            texture.critical = reader.Read<uint8_t>() != 0;
+            result.textures.push_back(std::move(texture));
+        }
+
+        if (!reader.IsValid() || !reader.AtEnd()) {
+            std::cerr << "Mesh cache is corrupt: " << cachePath << std::endl;
+            return false;
+        }
+
+        contents = std::move(result);
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to read mesh cache " << cachePath << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool MeshCache::Write(const std::string& cachePath, uint64_t sourceHash, const MeshCacheContents& contents) {
+    try {
+        CacheWriter writer;
+        writer.Write(static_cast<uint8_t>(contents.hasEmissiveStrengthExtension));
+        writer.Write(contents.lightScale);
+
+        writer.Write(static_cast<uint32_t>(contents.materialMeshes.size()));
+        for (const auto& mesh : contents.materialMeshes) {
+            WriteMaterialMesh(writer, mesh);
+        }
+        writer.Write(static_cast<uint32_t>(contents.materials.size()));
+        for (const auto& material : contents.materials) {
+            WriteMaterial(writer, *material);
+        }
+        writer.Write(static_cast<uint32_t>(contents.lights.size()));
+        for (const auto& light : contents.lights) {
+            WriteLight(writer, light);
+        }
+        writer.Write(static_cast<uint32_t>(contents.cameras.size()));
+        for (const auto& camera : contents.cameras) {
+            WriteCamera(writer, camera);
+        }
+        writer.Write(static_cast<uint32_t>(contents.textures.size()));
+        for (const auto& texture : contents.textures) {
+            writer.WriteString(texture.aliasId);
+            writer.WriteString(texture.filePath);
+            writer.Write(static_cast<uint8_t>(texture.critical));
+        }
+
+        const std::vector<char>& payload = writer.GetBuffer();
+        CacheHeader header{};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = VERSION;
+        header.vertexStride = sizeof(Vertex);
+        header.instanceStride = sizeof(InstanceData);
+        header.sourceHash = sourceHash;
+        header.payloadSize = payload.size();
+
+        // Write to a temporary file first so a crash never leaves a half-written cache behind
+        const std::string tempPath = cachePath + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                std::cerr << "Failed to open mesh cache for writing: " << tempPath << std::endl;
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            if (!file.good()) {
+                std::cerr << "Failed to write mesh cache: " << tempPath << std::endl;
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, cachePath);
+
+        std::cout << "Wrote mesh cache " << cachePath << " (" << (sizeof(header) + payload.size()) / (1024 * 1024) << " MB)" << std::endl;
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to write mesh cache " << cachePath << ": " << e.what() << std::endl;
+        return false;
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "model_loader.h"
+
+/**
+ * @brief Everything ModelLoader produces for one glTF file.
+ */
+struct MeshCacheContents {
+    std::vector<MaterialMesh> materialMeshes;
+    std::vector<std::unique_ptr<Material>> materials;
+    std::vector<ExtractedLight> lights;
+    std::vector<CameraData> cameras;
+    std::vector<MeshCacheTexture> textures;
+    bool hasEmissiveStrengthExtension = false;
+    float lightScale = 1.0f;
+};
+
+/**
+ * @brief Binary cache of preprocessed glTF geometry.
+ *
+ * Stores the processed MaterialMesh vertex/index/meshlet/LOD/instance arrays (normals
+ * normalized, tangents orthogonalized or generated by MikkTSpace), materials,
+ * punctual lights and cameras, so warm loads skip tinygltf and tangent
+ * generation entirely. Cache files are memory-mapped and the bulk arrays are
+ * copied straight out of the mapping.
+ *
+ * A cache file is only used when its format version, vertex/instance layouts
+ * and source hash all match; anything else is treated as a miss and the model
+ * is parsed (and the cache rewritten) as usual.
+ */
+class MeshCache {
+public:
+    // Bump whenever the file layout or ModelLoader's geometry processing changes
+    static constexpr uint32_t VERSION = 4;
+
+    /**
+     * @brief Get the cache file path for a source model.
+     * @param sourcePath The glTF/glb path.
+     * @return The cache file path.
+     */
+    static std::string GetCachePath(const std::string& sourcePath);
+
+    /**
+     * @brief Hash a source model and its external buffers.
+     *
+     * The glTF/glb file contents are hashed; external .bin buffers next to a
+     * .gltf file contribute their name, size and modification time.
+     *
+     * @param sourcePath The glTF/glb path.
+     * @param hash Receives the hash.
+     * @return True if the source could be read, false otherwise.
+     */
+    static bool ComputeSourceHash(const std::string& sourcePath, uint64_t& hash);
+
+    /**
+     * @brief Read a cache file.
+     * @param cachePath The cache file path.
+     * @param sourceHash The expected source hash.
+     * @param contents Receives the cached data.
+     * @return True if the cache was valid and read completely, false otherwise.
+     */
+    static bool Read(const std::string& cachePath, uint64_t sourceHash, MeshCacheContents& contents);
+
+    /**
+     * @brief Write a cache file (via a temporary file that is renamed into place).
+     * @param cachePath The cache file path.
+     * @param sourceHash The source hash to store.
+     * @param contents The data to store.
+     * @return True if the cache was written, false otherwise.
+     */
+    static bool Write(const std::string& cachePath, uint64_t sourceHash, const MeshCacheContents& contents);
+};
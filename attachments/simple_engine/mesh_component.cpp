@@ -1,13 +1,18 @@
 #include "mesh_component.h"
 #include "model_loader.h"
+#include "mesh_optimizer.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <glm/gtc/packing.hpp>
 
 // Most of the MeshComponent class implementation is in the header file
 // This file is mainly for any methods that might need additional implementation
 
-void MeshComponent::CreateSphere(float radius, const glm::vec3& color, int segments) {
-    vertices.clear();
-    indices.clear();
+std::shared_ptr<const MeshGeometry> MeshGeometry::CreateSphere(float radius, int segments) {
+    auto geometry = std::make_shared<MeshGeometry>();
+    auto& vertices = geometry->vertices;
+    auto& indices = geometry->indices;
 
     // Generate sphere vertices using parametric equations
     for (int lat = 0; lat <= segments; ++lat) {
@@ -80,7 +85,15 @@ void MeshComponent::CreateSphere(float radius, const glm::vec3& color, int segme
         }
     }
 
-    RecomputeLocalAABB();
+    // The latitude/longitude grid order is cache-hostile; reorder it like loaded meshes
+    MeshOptimizer::OptimizeMesh(vertices, indices, offsetof(Vertex, position));
+
+    geometry->ComputeAABB();
+    return geometry;
+}
+
+void MeshComponent::CreateSphere(float radius, const glm::vec3& color, int segments) {
+    SetGeometry(MeshGeometry::CreateSphere(radius, segments));
 }
 
 void MeshComponent::LoadFromModel(const Model* model) {
@@ -89,8 +102,97 @@ void MeshComponent::LoadFromModel(const Model* model) {
     }
 
     // Copy vertex and index data from the model
-    vertices = model->GetVertices();
-    indices = model->GetIndices();
+    auto modelGeometry = std::make_shared<MeshGeometry>();
+    modelGeometry->vertices = model->GetVertices();
+    modelGeometry->indices = model->GetIndices();
+    modelGeometry->ComputeAABB();
+    SetGeometry(std::move(modelGeometry));
+}
+
+namespace {
+    glm::vec2 SignNotZero(const glm::vec2& v) {
+        return {v.x >= 0.0f ? 1.0f : -1.0f, v.y >= 0.0f ? 1.0f : -1.0f};
+    }
+
+    int16_t PackSnorm16(float value) {
+        return static_cast<int16_t>(std::round(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    float UnpackSnorm16(int16_t value) {
+        return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+    }
+
+    // Octahedral mapping of a unit vector onto [-1, 1]^2
+    void OctEncode(const glm::vec3& v, int16_t out[2]) {
+        float length1 = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+        if (length1 <= 0.0f) {
+            out[0] = 0;
+            out[1] = 0;
+            return;
+        }
+        glm::vec2 e = glm::vec2(v.x, v.y) / length1;
+        if (v.z < 0.0f) {
+            e = (1.0f - glm::abs(glm::vec2(e.y, e.x))) * SignNotZero(e);
+        }
+        out[0] = PackSnorm16(e.x);
+        out[1] = PackSnorm16(e.y);
+    }
+
+    // Must match OctDecode() in the shaders
+    glm::vec3 OctDecode(const int16_t in[2]) {
+        glm::vec2 e(UnpackSnorm16(in[0]), UnpackSnorm16(in[1]));
+        glm::vec3 v(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+        float t = std::max(-v.z, 0.0f);
+        v.x += v.x >= 0.0f ? -t : t;
+        v.y += v.y >= 0.0f ? -t : t;
+        float length = glm::length(v);
+        return length > 0.0f ? v / length : glm::vec3(0.0f, 0.0f, 1.0f);
+    }
+}
+
+VertexQuantization PackedVertex::ComputeQuantization(const std::vector<Vertex>& vertices) {
+    VertexQuantization quantization;
+    if (vertices.empty()) {
+        return quantization;
+    }
+
+    glm::vec3 minBounds(std::numeric_limits<float>::max());
+    glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+    for (const auto& vertex : vertices) {
+        minBounds = glm::min(minBounds, vertex.position);
+        maxBounds = glm::max(maxBounds, vertex.position);
+    }
+
+    quantization.positionOffset = minBounds;
+    // Flat axes keep a non-zero scale so decoding stays well defined
+    quantization.positionScale = glm::max(maxBounds - minBounds, glm::vec3(1e-6f));
+    return quantization;
+}
+
+PackedVertex PackedVertex::Encode(const Vertex& vertex, const VertexQuantization& quantization) {
+    PackedVertex packed{};
+
+    glm::vec3 normalized = glm::clamp((vertex.position - quantization.positionOffset) / quantization.positionScale,
+                                      glm::vec3(0.0f), glm::vec3(1.0f));
+    for (int i = 0; i < 3; ++i) {
+        packed.position[i] = static_cast<uint16_t>(std::round(normalized[i] * 65535.0f));
+    }
+    packed.position[3] = vertex.tangent.w < 0.0f ? 0 : 65535;
+
+    OctEncode(vertex.normal, packed.normal);
+    OctEncode(glm::vec3(vertex.tangent), packed.tangent);
+
+    packed.texCoord[0] = static_cast<uint16_t>(glm::packHalf1x16(vertex.texCoord.x));
+    packed.texCoord[1] = static_cast<uint16_t>(glm::packHalf1x16(vertex.texCoord.y));
+    return packed;
+}
 
-    RecomputeLocalAABB();
+Vertex PackedVertex::Decode(const VertexQuantization& quantization) const {
+    Vertex vertex{};
+    glm::vec3 normalized(position[0] / 65535.0f, position[1] / 65535.0f, position[2] / 65535.0f);
+    vertex.position = quantization.positionOffset + normalized * quantization.positionScale;
+    vertex.normal = OctDecode(normal);
+    vertex.tangent = glm::vec4(OctDecode(tangent), position[3] >= 32768 ? 1.0f : -1.0f);
+    vertex.texCoord = glm::vec2(glm::unpackHalf1x16(texCoord[0]), glm::unpackHalf1x16(texCoord[1]));
+    return vertex;
 }
@@ -3,11 +3,15 @@
 #include <vector>
 #include <string>
 #include <array>
+#include <algorithm>
+#include <span>
+#include <memory>
 #include <glm/glm.hpp>
 
 #include <vulkan/vulkan.hpp>
 
 #include "component.h"
+#include "mesh_optimizer.h"
 
 /**
  * @brief Structure representing per-instance data for instanced rendering.
@@ -245,17 +249,164 @@ struct Vertex {
 };
 
 /**
- * @brief Component that handles the mesh data for rendering.
+ * @brief Dequantization parameters of a packed mesh: position = offset + unorm16 * scale.
  */
-class MeshComponent final : public Component {
-private:
+struct VertexQuantization {
+    glm::vec3 positionOffset = glm::vec3(0.0f); // AABB minimum
+    glm::vec3 positionScale = glm::vec3(1.0f);  // AABB extent
+};
+
+/**
+ * @brief Compact 20-byte vertex layout (vs. 48 bytes for Vertex).
+ *
+ * - position: unorm16 xyz relative to the mesh AABB; w holds the tangent handedness (0 = -1, 65535 = +1)
+ * - normal, tangent: octahedral encoding in snorm16x2
+ * - texCoord: half floats
+ *
+ * Shaders read it through the VSMainPacked entry points, which decode with the
+ * positionOffset/positionScale of the per-entity uniform buffer.
+ *
+ * Round-trip error: positions are off by at most half a quantization step
+ * (extent / 131070 per axis), unit normals and tangents by at most
+ * MAX_DIRECTION_ERROR, and texture coordinates by the half float rounding
+ * (MAX_TEXCOORD_RELATIVE_ERROR of their magnitude).
+ */
+struct PackedVertex {
+    static constexpr float MAX_DIRECTION_ERROR = 1e-4f;               // Distance between the unit vectors
+    static constexpr float MAX_TEXCOORD_RELATIVE_ERROR = 1.0f / 2048.0f; // Half float rounding (11-bit significand)
+
+    uint16_t position[4];
+    int16_t normal[2];
+    int16_t tangent[2];
+    uint16_t texCoord[2];
+
+    /**
+     * @brief Compute the quantization range (AABB) of a vertex array.
+     * @param vertices The vertices to encode.
+     * @return The quantization parameters.
+     */
+    static VertexQuantization ComputeQuantization(const std::vector<Vertex>& vertices);
+
+    /**
+     * @brief Encode a vertex.
+     * @param vertex The full-precision vertex.
+     * @param quantization The quantization range of its mesh.
+     * @return The packed vertex.
+     */
+    static PackedVertex Encode(const Vertex& vertex, const VertexQuantization& quantization);
+
+    /**
+     * @brief Decode the vertex exactly as the shaders do (used to measure round-trip error).
+     * @param quantization The quantization range of its mesh.
+     * @return The decoded vertex.
+     */
+    [[nodiscard]] Vertex Decode(const VertexQuantization& quantization) const;
+
+    static vk::VertexInputBindingDescription getBindingDescription() {
+        constexpr vk::VertexInputBindingDescription bindingDescription(
+            0,                                  // binding
+            sizeof(PackedVertex),               // stride
+            vk::VertexInputRate::eVertex        // inputRate
+        );
+        return bindingDescription;
+    }
+
+    // Same locations as Vertex, so only the formats differ
+    static std::array<vk::VertexInputAttributeDescription, 4> getAttributeDescriptions() {
+        constexpr std::array<vk::VertexInputAttributeDescription, 4> attributeDescriptions = {
+            vk::VertexInputAttributeDescription{
+                .location = 0,
+                .binding = 0,
+                .format = vk::Format::eR16G16B16A16Unorm,
+                .offset = offsetof(PackedVertex, position)
+            },
+            vk::VertexInputAttributeDescription{
+                .location = 1,
+                .binding = 0,
+                .format = vk::Format::eR16G16Snorm,
+                .offset = offsetof(PackedVertex, normal)
+            },
+            vk::VertexInputAttributeDescription{
+                .location = 2,
+                .binding = 0,
+                .format = vk::Format::eR16G16Sfloat,
+                .offset = offsetof(PackedVertex, texCoord)
+            },
+            vk::VertexInputAttributeDescription{
+                .location = 3,
+                .binding = 0,
+                .format = vk::Format::eR16G16Snorm,
+                .offset = offsetof(PackedVertex, tangent)
+            }
+        };
+        return attributeDescriptions;
+    }
+};
+static_assert(sizeof(PackedVertex) == 20, "PackedVertex layout must stay tightly packed");
+
+/**
+ * @brief Immutable geometry of a mesh, shared by all MeshComponents that draw it.
+ *
+ * Loaded meshes and procedural shapes are built once and handed out as
+ * shared_ptr<const MeshGeometry>, so entities showing the same mesh hold one CPU
+ * copy and the renderer uploads it to a single vertex/index arena range.
+ */
+struct MeshGeometry {
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
+    std::vector<Meshlet> meshlets;     // Index ranges for cluster culling (empty if not clustered)
+    std::vector<uint32_t> lodIndices;  // Coarser levels of detail, appended after indices on upload
+    std::vector<MeshLod> lods;         // Level ranges in indices + lodIndices, base first (empty if single level)
+
+    // Local-space AABB
+    glm::vec3 aabbMin{0.0f};
+    glm::vec3 aabbMax{0.0f};
+    bool aabbValid = false;
+
+    /**
+     * @brief Compute the AABB from the vertices.
+     */
+    void ComputeAABB() {
+        if (vertices.empty()) {
+            aabbMin = glm::vec3(0.0f);
+            aabbMax = glm::vec3(0.0f);
+            aabbValid = false;
+            return;
+        }
+        aabbMin = vertices[0].position;
+        aabbMax = vertices[0].position;
+        for (const auto& v : vertices) {
+            aabbMin = glm::min(aabbMin, v.position);
+            aabbMax = glm::max(aabbMax, v.position);
+        }
+        aabbValid = true;
+    }
+
+    /**
+     * @brief Get the CPU memory held by the arrays.
+     * @return The size in bytes.
+     */
+    [[nodiscard]] size_t GetMemoryBytes() const {
+        return vertices.size() * sizeof(Vertex) + (indices.size() + lodIndices.size()) * sizeof(uint32_t) +
+               meshlets.size() * sizeof(Meshlet) + lods.size() * sizeof(MeshLod);
+    }
+
+    /**
+     * @brief Create a UV sphere.
+     * @param radius The radius of the sphere.
+     * @param segments The number of latitude and longitude segments.
+     * @return The geometry.
+     */
+    static std::shared_ptr<const MeshGeometry> CreateSphere(float radius, int segments);
+};
 
-    // Cached local-space AABB
-    glm::vec3 localAABBMin{0.0f};
-    glm::vec3 localAABBMax{0.0f};
-    bool localAABBValid = false;
+/**
+ * @brief Component that handles the mesh data for rendering.
+ */
+class MeshComponent final : public Component {
+private:
+    // Shared with every other component showing the same mesh; never null
+    std::shared_ptr<const MeshGeometry> geometry = std::make_shared<const MeshGeometry>();
 
     // All PBR texture paths for this mesh
     std::string texturePath;           // Primary texture path (baseColor) - kept for backward compatibility
@@ -268,6 +419,26 @@ private:
     // Instancing support
     std::vector<InstanceData> instances;  // Instance data for instanced rendering
     bool isInstanced = false;             // Flag to indicate if this mesh uses instancing
+    size_t instanceDirtyBegin = 0;        // Instances modified since the renderer last took them
+    size_t instanceDirtyEnd = 0;          // (empty when begin == end)
+
+    // The setters below replace the shared geometry with a modified private copy
+    template<typename Modify>
+    void modifyGeometry(Modify&& modify) {
+        auto copy = std::make_shared<MeshGeometry>(*geometry);
+        modify(*copy);
+        geometry = std::move(copy);
+    }
+
+    void markInstancesDirty(size_t first, size_t last) {
+        if (instanceDirtyBegin == instanceDirtyEnd) {
+            instanceDirtyBegin = first;
+            instanceDirtyEnd = last;
+        } else {
+            instanceDirtyBegin = std::min(instanceDirtyBegin, first);
+            instanceDirtyEnd = std::max(instanceDirtyEnd, last);
+        }
+    }
 
     // The renderer will manage Vulkan resources
     // This component only stores the data
@@ -280,35 +451,36 @@ public:
     explicit MeshComponent(const std::string& componentName = "MeshComponent")
         : Component(componentName) {}
 
-    // Local AABB utilities
-    void RecomputeLocalAABB() {
-        if (vertices.empty()) {
-            localAABBMin = glm::vec3(0.0f);
-            localAABBMax = glm::vec3(0.0f);
-            localAABBValid = false;
-            return;
-        }
-        glm::vec3 minB = vertices[0].position;
-        glm::vec3 maxB = vertices[0].position;
-        for (const auto& v : vertices) {
-            minB = glm::min(minB, v.position);
-            maxB = glm::max(maxB, v.position);
-        }
-        localAABBMin = minB;
-        localAABBMax = maxB;
-        localAABBValid = true;
+    /**
+     * @brief Reference shared geometry.
+     * @param newGeometry The geometry (null clears the mesh).
+     */
+    void SetGeometry(std::shared_ptr<const MeshGeometry> newGeometry) {
+        geometry = newGeometry ? std::move(newGeometry) : std::make_shared<const MeshGeometry>();
     }
-    [[nodiscard]] bool HasLocalAABB() const { return localAABBValid; }
-    [[nodiscard]] glm::vec3 GetLocalAABBMin() const { return localAABBMin; }
-    [[nodiscard]] glm::vec3 GetLocalAABBMax() const { return localAABBMax; }
+
+    /**
+     * @brief Get the geometry of the mesh.
+     * @return The shared geometry (never null).
+     */
+    [[nodiscard]] const std::shared_ptr<const MeshGeometry>& GetGeometry() const {
+        return geometry;
+    }
+
+    // Local AABB utilities
+    [[nodiscard]] bool HasLocalAABB() const { return geometry->aabbValid; }
+    [[nodiscard]] glm::vec3 GetLocalAABBMin() const { return geometry->aabbMin; }
+    [[nodiscard]] glm::vec3 GetLocalAABBMax() const { return geometry->aabbMax; }
 
     /**
      * @brief Set the vertices of the mesh.
      * @param newVertices The new vertices.
      */
     void SetVertices(const std::vector<Vertex>& newVertices) {
-        vertices = newVertices;
-        RecomputeLocalAABB();
+        modifyGeometry([&](MeshGeometry& g) {
+            g.vertices = newVertices;
+            g.ComputeAABB();
+        });
     }
 
     /**
@@ -316,7 +488,7 @@ public:
      * @return The vertices.
      */
     [[nodiscard]] const std::vector<Vertex>& GetVertices() const {
-        return vertices;
+        return geometry->vertices;
     }
 
     /**
@@ -324,7 +496,7 @@ public:
      * @param newIndices The new indices.
      */
     void SetIndices(const std::vector<uint32_t>& newIndices) {
-        indices = newIndices;
+        modifyGeometry([&](MeshGeometry& g) { g.indices = newIndices; });
     }
 
     /**
@@ -332,7 +504,51 @@ public:
      * @return The indices.
      */
     [[nodiscard]] const std::vector<uint32_t>& GetIndices() const {
-        return indices;
+        return geometry->indices;
+    }
+
+    /**
+     * @brief Set the meshlets of the mesh (index ranges into the current indices).
+     * @param newMeshlets The new meshlets.
+     */
+    void SetMeshlets(const std::vector<Meshlet>& newMeshlets) {
+        modifyGeometry([&](MeshGeometry& g) { g.meshlets = newMeshlets; });
+    }
+
+    /**
+     * @brief Get the meshlets of the mesh.
+     * @return The meshlets (empty if the mesh was not clustered).
+     */
+    [[nodiscard]] const std::vector<Meshlet>& GetMeshlets() const {
+        return geometry->meshlets;
+    }
+
+    /**
+     * @brief Set the levels of detail of the mesh.
+     * @param newLods The level ranges into the indices followed by newLodIndices, base level first.
+     * @param newLodIndices The indices of the coarser levels.
+     */
+    void SetLods(const std::vector<MeshLod>& newLods, const std::vector<uint32_t>& newLodIndices) {
+        modifyGeometry([&](MeshGeometry& g) {
+            g.lods = newLods;
+            g.lodIndices = newLodIndices;
+        });
+    }
+
+    /**
+     * @brief Get the levels of detail of the mesh.
+     * @return The levels, base level first (empty if the mesh has a single level).
+     */
+    [[nodiscard]] const std::vector<MeshLod>& GetLods() const {
+        return geometry->lods;
+    }
+
+    /**
+     * @brief Get the indices of the coarser levels of detail.
+     * @return The indices that follow the base indices in the index buffer.
+     */
+    [[nodiscard]] const std::vector<uint32_t>& GetLodIndices() const {
+        return geometry->lodIndices;
     }
 
     /**
@@ -390,6 +606,7 @@ public:
     void AddInstance(const glm::mat4& transform, uint32_t materialIndex = 0) {
         instances.emplace_back(transform, materialIndex);
         isInstanced = instances.size() > 1;
+        markInstancesDirty(instances.size() - 1, instances.size());
     }
 
     /**
@@ -399,6 +616,7 @@ public:
     void SetInstances(const std::vector<InstanceData>& newInstances) {
         instances = newInstances;
         isInstanced = instances.size() > 1;
+        markInstancesDirty(0, std::max<size_t>(instances.size(), 1));
     }
 
     /**
@@ -431,6 +649,7 @@ public:
     void ClearInstances() {
         instances.clear();
         isInstanced = false;
+        markInstancesDirty(0, 1);
     }
 
     /**
@@ -442,7 +661,40 @@ public:
     void UpdateInstance(size_t index, const glm::mat4& transform, uint32_t materialIndex = 0) {
         if (index < instances.size()) {
             instances[index] = InstanceData(transform, materialIndex);
+            markInstancesDirty(index, index + 1);
+        }
+    }
+
+    /**
+     * @brief Overwrite a contiguous range of instances.
+     * Updating many instances through one call keeps their upload to a single range.
+     * @param firstIndex The index of the first instance to overwrite.
+     * @param newInstances The new instance data (clipped to the current instance count).
+     */
+    void UpdateInstances(size_t firstIndex, std::span<const InstanceData> newInstances) {
+        if (firstIndex >= instances.size()) {
+            return;
+        }
+        size_t count = std::min(newInstances.size(), instances.size() - firstIndex);
+        std::copy_n(newInstances.begin(), count, instances.begin() + static_cast<std::ptrdiff_t>(firstIndex));
+        markInstancesDirty(firstIndex, firstIndex + count);
+    }
+
+    /**
+     * @brief Take the range of instances modified since the last call.
+     * Used by the renderer to upload only what changed; the range is cleared.
+     * @param first Receives the first modified instance.
+     * @param last Receives one past the last modified instance.
+     * @return True if any instance was modified, false otherwise.
+     */
+    bool TakeDirtyInstanceRange(size_t& first, size_t& last) {
+        if (instanceDirtyBegin == instanceDirtyEnd) {
+            return false;
         }
+        first = instanceDirtyBegin;
+        last = instanceDirtyEnd;
+        instanceDirtyBegin = instanceDirtyEnd = 0;
+        return true;
     }
 
     /**
@@ -0,0 +1,1368 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Post-transform vertex cache statistics of an index buffer.
+ */
+struct VertexCacheStats {
+    size_t triangleCount = 0;
+    size_t vertexCount = 0;          // Unique vertices referenced by the indices
+    size_t verticesTransformed = 0;  // Cache misses, i.e., vertex shader invocations
+    float acmr = 0.0f;               // Average cache miss ratio: transformed / triangles (0.5 - 3.0)
+    float atvr = 0.0f;               // Average transform to vertex ratio: transformed / vertices (>= 1.0)
+};
+
+/**
+ * @brief Result of MeshOptimizer::OptimizeMesh.
+ */
+struct MeshOptimizationStats {
+    size_t verticesBefore = 0;
+    size_t verticesAfter = 0;        // After welding and dropping unreferenced vertices
+    VertexCacheStats cacheBefore;
+    VertexCacheStats cacheAfter;
+    bool overdrawOrdered = false;    // False if cluster ordering was rejected for costing too much cache efficiency
+
+    // Level of detail generation (MeshOptimizer::BuildLodChain)
+    size_t lodCount = 0;             // Levels generated in addition to the base mesh
+    size_t lodSourceTriangles = 0;   // Triangles fed to the simplifier over all levels
+    double lodMs = 0.0;              // Time spent simplifying
+    float maxLodRelativeError = 0.0f;  // Largest geometric error relative to the mesh extent
+    float maxLodNormalError = 0.0f;    // Largest normal deviation of a collapse (1 - cos)
+};
+
+/**
+ * @brief Result of MeshOptimizer::SimplifyMesh.
+ */
+struct SimplificationResult {
+    float error = 0.0f;          // Largest collapse error in mesh units
+    float relativeError = 0.0f;  // The same error relative to the mesh extent
+    float normalError = 0.0f;    // Largest normal deviation of a collapse (1 - cos), 0 without normals
+    size_t collapses = 0;
+};
+
+/**
+ * @brief One level of detail: a range of the shared index buffer.
+ */
+struct MeshLod {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    float error = 0.0f;          // Geometric error in mesh units (0 for the base level)
+};
+
+/**
+ * @brief A cluster of up to MeshOptimizer::MAX_MESHLET_TRIANGLES triangles that is culled as a unit.
+ *
+ * The triangles of a meshlet are contiguous in the index buffer, so visible
+ * meshlets can be drawn as plain index ranges.
+ */
+struct Meshlet {
+    float center[3] = {0.0f, 0.0f, 0.0f}; // Bounding sphere in mesh space
+    float radius = 0.0f;
+    float coneApex[3] = {0.0f, 0.0f, 0.0f};
+    float coneAxis[3] = {0.0f, 0.0f, 0.0f};
+    float coneCutoff = 1.0f;               // Back-facing if dot(normalize(apex - eye), axis) >= cutoff; 1 with a zero axis never culls
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    uint32_t vertexCount = 0;              // Unique vertices referenced (<= MAX_MESHLET_VERTICES)
+};
+
+/**
+ * @brief Load-time mesh optimization.
+ *
+ * Header-only and independent of the engine's vertex types, so it can be used by
+ * the simple engine and by the tutorial chapters alike. Vertices are treated as
+ * opaque, trivially copyable records of a given stride; only the overdraw pass
+ * reads positions (three floats at a given byte offset).
+ *
+ * The usual pipeline (OptimizeMesh) is:
+ * 1. Weld bitwise-identical vertices with an open-addressing hash table.
+ * 2. Reorder triangles for the post-transform vertex cache (Tipsify, Sander et al. 2007).
+ * 3. Reorder the resulting triangle clusters front-to-back from the outside in to
+ *    reduce overdraw, as long as the vertex cache efficiency stays within a threshold.
+ * 4. Reorder vertices in first-use order for vertex fetch locality.
+ *
+ * BuildLodChain adds coarser index buffers over the same vertices with
+ * quadric error metric edge collapses (Garland and Heckbert 1997).
+ */
+class MeshOptimizer {
+public:
+    // FIFO cache size used for optimization and for reporting ACMR/ATVR
+    static constexpr uint32_t CACHE_SIZE = 16;
+
+    // Meshlet limits (the common mesh shader sizes, which also keep culling granularity fine)
+    static constexpr uint32_t MAX_MESHLET_VERTICES = 64;
+    static constexpr uint32_t MAX_MESHLET_TRIANGLES = 124;
+
+    // Level of detail chain: each level targets half the triangles of the previous one
+    static constexpr uint32_t MAX_LOD_COUNT = 5;            // Including the base mesh
+    static constexpr float LOD_TARGET_ERROR = 0.05f;        // Per level, relative to the mesh extent
+    static constexpr float LOD_MIN_REDUCTION = 0.8f;        // Stop once a level keeps more than this fraction
+    static constexpr float LOD_NORMAL_WEIGHT = 0.05f;       // Relative error charged for a fully flipped normal
+
+    /**
+     * @brief Simulate a FIFO post-transform vertex cache.
+     * @param indices The index buffer (triangle list).
+     * @param indexCount The number of indices.
+     * @param vertexCount The number of vertices the indices refer to.
+     * @param cacheSize The cache size in vertices.
+     * @return The cache statistics.
+     */
+    static VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                               uint32_t cacheSize = CACHE_SIZE) {
+        VertexCacheStats stats;
+        stats.triangleCount = indexCount / 3;
+
+        // A vertex is cached if fewer than cacheSize misses happened since it was inserted
+        std::vector<size_t> insertedAt(vertexCount, SIZE_MAX);
+        for (size_t i = 0; i < indexCount; ++i) {
+            uint32_t index = indices[i];
+            if (insertedAt[index] == SIZE_MAX) {
+                stats.vertexCount++;
+            }
+            if (insertedAt[index] == SIZE_MAX || stats.verticesTransformed - insertedAt[index] >= cacheSize) {
+                insertedAt[index] = stats.verticesTransformed++;
+            }
+        }
+
+        stats.acmr = stats.triangleCount > 0 ? static_cast<float>(stats.verticesTransformed) / static_cast<float>(stats.triangleCount) : 0.0f;
+        stats.atvr = stats.vertexCount > 0 ? static_cast<float>(stats.verticesTransformed) / static_cast<float>(stats.vertexCount) : 0.0f;
+        return stats;
+    }
+
+    /**
+     * @brief Build a remap table that welds bitwise-identical vertices.
+     *
+     * New indices are assigned in order of first use, so remapping also orders
+     * the vertex buffer for fetch locality. Unreferenced vertices map to UINT32_MAX.
+     *
+     * @param remap Receives the remap table (one entry per source vertex).
+     * @param indices The index buffer, or nullptr for a non-indexed triangle list.
+     * @param indexCount The number of indices (the number of vertices if non-indexed).
+     * @param vertices The vertex data.
+     * @param vertexCount The number of vertices.
+     * @param vertexStride The size of one vertex in bytes.
+     * @return The number of unique vertices.
+     */
+    static size_t GenerateVertexRemap(std::vector<uint32_t>& remap, const uint32_t* indices, size_t indexCount,
+                                      const void* vertices, size_t vertexCount, size_t vertexStride) {
+        remap.assign(vertexCount, UINT32_MAX);
+        const auto* bytes = static_cast<const unsigned char*>(vertices);
+
+        // Open addressing with linear probing; holds the first source vertex of every unique vertex
+        size_t capacity = 1;
+        while (capacity < vertexCount + vertexCount / 2) {
+            capacity *= 2;
+        }
+        std::vector<uint32_t> table(capacity, UINT32_MAX);
+
+        size_t uniqueCount = 0;
+        for (size_t i = 0; i < indexCount; ++i) {
+            uint32_t index = indices ? indices[i] : static_cast<uint32_t>(i);
+            if (remap[index] != UINT32_MAX) {
+                continue;
+            }
+
+            const unsigned char* vertex = bytes + index * vertexStride;
+            size_t bucket = HashBytes(vertex, vertexStride) & (capacity - 1);
+            while (table[bucket] != UINT32_MAX &&
+                   std::memcmp(bytes + table[bucket] * vertexStride, vertex, vertexStride) != 0) {
+                bucket = (bucket + 1) & (capacity - 1);
+            }
+
+            if (table[bucket] == UINT32_MAX) {
+                table[bucket] = index;
+                remap[index] = static_cast<uint32_t>(uniqueCount++);
+            } else {
+                remap[index] = remap[table[bucket]];
+            }
+        }
+        return uniqueCount;
+    }
+
+    /**
+     * @brief Build a remap table that orders vertices by first use (no welding).
+     * @param remap Receives the remap table; unreferenced vertices map to UINT32_MAX.
+     * @param indices The index buffer.
+     * @param indexCount The number of indices.
+     * @param vertexCount The number of vertices.
+     * @return The number of referenced vertices.
+     */
+    static size_t GenerateVertexFetchRemap(std::vector<uint32_t>& remap, const uint32_t* indices, size_t indexCount,
+                                           size_t vertexCount) {
+        remap.assign(vertexCount, UINT32_MAX);
+        size_t nextVertex = 0;
+        for (size_t i = 0; i < indexCount; ++i) {
+            if (remap[indices[i]] == UINT32_MAX) {
+                remap[indices[i]] = static_cast<uint32_t>(nextVertex++);
+            }
+        }
+        return nextVertex;
+    }
+
+    /**
+     * @brief Reorder a vertex buffer with a remap table (dropping unmapped vertices).
+     * @param vertices The vertex buffer to remap in place.
+     * @param remap The remap table.
+     * @param uniqueCount The number of unique vertices the table maps to.
+     */
+    template <typename VertexType>
+    static void RemapVertexBuffer(std::vector<VertexType>& vertices, const std::vector<uint32_t>& remap, size_t uniqueCount) {
+        static_assert(std::is_trivially_copyable_v<VertexType>, "MeshOptimizer requires trivially copyable vertices");
+        std::vector<VertexType> remapped(uniqueCount);
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            if (remap[i] != UINT32_MAX) {
+                remapped[remap[i]] = vertices[i];
+            }
+        }
+        vertices = std::move(remapped);
+    }
+
+    /**
+     * @brief Reorder vertices by first use in the index buffer and drop unreferenced ones.
+     * @param vertices The vertex buffer, reordered in place.
+     * @param indices The index buffer, remapped in place.
+     */
+    template <typename VertexType>
+    static void OptimizeVertexFetch(std::vector<VertexType>& vertices, std::vector<uint32_t>& indices) {
+        std::vector<uint32_t> remap;
+        size_t uniqueCount = GenerateVertexFetchRemap(remap, indices.data(), indices.size(), vertices.size());
+        RemapIndexBuffer(indices.data(), indices.data(), indices.size(), remap);
+        RemapVertexBuffer(vertices, remap, uniqueCount);
+    }
+
+    /**
+     * @brief Remap an index buffer.
+     * @param destination Receives indexCount remapped indices (may alias indices).
+     * @param indices The index buffer, or nullptr for a non-indexed triangle list.
+     * @param indexCount The number of indices.
+     * @param remap The remap table.
+     */
+    static void RemapIndexBuffer(uint32_t* destination, const uint32_t* indices, size_t indexCount, const std::vector<uint32_t>& remap) {
+        for (size_t i = 0; i < indexCount; ++i) {
+            destination[i] = remap[indices ? indices[i] : i];
+        }
+    }
+
+    /**
+     * @brief Reorder triangles for the post-transform vertex cache (Tipsify).
+     *
+     * Fans around the most recently used vertices and only jumps elsewhere at
+     * dead ends; those jumps split the output into clusters that can be
+     * reordered freely without hurting the cache much (see OptimizeOverdraw).
+     *
+     * @param destination Receives the reordered indices (must not alias indices).
+     * @param indices The index buffer.
+     * @param indexCount The number of indices.
+     * @param vertexCount The number of vertices.
+     * @param clusters Optional; receives the first triangle of every cluster.
+     * @param cacheSize The cache size to optimize for.
+     */
+    static void OptimizeVertexCache(uint32_t* destination, const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                    std::vector<uint32_t>* clusters = nullptr, uint32_t cacheSize = CACHE_SIZE) {
+        size_t triangleCount = indexCount / 3;
+        if (clusters) {
+            clusters->clear();
+        }
+        if (triangleCount == 0) {
+            return;
+        }
+
+        // Vertex -> triangle adjacency (CSR layout)
+        std::vector<uint32_t> liveTriangles(vertexCount, 0);
+        for (size_t i = 0; i < indexCount; ++i) {
+            liveTriangles[indices[i]]++;
+        }
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+        }
+        std::vector<uint32_t> adjacency(indexCount);
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+            }
+        }
+
+        std::vector<uint32_t> cacheTime(vertexCount, 0);
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<uint32_t> deadEndStack;
+        deadEndStack.reserve(indexCount);
+        std::vector<uint32_t> candidates;
+
+        uint32_t timestamp = cacheSize + 1;
+        size_t cursor = 0;          // Next vertex to consider when the dead-end stack runs dry
+        size_t outputTriangles = 0;
+        int64_t fanningVertex = 0;
+        // Start on the first referenced vertex
+        while (fanningVertex < static_cast<int64_t>(vertexCount) && liveTriangles[fanningVertex] == 0) {
+            fanningVertex++;
+        }
+        if (clusters) {
+            clusters->push_back(0);
+        }
+
+        while (fanningVertex >= 0 && fanningVertex < static_cast<int64_t>(vertexCount)) {
+            candidates.clear();
+
+            // Emit every remaining triangle around the fanning vertex
+            for (uint32_t a = adjacencyOffsets[fanningVertex]; a < adjacencyOffsets[fanningVertex + 1]; ++a) {
+                uint32_t triangle = adjacency[a];
+                if (emitted[triangle]) {
+                    continue;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t v = indices[triangle * 3 + k];
+                    destination[outputTriangles * 3 + k] = v;
+                    deadEndStack.push_back(v);
+                    candidates.push_back(v);
+                    liveTriangles[v]--;
+                    if (timestamp - cacheTime[v] > cacheSize) {
+                        cacheTime[v] = timestamp++;
+                    }
+                }
+                emitted[triangle] = true;
+                outputTriangles++;
+            }
+
+            // Pick the candidate that will still be in the cache after its remaining triangles are emitted
+            int64_t nextVertex = -1;
+            int64_t bestPriority = -1;
+            for (uint32_t v : candidates) {
+                if (liveTriangles[v] == 0) {
+                    continue;
+                }
+                int64_t priority = 0;
+                if (timestamp - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize) {
+                    priority = timestamp - cacheTime[v];
+                }
+                if (priority > bestPriority) {
+                    bestPriority = priority;
+                    nextVertex = v;
+                }
+            }
+
+            if (nextVertex == -1) {
+                // Dead end: resume from recently used vertices, then from the input order
+                while (!deadEndStack.empty() && nextVertex == -1) {
+                    uint32_t v = deadEndStack.back();
+                    deadEndStack.pop_back();
+                    if (liveTriangles[v] > 0) {
+                        nextVertex = v;
+                    }
+                }
+                while (nextVertex == -1 && cursor < vertexCount) {
+                    if (liveTriangles[cursor] > 0) {
+                        nextVertex = static_cast<int64_t>(cursor);
+                    }
+                    cursor++;
+                }
+                if (clusters && nextVertex != -1 && outputTriangles < triangleCount) {
+                    clusters->push_back(static_cast<uint32_t>(outputTriangles));
+                }
+            }
+            fanningVertex = nextVertex;
+        }
+    }
+
+    /**
+     * @brief Reorder triangle clusters to reduce overdraw (Sander et al. 2007).
+     *
+     * Hard clusters from OptimizeVertexCache are split further wherever the cache
+     * miss ratio of the cluster so far, starting from a cold cache, is within
+     * threshold of the hard cluster's. Clusters are then sorted so those facing
+     * away from the mesh center (likely occluders) are drawn first.
+     *
+     * @param destination Receives the reordered indices (must not alias indices).
+     * @param indices The cache-optimized index buffer.
+     * @param indexCount The number of indices.
+     * @param vertices The vertex data.
+     * @param vertexCount The number of vertices.
+     * @param vertexStride The size of one vertex in bytes.
+     * @param positionOffset The byte offset of the float3 position within a vertex.
+     * @param clusters The hard cluster boundaries from OptimizeVertexCache.
+     * @param threshold The allowed ACMR degradation of split clusters (e.g., 1.05).
+     * @param cacheSize The cache size used for splitting.
+     */
+    static void OptimizeOverdraw(uint32_t* destination, const uint32_t* indices, size_t indexCount,
+                                 const void* vertices, size_t vertexCount, size_t vertexStride, size_t positionOffset,
+                                 const std::vector<uint32_t>& clusters, float threshold, uint32_t cacheSize = CACHE_SIZE) {
+        size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0) {
+            return;
+        }
+        const auto* bytes = static_cast<const unsigned char*>(vertices);
+        auto position = [&](uint32_t index, float out[3]) {
+            std::memcpy(out, bytes + index * vertexStride + positionOffset, 3 * sizeof(float));
+        };
+
+        // Soft boundaries inside the hard clusters. Misses are counted globally; a vertex
+        // inserted before the current (sub-)cluster started counts as a miss, which
+        // simulates a cold cache without clearing anything.
+        std::vector<uint32_t> softClusters;
+        std::vector<size_t> insertedAt(vertexCount, SIZE_MAX);
+        size_t misses = 0;
+        auto transform = [&](uint32_t index, size_t coldSince) {
+            size_t inserted = insertedAt[index];
+            if (inserted == SIZE_MAX || inserted < coldSince || misses - inserted >= cacheSize) {
+                insertedAt[index] = misses++;
+            }
+        };
+        for (size_t c = 0; c < clusters.size(); ++c) {
+            size_t begin = clusters[c];
+            size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+
+            // Cluster ACMR as it was emitted, i.e., with the cache warmed up by the previous cluster
+            size_t clusterStart = misses;
+            for (size_t i = begin * 3; i < end * 3; ++i) {
+                transform(indices[i], 0);
+            }
+            float clusterAcmr = static_cast<float>(misses - clusterStart) / static_cast<float>(end - begin);
+
+            softClusters.push_back(static_cast<uint32_t>(begin));
+            size_t start = begin;
+            size_t startMisses = misses;
+            for (size_t t = begin; t < end; ++t) {
+                for (int k = 0; k < 3; ++k) {
+                    transform(indices[t * 3 + k], startMisses);
+                }
+                // Split once this sub-cluster is efficient enough on its own
+                if (t + 1 < end && t > start &&
+                    static_cast<float>(misses - startMisses) / static_cast<float>(t + 1 - start) <= threshold * clusterAcmr) {
+                    softClusters.push_back(static_cast<uint32_t>(t + 1));
+                    start = t + 1;
+                    startMisses = misses;
+                }
+            }
+        }
+
+        // Mesh centroid
+        float meshCenter[3] = {0.0f, 0.0f, 0.0f};
+        for (size_t i = 0; i < indexCount; ++i) {
+            float p[3];
+            position(indices[i], p);
+            for (int k = 0; k < 3; ++k) meshCenter[k] += p[k];
+        }
+        for (float& component : meshCenter) component /= static_cast<float>(indexCount);
+
+        // Sort key: how much the cluster faces away from the mesh center
+        std::vector<float> sortKey(softClusters.size());
+        for (size_t c = 0; c < softClusters.size(); ++c) {
+            size_t begin = softClusters[c];
+            size_t end = c + 1 < softClusters.size() ? softClusters[c + 1] : triangleCount;
+
+            float center[3] = {0.0f, 0.0f, 0.0f};
+            float normal[3] = {0.0f, 0.0f, 0.0f};
+            float totalArea = 0.0f;
+            for (size_t t = begin; t < end; ++t) {
+                float p0[3], p1[3], p2[3];
+                position(indices[t * 3 + 0], p0);
+                position(indices[t * 3 + 1], p1);
+                position(indices[t * 3 + 2], p2);
+                float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                // Cross product length is twice the area, so area weighting is implicit
+                float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+                float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                for (int k = 0; k < 3; ++k) {
+                    center[k] += (p0[k] + p1[k] + p2[k]) * (area / 3.0f);
+                    normal[k] += n[k];
+                }
+                totalArea += area;
+            }
+
+            float normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            if (totalArea <= 0.0f || normalLength <= 0.0f) {
+                sortKey[c] = 0.0f;
+                continue;
+            }
+            float key = 0.0f;
+            for (int k = 0; k < 3; ++k) {
+                key += (center[k] / totalArea - meshCenter[k]) * (normal[k] / normalLength);
+            }
+            sortKey[c] = key;
+        }
+
+        std::vector<uint32_t> order(softClusters.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKey[a] > sortKey[b]; });
+
+        size_t output = 0;
+        for (uint32_t c : order) {
+            size_t begin = softClusters[c];
+            size_t end = c + 1 < softClusters.size() ? softClusters[c + 1] : triangleCount;
+            std::memcpy(destination + output, indices + begin * 3, (end - begin) * 3 * sizeof(uint32_t));
+            output += (end - begin) * 3;
+        }
+    }
+
+    /**
+     * @brief Run the full optimization pipeline on an indexed or non-indexed mesh.
+     *
+     * If indices is empty, vertices are treated as a triangle list and an index
+     * buffer is generated by welding.
+     *
+     * @param vertices The vertex buffer, optimized in place.
+     * @param indices The index buffer, optimized in place.
+     * @param positionOffset The byte offset of the float3 position within VertexType.
+     * @param overdrawThreshold The allowed ACMR degradation for overdraw ordering (1.0 disables it).
+     * @return The optimization statistics.
+     */
+    template <typename VertexType>
+    static MeshOptimizationStats OptimizeMesh(std::vector<VertexType>& vertices, std::vector<uint32_t>& indices,
+                                              size_t positionOffset, float overdrawThreshold = 1.05f) {
+        static_assert(std::is_trivially_copyable_v<VertexType>, "MeshOptimizer requires trivially copyable vertices");
+        MeshOptimizationStats stats;
+        stats.verticesBefore = vertices.size();
+
+        const bool indexed = !indices.empty();
+        size_t indexCount = indexed ? indices.size() : vertices.size();
+        indexCount -= indexCount % 3;
+        if (indexCount == 0) {
+            stats.verticesAfter = vertices.size();
+            return stats;
+        }
+
+        if (indexed) {
+            stats.cacheBefore = AnalyzeVertexCache(indices.data(), indexCount, vertices.size());
+        } else {
+            // Every corner of a non-indexed mesh is transformed
+            stats.cacheBefore.triangleCount = indexCount / 3;
+            stats.cacheBefore.vertexCount = indexCount;
+            stats.cacheBefore.verticesTransformed = indexCount;
+            stats.cacheBefore.acmr = 3.0f;
+            stats.cacheBefore.atvr = 1.0f;
+        }
+
+        // 1. Weld
+        std::vector<uint32_t> remap;
+        size_t uniqueCount = GenerateVertexRemap(remap, indexed ? indices.data() : nullptr, indexCount,
+                                                 vertices.data(), vertices.size(), sizeof(VertexType));
+        std::vector<uint32_t> welded(indexCount);
+        RemapIndexBuffer(welded.data(), indexed ? indices.data() : nullptr, indexCount, remap);
+        RemapVertexBuffer(vertices, remap, uniqueCount);
+
+        // 2. Vertex cache
+        std::vector<uint32_t> clusters;
+        std::vector<uint32_t> cacheOptimized(indexCount);
+        OptimizeVertexCache(cacheOptimized.data(), welded.data(), indexCount, vertices.size(), &clusters);
+
+        // 3. Overdraw. Splitting keeps each cluster within the threshold, but the cold cache at
+        //    the start of every reordered cluster adds a little on top, so the result is only
+        //    rejected if the overall ACMR degrades by more than twice the allowed margin.
+        if (overdrawThreshold > 1.0f && clusters.size() > 1) {
+            std::vector<uint32_t> overdrawOptimized(indexCount);
+            OptimizeOverdraw(overdrawOptimized.data(), cacheOptimized.data(), indexCount, vertices.data(), vertices.size(),
+                             sizeof(VertexType), positionOffset, clusters, overdrawThreshold);
+            float cacheAcmr = AnalyzeVertexCache(cacheOptimized.data(), indexCount, vertices.size()).acmr;
+            float overdrawAcmr = AnalyzeVertexCache(overdrawOptimized.data(), indexCount, vertices.size()).acmr;
+            if (overdrawAcmr <= cacheAcmr * (2.0f * overdrawThreshold - 1.0f)) {
+                cacheOptimized.swap(overdrawOptimized);
+                stats.overdrawOrdered = true;
+            }
+        }
+
+        // 4. Vertex fetch
+        indices = std::move(cacheOptimized);
+        OptimizeVertexFetch(vertices, indices);
+
+        stats.verticesAfter = vertices.size();
+        stats.cacheAfter = AnalyzeVertexCache(indices.data(), indices.size(), vertices.size());
+        return stats;
+    }
+
+    /**
+     * @brief Split a mesh into meshlets and make each meshlet's triangles contiguous.
+     *
+     * Meshlets grow greedily from the first unused triangle in index order, preferring
+     * adjacent triangles that add the fewest new vertices and then those whose normals
+     * agree best with the meshlet (tighter cones cull better). Run it after
+     * OptimizeMesh so the seeds follow the cache-optimized order, and follow it with
+     * OptimizeVertexFetch since triangles move.
+     *
+     * @param indices The index buffer, reordered in place.
+     * @param vertices The vertex data.
+     * @param vertexCount The number of vertices.
+     * @param vertexStride The size of one vertex in bytes.
+     * @param positionOffset The byte offset of the float3 position within a vertex.
+     * @param maxVertices The vertex limit per meshlet.
+     * @param maxTriangles The triangle limit per meshlet.
+     * @return The meshlets in index buffer order.
+     */
+    static std::vector<Meshlet> BuildMeshlets(std::vector<uint32_t>& indices, const void* vertices, size_t vertexCount,
+                                              size_t vertexStride, size_t positionOffset,
+                                              uint32_t maxVertices = MAX_MESHLET_VERTICES,
+                                              uint32_t maxTriangles = MAX_MESHLET_TRIANGLES) {
+        std::vector<Meshlet> meshlets;
+        size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0 || maxVertices < 3 || maxTriangles == 0) {
+            return meshlets;
+        }
+        const auto* bytes = static_cast<const unsigned char*>(vertices);
+        auto position = [&](uint32_t index, float out[3]) {
+            std::memcpy(out, bytes + index * vertexStride + positionOffset, 3 * sizeof(float));
+        };
+
+        // Unit face normals (zero for degenerate triangles)
+        std::vector<float> normals(triangleCount * 3);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            float p0[3], p1[3], p2[3];
+            position(indices[t * 3 + 0], p0);
+            position(indices[t * 3 + 1], p1);
+            position(indices[t * 3 + 2], p2);
+            float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (int k = 0; k < 3; ++k) {
+                normals[t * 3 + k] = length > 0.0f ? n[k] / length : 0.0f;
+            }
+        }
+
+        // Vertex -> triangle adjacency (CSR layout)
+        std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+        for (uint32_t index : indices) {
+            adjacencyOffsets[index + 1]++;
+        }
+        for (size_t v = 0; v < vertexCount; ++v) {
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        }
+        std::vector<uint32_t> adjacency(indices.size());
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+            }
+        }
+
+        std::vector<bool> emitted(triangleCount, false);
+        std::vector<uint32_t> vertexMeshlet(vertexCount, UINT32_MAX); // Meshlet that last took each vertex
+        std::vector<uint32_t> reordered;
+        reordered.reserve(indices.size());
+        std::vector<uint32_t> meshletVertices;
+        size_t seedCursor = 0;
+
+        auto newVertexCount = [&](uint32_t triangle, uint32_t meshletId) {
+            uint32_t count = 0;
+            for (int k = 0; k < 3; ++k) {
+                count += vertexMeshlet[indices[triangle * 3 + k]] != meshletId ? 1 : 0;
+            }
+            return count;
+        };
+
+        while (true) {
+            while (seedCursor < triangleCount && emitted[seedCursor]) {
+                seedCursor++;
+            }
+            if (seedCursor == triangleCount) {
+                break;
+            }
+
+            auto meshletId = static_cast<uint32_t>(meshlets.size());
+            Meshlet& meshlet = meshlets.emplace_back();
+            meshlet.firstIndex = static_cast<uint32_t>(reordered.size());
+            meshletVertices.clear();
+            float normalSum[3] = {0.0f, 0.0f, 0.0f};
+            uint32_t meshletTriangles = 0;
+
+            auto addTriangle = [&](uint32_t triangle) {
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t index = indices[triangle * 3 + k];
+                    if (vertexMeshlet[index] != meshletId) {
+                        vertexMeshlet[index] = meshletId;
+                        meshletVertices.push_back(index);
+                    }
+                    reordered.push_back(index);
+                }
+                for (int k = 0; k < 3; ++k) {
+                    normalSum[k] += normals[triangle * 3 + k];
+                }
+                emitted[triangle] = true;
+                meshletTriangles++;
+            };
+
+            // Best unused triangle around the given vertices that still fits
+            auto findCandidate = [&](const uint32_t* candidateVertices, size_t count) -> int64_t {
+                int64_t best = -1;
+                uint32_t bestNew = UINT32_MAX;
+                float bestAlignment = -2.0f;
+                for (size_t i = 0; i < count; ++i) {
+                    uint32_t v = candidateVertices[i];
+                    for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; ++a) {
+                        uint32_t triangle = adjacency[a];
+                        if (emitted[triangle]) {
+                            continue;
+                        }
+                        uint32_t added = newVertexCount(triangle, meshletId);
+                        if (meshletVertices.size() + added > maxVertices) {
+                            continue;
+                        }
+                        float alignment = normalSum[0] * normals[triangle * 3] + normalSum[1] * normals[triangle * 3 + 1] +
+                                          normalSum[2] * normals[triangle * 3 + 2];
+                        if (added < bestNew || (added == bestNew && alignment > bestAlignment)) {
+                            best = triangle;
+                            bestNew = added;
+                            bestAlignment = alignment;
+                        }
+                    }
+                }
+                return best;
+            };
+
+            uint32_t lastTriangle = static_cast<uint32_t>(seedCursor);
+            addTriangle(lastTriangle);
+            while (meshletTriangles < maxTriangles) {
+                // Cheap search around the last triangle first, then around the whole meshlet
+                uint32_t lastVertices[3] = {indices[lastTriangle * 3], indices[lastTriangle * 3 + 1], indices[lastTriangle * 3 + 2]};
+                int64_t next = findCandidate(lastVertices, 3);
+                if (next < 0) {
+                    next = findCandidate(meshletVertices.data(), meshletVertices.size());
+                }
+                if (next < 0) {
+                    // Disconnected: continue with the next triangle in index order if it fits
+                    size_t cursor = seedCursor;
+                    while (cursor < triangleCount && emitted[cursor]) {
+                        cursor++;
+                    }
+                    if (cursor == triangleCount ||
+                        meshletVertices.size() + newVertexCount(static_cast<uint32_t>(cursor), meshletId) > maxVertices) {
+                        break;
+                    }
+                    next = static_cast<int64_t>(cursor);
+                }
+                lastTriangle = static_cast<uint32_t>(next);
+                addTriangle(lastTriangle);
+            }
+
+            meshlet.indexCount = meshletTriangles * 3;
+            meshlet.vertexCount = static_cast<uint32_t>(meshletVertices.size());
+            ComputeMeshletBounds(meshlet, reordered.data() + meshlet.firstIndex, meshletVertices, bytes, vertexStride, positionOffset);
+        }
+
+        indices = std::move(reordered);
+        return meshlets;
+    }
+
+    /**
+     * @brief Check whether a meshlet's normal cone faces away from a viewer.
+     * Conservative: true only if every triangle of the meshlet is back-facing.
+     * Not valid for mirrored transforms, which flip the winding.
+     * @param meshlet The meshlet.
+     * @param viewer The viewer position in mesh space.
+     * @return True if the meshlet can be skipped.
+     */
+    static bool IsMeshletBackFacing(const Meshlet& meshlet, const float viewer[3]) {
+        if (meshlet.coneCutoff >= 1.0f) {
+            return false;
+        }
+        float toApex[3] = {meshlet.coneApex[0] - viewer[0], meshlet.coneApex[1] - viewer[1], meshlet.coneApex[2] - viewer[2]};
+        float distance = std::sqrt(toApex[0] * toApex[0] + toApex[1] * toApex[1] + toApex[2] * toApex[2]);
+        if (distance <= 0.0f) {
+            return false;
+        }
+        float alignment = (toApex[0] * meshlet.coneAxis[0] + toApex[1] * meshlet.coneAxis[1] + toApex[2] * meshlet.coneAxis[2]) / distance;
+        return alignment >= meshlet.coneCutoff;
+    }
+
+    /**
+     * @brief Simplify a mesh with quadric error metric half-edge collapses.
+     *
+     * Vertices are collapsed onto neighbours, so the result indexes the original
+     * vertex buffer and can share it with the base mesh. Vertices with the same
+     * position but different attributes (UV or normal seams) are collapsed
+     * together and only along the seam, open borders only collapse along the
+     * border, and non-manifold vertices are locked. Collapses that flip a
+     * triangle are rejected. When normals are given, the normal deviation of a
+     * collapse is added to its cost so shading discontinuities are preserved.
+     *
+     * @param destination Receives the simplified index buffer.
+     * @param indices The index buffer.
+     * @param indexCount The number of indices.
+     * @param vertices The vertex data.
+     * @param vertexCount The number of vertices.
+     * @param vertexStride The size of one vertex in bytes.
+     * @param positionOffset The byte offset of the float3 position within a vertex.
+     * @param targetIndexCount Stop once the index count drops to this.
+     * @param targetError Maximum collapse error relative to the mesh extent.
+     * @param normalOffset The byte offset of the float3 normal, or SIZE_MAX to ignore normals.
+     * @param normalWeight The relative error charged for a normal deviation of 1 (90 degrees).
+     * @return The errors of the simplification.
+     */
+    static SimplificationResult SimplifyMesh(std::vector<uint32_t>& destination, const uint32_t* indices, size_t indexCount,
+                                             const void* vertices, size_t vertexCount, size_t vertexStride, size_t positionOffset,
+                                             size_t targetIndexCount, float targetError,
+                                             size_t normalOffset = SIZE_MAX, float normalWeight = LOD_NORMAL_WEIGHT) {
+        SimplificationResult result;
+        destination.assign(indices, indices + indexCount - indexCount % 3);
+        if (destination.size() <= targetIndexCount || vertexCount == 0) {
+            return result;
+        }
+        const auto* bytes = static_cast<const unsigned char*>(vertices);
+
+        // Positions normalized to the unit cube so errors are relative to the extent
+        std::vector<float> positions(vertexCount * 3);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            std::memcpy(&positions[v * 3], bytes + v * vertexStride + positionOffset, 3 * sizeof(float));
+        }
+        float minBounds[3] = {INFINITY, INFINITY, INFINITY};
+        float maxBounds[3] = {-INFINITY, -INFINITY, -INFINITY};
+        for (uint32_t index : destination) {
+            for (int k = 0; k < 3; ++k) {
+                minBounds[k] = std::min(minBounds[k], positions[index * 3 + k]);
+                maxBounds[k] = std::max(maxBounds[k], positions[index * 3 + k]);
+            }
+        }
+        float extent = std::max({maxBounds[0] - minBounds[0], maxBounds[1] - minBounds[1], maxBounds[2] - minBounds[2]});
+        if (!(extent > 0.0f)) {
+            return result;
+        }
+
+        // Vertices sharing a position form a ring of wedges with one representative
+        std::vector<uint32_t> positionIds;
+        size_t positionCount = GenerateVertexRemap(positionIds, nullptr, vertexCount, positions.data(), vertexCount, 3 * sizeof(float));
+        std::vector<uint32_t> firstWedge(positionCount, UINT32_MAX);
+        std::vector<uint32_t> representative(vertexCount);
+        std::vector<uint32_t> nextWedge(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            uint32_t& first = firstWedge[positionIds[v]];
+            if (first == UINT32_MAX) {
+                first = v;
+                nextWedge[v] = v;
+            } else {
+                nextWedge[v] = nextWedge[first];
+                nextWedge[first] = v;
+            }
+            representative[v] = first;
+        }
+        for (size_t v = 0; v < vertexCount; ++v) {
+            for (int k = 0; k < 3; ++k) {
+                positions[v * 3 + k] = (positions[v * 3 + k] - minBounds[k]) / extent;
+            }
+        }
+
+        std::vector<float> normals;
+        if (normalOffset != SIZE_MAX) {
+            normals.resize(vertexCount * 3);
+            for (size_t v = 0; v < vertexCount; ++v) {
+                float* n = &normals[v * 3];
+                std::memcpy(n, bytes + v * vertexStride + normalOffset, 3 * sizeof(float));
+                float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                for (int k = 0; k < 3; ++k) n[k] = length > 0.0f ? n[k] / length : 0.0f;
+            }
+        }
+
+        // Classify representatives from the directed position-space edges: an edge without
+        // its reverse lies on an open border, a repeated edge is non-manifold
+        enum class VertexKind : uint8_t { Manifold, Border, Locked };
+        std::vector<VertexKind> kinds(vertexCount, VertexKind::Manifold);
+        std::vector<uint32_t> borderNext(vertexCount, UINT32_MAX);
+        std::vector<uint32_t> borderPrev(vertexCount, UINT32_MAX);
+        std::vector<Quadric> quadrics(vertexCount);
+        auto edgeKey = [](uint32_t a, uint32_t b) { return (static_cast<uint64_t>(a) << 32) | b; };
+        {
+            std::vector<uint64_t> edges;
+            edges.reserve(destination.size());
+            for (size_t i = 0; i < destination.size(); i += 3) {
+                for (int e = 0; e < 3; ++e) {
+                    uint32_t a = representative[destination[i + e]];
+                    uint32_t b = representative[destination[i + (e + 1) % 3]];
+                    if (a != b) edges.push_back(edgeKey(a, b));
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+
+            std::vector<uint8_t> borderOut(vertexCount, 0);
+            std::vector<uint8_t> borderIn(vertexCount, 0);
+            for (size_t i = 0; i < edges.size(); ++i) {
+                auto a = static_cast<uint32_t>(edges[i] >> 32);
+                auto b = static_cast<uint32_t>(edges[i] & 0xffffffffu);
+                if ((i > 0 && edges[i - 1] == edges[i]) || (i + 1 < edges.size() && edges[i + 1] == edges[i])) {
+                    kinds[a] = kinds[b] = VertexKind::Locked;
+                } else if (!std::binary_search(edges.begin(), edges.end(), edgeKey(b, a))) {
+                    borderOut[a] = static_cast<uint8_t>(std::min(borderOut[a] + 1, 2));
+                    borderIn[b] = static_cast<uint8_t>(std::min(borderIn[b] + 1, 2));
+                    borderNext[a] = b;
+                    borderPrev[b] = a;
+                }
+            }
+            for (size_t v = 0; v < vertexCount; ++v) {
+                if (kinds[v] == VertexKind::Locked || (borderOut[v] == 0 && borderIn[v] == 0)) continue;
+                kinds[v] = (borderOut[v] == 1 && borderIn[v] == 1) ? VertexKind::Border : VertexKind::Locked;
+            }
+        }
+
+        // Area-weighted face planes, plus planes perpendicular to border edges so borders keep their shape
+        constexpr double BORDER_WEIGHT = 10.0;
+        for (size_t i = 0; i < destination.size(); i += 3) {
+            uint32_t corners[3] = {representative[destination[i]], representative[destination[i + 1]], representative[destination[i + 2]]};
+            const float* p0 = &positions[corners[0] * 3];
+            const float* p1 = &positions[corners[1] * 3];
+            const float* p2 = &positions[corners[2] * 3];
+            double normal[3];
+            double area = TriangleNormal(p0, p1, p2, normal);
+            if (area <= 0.0) continue;
+            Quadric face = Quadric::FromPlane(normal, p0, area);
+            for (uint32_t corner : corners) quadrics[corner] += face;
+
+            for (int e = 0; e < 3; ++e) {
+                uint32_t a = corners[e];
+                uint32_t b = corners[(e + 1) % 3];
+                if (borderNext[a] != b || kinds[a] == VertexKind::Manifold) continue;
+                const float* pa = &positions[a * 3];
+                const float* pb = &positions[b * 3];
+                double edge[3] = {pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2]};
+                double lengthSquared = edge[0] * edge[0] + edge[1] * edge[1] + edge[2] * edge[2];
+                double perpendicular[3] = {edge[1] * normal[2] - edge[2] * normal[1],
+                                           edge[2] * normal[0] - edge[0] * normal[2],
+                                           edge[0] * normal[1] - edge[1] * normal[0]};
+                double length = std::sqrt(perpendicular[0] * perpendicular[0] + perpendicular[1] * perpendicular[1] + perpendicular[2] * perpendicular[2]);
+                if (length <= 0.0) continue;
+                for (double& component : perpendicular) component /= length;
+                Quadric border = Quadric::FromPlane(perpendicular, pa, lengthSquared * BORDER_WEIGHT);
+                quadrics[a] += border;
+                quadrics[b] += border;
+            }
+        }
+
+        size_t targetTriangles = targetIndexCount / 3;
+        std::vector<uint32_t> triangleOffsets(vertexCount + 1);
+        std::vector<uint32_t> vertexTriangles;
+        std::vector<uint32_t> remap(vertexCount);
+        std::vector<uint8_t> passLocked(vertexCount);
+        std::vector<std::pair<uint32_t, uint32_t>> wedgeTargets;
+        struct Collapse {
+            float cost;
+            uint32_t from;
+            uint32_t to;
+        };
+        std::vector<Collapse> collapses;
+
+        while (destination.size() / 3 > targetTriangles) {
+            size_t triangleCount = destination.size() / 3;
+
+            // Representative -> triangle adjacency (CSR layout)
+            std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+            for (uint32_t index : destination) {
+                triangleOffsets[representative[index] + 1]++;
+            }
+            for (size_t v = 0; v < vertexCount; ++v) {
+                triangleOffsets[v + 1] += triangleOffsets[v];
+            }
+            vertexTriangles.resize(destination.size());
+            {
+                std::vector<uint32_t> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+                for (size_t t = 0; t < triangleCount; ++t) {
+                    for (int k = 0; k < 3; ++k) {
+                        vertexTriangles[cursor[representative[destination[t * 3 + k]]]++] = static_cast<uint32_t>(t);
+                    }
+                }
+            }
+
+            // Rank every allowed collapse by the quadric error of moving its source onto its target
+            auto collapseCost = [&](uint32_t from, uint32_t to) {
+                if (kinds[from] == VertexKind::Locked) return INFINITY;
+                if (kinds[from] == VertexKind::Border && borderNext[from] != to && borderPrev[from] != to) return INFINITY;
+                return static_cast<float>(std::sqrt(quadrics[from].Evaluate(&positions[to * 3])));
+            };
+            collapses.clear();
+            for (size_t i = 0; i < destination.size(); i += 3) {
+                for (int e = 0; e < 3; ++e) {
+                    uint32_t a = representative[destination[i + e]];
+                    uint32_t b = representative[destination[i + (e + 1) % 3]];
+                    if (a >= b) continue; // Interior edges appear in both directions; consider each once
+                    float costAB = collapseCost(a, b);
+                    float costBA = collapseCost(b, a);
+                    float cost = std::min(costAB, costBA);
+                    if (cost <= targetError) {
+                        collapses.push_back(costAB <= costBA ? Collapse{costAB, a, b} : Collapse{costBA, b, a});
+                    }
+                }
+            }
+            if (collapses.empty()) {
+                break;
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& lhs, const Collapse& rhs) { return lhs.cost < rhs.cost; });
+
+            // Apply the cheapest collapses with disjoint one-rings, so every check below sees
+            // the triangles as they were at the start of the pass
+            for (uint32_t v = 0; v < vertexCount; ++v) remap[v] = v;
+            std::fill(passLocked.begin(), passLocked.end(), 0);
+            size_t removedTriangles = 0;
+            size_t passCollapses = 0;
+            for (const Collapse& collapse : collapses) {
+                if (triangleCount - removedTriangles <= targetTriangles) break;
+                uint32_t from = collapse.from;
+                uint32_t to = collapse.to;
+                if (passLocked[from] || passLocked[to]) continue;
+
+                // A border vertex must not close a three-vertex border loop
+                if (kinds[from] == VertexKind::Border && borderNext[borderNext[from]] == borderPrev[from]) continue;
+
+                // Every wedge of the source must have a unique wedge of the target next to it
+                wedgeTargets.clear();
+                bool valid = true;
+                size_t collapsedTriangles = 0;
+                for (uint32_t t = triangleOffsets[from]; t < triangleOffsets[from + 1] && valid; ++t) {
+                    const uint32_t* triangle = &destination[vertexTriangles[t] * 3];
+                    uint32_t wedge = UINT32_MAX;
+                    uint32_t target = UINT32_MAX;
+                    for (int k = 0; k < 3; ++k) {
+                        if (representative[triangle[k]] == from) wedge = triangle[k];
+                        if (representative[triangle[k]] == to) target = triangle[k];
+                    }
+                    if (target == UINT32_MAX) {
+                        // The triangle survives; it must not flip
+                        valid = !TriangleFlips(triangle, wedge, &positions[to * 3], positions);
+                        continue;
+                    }
+                    collapsedTriangles++;
+                    auto it = std::find_if(wedgeTargets.begin(), wedgeTargets.end(), [&](const auto& entry) { return entry.first == wedge; });
+                    if (it == wedgeTargets.end()) {
+                        wedgeTargets.emplace_back(wedge, target);
+                    } else if (it->second != target) {
+                        valid = false;
+                    }
+                }
+                for (uint32_t wedge = from; valid; ) {
+                    bool referenced = false;
+                    bool mapped = false;
+                    for (uint32_t t = triangleOffsets[from]; t < triangleOffsets[from + 1] && !referenced; ++t) {
+                        const uint32_t* triangle = &destination[vertexTriangles[t] * 3];
+                        referenced = triangle[0] == wedge || triangle[1] == wedge || triangle[2] == wedge;
+                    }
+                    for (const auto& entry : wedgeTargets) mapped = mapped || entry.first == wedge;
+                    valid = !referenced || mapped;
+                    wedge = nextWedge[wedge];
+                    if (wedge == from) break;
+                }
+                if (!valid || collapsedTriangles == 0) continue;
+
+                // Normal deviation between the wedges and the attributes they inherit
+                float cost = collapse.cost;
+                float normalError = 0.0f;
+                if (!normals.empty()) {
+                    for (const auto& [wedge, target] : wedgeTargets) {
+                        const float* n0 = &normals[wedge * 3];
+                        const float* n1 = &normals[target * 3];
+                        normalError = std::max(normalError, 1.0f - (n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2]));
+                    }
+                    cost += normalWeight * normalError;
+                    if (cost > targetError) continue;
+                }
+
+                for (const auto& [wedge, target] : wedgeTargets) {
+                    remap[wedge] = target;
+                }
+                quadrics[to] += quadrics[from];
+                if (kinds[from] == VertexKind::Border) {
+                    if (borderNext[from] == to) {
+                        borderPrev[to] = borderPrev[from];
+                        borderNext[borderPrev[from]] = to;
+                    } else {
+                        borderNext[to] = borderNext[from];
+                        borderPrev[borderNext[from]] = to;
+                    }
+                }
+
+                // Lock the one-ring of the source: its triangles change
+                for (uint32_t t = triangleOffsets[from]; t < triangleOffsets[from + 1]; ++t) {
+                    const uint32_t* triangle = &destination[vertexTriangles[t] * 3];
+                    for (int k = 0; k < 3; ++k) passLocked[representative[triangle[k]]] = 1;
+                }
+                removedTriangles += collapsedTriangles;
+                passCollapses++;
+                result.relativeError = std::max(result.relativeError, cost);
+                result.normalError = std::max(result.normalError, normalError);
+            }
+            if (passCollapses == 0) {
+                break;
+            }
+            result.collapses += passCollapses;
+
+            // Remap and drop the triangles that collapsed
+            size_t writeIndex = 0;
+            for (size_t i = 0; i < destination.size(); i += 3) {
+                uint32_t a = remap[destination[i]];
+                uint32_t b = remap[destination[i + 1]];
+                uint32_t c = remap[destination[i + 2]];
+                uint32_t ra = representative[a];
+                uint32_t rb = representative[b];
+                uint32_t rc = representative[c];
+                if (ra == rb || rb == rc || ra == rc) continue;
+                destination[writeIndex++] = a;
+                destination[writeIndex++] = b;
+                destination[writeIndex++] = c;
+            }
+            destination.resize(writeIndex);
+        }
+
+        result.error = result.relativeError * extent;
+        return result;
+    }
+
+    /**
+     * @brief Build a chain of coarser index buffers sharing the base mesh's vertices.
+     *
+     * Each level simplifies the previous one to half its triangles within
+     * LOD_TARGET_ERROR and is reordered for the vertex cache. The chain stops
+     * at MAX_LOD_COUNT levels or once a level no longer shrinks meaningfully.
+     * Errors accumulate along the chain, so each level's error bounds its
+     * distance from the base mesh.
+     *
+     * @param vertices The vertex buffer.
+     * @param indices The base index buffer.
+     * @param lodIndices Receives the index buffers of the coarser levels, back to back.
+     * @param positionOffset The byte offset of the float3 position within a vertex.
+     * @param normalOffset The byte offset of the float3 normal, or SIZE_MAX to ignore normals.
+     * @param stats Optional; receives the LOD counters.
+     * @return The levels, starting with the base mesh. Ranges of coarser levels start
+     *         after the base indices, as if lodIndices were appended to indices.
+     */
+    template <typename VertexType>
+    static std::vector<MeshLod> BuildLodChain(const std::vector<VertexType>& vertices, const std::vector<uint32_t>& indices,
+                                              std::vector<uint32_t>& lodIndices, size_t positionOffset,
+                                              size_t normalOffset = SIZE_MAX, MeshOptimizationStats* stats = nullptr) {
+        static_assert(std::is_trivially_copyable_v<VertexType>, "MeshOptimizer requires trivially copyable vertices");
+        std::vector<MeshLod> lods;
+        lodIndices.clear();
+        if (indices.empty()) {
+            return lods;
+        }
+        lods.push_back({0, static_cast<uint32_t>(indices.size()), 0.0f});
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uint32_t> source = indices;
+        std::vector<uint32_t> simplified;
+        float accumulatedError = 0.0f;
+        float accumulatedRelativeError = 0.0f;
+        while (lods.size() < MAX_LOD_COUNT) {
+            size_t target = source.size() / 6 * 3;
+            SimplificationResult result = SimplifyMesh(simplified, source.data(), source.size(), vertices.data(), vertices.size(),
+                                                       sizeof(VertexType), positionOffset, target, LOD_TARGET_ERROR, normalOffset);
+            if (stats) {
+                stats->lodSourceTriangles += source.size() / 3;
+                stats->maxLodNormalError = std::max(stats->maxLodNormalError, result.normalError);
+            }
+            if (simplified.empty() || static_cast<float>(simplified.size()) > LOD_MIN_REDUCTION * static_cast<float>(source.size())) {
+                break;
+            }
+            accumulatedError += result.error;
+            accumulatedRelativeError += result.relativeError;
+
+            source.resize(simplified.size());
+            OptimizeVertexCache(source.data(), simplified.data(), simplified.size(), vertices.size());
+            lods.push_back({static_cast<uint32_t>(indices.size() + lodIndices.size()), static_cast<uint32_t>(source.size()), accumulatedError});
+            lodIndices.insert(lodIndices.end(), source.begin(), source.end());
+        }
+
+        if (stats) {
+            stats->lodCount += lods.size() - 1;
+            stats->lodMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            stats->maxLodRelativeError = std::max(stats->maxLodRelativeError, accumulatedRelativeError);
+        }
+        return lods;
+    }
+
+private:
+    // Bounding sphere and normal cone of one meshlet
+    static void ComputeMeshletBounds(Meshlet& meshlet, const uint32_t* meshletIndices, const std::vector<uint32_t>& meshletVertices,
+                                     const unsigned char* bytes, size_t vertexStride, size_t positionOffset) {
+        auto position = [&](uint32_t index, float out[3]) {
+            std::memcpy(out, bytes + index * vertexStride + positionOffset, 3 * sizeof(float));
+        };
+
+        // Sphere around the AABB center
+        float minBounds[3] = {INFINITY, INFINITY, INFINITY};
+        float maxBounds[3] = {-INFINITY, -INFINITY, -INFINITY};
+        for (uint32_t index : meshletVertices) {
+            float p[3];
+            position(index, p);
+            for (int k = 0; k < 3; ++k) {
+                minBounds[k] = std::min(minBounds[k], p[k]);
+                maxBounds[k] = std::max(maxBounds[k], p[k]);
+            }
+        }
+        for (int k = 0; k < 3; ++k) {
+            meshlet.center[k] = 0.5f * (minBounds[k] + maxBounds[k]);
+        }
+        float radiusSquared = 0.0f;
+        for (uint32_t index : meshletVertices) {
+            float p[3];
+            position(index, p);
+            float d[3] = {p[0] - meshlet.center[0], p[1] - meshlet.center[1], p[2] - meshlet.center[2]};
+            radiusSquared = std::max(radiusSquared, d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        }
+        meshlet.radius = std::sqrt(radiusSquared);
+
+        // Normal cone: average of the unit face normals, widened to the least aligned face
+        uint32_t triangleCount = meshlet.indexCount / 3;
+        std::vector<float> faceNormals(triangleCount * 3, 0.0f);
+        std::vector<bool> degenerate(triangleCount, false);
+        float axis[3] = {0.0f, 0.0f, 0.0f};
+        for (uint32_t t = 0; t < triangleCount; ++t) {
+            float p0[3], p1[3], p2[3];
+            position(meshletIndices[t * 3 + 0], p0);
+            position(meshletIndices[t * 3 + 1], p1);
+            position(meshletIndices[t * 3 + 2], p2);
+            float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length <= 0.0f) {
+                degenerate[t] = true;
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) {
+                faceNormals[t * 3 + k] = n[k] / length;
+                axis[k] += n[k] / length;
+            }
+        }
+
+        meshlet.coneAxis[0] = meshlet.coneAxis[1] = meshlet.coneAxis[2] = 0.0f;
+        meshlet.coneApex[0] = meshlet.center[0];
+        meshlet.coneApex[1] = meshlet.center[1];
+        meshlet.coneApex[2] = meshlet.center[2];
+        meshlet.coneCutoff = 1.0f;
+
+        float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        if (axisLength <= 0.0f) {
+            return;
+        }
+        for (float& component : axis) component /= axisLength;
+
+        float minDot = 1.0f;
+        for (uint32_t t = 0; t < triangleCount; ++t) {
+            if (degenerate[t]) continue;
+            float d = axis[0] * faceNormals[t * 3] + axis[1] * faceNormals[t * 3 + 1] + axis[2] * faceNormals[t * 3 + 2];
+            minDot = std::min(minDot, d);
+        }
+        if (minDot <= 0.0f) {
+            // Faces point in opposite directions: the meshlet can never be entirely back-facing
+            return;
+        }
+
+        // Move the apex back along the axis until it is behind every face plane
+        float maxT = 0.0f;
+        for (uint32_t t = 0; t < triangleCount; ++t) {
+            if (degenerate[t]) continue;
+            float p0[3];
+            position(meshletIndices[t * 3], p0);
+            const float* n = &faceNormals[t * 3];
+            float dc = (meshlet.center[0] - p0[0]) * n[0] + (meshlet.center[1] - p0[1]) * n[1] + (meshlet.center[2] - p0[2]) * n[2];
+            float dn = axis[0] * n[0] + axis[1] * n[1] + axis[2] * n[2];
+            maxT = std::max(maxT, dc / dn);
+        }
+
+        for (int k = 0; k < 3; ++k) {
+            meshlet.coneAxis[k] = axis[k];
+            meshlet.coneApex[k] = meshlet.center[k] - axis[k] * maxT;
+        }
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+
+    // Symmetric 4x4 plane quadric (Garland and Heckbert), accumulated in double precision
+    struct Quadric {
+        double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+        double b0 = 0.0, b1 = 0.0, b2 = 0.0, c = 0.0;
+        double weight = 0.0;
+
+        static Quadric FromPlane(const double normal[3], const float point[3], double weight) {
+            double d = -(normal[0] * point[0] + normal[1] * point[1] + normal[2] * point[2]);
+            Quadric q;
+            q.a00 = normal[0] * normal[0] * weight;
+            q.a11 = normal[1] * normal[1] * weight;
+            q.a22 = normal[2] * normal[2] * weight;
+            q.a01 = normal[0] * normal[1] * weight;
+            q.a02 = normal[0] * normal[2] * weight;
+            q.a12 = normal[1] * normal[2] * weight;
+            q.b0 = normal[0] * d * weight;
+            q.b1 = normal[1] * d * weight;
+            q.b2 = normal[2] * d * weight;
+            q.c = d * d * weight;
+            q.weight = weight;
+            return q;
+        }
+
+        Quadric& operator+=(const Quadric& other) {
+            a00 += other.a00; a11 += other.a11; a22 += other.a22;
+            a01 += other.a01; a02 += other.a02; a12 += other.a12;
+            b0 += other.b0; b1 += other.b1; b2 += other.b2;
+            c += other.c;
+            weight += other.weight;
+            return *this;
+        }
+
+        // Weighted mean squared distance of a point to the accumulated planes
+        double Evaluate(const float p[3]) const {
+            double x = p[0], y = p[1], z = p[2];
+            double r = a00 * x * x + a11 * y * y + a22 * z * z
+                     + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                     + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return weight > 0.0 ? std::abs(r) / weight : 0.0;
+        }
+    };
+
+    // Unit normal of a triangle; returns twice its area (0 if degenerate)
+    static double TriangleNormal(const float p0[3], const float p1[3], const float p2[3], double normal[3]) {
+        double e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+        double e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+        normal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+        normal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+        normal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+        double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (length <= 0.0) {
+            return 0.0;
+        }
+        for (int k = 0; k < 3; ++k) normal[k] /= length;
+        return length;
+    }
+
+    // True if moving one corner of a triangle to a new position flips or degenerates the triangle
+    static bool TriangleFlips(const uint32_t* triangle, uint32_t corner, const float* newPosition, const std::vector<float>& positions) {
+        const float* before[3];
+        const float* after[3];
+        for (int k = 0; k < 3; ++k) {
+            before[k] = &positions[triangle[k] * 3];
+            after[k] = triangle[k] == corner ? newPosition : before[k];
+        }
+        double n0[3], n1[3];
+        if (TriangleNormal(before[0], before[1], before[2], n0) <= 0.0) {
+            return false;
+        }
+        if (TriangleNormal(after[0], after[1], after[2], n1) <= 0.0) {
+            return true;
+        }
+        return n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2] <= 0.0;
+    }
+
+    // 32-bit words mixed with the MurmurHash2 step, tail bytes folded in at the end
+    static size_t HashBytes(const unsigned char* data, size_t size) {
+        constexpr uint32_t m = 0x5bd1e995;
+        uint32_t h = static_cast<uint32_t>(size);
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            uint32_t k;
+            std::memcpy(&k, data + i, sizeof(k));
+            k *= m;
+            k ^= k >> 24;
+            k *= m;
+            h = (h * m) ^ k;
+        }
+        for (; i < size; ++i) {
+            h = (h ^ data[i]) * m;
+        }
+        h ^= h >> 13;
+        h *= m;
+        h ^= h >> 15;
+        return h;
+    }
+};
@@ -1,6 +1,9 @@
 #include "model_loader.h"
 #include "renderer.h"
 #include "mesh_component.h"
+#include "mesh_cache.h"
+#include "profiler.h"
+#include <chrono>
 #include <iostream>
 #include <filesystem>
 #include <set>
@@ -65,6 +68,150 @@ static void setTSpaceBasic(const SMikkTSpaceContext* pContext, const float fvTan
     vert.tangent.w = (fSign >= 0.0f) ? 1.0f : -1.0f;
 }
 
+// Outcome of tangent processing for one primitive, reported after the parallel mesh stage
+enum class TangentSource {
+    Gltf,
+    MikkTSpace,
+    MikkTSpaceFailed,
+    Default
+};
+
+// Decode one glTF primitive into an empty MaterialMesh. Runs on geometry worker threads:
+// it only reads the tinygltf model and writes to the given mesh, so primitives can be
+// processed concurrently. Returns false if the primitive has no POSITION attribute.
+static bool BuildPrimitiveGeometry(const tinygltf::Model& gltfModel, const tinygltf::Primitive& primitive,
+                                   MaterialMesh& materialMesh, TangentSource& tangentSource) {
+    PROFILE_SCOPE("ModelLoader::BuildPrimitiveGeometry");
+
+    // Get the position accessor, which defines the vertex count.
+    auto posIt = primitive.attributes.find("POSITION");
+    if (posIt == primitive.attributes.end()) return false;
+    const tinygltf::Accessor& posAccessor = gltfModel.accessors[posIt->second];
+
+    // Decode indices straight into the presized index array
+    if (primitive.indices >= 0) {
+        const tinygltf::Accessor& indexAccessor = gltfModel.accessors[primitive.indices];
+        const tinygltf::BufferView& indexBufferView = gltfModel.bufferViews[indexAccessor.bufferView];
+        const tinygltf::Buffer& indexBuffer = gltfModel.buffers[indexBufferView.buffer];
+        const void* indexData = &indexBuffer.data[indexBufferView.byteOffset + indexAccessor.byteOffset];
+        if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
+            const auto* buf = static_cast<const uint16_t*>(indexData);
+            materialMesh.indices.assign(buf, buf + indexAccessor.count);
+        } else if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) {
+            const auto* buf = static_cast<const uint32_t*>(indexData);
+            materialMesh.indices.assign(buf, buf + indexAccessor.count);
+        }
+    }
+
+    // Get data pointers and strides for all available attributes ONCE before the loop.
+    const tinygltf::BufferView& posBufferView = gltfModel.bufferViews[posAccessor.bufferView];
+    const tinygltf::Buffer& buffer = gltfModel.buffers[posBufferView.buffer];
+    const unsigned char* pPositions = &buffer.data[posBufferView.byteOffset + posAccessor.byteOffset];
+    const size_t posByteStride = posBufferView.byteStride == 0 ? sizeof(glm::vec3) : posBufferView.byteStride;
+
+    const unsigned char* pNormals = nullptr;
+    size_t normalByteStride = 0;
+    auto normalIt = primitive.attributes.find("NORMAL");
+    if (normalIt != primitive.attributes.end()) {
+        const tinygltf::Accessor& normalAccessor = gltfModel.accessors[normalIt->second];
+        const tinygltf::BufferView& normalBufferView = gltfModel.bufferViews[normalAccessor.bufferView];
+        pNormals = &gltfModel.buffers[normalBufferView.buffer].data[normalBufferView.byteOffset + normalAccessor.byteOffset];
+        normalByteStride = normalBufferView.byteStride == 0 ? sizeof(glm::vec3) : normalBufferView.byteStride;
+    }
+
+    const unsigned char* pTexCoords = nullptr;
+    size_t texCoordByteStride = 0;
+    auto texCoordIt = primitive.attributes.find("TEXCOORD_0");
+    if (texCoordIt != primitive.attributes.end()) {
+        const tinygltf::Accessor& texCoordAccessor = gltfModel.accessors[texCoordIt->second];
+        const tinygltf::BufferView& texCoordBufferView = gltfModel.bufferViews[texCoordAccessor.bufferView];
+        pTexCoords = &gltfModel.buffers[texCoordBufferView.buffer].data[texCoordBufferView.byteOffset + texCoordAccessor.byteOffset];
+        texCoordByteStride = texCoordBufferView.byteStride == 0 ? sizeof(glm::vec2) : texCoordBufferView.byteStride;
+    }
+
+    const unsigned char* pTangents = nullptr;
+    size_t tangentByteStride = 0;
+    auto tangentIt = primitive.attributes.find("TANGENT");
+    bool hasTangents = (tangentIt != primitive.attributes.end());
+    if (hasTangents) {
+        const tinygltf::Accessor& tangentAccessor = gltfModel.accessors[tangentIt->second];
+        const tinygltf::BufferView& tangentBufferView = gltfModel.bufferViews[tangentAccessor.bufferView];
+        pTangents = &gltfModel.buffers[tangentBufferView.buffer].data[tangentBufferView.byteOffset + tangentAccessor.byteOffset];
+        tangentByteStride = tangentBufferView.byteStride == 0 ? sizeof(glm::vec4) : tangentBufferView.byteStride;
+    }
+
+    materialMesh.vertices.resize(posAccessor.count);
+
+    // Use a SINGLE, SAFE loop to load all vertex data.
+    for (size_t i = 0; i < posAccessor.count; ++i) {
+        auto& [position, normal, texCoord, tangent] = materialMesh.vertices[i];
+
+        position = *reinterpret_cast<const glm::vec3*>(pPositions + i * posByteStride);
+
+        if (pNormals) {
+            normal = *reinterpret_cast<const glm::vec3*>(pNormals + i * normalByteStride);
+        } else {
+            normal = glm::vec3(0.0f, 0.0f, 1.0f);
+        }
+        // Normalize normals to ensure consistent magnitude
+        if (glm::dot(normal, normal) > 0.0f) {
+            normal = glm::normalize(normal);
+        } else {
+            normal = glm::vec3(0.0f, 0.0f, 1.0f);
+        }
+
+        if (pTexCoords) {
+            texCoord = *reinterpret_cast<const glm::vec2*>(pTexCoords + i * texCoordByteStride);
+        } else {
+            texCoord = glm::vec2(0.0f, 0.0f);
+        }
+
+        if (hasTangents && pTangents) {
+            // Load glTF tangent and ensure it is normalized and orthogonal to the normal.
+            glm::vec4 t4 = *reinterpret_cast<const glm::vec4*>(pTangents + i * tangentByteStride);
+            glm::vec3 T = glm::vec3(t4);
+            // Normalize tangent and make it orthogonal to normal to avoid skewed TBN
+            if (glm::dot(T, T) > 0.0f) {
+                T = glm::normalize(T);
+                T = glm::normalize(T - normal * glm::dot(normal, T));
+            } else {
+                T = glm::vec3(1.0f, 0.0f, 0.0f);
+            }
+            float w = (t4.w >= 0.0f) ? 1.0f : -1.0f; // clamp handedness to +/-1
+            tangent = glm::vec4(T, w);
+        } else {
+            // No tangents in source: use a safe default tangent (T=+X, handedness=+1)
+            tangent = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
+        }
+    }
+
+    // AFTER the mesh is fully built, generate tangents via MikkTSpace ONLY if the source mesh lacks glTF tangents.
+    if (hasTangents) {
+        tangentSource = TangentSource::Gltf;
+    } else if (pNormals && pTexCoords && !materialMesh.indices.empty()) {
+        MikkTSpaceInterface mikkInterface;
+        mikkInterface.vertices = &materialMesh.vertices;
+        mikkInterface.indices = &materialMesh.indices;
+
+        SMikkTSpaceInterface sm_interface{};
+        sm_interface.m_getNumFaces = getNumFaces;
+        sm_interface.m_getNumVerticesOfFace = getNumVerticesOfFace;
+        sm_interface.m_getPosition = getPosition;
+        sm_interface.m_getNormal = getNormal;
+        sm_interface.m_getTexCoord = getTexCoord;
+        sm_interface.m_setTSpaceBasic = setTSpaceBasic;
+
+        SMikkTSpaceContext mikk_context{};
+        mikk_context.m_pInterface = &sm_interface;
+        mikk_context.m_pUserData = &mikkInterface;
+
+        tangentSource = genTangSpaceDefault(&mikk_context) ? TangentSource::MikkTSpace : TangentSource::MikkTSpaceFailed;
+    } else {
+        tangentSource = TangentSource::Default;
+    }
+    return true;
+}
+
 // KTX2 decoding for GLTF images
 #include <ktx.h>
 
@@ -115,23 +262,64 @@ bool ModelLoader::Initialize(Renderer* _renderer) {
         return false;
     }
 
+    // Dedicated workers for geometry extraction so mesh jobs do not queue behind the
+    // texture decodes that the material pass schedules on the renderer's pool
+    if (!geometryPool) {
+        geometryThreadCount = std::max(1u, std::thread::hardware_concurrency());
+        geometryPool = std::make_unique<ThreadPool>(geometryThreadCount);
+    }
+
     return true;
 }
 
-Model* ModelLoader::LoadGLTF(const std::string& filename) {
+Model* ModelLoader::LoadGLTF(const std::string& filename, const MeshReadyCallback& onMeshReady) {
     // Check if the model is already loaded
     auto it = models.find(filename);
     if (it != models.end()) {
+        EmitMaterialMeshes(filename, onMeshReady);
         return it->second.get();
     }
 
     // Create a new model
     auto model = std::make_unique<Model>(filename);
+    auto loadStart = std::chrono::steady_clock::now();
+
+    // Prefer the preprocessed mesh cache; fall back to a full parse on any mismatch
+    uint64_t sourceHash = 0;
+    bool cacheUsable = meshCacheEnabled && MeshCache::ComputeSourceHash(filename, sourceHash);
+    if (!meshOptimizationEnabled) {
+        // Unoptimized geometry must not be served from (or overwrite) the optimized cache silently
+        sourceHash = ~sourceHash;
+    }
+    bool fromCache = cacheUsable && LoadFromMeshCache(filename, sourceHash, model.get());
+
+    if (!fromCache) {
+        textureRequests.clear();
+        textureRequestsCacheable = true;
 
-    // Parse the GLTF file
-    if (!ParseGLTF(filename, model.get())) {
-        std::cerr << "ModelLoader::LoadGLTF: Failed to parse GLTF file: " << filename << std::endl;
-        return nullptr;
+        // Parse the GLTF file
+        if (!ParseGLTF(filename, model.get(), onMeshReady)) {
+            std::cerr << "ModelLoader::LoadGLTF: Failed to parse GLTF file: " << filename << std::endl;
+            return nullptr;
+        }
+    }
+
+    ModelLoadStats stats;
+    stats.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+    stats.fromMeshCache = fromCache;
+    stats.meshStageMs = fromCache ? 0.0 : lastMeshStageMs;
+    if (!fromCache) {
+        stats.meshOptimization = lastMeshOptimizationStats;
+    }
+    loadStats[filename] = stats;
+    std::cout << "Loaded " << filename << " in " << stats.loadMs << " ms ("
+              << (fromCache ? "mesh cache" : "parsed glTF") << ")" << std::endl;
+
+    if (fromCache) {
+        // Nothing is left to decode; hand the meshes out in file order
+        EmitMaterialMeshes(filename, onMeshReady);
+    } else if (cacheUsable) {
+        WriteMeshCache(filename, sourceHash, model.get());
     }
 
     // Store the model
@@ -141,6 +329,158 @@ Model* ModelLoader::LoadGLTF(const std::string& filename) {
 }
 
 
+bool ModelLoader::LoadFromMeshCache(const std::string& filename, uint64_t sourceHash, Model* model) {
+    MeshCacheContents contents;
+    if (!MeshCache::Read(MeshCache::GetCachePath(filename), sourceHash, contents)) {
+        return false;
+    }
+
+    hasEmissiveStrengthExtension = contents.hasEmissiveStrengthExtension;
+    light_scale = contents.lightScale;
+
+    for (auto& material : contents.materials) {
+        std::string name = material->GetName();
+        materials[name] = std::move(material);
+    }
+
+    // Replay the texture requests of the original parse. A texture referenced under several
+    // IDs is loaded once, as critical if any of its uses was critical.
+    std::unordered_map<std::string, bool> fileCritical;
+    for (const auto& texture : contents.textures) {
+        if (texture.aliasId.empty()) {
+            fileCritical[texture.filePath] = fileCritical[texture.filePath] || texture.critical;
+        }
+    }
+    for (const auto& texture : contents.textures) {
+        if (!texture.aliasId.empty()) {
+            renderer->RegisterTextureAlias(texture.aliasId, texture.filePath);
+            continue;
+        }
+        auto it = fileCritical.find(texture.filePath);
+        if (it != fileCritical.end()) {
+            renderer->LoadTextureAsync(texture.filePath, it->second);
+            fileCritical.erase(it);
+        }
+    }
+
+    model->cameras = std::move(contents.cameras);
+    extractedLights[filename] = std::move(contents.lights);
+    SetCombinedMeshData(model, contents.materialMeshes);
+    materialMeshes[filename] = std::move(contents.materialMeshes);
+    return true;
+}
+
+void ModelLoader::WriteMeshCache(const std::string& filename, uint64_t sourceHash, const Model* model) {
+    if (!textureRequestsCacheable) {
+        std::cout << "Not writing mesh cache for " << filename << ": it uses textures without a file URI" << std::endl;
+        return;
+    }
+
+    MeshCacheContents contents;
+    contents.hasEmissiveStrengthExtension = hasEmissiveStrengthExtension;
+    contents.lightScale = light_scale;
+    contents.cameras = model->GetCameras();
+    contents.textures = textureRequests;
+
+    // Borrow the meshes instead of copying the (potentially very large) vertex arrays
+    auto meshIt = materialMeshes.find(filename);
+    if (meshIt != materialMeshes.end()) {
+        contents.materialMeshes = std::move(meshIt->second);
+    }
+    auto lightIt = extractedLights.find(filename);
+    if (lightIt != extractedLights.end()) {
+        contents.lights = lightIt->second;
+    }
+
+    // Only materials referenced by the model's meshes are looked up later
+    std::set<std::string> materialNames;
+    for (const auto& mesh : contents.materialMeshes) {
+        materialNames.insert(mesh.materialName);
+    }
+    for (const auto& name : materialNames) {
+        auto materialIt = materials.find(name);
+        if (materialIt != materials.end() && materialIt->second) {
+            contents.materials.push_back(std::make_unique<Material>(*materialIt->second));
+        }
+    }
+
+    MeshCache::Write(MeshCache::GetCachePath(filename), sourceHash, contents);
+
+    if (meshIt != materialMeshes.end()) {
+        meshIt->second = std::move(contents.materialMeshes);
+    }
+}
+
+void ModelLoader::SetCombinedMeshData(Model* model, const std::vector<MaterialMesh>& meshes) {
+    std::vector<Vertex> combinedVertices;
+    std::vector<uint32_t> combinedIndices;
+
+    for (const auto& materialMesh : meshes) {
+        // Add to combined mesh for backward compatibility (keep vertices in an original coordinate system)
+        if (!materialMesh.instances.empty()) {
+            size_t vertexOffset = combinedVertices.size();
+
+            // Don't transform vertices - keep them in the original coordinate system
+            // Instance transforms should be handled by the instancing system, not applied to vertex data
+            const std::vector<Vertex>& vertices = materialMesh.GetVertices();
+            combinedVertices.insert(combinedVertices.end(), vertices.begin(), vertices.end());
+
+            for (uint32_t index : materialMesh.GetIndices()) {
+                combinedIndices.push_back(index + static_cast<uint32_t>(vertexOffset));
+            }
+        }
+    }
+
+    model->SetVertices(combinedVertices);
+    model->SetIndices(combinedIndices);
+}
+
+void ModelLoader::ScheduleImageUpload(const std::string& textureId, const tinygltf::Image& image,
+                                      const std::string& baseTexturePath, bool critical) {
+    if (image.image.empty() && !image.uri.empty()) {
+        // Left undecoded by the parser: the renderer's texture workers decode the file
+        std::string filePath = baseTexturePath + image.uri;
+        if (textureId != filePath) {
+            RegisterTextureAlias(textureId, filePath);
+        }
+        ScheduleTextureFile(filePath, critical);
+        return;
+    }
+    renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component, critical);
+    RecordImageTexture(textureId, image, baseTexturePath, critical);
+}
+
+void ModelLoader::RecordImageTexture(const std::string& textureId, const tinygltf::Image& image,
+                                     const std::string& baseTexturePath, bool critical) {
+    if (image.uri.empty()) {
+        // Image bytes live inside the glTF/glb buffers; a cached load would have to parse them anyway
+        textureRequestsCacheable = false;
+        return;
+    }
+
+    // On a warm load the renderer decodes the same file on its worker threads
+    std::string filePath = baseTexturePath + image.uri;
+    if (textureId != filePath) {
+        textureRequests.push_back({textureId, filePath, false});
+    }
+    textureRequests.push_back({std::string(), filePath, critical});
+}
+
+void ModelLoader::ScheduleTextureFile(const std::string& filePath, bool critical) {
+    renderer->LoadTextureAsync(filePath, critical);
+    textureRequests.push_back({std::string(), filePath, critical});
+}
+
+void ModelLoader::RegisterTextureAlias(const std::string& aliasId, const std::string& filePath) {
+    renderer->RegisterTextureAlias(aliasId, filePath);
+    textureRequests.push_back({aliasId, filePath, false});
+}
+
+ModelLoadStats ModelLoader::GetLoadStats(const std::string& modelName) const {
+    auto it = loadStats.find(modelName);
+    return it != loadStats.end() ? it->second : ModelLoadStats{};
+}
+
 Model* ModelLoader::GetModel(const std::string& name) {
     auto it = models.find(name);
     if (it != models.end()) {
@@ -150,7 +490,7 @@ Model* ModelLoader::GetModel(const std::string& name) {
 }
 
 
-bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
+bool ModelLoader::ParseGLTF(const std::string& filename, Model* model, const MeshReadyCallback& onMeshReady) {
     std::cout << "Parsing GLTF file: " << filename << std::endl;
 
     // Extract the directory path from the model file to use as a base path for textures
@@ -172,6 +512,12 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
     loader.SetImageLoader([](tinygltf::Image* image, const int image_idx, std::string* err,
                             std::string* warn, int req_width, int req_height,
                             const unsigned char* bytes, int size, void* user_data) -> bool {
+        // External files (tinygltf sets the URI only for those) are decoded later on the
+        // renderer's texture workers, keeping the transcode out of the parse
+        if (!image->uri.empty()) {
+            return true;
+        }
+
         // Try KTX2 first using libktx
         ktxTexture2* ktxTex = nullptr;
         KTX_error_code result = ktxTexture2_CreateFromMemory(bytes, size, KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &ktxTex);
@@ -403,11 +749,11 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
                             const auto& image = gltfModel.images[imageIndex];
                             std::string textureId = "gltf_baseColor_" + std::to_string(texIndex);
                             if (!image.image.empty()) {
-                                renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
+                                ScheduleImageUpload(textureId, image, baseTexturePath);
                                 material->albedoTexturePath = textureId;
                             } else if (!image.uri.empty()) {
                                 std::string filePath = baseTexturePath + image.uri;
-                                renderer->LoadTextureAsync(filePath);
+                                ScheduleTextureFile(filePath);
                                 material->albedoTexturePath = filePath;
                             }
                         }
@@ -426,14 +772,14 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
                             const auto& image = gltfModel.images[texture.source];
                             if (!image.image.empty()) {
                                 // Embedded image data (already decoded by tinygltf image loader)
-                                renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component, false);
+                                ScheduleImageUpload(textureId, image, baseTexturePath, false);
                                 material->specGlossTexturePath = textureId;
                                 material->metallicRoughnessTexturePath = textureId; // reuse binding 2
                             } else if (!image.uri.empty()) {
                                 // External KTX2 file: offload libktx decode + upload to renderer worker threads
                                 std::string filePath = baseTexturePath + image.uri;
-                                renderer->RegisterTextureAlias(textureId, filePath);
-                                renderer->LoadTextureAsync(filePath);
+                                RegisterTextureAlias(textureId, filePath);
+                                ScheduleTextureFile(filePath);
                                 material->specGlossTexturePath = textureId;
                                 material->metallicRoughnessTexturePath = textureId; // reuse binding 2
                             }
@@ -471,15 +817,15 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
                     const auto& image = gltfModel.images[imageIndex];
                     std::cout << "    Image data size: " << image.image.size() << ", URI: " << image.uri << std::endl;
                     if (!image.image.empty()) {
-                        // Always use memory-based upload (KTX2 already decoded by SetImageLoader)
-                        renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component, true);
+                        // Embedded image, already decoded by SetImageLoader
+                        ScheduleImageUpload(textureId, image, baseTexturePath, true);
                         material->albedoTexturePath = textureId;
                         std::cout << "    Scheduled base color texture upload from memory: " << textureId << std::endl;
                     } else if (!image.uri.empty()) {
                         // Offload KTX2 file reading/upload to renderer thread pool
                         std::string filePath = baseTexturePath + image.uri;
-                        renderer->RegisterTextureAlias(textureId, filePath);
-                        renderer->LoadTextureAsync(filePath, true);
+                        RegisterTextureAlias(textureId, filePath);
+                        ScheduleTextureFile(filePath, true);
                         material->albedoTexturePath = textureId;
                         std::cout << "    Scheduled base color KTX2 load from file: " << filePath << " (alias for " << textureId << ")" << std::endl;
                     } else {
@@ -501,13 +847,13 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
                     const auto& image = gltfModel.images[texture.source];
                     if (!image.image.empty()) {
                         // Load embedded texture data asynchronously
-                        renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
+                        ScheduleImageUpload(textureId, image, baseTexturePath);
                         std::cout << "    Scheduled embedded metallic-roughness texture upload: " << textureId << std::endl;
                     } else if (!image.uri.empty()) {
                         // Offload KTX2 file reading/upload to renderer thread pool
                         std::string filePath = baseTexturePath + image.uri;
-                        renderer->RegisterTextureAlias(textureId, filePath);
-                        renderer->LoadTextureAsync(filePath);
+                        RegisterTextureAlias(textureId, filePath);
+                        ScheduleTextureFile(filePath);
                         material->metallicRoughnessTexturePath = textureId;
                         std::cout << "    Scheduled metallic-roughness KTX2 load from file: " << filePath << " (alias for " << textureId << ")" << std::endl;
                     } else {
@@ -543,15 +889,15 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
                     // Load texture data (embedded or external)
                     const auto& image = gltfModel.images[imageIndex];
                     if (!image.image.empty()) {
-                        renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
+                        ScheduleImageUpload(textureId, image, baseTexturePath);
                         material->normalTexturePath = textureId;
                         std::cout << "    Scheduled normal texture upload from memory: " << textureId
                                   << " (" << image.width << "x" << image.height << ")" << std::endl;
                     } else if (!image.uri.empty()) {
                         // Offload KTX2 file reading/upload to renderer thread pool
                         std::string filePath = baseTexturePath + image.uri;
-                        renderer->RegisterTextureAlias(textureId, filePath);
-                        renderer->LoadTextureAsync(filePath);
+                        RegisterTextureAlias(textureId, filePath);
+                        ScheduleTextureFile(filePath);
                         material->normalTexturePath = textureId;
                         std::cout << "    Scheduled normal KTX2 load from file: " << filePath << " (alias for " << textureId << ")" << std::endl;
                     } else {
@@ -573,14 +919,14 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
                     const auto& image = gltfModel.images[texture.source];
                     if (!image.image.empty()) {
                         // Schedule embedded texture upload
-                        renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
+                        ScheduleImageUpload(textureId, image, baseTexturePath);
                         std::cout << "    Scheduled embedded occlusion texture upload: " << textureId
                                   << " (" << image.width << "x" << image.height << ")" << std::endl;
                     } else if (!image.uri.empty()) {
                         // Offload KTX2 file reading/upload to renderer thread pool
                         std::string filePath = baseTexturePath + image.uri;
-                        renderer->RegisterTextureAlias(textureId, filePath);
-                        renderer->LoadTextureAsync(filePath);
+                        RegisterTextureAlias(textureId, filePath);
+                        ScheduleTextureFile(filePath);
                         material->occlusionTexturePath = textureId;
                         std::cout << "    Scheduled occlusion KTX2 load from file: " << filePath << " (alias for " << textureId << ")" << std::endl;
                     } else {
@@ -602,14 +948,14 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
                     const auto& image = gltfModel.images[texture.source];
                     if (!image.image.empty()) {
                         // Schedule embedded texture upload
-                        renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
+                        ScheduleImageUpload(textureId, image, baseTexturePath);
                         std::cout << "    Scheduled embedded emissive texture upload: " << textureId
                                   << " (" << image.width << "x" << image.height << ")" << std::endl;
                     } else if (!image.uri.empty()) {
                         // Offload KTX2 file reading/upload to renderer thread pool
                         std::string filePath = baseTexturePath + image.uri;
-                        renderer->RegisterTextureAlias(textureId, filePath);
-                        renderer->LoadTextureAsync(filePath);
+                        RegisterTextureAlias(textureId, filePath);
+                        ScheduleTextureFile(filePath);
                         material->emissiveTexturePath = textureId;
                         std::cout << "    Scheduled emissive KTX2 load from file: " << filePath << " (alias for " << textureId << ")" << std::endl;
                     } else {
@@ -659,14 +1005,14 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
                             if (!image.uri.empty()) {
                                 texIdOrPath = baseTexturePath + image.uri;
                                 // Schedule async load; libktx decoding will occur on renderer worker threads
-                                renderer->LoadTextureAsync(texIdOrPath, true);
+                                ScheduleTextureFile(texIdOrPath, true);
                                 mat->albedoTexturePath = texIdOrPath;
                                 std::cout << "    Scheduled base color KTX2 file load (KHR_specGloss): " << texIdOrPath << std::endl;
                             }
                             if (mat->albedoTexturePath.empty() && !image.image.empty()) {
                                 // Upload embedded image data (already decoded via our image loader when KTX2)
                                 texIdOrPath = "gltf_baseColor_" + std::to_string(texIndex);
-                                renderer->LoadTextureFromMemoryAsync(texIdOrPath, image.image.data(), image.width, image.height, image.component, true);
+                                ScheduleImageUpload(texIdOrPath, image, baseTexturePath, true);
                                     mat->albedoTexturePath = texIdOrPath;
                                     std::cout << "    Scheduled base color texture upload from memory (KHR_specGloss): " << texIdOrPath << std::endl;
                             }
@@ -706,7 +1052,7 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
                 // Ensure the file exists before attempting to load
                 if (std::filesystem::exists(cand)) {
                     // Schedule async load; libktx decoding will occur on renderer worker threads
-                    renderer->LoadTextureAsync(cand, true);
+                    ScheduleTextureFile(cand, true);
                     mat->albedoTexturePath = cand;
                     std::cout << "    Scheduled derived base color KTX2 load from normal sibling: " << cand << std::endl;
                     break;
@@ -745,13 +1091,13 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
 
             std::string textureId = baseTexturePath + imageUri; // use path string as ID for cache
             if (!image.image.empty()) {
-                renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
+                ScheduleImageUpload(textureId, image, baseTexturePath);
                 mat->albedoTexturePath = textureId;
                 std::cout << "    Scheduled base color upload from memory (by name): " << textureId << std::endl;
                 break;
             } else {
                 // Fallback: offload KTX2 file load to renderer threads
-                renderer->LoadTextureAsync(textureId);
+                ScheduleTextureFile(textureId);
                 mat->albedoTexturePath = textureId;
                 std::cout << "    Scheduled base color KTX2 load from file (by name): " << textureId << std::endl;
                 break;
@@ -934,7 +1280,18 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
         return hash;
     };
 
-    // Process all meshes with improved instancing support
+    // Geometry of each unique MaterialMesh is decoded by exactly one job
+    struct GeometryJob {
+        const tinygltf::Primitive* primitive = nullptr;
+        MaterialMesh* materialMesh = nullptr;
+        TangentSource tangentSource = TangentSource::Default;
+        MeshOptimizationStats optimization;
+        std::future<bool> result;
+    };
+    std::vector<GeometryJob> geometryJobs;
+
+    // Serial pass: assign every primitive to its MaterialMesh and collect instances in
+    // file order, so the result does not depend on how the jobs are scheduled
     for (size_t meshIndex = 0; meshIndex < gltfModel.meshes.size(); ++meshIndex) {
         const auto& mesh = gltfModel.meshes[meshIndex];
 
@@ -950,6 +1307,9 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
 
         // Process each primitive (material group) in this mesh
         for (const auto& primitive : mesh.primitives) {
+            // Primitives without positions have no geometry and are skipped entirely
+            if (!primitive.attributes.contains("POSITION")) continue;
+
             // Get the material index for this primitive
             int materialIndex = primitive.material;
             if (materialIndex < 0) {
@@ -960,9 +1320,10 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
             std::string geometryHash = createGeometryHash(primitive, materialIndex);
 
             // Check if we already have this exact geometry and material combination
-            if (!geometryMaterialMeshMap.contains(geometryHash)) {
+            auto [meshIt, inserted] = geometryMaterialMeshMap.try_emplace(geometryHash);
+            MaterialMesh& materialMesh = meshIt->second;
+            if (inserted) {
                 // Create a new MaterialMesh for this unique geometry and material combination
-                MaterialMesh materialMesh;
                 materialMesh.materialIndex = materialIndex;
 
                 // Set material name
@@ -974,159 +1335,12 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
                     materialMesh.materialName = "no_material";
                 }
 
-                geometryMaterialMeshMap[geometryHash] = materialMesh;
+                // Only the first primitive with this geometry is decoded
+                GeometryJob& job = geometryJobs.emplace_back();
+                job.primitive = &primitive;
+                job.materialMesh = &materialMesh;
             }
 
-            MaterialMesh& materialMesh = geometryMaterialMeshMap[geometryHash];
-
-            // Only process geometry if this MaterialMesh is empty (first time processing this geometry)
-if (materialMesh.vertices.empty()) {
-
-    auto vertexOffsetInMaterialMesh = static_cast<uint32_t>(materialMesh.vertices.size());
-
-    // Get indices for this primitive (your existing code is correct)
-    if (primitive.indices >= 0) {
-        const tinygltf::Accessor& indexAccessor = gltfModel.accessors[primitive.indices];
-        const tinygltf::BufferView& indexBufferView = gltfModel.bufferViews[indexAccessor.bufferView];
-        const tinygltf::Buffer& indexBuffer = gltfModel.buffers[indexBufferView.buffer];
-        const void* indexData = &indexBuffer.data[indexBufferView.byteOffset + indexAccessor.byteOffset];
-        if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
-            const auto* buf = static_cast<const uint16_t*>(indexData);
-            for (size_t i = 0; i < indexAccessor.count; ++i) {
-                materialMesh.indices.push_back(buf[i] + vertexOffsetInMaterialMesh);
-            }
-        } else if (indexAccessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) {
-            const auto* buf = static_cast<const uint32_t*>(indexData);
-            for (size_t i = 0; i < indexAccessor.count; ++i) {
-                materialMesh.indices.push_back(buf[i] + vertexOffsetInMaterialMesh);
-            }
-        }
-    }
-
-    // --- START: FINAL SAFE AND CORRECT VERTEX LOADING ---
-
-    // Get the position accessor, which defines the vertex count.
-    auto posIt = primitive.attributes.find("POSITION");
-    if (posIt == primitive.attributes.end()) continue;
-    const tinygltf::Accessor& posAccessor = gltfModel.accessors[posIt->second];
-
-    // Get data pointers and strides for all available attributes ONCE before the loop.
-    const tinygltf::BufferView& posBufferView = gltfModel.bufferViews[posAccessor.bufferView];
-    const tinygltf::Buffer& buffer = gltfModel.buffers[posBufferView.buffer];
-    const unsigned char* pPositions = &buffer.data[posBufferView.byteOffset + posAccessor.byteOffset];
-    const size_t posByteStride = posBufferView.byteStride == 0 ? sizeof(glm::vec3) : posBufferView.byteStride;
-
-    const unsigned char* pNormals = nullptr;
-    size_t normalByteStride = 0;
-    auto normalIt = primitive.attributes.find("NORMAL");
-    if (normalIt != primitive.attributes.end()) {
-        const tinygltf::Accessor& normalAccessor = gltfModel.accessors[normalIt->second];
-        const tinygltf::BufferView& normalBufferView = gltfModel.bufferViews[normalAccessor.bufferView];
-        pNormals = &gltfModel.buffers[normalBufferView.buffer].data[normalBufferView.byteOffset + normalAccessor.byteOffset];
-        normalByteStride = normalBufferView.byteStride == 0 ? sizeof(glm::vec3) : normalBufferView.byteStride;
-    }
-
-    const unsigned char* pTexCoords = nullptr;
-    size_t texCoordByteStride = 0;
-    auto texCoordIt = primitive.attributes.find("TEXCOORD_0");
-    if (texCoordIt != primitive.attributes.end()) {
-        const tinygltf::Accessor& texCoordAccessor = gltfModel.accessors[texCoordIt->second];
-        const tinygltf::BufferView& texCoordBufferView = gltfModel.bufferViews[texCoordAccessor.bufferView];
-        pTexCoords = &gltfModel.buffers[texCoordBufferView.buffer].data[texCoordBufferView.byteOffset + texCoordAccessor.byteOffset];
-        texCoordByteStride = texCoordBufferView.byteStride == 0 ? sizeof(glm::vec2) : texCoordBufferView.byteStride;
-    }
-
-    const unsigned char* pTangents = nullptr;
-    size_t tangentByteStride = 0;
-    auto tangentIt = primitive.attributes.find("TANGENT");
-    bool hasTangents = (tangentIt != primitive.attributes.end());
-    if (hasTangents) {
-        const tinygltf::Accessor& tangentAccessor = gltfModel.accessors[tangentIt->second];
-        const tinygltf::BufferView& tangentBufferView = gltfModel.bufferViews[tangentAccessor.bufferView];
-        pTangents = &gltfModel.buffers[tangentBufferView.buffer].data[tangentBufferView.byteOffset + tangentAccessor.byteOffset];
-        tangentByteStride = tangentBufferView.byteStride == 0 ? sizeof(glm::vec4) : tangentBufferView.byteStride;
-    }
-
-    // Append vertices for this primitive preserving prior vertices
-    size_t baseVertex = materialMesh.vertices.size();
-    materialMesh.vertices.resize(baseVertex + posAccessor.count);
-
-    // Use a SINGLE, SAFE loop to load all vertex data.
-    for (size_t i = 0; i < posAccessor.count; ++i) {
-        auto& [position, normal, texCoord, tangent] = materialMesh.vertices[baseVertex + i];
-
-        position = *reinterpret_cast<const glm::vec3*>(pPositions + i * posByteStride);
-
-        if (pNormals) {
-            normal = *reinterpret_cast<const glm::vec3*>(pNormals + i * normalByteStride);
-        } else {
-            normal = glm::vec3(0.0f, 0.0f, 1.0f);
-        }
-        // Normalize normals to ensure consistent magnitude
-        if (glm::dot(normal, normal) > 0.0f) {
-            normal = glm::normalize(normal);
-        } else {
-            normal = glm::vec3(0.0f, 0.0f, 1.0f);
-        }
-
-        if (pTexCoords) {
-            texCoord = *reinterpret_cast<const glm::vec2*>(pTexCoords + i * texCoordByteStride);
-        } else {
-            texCoord = glm::vec2(0.0f, 0.0f);
-        }
-
-        if (hasTangents && pTangents) {
-            // Load glTF tangent and ensure it is normalized and orthogonal to the normal.
-            glm::vec4 t4 = *reinterpret_cast<const glm::vec4*>(pTangents + i * tangentByteStride);
-            glm::vec3 T = glm::vec3(t4);
-            // Normalize tangent and make it orthogonal to normal to avoid skewed TBN
-            if (glm::dot(T, T) > 0.0f) {
-                T = glm::normalize(T);
-                T = glm::normalize(T - normal * glm::dot(normal, T));
-            } else {
-                T = glm::vec3(1.0f, 0.0f, 0.0f);
-            }
-            float w = (t4.w >= 0.0f) ? 1.0f : -1.0f; // clamp handedness to +/-1
-            tangent = glm::vec4(T, w);
-        } else {
-            // No tangents in source: use a safe default tangent (T=+X, handedness=+1)
-            tangent = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
-        }
-    }
-
-    // AFTER the mesh is fully built, generate tangents via MikkTSpace ONLY if the source mesh lacks glTF tangents.
-    if (!hasTangents) {
-        if (pNormals && pTexCoords && !materialMesh.indices.empty()) {
-            MikkTSpaceInterface mikkInterface;
-            mikkInterface.vertices = &materialMesh.vertices;
-            mikkInterface.indices = &materialMesh.indices;
-
-            SMikkTSpaceInterface sm_interface{};
-            sm_interface.m_getNumFaces = getNumFaces;
-            sm_interface.m_getNumVerticesOfFace = getNumVerticesOfFace;
-            sm_interface.m_getPosition = getPosition;
-            sm_interface.m_getNormal = getNormal;
-            sm_interface.m_getTexCoord = getTexCoord;
-            sm_interface.m_setTSpaceBasic = setTSpaceBasic;
-
-            SMikkTSpaceContext mikk_context{};
-            mikk_context.m_pInterface = &sm_interface;
-            mikk_context.m_pUserData = &mikkInterface;
-
-            if (genTangSpaceDefault(&mikk_context)) {
-                std::cout << "      Generated tangents (MikkTSpace) for material: " << materialMesh.materialName << std::endl;
-            } else {
-                std::cerr << "      Failed to generate tangents for material: " << materialMesh.materialName << std::endl;
-            }
-        } else {
-            std::cout << "      Skipping tangent generation (missing normals, UVs, or indices) for material: " << materialMesh.materialName << std::endl;
-        }
-    } else {
-        std::cout << "      Using glTF-provided tangents for material: " << materialMesh.materialName << std::endl;
-    }
-    // --- END: FINAL SAFE AND CORRECT VERTEX LOADING ---
-}
-
             // Add all instances to this MaterialMesh (both new and existing geometry)
             for (const glm::mat4& instanceTransform : instances) {
                 materialMesh.AddInstance(instanceTransform, static_cast<uint32_t>(materialIndex));
@@ -1134,18 +1348,8 @@ if (materialMesh.vertices.empty()) {
         }
     }
 
-    // Convert geometry-based material mesh map to vector
-    std::vector<MaterialMesh> modelMaterialMeshes;
-    for (auto& val : geometryMaterialMeshMap | std::views::values) {
-        modelMaterialMeshes.push_back(val);
-    }
-
-    // Process texture loading for each MaterialMesh
-    std::vector<Vertex> combinedVertices;
-    std::vector<uint32_t> combinedIndices;
-
-    // Process texture loading for each MaterialMesh
-    for (auto & materialMesh : modelMaterialMeshes) {
+    // Texture requests of one MaterialMesh; issued as soon as its geometry job completes
+    auto scheduleMeshTextures = [&](MaterialMesh& materialMesh) {
         int materialIndex = materialMesh.materialIndex;
 
         // Get ALL texture paths for this material (same as ParseGLTFDataOnly)
@@ -1179,9 +1383,9 @@ if (materialMesh.vertices.empty()) {
 
                         // Load texture data (embedded or external) with caching
                         const auto& image = gltfModel.images[imageIndex];
-                        if (!image.image.empty()) {
+                        if (!image.image.empty() || !image.uri.empty()) {
                             if (!loadedTextures.contains(textureId)) {
-                                renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component, true);
+                                ScheduleImageUpload(textureId, image, baseTexturePath, true);
                                 loadedTextures.insert(textureId);
                                 std::cout << "      Scheduled baseColor texture upload: " << textureId
                                           << " (" << image.width << "x" << image.height << ")" << std::endl;
@@ -1189,7 +1393,7 @@ if (materialMesh.vertices.empty()) {
                                 std::cout << "      Using cached baseColor texture: " << textureId << std::endl;
                             }
                         } else {
-                            std::cerr << "      Warning: No decoded bytes for baseColor texture index " << texIndex << std::endl;
+                            std::cerr << "      Warning: No image data for baseColor texture index " << texIndex << std::endl;
                         }
                     }
                 }
@@ -1218,13 +1422,13 @@ if (materialMesh.vertices.empty()) {
                             // Use the relative path from the GLTF directory
                             std::string textureId = baseTexturePath + imageUri;
                             if (!image.image.empty()) {
-                                renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
+                                ScheduleImageUpload(textureId, image, baseTexturePath);
                                 materialMesh.baseColorTexturePath = textureId;
                                 materialMesh.texturePath = textureId;
                                 std::cout << "      Scheduled baseColor upload from memory (heuristic): " << textureId << std::endl;
                             } else {
                                 // Fallback: offload KTX2 file load to renderer worker threads
-                                renderer->LoadTextureAsync(textureId, true);
+                                ScheduleTextureFile(textureId, true);
                                 materialMesh.baseColorTexturePath = textureId;
                                 materialMesh.texturePath = textureId;
                                 std::cout << "      Scheduled baseColor KTX2 load from file (heuristic): " << textureId << std::endl;
@@ -1248,14 +1452,14 @@ if (materialMesh.vertices.empty()) {
                         const auto& image = gltfModel.images[texture.source];
                         if (!image.image.empty()) {
                             // Load embedded texture data
-                            renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
+                            ScheduleImageUpload(textureId, image, baseTexturePath);
                             std::cout << "      Scheduled embedded normal texture: " << textureId
                                       << " (" << image.width << "x" << image.height << ")" << std::endl;
                         } else if (!image.uri.empty()) {
                             // Fallback: offload KTX2 normal map load to renderer worker threads
                             std::string filePath = baseTexturePath + image.uri;
-                            renderer->RegisterTextureAlias(textureId, filePath);
-                            renderer->LoadTextureAsync(filePath);
+                            RegisterTextureAlias(textureId, filePath);
+                            ScheduleTextureFile(filePath);
                             materialMesh.normalTexturePath = textureId;
                             std::cout << "    Scheduled normal KTX2 load from file: " << filePath << " (alias for " << textureId << ")" << std::endl;
                         } else {
@@ -1273,13 +1477,9 @@ if (materialMesh.vertices.empty()) {
                             (imageUri.find(materialName) != std::string::npos ||
                              materialName.find(imageUri.substr(0, imageUri.find('_'))) != std::string::npos)) {
                             std::string textureId = baseTexturePath + imageUri;
-                            if (!image.image.empty()) {
-                                renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
-                                materialMesh.normalTexturePath = textureId;
-                                std::cout << "      Scheduled normal upload from memory (heuristic): " << textureId << std::endl;
-                            } else {
-                                std::cerr << "      Warning: Heuristic normal image has no decoded bytes: " << imageUri << std::endl;
-                            }
+                            ScheduleImageUpload(textureId, image, baseTexturePath);
+                            materialMesh.normalTexturePath = textureId;
+                            std::cout << "      Scheduled normal texture (heuristic): " << textureId << std::endl;
                             break;
                         }
                     }
@@ -1297,13 +1497,13 @@ if (materialMesh.vertices.empty()) {
 
                         // Load texture data (embedded or external)
                         const auto& image = gltfModel.images[texture.source];
-                        if (!image.image.empty()) {
-                            renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
+                        if (!image.image.empty() || !image.uri.empty()) {
+                            ScheduleImageUpload(textureId, image, baseTexturePath);
                             materialMesh.metallicRoughnessTexturePath = textureId;
                             std::cout << "      Scheduled metallic-roughness texture upload: " << textureId
                                           << " (" << image.width << "x" << image.height << ")" << std::endl;
                         } else {
-                            std::cerr << "      Warning: No decoded bytes for metallic-roughness texture index " << texIndex << std::endl;
+                            std::cerr << "      Warning: No image data for metallic-roughness texture index " << texIndex << std::endl;
                         }
                     }
                 }
@@ -1338,17 +1538,11 @@ if (materialMesh.vertices.empty()) {
 
                         // Load texture data (embedded or external)
                         const auto& image = gltfModel.images[texture.source];
-                        if (!image.image.empty()) {
-                            if (renderer->LoadTextureFromMemory(textureId, image.image.data(),
-                                                              image.width, image.height, image.component)) {
-                                materialMesh.occlusionTexturePath = textureId;
-                                std::cout << "      Loaded occlusion texture from memory: " << textureId
-                                              << " (" << image.width << "x" << image.height << ")" << std::endl;
-                            } else {
-                                std::cerr << "      Failed to load occlusion texture from memory: " << textureId << std::endl;
-                            }
+                        if (!image.image.empty() || !image.uri.empty()) {
+                            ScheduleImageUpload(textureId, image, baseTexturePath);
+                            std::cout << "      Scheduled occlusion texture: " << textureId << std::endl;
                         } else {
-                            std::cerr << "      Warning: No decoded bytes for occlusion texture index " << texIndex << std::endl;
+                            std::cerr << "      Warning: No image data for occlusion texture index " << texIndex << std::endl;
                         }
                     }
                 }
@@ -1363,13 +1557,9 @@ if (materialMesh.vertices.empty()) {
                             (imageUri.find(materialName) != std::string::npos ||
                              materialName.find(imageUri.substr(0, imageUri.find('_'))) != std::string::npos)) {
                             std::string textureId = baseTexturePath + imageUri;
-                            if (!image.image.empty()) {
-                                renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
-                                materialMesh.occlusionTexturePath = textureId;
-                                std::cout << "      Scheduled occlusion upload from memory (heuristic): " << textureId << std::endl;
-                            } else {
-                                std::cerr << "      Warning: Heuristic occlusion image has no decoded bytes: " << imageUri << std::endl;
-                            }
+                            ScheduleImageUpload(textureId, image, baseTexturePath);
+                            materialMesh.occlusionTexturePath = textureId;
+                            std::cout << "      Scheduled occlusion texture (heuristic): " << textureId << std::endl;
                             break;
                         }
                     }
@@ -1389,7 +1579,7 @@ if (materialMesh.vertices.empty()) {
                         const auto& image = gltfModel.images[texture.source];
                         if (!image.image.empty()) {
                             // Load embedded texture data
-                            renderer->LoadTextureFromMemoryAsync(textureId, image.image.data(), image.width, image.height, image.component);
+                            ScheduleImageUpload(textureId, image, baseTexturePath);
                             std::cout << "      Scheduled embedded emissive texture: " << textureId
                                       << " (" << image.width << "x" << image.height << ")" << std::endl;
                         } else if (!image.uri.empty()) {
@@ -1419,30 +1609,137 @@ if (materialMesh.vertices.empty()) {
                 }
             }
         }
+    };
 
-        // Add to combined mesh for backward compatibility (keep vertices in an original coordinate system)
-        if (!materialMesh.instances.empty()) {
-            size_t vertexOffset = combinedVertices.size();
+    // Parallel pass: decode attributes and generate tangents per unique geometry. Map nodes
+    // are stable and every job owns its MaterialMesh, so no synchronization is needed.
+    {
+        PROFILE_SCOPE("ModelLoader::MeshStage");
+        auto meshStageStart = std::chrono::steady_clock::now();
+        for (auto& job : geometryJobs) {
+            job.result = geometryPool->enqueue([&gltfModel, &job, optimize = meshOptimizationEnabled]() {
+                try {
+                    if (!BuildPrimitiveGeometry(gltfModel, *job.primitive, *job.materialMesh, job.tangentSource)) {
+                        return false;
+                    }
+                    if (optimize) {
+                        // Runs after tangent generation so welding only merges fully identical vertices
+                        PROFILE_SCOPE("ModelLoader::OptimizeMesh");
+                        MaterialMesh& mesh = *job.materialMesh;
+                        job.optimization = MeshOptimizer::OptimizeMesh(mesh.vertices, mesh.indices, offsetof(Vertex, position));
+
+                        // Cluster the optimized triangles for per-meshlet culling
+                        mesh.meshlets = MeshOptimizer::BuildMeshlets(mesh.indices, mesh.vertices.data(), mesh.vertices.size(),
+                                                                     sizeof(Vertex), offsetof(Vertex, position));
+
+                        // Coarser levels index the same vertices, so fetch order covers all of them
+                        mesh.lods = MeshOptimizer::BuildLodChain(mesh.vertices, mesh.indices, mesh.lodIndices, offsetof(Vertex, position),
+                                                                 offsetof(Vertex, normal), &job.optimization);
+                        size_t baseIndexCount = mesh.indices.size();
+                        mesh.indices.insert(mesh.indices.end(), mesh.lodIndices.begin(), mesh.lodIndices.end());
+                        MeshOptimizer::OptimizeVertexFetch(mesh.vertices, mesh.indices);
+                        mesh.lodIndices.assign(mesh.indices.begin() + static_cast<std::ptrdiff_t>(baseIndexCount), mesh.indices.end());
+                        mesh.indices.resize(baseIndexCount);
+                        job.optimization.cacheAfter = MeshOptimizer::AnalyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertices.size());
+                    }
+                    return true;
+                } catch (const std::exception& e) {
+                    std::cerr << "Failed to build geometry for material " << job.materialMesh->materialName << ": " << e.what() << std::endl;
+                    return false;
+                }
+            });
+        }
 
-            // FIXED: Don't transform vertices - keep them in the original coordinate system
-            // Instance transforms should be handled by the instancing system, not applied to vertex data
-            for (const auto& vertex : materialMesh.vertices) {
-                // Use vertices as-is without any transformation
-                combinedVertices.push_back(vertex);
+        // Wait in submission order and report in a deterministic order. Each mesh's textures are
+        // requested and the mesh is handed out as soon as it is done, while later jobs still run.
+        double handOffMs = 0.0;
+        bool emitting = static_cast<bool>(onMeshReady);
+        for (auto& job : geometryJobs) {
+            bool built = job.result.get();
+            const std::string& materialName = job.materialMesh->materialName;
+            switch (job.tangentSource) {
+                case TangentSource::Gltf:
+                    std::cout << "      Using glTF-provided tangents for material: " << materialName << std::endl;
+                    break;
+                case TangentSource::MikkTSpace:
+                    std::cout << "      Generated tangents (MikkTSpace) for material: " << materialName << std::endl;
+                    break;
+                case TangentSource::MikkTSpaceFailed:
+                    std::cerr << "      Failed to generate tangents for material: " << materialName << std::endl;
+                    break;
+                case TangentSource::Default:
+                    std::cout << "      Skipping tangent generation (missing normals, UVs, or indices) for material: " << materialName << std::endl;
+                    break;
             }
 
-            for (uint32_t index : materialMesh.indices) {
-                combinedIndices.push_back(index + vertexOffset);
+            // Later jobs still reference gltfModel, so nothing may escape this loop
+            auto handOffStart = std::chrono::steady_clock::now();
+            try {
+                scheduleMeshTextures(*job.materialMesh);
+                if (emitting && built && !job.materialMesh->GetIndices().empty()) {
+                    ShareGeometry(*job.materialMesh);
+                    emitting = onMeshReady(*job.materialMesh);
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Failed to hand out mesh for material " << materialName << ": " << e.what() << std::endl;
+                emitting = false;
             }
+            handOffMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - handOffStart).count();
         }
+
+        // The callback may wait for the consumer; that time is not part of the mesh stage
+        lastMeshStageMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - meshStageStart).count() - handOffMs;
+
+        // Sum the per-primitive optimization results; ratios are recomputed from the totals
+        lastMeshOptimizationStats = MeshOptimizationStats{};
+        if (meshOptimizationEnabled) {
+            auto accumulate = [](VertexCacheStats& total, const VertexCacheStats& stats) {
+                total.triangleCount += stats.triangleCount;
+                total.vertexCount += stats.vertexCount;
+                total.verticesTransformed += stats.verticesTransformed;
+                total.acmr = total.triangleCount > 0 ? static_cast<float>(total.verticesTransformed) / static_cast<float>(total.triangleCount) : 0.0f;
+                total.atvr = total.vertexCount > 0 ? static_cast<float>(total.verticesTransformed) / static_cast<float>(total.vertexCount) : 0.0f;
+            };
+            size_t meshletCount = 0;
+            for (const auto& job : geometryJobs) {
+                meshletCount += job.materialMesh->GetMeshlets().size();
+                lastMeshOptimizationStats.verticesBefore += job.optimization.verticesBefore;
+                lastMeshOptimizationStats.verticesAfter += job.optimization.verticesAfter;
+                accumulate(lastMeshOptimizationStats.cacheBefore, job.optimization.cacheBefore);
+                accumulate(lastMeshOptimizationStats.cacheAfter, job.optimization.cacheAfter);
+                lastMeshOptimizationStats.lodCount += job.optimization.lodCount;
+                lastMeshOptimizationStats.lodSourceTriangles += job.optimization.lodSourceTriangles;
+                lastMeshOptimizationStats.lodMs += job.optimization.lodMs;
+                lastMeshOptimizationStats.maxLodRelativeError = std::max(lastMeshOptimizationStats.maxLodRelativeError, job.optimization.maxLodRelativeError);
+                lastMeshOptimizationStats.maxLodNormalError = std::max(lastMeshOptimizationStats.maxLodNormalError, job.optimization.maxLodNormalError);
+            }
+            const MeshOptimizationStats& totals = lastMeshOptimizationStats;
+            std::cout << "Mesh optimization: " << meshletCount << " meshlets, " << totals.verticesBefore << " -> " << totals.verticesAfter << " vertices, ACMR "
+                      << totals.cacheBefore.acmr << " -> " << totals.cacheAfter.acmr << ", ATVR "
+                      << totals.cacheBefore.atvr << " -> " << totals.cacheAfter.atvr << std::endl;
+            // lodMs is summed over the worker threads, so this is the per-thread simplification rate
+            double trianglesPerSecond = totals.lodMs > 0.0 ? static_cast<double>(totals.lodSourceTriangles) / (totals.lodMs * 1e-3) : 0.0;
+            std::cout << "LOD generation: " << totals.lodCount << " levels, " << totals.lodSourceTriangles << " triangles simplified at "
+                      << trianglesPerSecond * 1e-6 << " Mtri/s per thread, max error " << totals.maxLodRelativeError * 100.0f
+                      << "% of mesh extent, max normal deviation " << totals.maxLodNormalError << std::endl;
+        }
+
+        std::cout << "Mesh stage: " << geometryJobs.size() << " unique primitives in " << lastMeshStageMs
+                  << " ms on " << geometryThreadCount << " threads" << std::endl;
+    }
+
+    // Convert geometry-based material mesh map to vector
+    std::vector<MaterialMesh> modelMaterialMeshes;
+    modelMaterialMeshes.reserve(geometryMaterialMeshMap.size());
+    for (auto& val : geometryMaterialMeshMap | std::views::values) {
+        modelMaterialMeshes.push_back(std::move(val));
     }
 
     // Store material meshes for this model
     materialMeshes[filename] = modelMaterialMeshes;
 
     // Set the combined mesh data in the model for backward compatibility
-    model->SetVertices(combinedVertices);
-    model->SetIndices(combinedIndices);
+    SetCombinedMeshData(model, modelMaterialMeshes);
 
     // Extract lights from the GLTF model
     std::cout << "Extracting lights from GLTF model..." << std::endl;
@@ -1479,21 +1776,22 @@ std::vector<ExtractedLight> ModelLoader::GetExtractedLights(const std::string& m
                 float emissiveIntensity = glm::length(material->emissive) * material->emissiveStrength;
                 if (emissiveIntensity >= 0.1f) {
                     // Calculate the center position of the emissive surface
+                    const std::vector<Vertex>& vertices = materialMesh.GetVertices();
                     glm::vec3 center(0.0f);
-                    if (!materialMesh.vertices.empty()) {
-                        for (const auto& vertex : materialMesh.vertices) {
+                    if (!vertices.empty()) {
+                        for (const auto& vertex : vertices) {
                             center += vertex.position;
                         }
-                        center /= static_cast<float>(materialMesh.vertices.size());
+                        center /= static_cast<float>(vertices.size());
                     }
 
                     // Calculate a reasonable direction (average normal of the surface)
                     glm::vec3 avgNormal(0.0f);
-                    if (!materialMesh.vertices.empty()) {
-                        for (const auto& vertex : materialMesh.vertices) {
+                    if (!vertices.empty()) {
+                        for (const auto& vertex : vertices) {
                             avgNormal += vertex.normal;
                         }
-                        avgNormal = glm::normalize(avgNormal / static_cast<float>(materialMesh.vertices.size()));
+                        avgNormal = glm::normalize(avgNormal / static_cast<float>(vertices.size()));
                     } else {
                         avgNormal = glm::vec3(0.0f, -1.0f, 0.0f); // Default downward direction
                     }
@@ -1559,6 +1857,54 @@ const std::vector<MaterialMesh>& ModelLoader::GetMaterialMeshes(const std::strin
     return emptyVector;
 }
 
+void ModelLoader::ShareMaterialMeshGeometry(const std::string& modelName) {
+    auto it = materialMeshes.find(modelName);
+    if (it == materialMeshes.end()) {
+        return;
+    }
+    for (auto& materialMesh : it->second) {
+        ShareGeometry(materialMesh);
+    }
+}
+
+void ModelLoader::ShareGeometry(MaterialMesh& materialMesh) {
+    if (materialMesh.geometry) {
+        return;
+    }
+    auto geometry = std::make_shared<MeshGeometry>();
+    geometry->vertices = std::move(materialMesh.vertices);
+    geometry->indices = std::move(materialMesh.indices);
+    geometry->meshlets = std::move(materialMesh.meshlets);
+    geometry->lodIndices = std::move(materialMesh.lodIndices);
+    geometry->lods = std::move(materialMesh.lods);
+    geometry->ComputeAABB();
+    materialMesh.vertices.clear();
+    materialMesh.indices.clear();
+    materialMesh.meshlets.clear();
+    materialMesh.lodIndices.clear();
+    materialMesh.lods.clear();
+    materialMesh.geometry = std::move(geometry);
+}
+
+void ModelLoader::EmitMaterialMeshes(const std::string& modelName, const MeshReadyCallback& onMeshReady) {
+    if (!onMeshReady) {
+        return;
+    }
+    auto it = materialMeshes.find(modelName);
+    if (it == materialMeshes.end()) {
+        return;
+    }
+    for (auto& materialMesh : it->second) {
+        if (materialMesh.GetIndices().empty()) {
+            continue;
+        }
+        ShareGeometry(materialMesh);
+        if (!onMeshReady(materialMesh)) {
+            break;
+        }
+    }
+}
+
 Material* ModelLoader::GetMaterial(const std::string& materialName) const {
     auto it = materials.find(materialName);
     if (it != materials.end()) {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -8,6 +10,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include "mesh_component.h"
+#include "mesh_optimizer.h"
+#include "thread_pool.h"
 #include <stdexcept>
 
 class Renderer;
@@ -17,6 +21,7 @@ class Material;
 // Forward declaration for tinygltf
 namespace tinygltf {
     class Model;
+    struct Image;
 }
 
 class Material {
@@ -123,6 +128,17 @@ struct MaterialMesh {
     std::string materialName;
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
+    std::vector<Meshlet> meshlets;  // Contiguous index ranges for cluster culling (empty if not optimized)
+    std::vector<uint32_t> lodIndices;  // Coarser levels of detail, appended after indices on upload
+    std::vector<MeshLod> lods;         // Level ranges in indices + lodIndices, base first (empty if not optimized)
+    std::shared_ptr<const MeshGeometry> geometry; // Set by ModelLoader::ShareMaterialMeshGeometry, which moves the arrays above into it
+
+    // Geometry access that works before and after the arrays were moved into the shared geometry
+    [[nodiscard]] const std::vector<Vertex>& GetVertices() const { return geometry ? geometry->vertices : vertices; }
+    [[nodiscard]] const std::vector<uint32_t>& GetIndices() const { return geometry ? geometry->indices : indices; }
+    [[nodiscard]] const std::vector<Meshlet>& GetMeshlets() const { return geometry ? geometry->meshlets : meshlets; }
+    [[nodiscard]] const std::vector<uint32_t>& GetLodIndices() const { return geometry ? geometry->lodIndices : lodIndices; }
+    [[nodiscard]] const std::vector<MeshLod>& GetLods() const { return geometry ? geometry->lods : lods; }
 
     // All PBR texture paths for this material
     std::string texturePath;           // Primary texture path (baseColor) - kept for backward compatibility
@@ -164,6 +180,28 @@ struct MaterialMesh {
     }
 };
 
+/**
+ * @brief A texture request issued while parsing a model, replayed when the model is loaded from the mesh cache.
+ *
+ * Entries with an alias register aliasId -> filePath; entries without one schedule
+ * an asynchronous file load of filePath.
+ */
+struct MeshCacheTexture {
+    std::string aliasId;
+    std::string filePath;
+    bool critical = false;
+};
+
+/**
+ * @brief Timing of a model load.
+ */
+struct ModelLoadStats {
+    double loadMs = 0.0;        // Time spent in LoadGLTF (excluding writing the mesh cache)
+    bool fromMeshCache = false; // True if the model was read from the mesh cache instead of parsed
+    double meshStageMs = 0.0;   // Parallel geometry extraction and tangent generation (0 on a cache hit)
+    MeshOptimizationStats meshOptimization; // Totals over all unique primitives (empty on a cache hit)
+};
+
 /**
  * @brief Class representing a 3D model.
  */
@@ -199,6 +237,12 @@ private:
  */
 class ModelLoader {
 public:
+    /**
+     * @brief Called on the loading thread for each material mesh as soon as its geometry and textures are ready.
+     * The mesh's geometry is already shared (see ShareMaterialMeshGeometry). Return false to stop the calls.
+     */
+    using MeshReadyCallback = std::function<bool(const MaterialMesh&)>;
+
     /**
      * @brief Default constructor.
      */
@@ -224,10 +268,15 @@ public:
 
     /**
      * @brief Load a model from a GLTF file.
+     *
+     * With a callback, each material mesh is handed out while the rest of the
+     * model is still being decoded, so the caller can upload it early. Meshes
+     * whose geometry failed to build are not handed out.
      * @param filename The path to the GLTF file.
+     * @param onMeshReady Called for each material mesh once it is ready (optional).
      * @return Pointer to the loaded model, or nullptr if loading failed.
      */
-    Model* LoadGLTF(const std::string& filename);
+    Model* LoadGLTF(const std::string& filename, const MeshReadyCallback& onMeshReady = nullptr);
 
 
     /**
@@ -253,6 +302,14 @@ public:
      */
     const std::vector<MaterialMesh>& GetMaterialMeshes(const std::string& modelName) const;
 
+    /**
+     * @brief Move the geometry of a model's material meshes into shared, immutable assets.
+     * Afterwards each MaterialMesh::geometry holds the data and its own arrays are empty,
+     * so entities created from the model reference the loader's single copy.
+     * @param modelName The name of the model.
+     */
+    void ShareMaterialMeshGeometry(const std::string& modelName);
+
     /**
      * @brief Get a material by name.
      * @param materialName The name of the material.
@@ -260,6 +317,37 @@ public:
      */
     Material* GetMaterial(const std::string& materialName) const;
 
+    /**
+     * @brief Enable or disable the binary mesh cache (see MeshCache).
+     * @param enabled True to read and write cache files next to the models, false to always parse.
+     */
+    void SetMeshCacheEnabled(bool enabled) { meshCacheEnabled = enabled; }
+
+    /**
+     * @brief Check if the binary mesh cache is used.
+     * @return True if enabled, false otherwise.
+     */
+    bool IsMeshCacheEnabled() const { return meshCacheEnabled; }
+
+    /**
+     * @brief Enable or disable load-time mesh optimization (see MeshOptimizer).
+     * @param enabled True to weld and reorder primitive geometry while parsing, false to keep source order.
+     */
+    void SetMeshOptimizationEnabled(bool enabled) { meshOptimizationEnabled = enabled; }
+
+    /**
+     * @brief Check if load-time mesh optimization is enabled.
+     * @return True if enabled, false otherwise.
+     */
+    bool IsMeshOptimizationEnabled() const { return meshOptimizationEnabled; }
+
+    /**
+     * @brief Get the load timing of a model.
+     * @param modelName The name of the model.
+     * @return The load statistics (zero if the model has not been loaded).
+     */
+    ModelLoadStats GetLoadStats(const std::string& modelName) const;
+
 
 private:
     // Reference to the renderer
@@ -281,13 +369,103 @@ private:
 
     float light_scale = 1.0f;
 
+    // Worker threads for parallel geometry extraction during parsing
+    std::unique_ptr<ThreadPool> geometryPool;
+    unsigned int geometryThreadCount = 0;
+    double lastMeshStageMs = 0.0;
+    bool meshOptimizationEnabled = true;
+    MeshOptimizationStats lastMeshOptimizationStats;
+
+    // Binary mesh cache
+    bool meshCacheEnabled = true;
+    std::unordered_map<std::string, ModelLoadStats> loadStats;
+
+    // Texture requests of the model being parsed; the parse is only cacheable if
+    // every texture can be reloaded from a file
+    std::vector<MeshCacheTexture> textureRequests;
+    bool textureRequestsCacheable = true;
+
     /**
      * @brief Parse a GLTF file.
      * @param filename The path to the GLTF file.
      * @param model The model to populate.
+     * @param onMeshReady Called for each material mesh as its geometry job completes (optional).
      * @return True if parsing was successful, false otherwise.
      */
-    bool ParseGLTF(const std::string& filename, Model* model);
+    bool ParseGLTF(const std::string& filename, Model* model, const MeshReadyCallback& onMeshReady);
+
+    /**
+     * @brief Hand the material meshes of a model that is already in memory to a callback.
+     * @param modelName The name of the model.
+     * @param onMeshReady The callback (nothing happens if it is empty).
+     */
+    void EmitMaterialMeshes(const std::string& modelName, const MeshReadyCallback& onMeshReady);
+
+    /**
+     * @brief Move the geometry of one material mesh into a shared, immutable asset (no-op if already shared).
+     * @param materialMesh The material mesh.
+     */
+    static void ShareGeometry(MaterialMesh& materialMesh);
+
+    /**
+     * @brief Populate a model from its mesh cache file.
+     * @param filename The path to the GLTF file.
+     * @param sourceHash The current source hash of the GLTF file.
+     * @param model The model to populate.
+     * @return True if the cache was valid and the model was populated, false otherwise.
+     */
+    bool LoadFromMeshCache(const std::string& filename, uint64_t sourceHash, Model* model);
+
+    /**
+     * @brief Write the mesh cache file of a freshly parsed model.
+     * @param filename The path to the GLTF file.
+     * @param sourceHash The source hash of the GLTF file.
+     * @param model The parsed model.
+     */
+    void WriteMeshCache(const std::string& filename, uint64_t sourceHash, const Model* model);
+
+    /**
+     * @brief Set the combined (backward compatible) mesh data of a model from its material meshes.
+     * @param model The model to populate.
+     * @param meshes The material meshes of the model.
+     */
+    static void SetCombinedMeshData(Model* model, const std::vector<MaterialMesh>& meshes);
+
+    /**
+     * @brief Upload a decoded glTF image and record how to reload it for the mesh cache.
+     * External images are not decoded by the parser; those are scheduled as file loads instead.
+     * @param textureId The texture ID.
+     * @param image The glTF image.
+     * @param baseTexturePath The directory of the GLTF file (with trailing separator).
+     * @param critical Whether the texture is needed before the loading screen is dismissed.
+     */
+    void ScheduleImageUpload(const std::string& textureId, const tinygltf::Image& image,
+                             const std::string& baseTexturePath, bool critical = false);
+
+    /**
+     * @brief Record how to reload an uploaded glTF image for the mesh cache.
+     * Images without a URI cannot be reloaded, which makes the current parse uncacheable.
+     * @param textureId The texture ID.
+     * @param image The glTF image.
+     * @param baseTexturePath The directory of the GLTF file (with trailing separator).
+     * @param critical Whether the texture is needed before the loading screen is dismissed.
+     */
+    void RecordImageTexture(const std::string& textureId, const tinygltf::Image& image,
+                            const std::string& baseTexturePath, bool critical);
+
+    /**
+     * @brief Schedule an asynchronous texture file load and record it for the mesh cache.
+     * @param filePath The texture file path.
+     * @param critical Whether the texture is needed before the loading screen is dismissed.
+     */
+    void ScheduleTextureFile(const std::string& filePath, bool critical = false);
+
+    /**
+     * @brief Register a texture alias and record it for the mesh cache.
+     * @param aliasId The alias texture ID.
+     * @param filePath The texture file path the alias resolves to.
+     */
+    void RegisterTextureAlias(const std::string& aliasId, const std::string& filePath);
 
     /**
      * @brief Extract lights from GLTF punctual lights extension.
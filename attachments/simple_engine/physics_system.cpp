@@ -3,6 +3,7 @@
 #include "renderer.h"
 #include "transform_component.h"
 #include "mesh_component.h"
+#include "profiler.h"
 #include <iostream>
 
 #include <glm/gtc/quaternion.hpp>
@@ -202,6 +203,7 @@ bool PhysicsSystem::Initialize() {
 }
 
 void PhysicsSystem::Update(std::chrono::milliseconds deltaTime) {
+    PROFILE_SCOPE("PhysicsSystem::Update");
     // Drain any pending rigid body creations queued from background threads
     std::vector<PendingCreation> toCreate;
     {
@@ -679,7 +681,7 @@ bool PhysicsSystem::InitializeVulkanResources() {
         integrateStageInfo.module = *vulkanResources.integrateShaderModule;
         integrateStageInfo.pName = "IntegrateCS";
         pipelineInfo.stage = integrateStageInfo;
-        vulkanResources.integratePipeline = vk::raii::Pipeline(raiiDevice, nullptr, pipelineInfo);
+        vulkanResources.integratePipeline = vk::raii::Pipeline(raiiDevice, renderer->GetPipelineCache(), pipelineInfo);
 
         // Broad phase pipeline
         vk::PipelineShaderStageCreateInfo broadPhaseStageInfo;
@@ -687,7 +689,7 @@ bool PhysicsSystem::InitializeVulkanResources() {
         broadPhaseStageInfo.module = *vulkanResources.broadPhaseShaderModule;
         broadPhaseStageInfo.pName = "BroadPhaseCS";
         pipelineInfo.stage = broadPhaseStageInfo;
-        vulkanResources.broadPhasePipeline = vk::raii::Pipeline(raiiDevice, nullptr, pipelineInfo);
+        vulkanResources.broadPhasePipeline = vk::raii::Pipeline(raiiDevice, renderer->GetPipelineCache(), pipelineInfo);
 
         // Narrow phase pipeline
         vk::PipelineShaderStageCreateInfo narrowPhaseStageInfo;
@@ -695,7 +697,7 @@ bool PhysicsSystem::InitializeVulkanResources() {
         narrowPhaseStageInfo.module = *vulkanResources.narrowPhaseShaderModule;
         narrowPhaseStageInfo.pName = "NarrowPhaseCS";
         pipelineInfo.stage = narrowPhaseStageInfo;
-        vulkanResources.narrowPhasePipeline = vk::raii::Pipeline(raiiDevice, nullptr, pipelineInfo);
+        vulkanResources.narrowPhasePipeline = vk::raii::Pipeline(raiiDevice, renderer->GetPipelineCache(), pipelineInfo);
 
         // Resolve pipeline
         vk::PipelineShaderStageCreateInfo resolveStageInfo;
@@ -703,7 +705,7 @@ bool PhysicsSystem::InitializeVulkanResources() {
         resolveStageInfo.module = *vulkanResources.resolveShaderModule;
         resolveStageInfo.pName = "ResolveCS";
         pipelineInfo.stage = resolveStageInfo;
-        vulkanResources.resolvePipeline = vk::raii::Pipeline(raiiDevice, nullptr, pipelineInfo);
+        vulkanResources.resolvePipeline = vk::raii::Pipeline(raiiDevice, renderer->GetPipelineCache(), pipelineInfo);
 
         // Create buffers
         vk::DeviceSize physicsBufferSize = sizeof(GPUPhysicsData) * maxGPUObjects;
@@ -1293,9 +1295,14 @@ void PhysicsSystem::SimulatePhysicsOnGPU(const std::chrono::milliseconds deltaTi
         nullptr
     );
 
+    GpuProfiler& gpuProfiler = renderer->GetGpuProfiler();
+
     // Step 1: Integrate forces and velocities
     vulkanResources.commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *vulkanResources.integratePipeline);
-    vulkanResources.commandBuffer.dispatch((rigidBodies.size() + 63) / 64, 1, 1);
+    {
+        GPU_PROFILE_COMPUTE_ZONE(gpuProfiler, vulkanResources.commandBuffer, "Physics::Integrate");
+        vulkanResources.commandBuffer.dispatch((rigidBodies.size() + 63) / 64, 1, 1);
+    }
 
     // Memory barrier to ensure integration is complete before collision detection
     vk::MemoryBarrier memoryBarrier;
@@ -1317,7 +1324,10 @@ void PhysicsSystem::SimulatePhysicsOnGPU(const std::chrono::milliseconds deltaTi
     // Dispatch number of workgroups matching [numthreads(64,1,1)] in BroadPhaseCS
     // One workgroup has 64 threads, each processes one pair by index
     uint32_t broadPhaseThreads = (numPairs + 63) / 64;
-    vulkanResources.commandBuffer.dispatch(std::max(1u, broadPhaseThreads), 1, 1);
+    {
+        GPU_PROFILE_COMPUTE_ZONE(gpuProfiler, vulkanResources.commandBuffer, "Physics::BroadPhase");
+        vulkanResources.commandBuffer.dispatch(std::max(1u, broadPhaseThreads), 1, 1);
+    }
 
     // Memory barrier to ensure the broad phase is complete before the narrow phase
     vulkanResources.commandBuffer.pipelineBarrier(
@@ -1334,7 +1344,10 @@ void PhysicsSystem::SimulatePhysicsOnGPU(const std::chrono::milliseconds deltaTi
     // Dispatch enough threads to process all potential collision pairs found by broad-phase
     // The shader will check counterBuffer[0] to determine the actual number of pairs to process
     uint32_t narrowPhaseThreads = (maxGPUCollisions + 63) / 64;
-    vulkanResources.commandBuffer.dispatch(narrowPhaseThreads, 1, 1);
+    {
+        GPU_PROFILE_COMPUTE_ZONE(gpuProfiler, vulkanResources.commandBuffer, "Physics::NarrowPhase");
+        vulkanResources.commandBuffer.dispatch(narrowPhaseThreads, 1, 1);
+    }
 
     // Memory barrier to ensure the narrow phase is complete before resolution
     vulkanResources.commandBuffer.pipelineBarrier(
@@ -1349,7 +1362,10 @@ void PhysicsSystem::SimulatePhysicsOnGPU(const std::chrono::milliseconds deltaTi
     // Step 4: Collision resolution
     vulkanResources.commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *vulkanResources.resolvePipeline);
     uint32_t resolveThreads = (maxGPUCollisions + 63) / 64;
-    vulkanResources.commandBuffer.dispatch(resolveThreads, 1, 1);
+    {
+        GPU_PROFILE_COMPUTE_ZONE(gpuProfiler, vulkanResources.commandBuffer, "Physics::Resolve");
+        vulkanResources.commandBuffer.dispatch(resolveThreads, 1, 1);
+    }
 
     // End command buffer
     vulkanResources.commandBuffer.end();
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <vulkan/vulkan.hpp>
+
+/**
+ * @brief Validation of stored pipeline cache data against the running device.
+ *
+ * Drivers should reject foreign data themselves, but not all of them do so
+ * gracefully, so the version-one header written by vkGetPipelineCacheData is
+ * checked before the data seeds a new pipeline cache.
+ */
+class PipelineCacheHeader {
+public:
+    /**
+     * @brief Check if stored cache data was written by this device and driver.
+     * @param data The stored cache data.
+     * @param size The size of the data in bytes.
+     * @param vendorID The vendor ID of the device.
+     * @param deviceID The device ID of the device.
+     * @param pipelineCacheUUID The device's pipeline cache UUID (VK_UUID_SIZE bytes).
+     * @return True if the data starts with a matching version-one header, false otherwise.
+     */
+    static bool Matches(const void* data, size_t size, uint32_t vendorID, uint32_t deviceID, const uint8_t* pipelineCacheUUID) {
+        VkPipelineCacheHeaderVersionOne header{};
+        if (!data || size < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+        return header.headerSize >= sizeof(header) && header.headerSize <= size &&
+               header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+               header.vendorID == vendorID && header.deviceID == deviceID &&
+               std::memcmp(header.pipelineCacheUUID, pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+};
@@ -510,3 +510,52 @@ void DesktopPlatform::CharCallback(GLFWwindow* window, unsigned int codepoint) {
     }
 }
 #endif
+
+// Headless platform implementation (shared by all targets)
+
+bool HeadlessPlatform::Initialize(const std::string& appName, int requestedWidth, int requestedHeight) {
+    if (requestedWidth <= 0 || requestedHeight <= 0) {
+        LOGE("Invalid headless render target size %dx%d", requestedWidth, requestedHeight);
+        return false;
+    }
+
+    width = requestedWidth;
+    height = requestedHeight;
+    quitRequested = false;
+
+    LOGI("Headless platform initialized for %s (%dx%d)", appName.c_str(), width, height);
+    return true;
+}
+
+void HeadlessPlatform::Cleanup() {
+    // Nothing to release: no window or native handles are owned
+}
+
+bool HeadlessPlatform::ProcessEvents() {
+    return !quitRequested;
+}
+
+bool HeadlessPlatform::CreateVulkanSurface(VkInstance, VkSurfaceKHR*) {
+    // There is no window to present to; the renderer draws into offscreen images instead
+    return false;
+}
+
+void HeadlessPlatform::SetResizeCallback(std::function<void(int, int)> callback) {
+    resizeCallback = std::move(callback);
+}
+
+void HeadlessPlatform::SetMouseCallback(std::function<void(float, float, uint32_t)> callback) {
+    mouseCallback = std::move(callback);
+}
+
+void HeadlessPlatform::SetKeyboardCallback(std::function<void(uint32_t, bool)> callback) {
+    keyboardCallback = std::move(callback);
+}
+
+void HeadlessPlatform::SetCharCallback(std::function<void(uint32_t)> callback) {
+    charCallback = std::move(callback);
+}
+
+void HeadlessPlatform::SetWindowTitle(const std::string&) {
+    // No window title when running headless
+}
@@ -95,6 +95,12 @@ public:
      */
     virtual bool CreateVulkanSurface(VkInstance instance, VkSurfaceKHR* surface) = 0;
 
+    /**
+     * @brief Check if the platform renders without a window or surface.
+     * @return True if rendering should target offscreen images only, false otherwise.
+     */
+    virtual bool IsHeadless() const { return false; }
+
     /**
      * @brief Set a callback for window resize events.
      * @param callback The callback function to be called when the window is resized.
@@ -444,6 +450,117 @@ public:
 };
 #endif
 
+/**
+ * @brief Headless implementation of the Platform interface.
+ *
+ * Provides a fixed-size "window" without any windowing system so the renderer
+ * can draw into offscreen images. This allows running the engine on machines
+ * without a display (e.g., CI boxes using a software ICD such as lavapipe).
+ */
+class HeadlessPlatform final : public Platform {
+private:
+    int width = 0;
+    int height = 0;
+    bool quitRequested = false;
+    std::function<void(int, int)> resizeCallback;
+    std::function<void(float, float, uint32_t)> mouseCallback;
+    std::function<void(uint32_t, bool)> keyboardCallback;
+    std::function<void(uint32_t)> charCallback;
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    HeadlessPlatform() = default;
+
+    /**
+     * @brief Initialize the platform.
+     * @param appName The name of the application.
+     * @param width The width of the offscreen render target.
+     * @param height The height of the offscreen render target.
+     * @return True if initialization was successful, false otherwise.
+     */
+    bool Initialize(const std::string& appName, int width, int height) override;
+
+    /**
+     * @brief Clean up platform resources.
+     */
+    void Cleanup() override;
+
+    /**
+     * @brief Process platform events.
+     * @return True until RequestQuit() has been called.
+     */
+    bool ProcessEvents() override;
+
+    /**
+     * @brief Check if the window has been resized (never happens when headless).
+     * @return Always false.
+     */
+    bool HasWindowResized() override { return false; }
+
+    /**
+     * @brief Get the offscreen render target width.
+     * @return The width.
+     */
+    int GetWindowWidth() const override { return width; }
+
+    /**
+     * @brief Get the offscreen render target height.
+     * @return The height.
+     */
+    int GetWindowHeight() const override { return height; }
+
+    /**
+     * @brief Create a Vulkan surface (not supported when headless).
+     * @param instance The Vulkan instance.
+     * @param surface Pointer to the surface handle to be filled.
+     * @return Always false.
+     */
+    bool CreateVulkanSurface(VkInstance instance, VkSurfaceKHR* surface) override;
+
+    /**
+     * @brief Check if the platform renders without a window or surface.
+     * @return Always true.
+     */
+    bool IsHeadless() const override { return true; }
+
+    /**
+     * @brief Set a callback for window resize events.
+     * @param callback The callback function (never invoked when headless).
+     */
+    void SetResizeCallback(std::function<void(int, int)> callback) override;
+
+    /**
+     * @brief Set a callback for mouse input events.
+     * @param callback The callback function (never invoked when headless).
+     */
+    void SetMouseCallback(std::function<void(float, float, uint32_t)> callback) override;
+
+    /**
+     * @brief Set a callback for keyboard input events.
+     * @param callback The callback function (never invoked when headless).
+     */
+    void SetKeyboardCallback(std::function<void(uint32_t, bool)> callback) override;
+
+    /**
+     * @brief Set a callback for character input events.
+     * @param callback The callback function (never invoked when headless).
+     */
+    void SetCharCallback(std::function<void(uint32_t)> callback) override;
+
+    /**
+     * @brief Set the window title (no-op when headless).
+     * @param title The new window title.
+     */
+    void SetWindowTitle(const std::string& title) override;
+
+    /**
+     * @brief Ask the main loop to exit on the next ProcessEvents() call.
+     */
+    void RequestQuit() { quitRequested = true; }
+};
+
 /**
  * @brief Factory function for creating a platform instance.
  * @param args Arguments to pass to the platform constructor.
@@ -0,0 +1,411 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    // The calling thread's ring buffer (owned by the profiler)
+    thread_local void* threadBufferPtr = nullptr;
+
+    // The virtual track last fed from the calling thread, so repeated records skip the registry
+    thread_local const char* cachedTrackName = nullptr;
+    thread_local void* cachedTrackPtr = nullptr;
+}
+
+Profiler::Profiler() {
+    frameHistory.reserve(FRAME_HISTORY);
+}
+
+std::string Profiler::EscapeJson(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped.push_back('\\');
+            escaped.push_back(c);
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            escaped.push_back(c);
+        }
+    }
+    return escaped;
+}
+
+Profiler::~Profiler() {
+    Shutdown();
+}
+
+bool Profiler::Initialize() {
+    if (collectorThread.joinable()) {
+        return true;
+    }
+
+    try {
+        calibrationStartTicks = Now();
+        calibrationStartTime = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(collectorMutex);
+            stopCollector = false;
+        }
+        enabled.store(true, std::memory_order_relaxed);
+        collectorThread = std::thread(&Profiler::collectorLoop, this);
+        return true;
+    } catch (const std::exception& e) {
+        enabled.store(false, std::memory_order_relaxed);
+        std::cerr << "Failed to start profiler: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void Profiler::Shutdown() {
+    enabled.store(false, std::memory_order_relaxed);
+    if (!collectorThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(collectorMutex);
+        stopCollector = true;
+    }
+    collectorCv.notify_all();
+    collectorThread.join();
+}
+
+Profiler::ThreadBuffer* Profiler::getThreadBuffer() {
+    if (threadBufferPtr) {
+        return static_cast<ThreadBuffer*>(threadBufferPtr);
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->threadIndex = static_cast<uint32_t>(threadBuffers.size());
+    buffer->threadName = "Thread " + std::to_string(buffer->threadIndex);
+    threadBufferPtr = buffer.get();
+    threadBuffers.push_back(std::move(buffer));
+    return static_cast<ThreadBuffer*>(threadBufferPtr);
+}
+
+void Profiler::RecordZone(const char* name, uint64_t startTicks, uint64_t endTicks, uint32_t depth) {
+    ThreadBuffer* buffer = getThreadBuffer();
+
+    // Single producer: only this thread advances writeIndex
+    uint64_t write = buffer->writeIndex.load(std::memory_order_relaxed);
+    uint64_t read = buffer->readIndex.load(std::memory_order_acquire);
+    if (write - read >= ThreadBuffer::CAPACITY) {
+        // The collector fell behind; drop rather than block the caller
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ProfileZoneEvent& event = buffer->events[write & (ThreadBuffer::CAPACITY - 1)];
+    event.name = name;
+    event.startTicks = startTicks;
+    event.endTicks = endTicks;
+    event.depth = depth;
+    buffer->writeIndex.store(write + 1, std::memory_order_release);
+}
+
+void Profiler::MarkFrame() {
+    if (!IsEnabled()) {
+        return;
+    }
+    // A zone without a name is the frame marker
+    uint64_t now = Now();
+    RecordZone(nullptr, now, now, 0);
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+    ThreadBuffer* buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->threadName = name;
+}
+
+void Profiler::RecordTrackZone(const char* trackName, const char* name, uint64_t startTicks, uint64_t endTicks) {
+    if (!IsEnabled()) {
+        return;
+    }
+
+    // Virtual tracks are fed from a single thread each (e.g., the render thread for "GPU"),
+    // so the buffer keeps its single-producer guarantee. Buffers are never removed, so the
+    // cached pointer stays valid.
+    ThreadBuffer* buffer = cachedTrackName == trackName ? static_cast<ThreadBuffer*>(cachedTrackPtr) : nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        auto it = trackIndices.find(trackName);
+        if (it == trackIndices.end()) {
+            auto track = std::make_unique<ThreadBuffer>();
+            track->threadIndex = static_cast<uint32_t>(threadBuffers.size());
+            track->threadName = trackName;
+            it = trackIndices.emplace(trackName, track->threadIndex).first;
+            threadBuffers.push_back(std::move(track));
+        }
+        buffer = threadBuffers[it->second].get();
+        cachedTrackName = trackName;
+        cachedTrackPtr = buffer;
+    }
+
+    uint64_t write = buffer->writeIndex.load(std::memory_order_relaxed);
+    uint64_t read = buffer->readIndex.load(std::memory_order_acquire);
+    if (write - read >= ThreadBuffer::CAPACITY) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ProfileZoneEvent& event = buffer->events[write & (ThreadBuffer::CAPACITY - 1)];
+    event.name = name;
+    event.startTicks = startTicks;
+    event.endTicks = endTicks;
+    event.depth = 0;
+    buffer->writeIndex.store(write + 1, std::memory_order_release);
+}
+
+void Profiler::collectorLoop() {
+    std::unique_lock<std::mutex> lock(collectorMutex);
+    while (!stopCollector) {
+        collectorCv.wait_for(lock, std::chrono::milliseconds(2), [this] { return stopCollector; });
+        lock.unlock();
+        updateCalibration();
+        collect();
+        lock.lock();
+    }
+}
+
+void Profiler::updateCalibration() {
+#if defined(PROFILER_USE_RDTSC)
+    uint64_t ticks = Now();
+    auto time = std::chrono::steady_clock::now();
+    uint64_t elapsedTicks = ticks - calibrationStartTicks;
+    auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(time - calibrationStartTime).count();
+    // Wait for a long enough window so the ratio is stable
+    if (elapsedTicks > 0 && elapsedNs > 10'000'000) {
+        nsPerTick.store(static_cast<double>(elapsedNs) / static_cast<double>(elapsedTicks), std::memory_order_relaxed);
+    }
+#else
+    using Period = std::chrono::steady_clock::period;
+    nsPerTick.store(1e9 * static_cast<double>(Period::num) / static_cast<double>(Period::den), std::memory_order_relaxed);
+#endif
+}
+
+double Profiler::TicksToMs(uint64_t ticks) const {
+    return static_cast<double>(ticks) * nsPerTick.load(std::memory_order_relaxed) * 1e-6;
+}
+
+uint64_t Profiler::SteadyTimeToTicks(std::chrono::steady_clock::time_point time) const {
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(time - calibrationStartTime).count());
+    double ticks = ns / nsPerTick.load(std::memory_order_relaxed);
+    return calibrationStartTicks + static_cast<int64_t>(ticks);
+}
+
+void Profiler::collect() {
+    std::lock_guard<std::mutex> drainLock(drainMutex);
+
+    // Snapshot the buffer list; buffers are never freed while the profiler lives
+    std::vector<ThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers.reserve(threadBuffers.size());
+        for (auto& buffer : threadBuffers) {
+            buffers.push_back(buffer.get());
+        }
+    }
+
+    std::vector<ProfileZoneEvent> batch;
+    for (ThreadBuffer* buffer : buffers) {
+        uint64_t read = buffer->readIndex.load(std::memory_order_relaxed);
+        uint64_t write = buffer->writeIndex.load(std::memory_order_acquire);
+        for (uint64_t i = read; i < write; ++i) {
+            ProfileZoneEvent event = buffer->events[i & (ThreadBuffer::CAPACITY - 1)];
+            event.threadIndex = buffer->threadIndex;
+            batch.push_back(event);
+        }
+        buffer->readIndex.store(write, std::memory_order_release);
+    }
+
+    if (batch.empty()) {
+        return;
+    }
+
+    // Zones complete in end-time order, so frame markers split the batch correctly
+    std::ranges::sort(batch, {}, &ProfileZoneEvent::endTicks);
+
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        for (const auto& event : batch) {
+            if (!event.name) {
+                if (lastFrameMarkTicks != 0) {
+                    currentFrame.startTicks = lastFrameMarkTicks;
+                    currentFrame.frameTicks = event.endTicks - lastFrameMarkTicks;
+                    if (frameHistory.size() < FRAME_HISTORY) {
+                        frameHistory.push_back(std::move(currentFrame));
+                    } else {
+                        frameHistory[frameHistoryNext] = std::move(currentFrame);
+                    }
+                    frameHistoryNext = (frameHistoryNext + 1) % FRAME_HISTORY;
+                }
+                currentFrame = FrameRecord{};
+                lastFrameMarkTicks = event.endTicks;
+                continue;
+            }
+
+            ZoneFrameTotals& totals = currentFrame.zones[event.name];
+            totals.ticks += event.endTicks - event.startTicks;
+            totals.calls++;
+            totals.depth = std::min(totals.depth, event.depth);
+            totals.firstStartTicks = std::min(totals.firstStartTicks, event.startTicks);
+        }
+    }
+
+    if (capturing.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(captureMutex);
+        for (const auto& event : batch) {
+            if (event.endTicks < captureStartTicks || captureEvents.size() >= MAX_CAPTURE_EVENTS) {
+                continue;
+            }
+            captureEvents.push_back(event);
+        }
+    }
+}
+
+std::vector<ProfileZoneStats> Profiler::GetZoneStats() const {
+    struct Accumulator {
+        uint64_t totalTicks = 0;
+        uint64_t maxTicks = 0;
+        uint64_t calls = 0;
+        uint32_t depth = UINT32_MAX;
+        uint64_t startOffset = 0;
+    };
+
+    std::unordered_map<std::string, Accumulator> accumulators;
+    size_t frameCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        frameCount = frameHistory.size();
+        // Walk oldest to newest so the start offset reflects the latest frame
+        for (size_t i = 0; i < frameCount; ++i) {
+            const FrameRecord& frame = frameHistory[(frameHistoryNext + i) % frameCount];
+            // Identical names from different translation units are merged by string
+            std::unordered_map<std::string, uint64_t> frameTicks;
+            for (const auto& [name, totals] : frame.zones) {
+                Accumulator& acc = accumulators[name];
+                acc.totalTicks += totals.ticks;
+                acc.calls += totals.calls;
+                acc.depth = std::min(acc.depth, totals.depth);
+                acc.startOffset = totals.firstStartTicks > frame.startTicks ? totals.firstStartTicks - frame.startTicks : 0;
+                frameTicks[name] += totals.ticks;
+            }
+            for (const auto& [name, ticks] : frameTicks) {
+                Accumulator& acc = accumulators[name];
+                acc.maxTicks = std::max(acc.maxTicks, ticks);
+            }
+        }
+    }
+
+    std::vector<std::pair<uint64_t, ProfileZoneStats>> ordered;
+    ordered.reserve(accumulators.size());
+    for (const auto& [name, acc] : accumulators) {
+        ProfileZoneStats stats;
+        stats.name = name;
+        stats.averageMs = TicksToMs(acc.totalTicks) / static_cast<double>(frameCount);
+        stats.maxMs = TicksToMs(acc.maxTicks);
+        stats.callsPerFrame = static_cast<double>(acc.calls) / static_cast<double>(frameCount);
+        stats.depth = acc.depth;
+        ordered.emplace_back(acc.startOffset, std::move(stats));
+    }
+    std::ranges::sort(ordered, [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first < b.first : a.second.depth < b.second.depth;
+    });
+
+    std::vector<ProfileZoneStats> result;
+    result.reserve(ordered.size());
+    for (auto& entry : ordered) {
+        result.push_back(std::move(entry.second));
+    }
+    return result;
+}
+
+double Profiler::GetAverageFrameMs() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    if (frameHistory.empty()) {
+        return 0.0;
+    }
+    uint64_t totalTicks = 0;
+    for (const auto& frame : frameHistory) {
+        totalTicks += frame.frameTicks;
+    }
+    return TicksToMs(totalTicks) / static_cast<double>(frameHistory.size());
+}
+
+void Profiler::StartCapture() {
+    {
+        std::lock_guard<std::mutex> lock(captureMutex);
+        captureEvents.clear();
+        captureStartTicks = Now();
+    }
+    capturing.store(true, std::memory_order_relaxed);
+}
+
+bool Profiler::StopCaptureAndWrite(const std::string& filename) {
+    if (!capturing.load(std::memory_order_relaxed)) {
+        std::cerr << "Profiler capture is not active" << std::endl;
+        return false;
+    }
+
+    // Pull in everything recorded so far before closing the capture
+    collect();
+    capturing.store(false, std::memory_order_relaxed);
+
+    std::vector<ProfileZoneEvent> events;
+    uint64_t startTicks = 0;
+    {
+        std::lock_guard<std::mutex> lock(captureMutex);
+        events.swap(captureEvents);
+        startTicks = captureStartTicks;
+    }
+
+    std::vector<std::string> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto& buffer : threadBuffers) {
+            threadNames.push_back(buffer->threadName);
+        }
+    }
+
+    try {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open profiler capture file: " << filename << std::endl;
+            return false;
+        }
+
+        auto toMicroseconds = [&](uint64_t ticks) { return TicksToMs(ticks) * 1000.0; };
+
+        file << std::fixed << std::setprecision(3);
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        for (size_t i = 0; i < threadNames.size(); ++i) {
+            file << (first ? "" : ",\n")
+                 << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+                 << ",\"args\":{\"name\":\"" << EscapeJson(threadNames[i]) << "\"}}";
+            first = false;
+        }
+        for (const auto& event : events) {
+            double ts = toMicroseconds(event.startTicks > startTicks ? event.startTicks - startTicks : 0);
+            file << (first ? "" : ",\n");
+            first = false;
+            if (!event.name) {
+                file << "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":" << event.threadIndex
+                     << ",\"ts\":" << ts << "}";
+                continue;
+            }
+            file << "{\"name\":\"" << EscapeJson(event.name) << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                 << event.threadIndex << ",\"ts\":" << ts
+                 << ",\"dur\":" << toMicroseconds(event.endTicks - event.startTicks) << "}";
+        }
+        file << "\n]}\n";
+
+        std::cout << "Profiler capture written to " << filename << " (" << events.size() << " events)" << std::endl;
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to write profiler capture: " << e.what() << std::endl;
+        return false;
+    }
+}
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROFILER_USE_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_USE_RDTSC 1
+#endif
+
+/**
+ * @brief A completed CPU zone as recorded by the owning thread.
+ *
+ * Zone names must outlive the profiler (string literals or other static storage),
+ * so recording never allocates or copies strings on the hot path.
+ */
+struct ProfileZoneEvent {
+    const char* name = nullptr;
+    uint64_t startTicks = 0;
+    uint64_t endTicks = 0;
+    uint32_t depth = 0;        // Nesting depth on the recording thread (0 = outermost)
+    uint32_t threadIndex = 0;  // Filled in by the collector
+};
+
+/**
+ * @brief Aggregated per-frame statistics of one zone over the recent frame window.
+ */
+struct ProfileZoneStats {
+    std::string name;
+    double averageMs = 0.0;     // Average total time per frame
+    double maxMs = 0.0;         // Worst total time in a single frame
+    double callsPerFrame = 0.0; // Average number of calls per frame
+    uint32_t depth = 0;         // Shallowest nesting depth observed (for indentation in UI)
+};
+
+/**
+ * @brief Low-overhead hierarchical CPU profiler.
+ *
+ * Each thread records completed zones into its own single-producer ring buffer
+ * without taking locks. A background collector thread drains the buffers,
+ * aggregates per-frame statistics between frame marks, and (while a capture is
+ * active) keeps the raw events so they can be exported as Chrome trace_event
+ * JSON (chrome://tracing, Perfetto).
+ */
+class Profiler {
+public:
+    /**
+     * @brief Get the singleton instance of the profiler.
+     * @return Reference to the profiler instance.
+     */
+    static Profiler& GetInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    /**
+     * @brief Read the profiler clock (TSC where available, steady_clock otherwise).
+     * @return The current tick count.
+     */
+    static uint64_t Now() {
+#if defined(PROFILER_USE_RDTSC)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    /**
+     * @brief Escape text for a JSON string (quotes and backslashes are escaped, control characters dropped).
+     * @param text The text to escape.
+     * @return The escaped text.
+     */
+    static std::string EscapeJson(const std::string& text);
+
+    /**
+     * @brief Start the background collector and enable zone recording.
+     * @return True if the profiler is running, false otherwise.
+     */
+    bool Initialize();
+
+    /**
+     * @brief Stop the collector thread and disable zone recording.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Check if zones are currently being recorded.
+     * @return True if enabled, false otherwise.
+     */
+    bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Record a completed zone for the calling thread (lock-free).
+     * @param name The zone name (must have static storage duration).
+     * @param startTicks The zone start from Now().
+     * @param endTicks The zone end from Now().
+     * @param depth The nesting depth of the zone.
+     */
+    void RecordZone(const char* name, uint64_t startTicks, uint64_t endTicks, uint32_t depth);
+
+    /**
+     * @brief Mark the end of a frame on the calling thread (usually the main thread).
+     */
+    void MarkFrame();
+
+    /**
+     * @brief Set a readable name for the calling thread in captures.
+     * @param name The thread name.
+     */
+    void SetThreadName(const std::string& name);
+
+    /**
+     * @brief Get zone statistics averaged over the recent frame window.
+     * @return The zone statistics, ordered by start time within the frame.
+     */
+    std::vector<ProfileZoneStats> GetZoneStats() const;
+
+    /**
+     * @brief Get the average CPU frame time (frame mark to frame mark) over the recent window.
+     * @return The average frame time in milliseconds.
+     */
+    double GetAverageFrameMs() const;
+
+    /**
+     * @brief Start keeping raw events for a Chrome trace export.
+     */
+    void StartCapture();
+
+    /**
+     * @brief Stop the capture and write it as Chrome trace_event JSON.
+     * @param filename The output path.
+     * @return True if the file was written, false otherwise.
+     */
+    bool StopCaptureAndWrite(const std::string& filename);
+
+    /**
+     * @brief Check if a capture is in progress.
+     * @return True if capturing, false otherwise.
+     */
+    bool IsCapturing() const { return capturing.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Convert a tick delta to milliseconds using the current clock calibration.
+     * @param ticks The tick delta.
+     * @return The duration in milliseconds.
+     */
+    double TicksToMs(uint64_t ticks) const;
+
+    /**
+     * @brief Convert an absolute steady_clock time point to profiler ticks.
+     * Used to place externally timed events (e.g., GPU timestamps) on the CPU timeline.
+     * @param time The steady_clock time point.
+     * @return The corresponding tick value.
+     */
+    uint64_t SteadyTimeToTicks(std::chrono::steady_clock::time_point time) const;
+
+    /**
+     * @brief Insert an externally timed zone on a named virtual track (e.g., "GPU").
+     * @param trackName The track name shown as a thread in captures (static storage).
+     * @param name The zone name (static storage).
+     * @param startTicks The zone start in profiler ticks.
+     * @param endTicks The zone end in profiler ticks.
+     */
+    void RecordTrackZone(const char* trackName, const char* name, uint64_t startTicks, uint64_t endTicks);
+
+protected:
+    Profiler();
+    virtual ~Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+private:
+    // Per-thread single-producer/single-consumer ring buffer of completed zones
+    struct ThreadBuffer {
+        static constexpr uint64_t CAPACITY = 1u << 14; // power of two
+        std::unique_ptr<ProfileZoneEvent[]> events = std::make_unique<ProfileZoneEvent[]>(CAPACITY);
+        alignas(64) std::atomic<uint64_t> writeIndex{0};
+        alignas(64) std::atomic<uint64_t> readIndex{0};
+        std::atomic<uint64_t> dropped{0};
+        uint32_t threadIndex = 0;
+        std::string threadName;
+    };
+
+    // Totals of one zone within a single frame
+    struct ZoneFrameTotals {
+        uint64_t ticks = 0;
+        uint32_t calls = 0;
+        uint32_t depth = UINT32_MAX;
+        uint64_t firstStartTicks = UINT64_MAX;
+    };
+
+    struct FrameRecord {
+        uint64_t startTicks = 0;
+        uint64_t frameTicks = 0;
+        std::unordered_map<const char*, ZoneFrameTotals> zones;
+    };
+
+    ThreadBuffer* getThreadBuffer();
+    void collectorLoop();
+    void collect();
+    void updateCalibration();
+
+    std::atomic<bool> enabled{false};
+    std::atomic<bool> capturing{false};
+
+    // Thread buffer registry (locked only when a thread records for the first time)
+    mutable std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+    std::unordered_map<const char*, uint32_t> trackIndices;
+
+    // Collector thread
+    std::thread collectorThread;
+    std::mutex collectorMutex;
+    std::condition_variable collectorCv;
+    bool stopCollector = false;
+    std::mutex drainMutex; // Serializes draining (collector thread vs. capture stop)
+
+    // Clock calibration (ticks -> nanoseconds)
+    uint64_t calibrationStartTicks = 0;
+    std::chrono::steady_clock::time_point calibrationStartTime;
+    std::atomic<double> nsPerTick{1.0};
+
+    // Aggregated frame history (collector writes, UI reads)
+    static constexpr size_t FRAME_HISTORY = 120;
+    mutable std::mutex statsMutex;
+    FrameRecord currentFrame;
+    uint64_t lastFrameMarkTicks = 0;
+    std::vector<FrameRecord> frameHistory;
+    size_t frameHistoryNext = 0;
+
+    // Capture storage
+    static constexpr size_t MAX_CAPTURE_EVENTS = 4u * 1024u * 1024u;
+    std::mutex captureMutex;
+    std::vector<ProfileZoneEvent> captureEvents;
+    uint64_t captureStartTicks = 0;
+};
+
+/**
+ * @brief RAII helper that records a zone from construction to destruction.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* zoneName) {
+        if (Profiler::GetInstance().IsEnabled()) {
+            name = zoneName;
+            depth = currentDepth++;
+            startTicks = Profiler::Now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (name) {
+            uint64_t endTicks = Profiler::Now();
+            --currentDepth;
+            Profiler::GetInstance().RecordZone(name, startTicks, endTicks, depth);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    static inline thread_local uint32_t currentDepth = 0;
+    const char* name = nullptr;
+    uint64_t startTicks = 0;
+    uint32_t depth = 0;
+};
+
+// Convenience macros for CPU profiling. Define SIMPLE_ENGINE_DISABLE_PROFILER to compile them out.
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#if defined(SIMPLE_ENGINE_DISABLE_PROFILER)
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_FRAME_MARK() ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#else
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#define PROFILE_FRAME_MARK() Profiler::GetInstance().MarkFrame()
+#define PROFILE_THREAD_NAME(name) Profiler::GetInstance().SetThreadName(name)
+#endif
@@ -15,6 +15,7 @@
 #include <unordered_set>
 #include <condition_variable>
 #include <atomic>
+#include <array>
 
 #include "platform.h"
 #include "entity.h"
@@ -23,6 +24,10 @@
 #include "memory_pool.h"
 #include "model_loader.h"
 #include "thread_pool.h"
+#include "gpu_profiler.h"
+#include "texture_residency.h"
+#include "texture_streaming.h"
+#include "deletion_queue.h"
 
 // Forward declarations
 class ImGuiSystem;
@@ -64,10 +69,9 @@ struct LightData {
 };
 
 /**
- * @brief Structure for the uniform buffer object (now without fixed light arrays).
+ * @brief Per-frame uniforms shared by every draw (now without fixed light arrays).
  */
 struct UniformBufferObject {
-    alignas(16) glm::mat4 model;
     alignas(16) glm::mat4 view;
     alignas(16) glm::mat4 proj;
     alignas(16) glm::vec4 camPos;
@@ -82,10 +86,89 @@ struct UniformBufferObject {
     alignas(8) glm::vec2 screenDimensions;
 };
 
+/**
+ * @brief Per-object data, one slot per entity in the per-frame object storage buffer.
+ */
+struct ObjectData {
+    alignas(16) glm::mat4 model;
+    alignas(16) glm::vec4 positionScale;   // PackedVertex dequantization (xyz); identity for unpacked meshes
+    alignas(16) glm::vec4 positionOffset;
+};
+
+/**
+ * @brief Per-frame draw submission results of the opaque pass.
+ */
+struct OpaquePassStats {
+    uint64_t meshletsTested = 0;
+    uint64_t meshletsVisible = 0;
+    uint64_t trianglesTotal = 0;      // Triangles the opaque pass would draw without culling (times instances)
+    uint64_t trianglesSubmitted = 0;  // Triangles actually submitted
+    uint64_t drawCommands = 0;        // Indexed draws (direct, or commands in the indirect buffer)
+    uint64_t drawCalls = 0;           // vkCmdDraw* calls recorded
+    uint64_t bufferBinds = 0;         // Vertex/index buffer bind calls recorded
+    uint64_t reducedLodDraws = 0;     // Meshes drawn at a coarser level of detail
+    uint64_t instanceBytesUploaded = 0; // Instance data re-uploaded for the frame's buffers
+    double recordMs = 0.0;            // CPU time spent recording the pass
+    uint64_t uniformBytesWritten = 0; // Global uniform and object data written for the frame
+    double uniformUpdateMs = 0.0;     // CPU time spent writing them
+};
+
+/**
+ * @brief Size and round-trip error of the meshes uploaded as PackedVertex.
+ */
+struct VertexPackingStats {
+    size_t meshCount = 0;
+    size_t vertexCount = 0;
+    size_t packedBytes = 0;
+    size_t unpackedBytes = 0;          // What the same vertices take as Vertex
+    float maxPositionError = 0.0f;     // Largest per-axis position error in model units
+    float maxNormalErrorDegrees = 0.0f;
+};
 
 /**
- * @brief Structure for PBR material properties.
- * This structure must match the PushConstants structure in the PBR shader.
+ * @brief Mesh uploads and buffers created for entity resources since startup.
+ */
+struct EntityBatchStats {
+    uint64_t batches = 0;              // preAllocateEntityResourcesBatch calls
+    uint64_t entities = 0;             // Entities they created resources for
+    uint64_t meshUploads = 0;          // Geometries copied to the arenas
+    uint64_t stagingBytes = 0;
+    uint64_t buffersCreated = 0;       // Staging buffers (a per-entity path creates one per mesh)
+    uint64_t submissions = 0;          // Transfer queue submissions
+};
+
+/**
+ * @brief Mesh geometry uploads and the components sharing them.
+ */
+struct GeometrySharingStats {
+    uint32_t residentMeshes = 0;       // Distinct geometries in the arenas
+    uint32_t meshReferences = 0;       // Components drawing from them
+    uint64_t deviceBytes = 0;          // Arena memory the resident geometries take
+    uint64_t duplicateBytesAvoided = 0; // What per-component uploads would have added
+};
+
+/**
+ * @brief Device memory returned by the memory pool compaction since startup.
+ */
+struct MemoryDefragmentationStats {
+    uint64_t relocations = 0;          // Buffers moved out of sparse blocks
+    uint64_t bytesMoved = 0;
+    uint64_t bytesReleased = 0;        // Empty blocks given back to the driver
+};
+
+/**
+ * @brief Images uploaded from memory that were identified by content.
+ */
+struct TextureDedupStats {
+    uint32_t uniqueImages = 0;         // Distinct payloads uploaded
+    uint32_t duplicateImages = 0;      // IDs aliased to an identical payload instead of uploaded
+    uint64_t duplicateBytesAvoided = 0; // Device memory those uploads would have taken
+};
+
+
+/**
+ * @brief Structure for material properties pushed to the lighting pipeline.
+ * This structure must match the PushConstants structure in the lighting shader.
  */
 struct MaterialProperties {
     alignas(16) glm::vec4 baseColorFactor;
@@ -108,6 +191,71 @@ struct MaterialProperties {
     alignas(4) bool hasEmissiveStrengthExtension;
 };
 
+/**
+ * @brief PBR material parameters, one entry per unique material in the bindless material buffer.
+ * Texture members are slots of the bindless texture array.
+ * This structure must match the MaterialData structure in the shaders (std430).
+ */
+struct MaterialData {
+    alignas(16) glm::vec4 baseColorFactor;
+    alignas(4) float metallicFactor;
+    alignas(4) float roughnessFactor;
+    alignas(4) int baseColorTextureSet;          // -1 = no texture
+    alignas(4) int physicalDescriptorTextureSet;
+    alignas(4) int normalTextureSet;
+    alignas(4) int occlusionTextureSet;
+    alignas(4) int emissiveTextureSet;
+    alignas(4) float alphaMask;
+    alignas(4) float alphaMaskCutoff;
+    alignas(16) glm::vec3 emissiveFactor;
+    alignas(4) float emissiveStrength;
+    alignas(4) float transmissionFactor;
+    alignas(4) int useSpecGlossWorkflow;
+    alignas(4) float glossinessFactor;
+    alignas(16) glm::vec3 specularFactor;
+    alignas(4) float ior;
+    alignas(4) int hasEmissiveStrengthExtension;
+    alignas(4) uint32_t baseColorTexture;
+    alignas(4) uint32_t metallicRoughnessTexture;
+    alignas(4) uint32_t normalTexture;
+    alignas(4) uint32_t occlusionTexture;
+    alignas(4) uint32_t emissiveTexture;
+};
+static_assert(sizeof(MaterialData) == 144, "MaterialData must match the std430 layout in the shaders");
+
+/**
+ * @brief Per-instance vertex data of the basic and PBR pipelines (binding 1).
+ *
+ * All entities' instances share one buffer, so each instance also names its
+ * entity's object slot and material entry; draws select an entity's range
+ * with firstInstance instead of binding a buffer or pushing constants.
+ */
+struct InstanceRecord {
+    InstanceData instance;
+    uint32_t objectIndex;    // Slot in the object storage buffer
+    uint32_t materialIndex;  // Entry in the bindless material buffer
+    uint32_t padding[2];
+
+    static vk::VertexInputBindingDescription getBindingDescription() {
+        return {1, sizeof(InstanceRecord), vk::VertexInputRate::eInstance};
+    }
+
+    // InstanceData's matrices (locations 4-10) followed by the two indices (location 11)
+    static std::array<vk::VertexInputAttributeDescription, 8> getAttributeDescriptions() {
+        std::array<vk::VertexInputAttributeDescription, 8> attributeDescriptions{};
+        auto instanceAttributes = InstanceData::getAttributeDescriptions();
+        std::ranges::copy(instanceAttributes, attributeDescriptions.begin());
+        attributeDescriptions[7] = vk::VertexInputAttributeDescription{
+            .location = 11,
+            .binding = 1,
+            .format = vk::Format::eR32G32Uint,
+            .offset = offsetof(InstanceRecord, objectIndex)
+        };
+        return attributeDescriptions;
+    }
+};
+static_assert(sizeof(InstanceRecord) == 128, "InstanceRecord must stay 16-byte aligned");
+
 /**
  * @brief Class for managing Vulkan rendering.
  *
@@ -174,6 +322,132 @@ public:
      */
     bool IsInitialized() const { return initialized; }
 
+    /**
+     * @brief Check if the renderer draws into offscreen images instead of a swapchain.
+     * @return True if running headless, false otherwise.
+     */
+    bool IsHeadless() const { return headless; }
+
+    /**
+     * @brief Get the GPU time of the most recently completed frame.
+     * Measured with timestamp queries around the frame's command buffer, so the
+     * value lags the CPU by up to MAX_FRAMES_IN_FLIGHT frames.
+     * @return The GPU frame time in milliseconds, or 0 if timestamps are unsupported.
+     */
+    double GetLastGpuFrameTimeMs() const { return gpuProfiler.GetLastZoneMs("Frame"); }
+
+    /**
+     * @brief Get the GPU timing layer (per-pass and compute dispatch timestamps).
+     * @return Reference to the GPU profiler.
+     */
+    GpuProfiler& GetGpuProfiler() { return gpuProfiler; }
+
+    /**
+     * @brief Get the pipeline cache shared by all pipelines created on this device.
+     * @return Reference to the pipeline cache.
+     */
+    const vk::raii::PipelineCache& GetPipelineCache() const { return pipelineCache; }
+
+    /**
+     * @brief Get the time spent creating the renderer's pipelines during initialization.
+     * @return The wall time in milliseconds.
+     */
+    double GetPipelineCreationMs() const { return pipelineCreationMs; }
+
+    /**
+     * @brief Check if the pipeline cache was loaded from disk (warm start).
+     * @return True if a valid cache file for this device was found, false otherwise.
+     */
+    bool IsPipelineCacheWarm() const { return pipelineCacheWarm; }
+
+    /**
+     * @brief Enable or disable CPU meshlet culling (frustum and normal cone) in the opaque pass.
+     * @param enable Whether to cull meshlets.
+     */
+    void SetMeshletCullingEnabled(bool enable) { meshletCullingEnabled = enable; }
+
+    /**
+     * @brief Check if meshlet culling is enabled.
+     * @return True if meshlets are culled, false otherwise.
+     */
+    bool IsMeshletCullingEnabled() const { return meshletCullingEnabled; }
+
+    /**
+     * @brief Enable or disable level of detail selection in the opaque pass.
+     * @param enable Whether to draw coarser levels of detail at a distance.
+     */
+    void SetLodEnabled(bool enable) { lodEnabled = enable; }
+
+    /**
+     * @brief Check if level of detail selection is enabled.
+     * @return True if coarser levels are drawn at a distance, false otherwise.
+     */
+    bool IsLodEnabled() const { return lodEnabled; }
+
+    /**
+     * @brief Set the largest projected error a level of detail may have.
+     * @param pixels The error threshold in pixels.
+     */
+    void SetLodErrorThreshold(float pixels) { lodErrorThreshold = pixels; }
+
+    /**
+     * @brief Get the level of detail error threshold.
+     * @return The error threshold in pixels.
+     */
+    float GetLodErrorThreshold() const { return lodErrorThreshold; }
+
+    /**
+     * @brief Enable or disable indirect submission of the opaque pass.
+     * @param enable Whether to write draws into the indirect buffer instead of recording them directly.
+     */
+    void SetIndirectDrawEnabled(bool enable) { indirectDrawEnabled = enable; }
+
+    /**
+     * @brief Check if indirect submission is enabled.
+     * @return True if the opaque pass is drawn with drawIndexedIndirect, false otherwise.
+     */
+    bool IsIndirectDrawEnabled() const { return indirectDrawEnabled && drawIndirectFirstInstanceSupported; }
+
+    /**
+     * @brief Get the draw statistics of the most recently recorded opaque pass.
+     * @return The opaque pass statistics.
+     */
+    OpaquePassStats GetOpaquePassStats() const { return lastOpaquePassStats; }
+
+    /**
+     * @brief Upload mesh geometry in the quantized PackedVertex layout.
+     * Must be called before Initialize(), since the pipelines' vertex input depends on it.
+     * @param enable Whether to use packed vertices.
+     */
+    void SetUsePackedVertices(bool enable) { usePackedVertices = enable; }
+
+    /**
+     * @brief Check if mesh geometry is uploaded as PackedVertex.
+     * @return True if packed vertices are used, false otherwise.
+     */
+    bool IsUsingPackedVertices() const { return usePackedVertices; }
+
+    /**
+     * @brief Get the size and round-trip error of the packed meshes uploaded so far.
+     * @return The vertex packing statistics.
+     */
+    VertexPackingStats GetVertexPackingStats() const {
+        std::lock_guard<std::mutex> lock(vertexPackingStatsMutex);
+        return vertexPackingStats;
+    }
+
+    /**
+     * @brief Get how many components share the uploaded mesh geometry.
+     * @return The geometry sharing statistics.
+     */
+    GeometrySharingStats GetGeometrySharingStats() const;
+
+    /**
+     * @brief Get the Vulkan objects created by batched entity resource creation.
+     * @return The batch statistics.
+     */
+    const EntityBatchStats& GetEntityBatchStats() const { return entityBatchStats; }
+
 
 
     /**
@@ -231,7 +505,7 @@ public:
      * @param commandBuffer The command buffer to submit.
      * @param fence The fence to signal when the operation completes.
      */
-    void SubmitToComputeQueue(vk::CommandBuffer commandBuffer, vk::Fence fence) const {
+    void SubmitToComputeQueue(vk::CommandBuffer commandBuffer, vk::Fence fence) {
         // Use mutex to ensure thread-safe access to queues
         vk::SubmitInfo submitInfo{
             .commandBufferCount = 1,
@@ -244,6 +518,7 @@ public:
         } else {
             graphicsQueue.submit(submitInfo, fence);
         }
+        gpuProfiler.SubmitZones(commandBuffer);
     }
 
     /**
@@ -313,52 +588,104 @@ public:
     // Vulkan work happens from a single thread while worker threads
     // perform only CPU-side decoding.
     //
-    // Parameters allow us to:
-    //  - limit the number of jobs processed per call (for streaming), and
-    //  - choose whether to include critical and/or non-critical jobs.
-    void ProcessPendingTextureJobs(uint32_t maxJobs = UINT32_MAX,
+    // Jobs are uploaded in order of the screen coverage of the entities
+    // using them (critical jobs first on ties) until the predicted cost of
+    // the next upload would exceed budgetMs. At least one job is uploaded
+    // per call. The flags choose whether to include critical and/or
+    // non-critical jobs.
+    void ProcessPendingTextureJobs(double budgetMs,
                                    bool includeCritical = true,
                                    bool includeNonCritical = true);
 
-    // Track which entities use a given texture ID so that descriptor sets
-    // can be refreshed when textures finish streaming in.
-    void RegisterTextureUser(const std::string& textureId, Entity* entity);
+    /**
+     * @brief Set the time per frame spent on texture uploads once the scene is shown.
+     * @param ms The budget in milliseconds.
+     */
+    void SetTextureStreamingBudgetMs(double ms) { textureStreamingBudgetMs = std::max(0.0, ms); }
+
+    /**
+     * @brief Get the texture streaming work of the last frame.
+     * @return The uploads, their time and the jobs still pending.
+     */
+    const TextureStreamingStats& GetTextureStreamingStats() const { return lastTextureStreamingStats; }
+
+    /**
+     * @brief Set the bytes per frame the memory pool compaction may copy.
+     * @param bytes The budget (0 disables relocation; empty blocks are still released).
+     */
+    void SetMemoryDefragmentationBudget(uint64_t bytes) { memoryDefragmentationBudget = bytes; }
+
+    /**
+     * @brief Get the memory pool compaction work since startup.
+     * @return The relocations and released blocks.
+     */
+    const MemoryDefragmentationStats& GetMemoryDefragmentationStats() const { return memoryDefragmentationStats; }
+
+    // Point the bindless slot of a texture ID at its uploaded image. The
+    // slot is rewritten in each frame's set before that frame is recorded.
     void OnTextureUploaded(const std::string& textureId);
 
+    /**
+     * @brief Release the GPU resources of an entity that is being destroyed.
+     *
+     * The instance range, object slot and geometry ranges are retired to the
+     * deletion queue and reused once the frames that may still draw the entity
+     * have finished. Call from the render thread between frames.
+     *
+     * @param entity The entity.
+     */
+    void ReleaseEntityResources(Entity* entity);
+
+    /**
+     * @brief Get the number of retired GPU objects waiting for their frames to finish.
+     * @return The number of entries.
+     */
+    size_t GetPendingDeletionCount() const { return deletionQueue.GetPendingCount(); }
+
+    /**
+     * @brief Limit the device memory textures may occupy.
+     *
+     * Least recently used textures beyond the budget are evicted to the default
+     * texture and streamed again when drawn. Useful to simulate a smaller device.
+     *
+     * @param bytes The budget in bytes, or 0 to derive it from the device memory budget.
+     */
+    void SetTextureMemoryBudget(uint64_t bytes) { textureBudgetOverride = bytes; }
+
+    /**
+     * @brief Get the texture residency statistics.
+     * @return The budget, resident memory and eviction counts.
+     */
+    TextureResidencyStats GetTextureResidencyStats() {
+        std::lock_guard<std::mutex> lock(bindlessMutex);
+        return textureResidency.GetStats();
+    }
+
+    /**
+     * @brief Get the content deduplication statistics of in-memory textures.
+     * @return The unique and duplicate image counts and the memory not uploaded.
+     */
+    TextureDedupStats GetTextureDedupStats() const {
+        std::shared_lock<std::shared_mutex> lock(textureResourcesMutex);
+        return textureDedupStats;
+    }
+
     // Global loading state (model/scene). Consider the scene "loading" while
     // either the model is being parsed/instantiated OR there are still
     // outstanding critical texture uploads (e.g., baseColor/albedo).
     bool IsLoading() const { return loadingFlag.load() || criticalJobsOutstanding.load() > 0; }
     void SetLoading(bool v) { loadingFlag.store(v); }
 
-    // Texture aliasing: map canonical IDs to actual loaded keys (e.g., file paths) to avoid duplicates
+    // Texture aliasing: map canonical IDs to actual loaded keys (e.g., file paths) to avoid duplicates.
+    // The alias map is kept flat (no value is itself an alias), so resolving is a single lookup.
     inline void RegisterTextureAlias(const std::string& aliasId, const std::string& targetId) {
         std::unique_lock<std::shared_mutex> lock(textureResourcesMutex);
-        if (aliasId.empty() || targetId.empty()) return;
-        // Resolve targetId without re-locking by walking the alias map directly
-        std::string resolved = targetId;
-        for (int i = 0; i < 8; ++i) {
-            auto it = textureAliases.find(resolved);
-            if (it == textureAliases.end()) break;
-            if (it->second == resolved) break;
-            resolved = it->second;
-        }
-        if (aliasId == resolved) {
-            textureAliases.erase(aliasId);
-        } else {
-            textureAliases[aliasId] = resolved;
-        }
+        registerTextureAliasLocked(aliasId, targetId);
     }
     inline std::string ResolveTextureId(const std::string& id) const {
         std::shared_lock<std::shared_mutex> lock(textureResourcesMutex);
-        std::string cur = id;
-        for (int i = 0; i < 8; ++i) { // prevent pathological cycles
-            auto it = textureAliases.find(cur);
-            if (it == textureAliases.end()) break;
-            if (it->second == cur) break; // self-alias guard
-            cur = it->second;
-        }
-        return cur;
+        auto it = textureAliases.find(id);
+        return it != textureAliases.end() ? it->second : id;
     }
 
     /**
@@ -472,6 +799,31 @@ public:
      */
     void updateAllDescriptorSetsWithNewLightBuffers();
 
+    /**
+     * @brief Create or resize the per-frame object storage buffers.
+     * @param objectCount The number of object slots to accommodate.
+     * @return True if successful, false otherwise.
+     */
+    bool createOrResizeObjectStorageBuffers(size_t objectCount);
+
+    /**
+     * @brief Update all existing descriptor sets with new object storage buffer references.
+     */
+    void updateAllDescriptorSetsWithNewObjectBuffers();
+
+    /**
+     * @brief Create or resize the per-frame material buffers.
+     * Every frame's buffer is marked dirty, so the whole table is uploaded again.
+     * @param materialCount The number of materials to accommodate.
+     * @return True if successful, false otherwise.
+     */
+    bool createOrResizeMaterialBuffers(size_t materialCount);
+
+    /**
+     * @brief Update the bindless descriptor sets with new material buffer references.
+     */
+    void updateAllDescriptorSetsWithNewMaterialBuffers();
+
     // Upload helper: record both layout transitions and the copy in a single submit with a fence
     void uploadImageFromStaging(vk::Buffer staging,
                                 vk::Image image,
@@ -492,9 +844,12 @@ public:
      * @brief Pre-allocate Vulkan resources for a batch of entities, batching mesh uploads.
      *
      * This variant is optimized for large scene loads (e.g., GLTF Bistro). It will:
-     *  - Create per-mesh GPU buffers as usual, but record all buffer copy commands
-     *    into a single command buffer and submit them in one batch.
-     *  - Then create uniform buffers and descriptor sets per entity.
+     *  - Sub-allocate the arena ranges of all new meshes, fill one pooled staging
+     *    buffer with their data and copy it with one command buffer submission.
+     *  - Then create the object slot, instance range and material of each entity;
+     *    none of them creates a buffer.
+     *  - Take the mesh references only once every entity has its resources; if
+     *    any step fails, the whole batch is rolled back.
      *
      * Callers that load many geometry entities at once (like GLTF scene loading)
      * should prefer this over repeated preAllocateEntityResources() calls.
@@ -520,6 +875,29 @@ private:
     // Platform
     Platform* platform = nullptr;
 
+    // Headless mode: no surface/swapchain, frames are rendered into offscreen images
+    bool headless = false;
+
+    // Level of detail selection: a coarser level is only taken once its projected error
+    // is below threshold * (1 - LOD_HYSTERESIS), so levels do not flicker at the boundary
+    static constexpr float LOD_HYSTERESIS = 0.25f;
+    bool lodEnabled = true;
+    float lodErrorThreshold = 1.0f;
+
+    // Meshlet culling (render thread only). Instanced meshes with more instances than the
+    // limit are drawn whole, since a meshlet is kept if any instance can see it.
+    static constexpr size_t MAX_MESHLET_CULLING_INSTANCES = 16;
+    bool meshletCullingEnabled = true;
+    bool indirectDrawEnabled = true;
+    OpaquePassStats lastOpaquePassStats;
+    OpaquePassStats opaquePassStats;
+    std::vector<std::pair<uint32_t, uint32_t>> meshletDrawRanges; // (firstIndex, indexCount)
+
+    // Vertex buffers hold PackedVertex instead of Vertex
+    bool usePackedVertices = false;
+    mutable std::mutex vertexPackingStatsMutex;
+    VertexPackingStats vertexPackingStats;
+
     // Model loader reference for accessing extracted lights
     class ModelLoader* modelLoader = nullptr;
 
@@ -556,6 +934,10 @@ private:
     vk::Extent2D swapChainExtent = {0, 0};
     std::vector<vk::raii::ImageView> swapChainImageViews;
 
+    // Offscreen render targets standing in for swapchain images in headless mode (one per frame in flight)
+    std::vector<vk::raii::Image> headlessImages;
+    std::vector<std::unique_ptr<MemoryPool::Allocation>> headlessImageAllocations;
+
     // Dynamic rendering info
     vk::RenderingInfo renderingInfo;
     std::vector<vk::RenderingAttachmentInfo> colorAttachments;
@@ -574,6 +956,12 @@ private:
     vk::raii::PipelineLayout lightingPipelineLayout = nullptr;
     vk::raii::Pipeline lightingPipeline = nullptr;
 
+    // Pipeline cache persisted between runs; only used when the header matches this device
+    static constexpr const char* PIPELINE_CACHE_PATH = "pipeline_cache.bin";
+    vk::raii::PipelineCache pipelineCache = nullptr;
+    bool pipelineCacheWarm = false;
+    double pipelineCreationMs = 0.0;
+
     // Pipeline rendering create info structures (for proper lifetime management)
     vk::PipelineRenderingCreateInfo mainPipelineRenderingCreateInfo;
     vk::PipelineRenderingCreateInfo pbrPipelineRenderingCreateInfo;
@@ -604,6 +992,10 @@ private:
     std::vector<vk::raii::Semaphore> renderFinishedSemaphores;
     std::vector<vk::raii::Fence> inFlightFences;
 
+    // GPU timestamp zones (frame, render passes, compute dispatches)
+    GpuProfiler gpuProfiler;
+    bool hostQueryResetEnabled = false;
+
     // Upload timeline semaphore for transfer -> graphics handoff (signaled per upload)
     vk::raii::Semaphore uploadsTimeline = nullptr;
     // Tracks last timeline value that has been submitted for signaling on uploadsTimeline
@@ -615,9 +1007,10 @@ private:
     vk::raii::ImageView depthImageView = nullptr;
 
     // Descriptor set layouts (declared before pools and sets)
-    vk::raii::DescriptorSetLayout descriptorSetLayout = nullptr;
-    vk::raii::DescriptorSetLayout pbrDescriptorSetLayout = nullptr;
-    vk::raii::DescriptorSetLayout transparentDescriptorSetLayout = nullptr;
+    vk::raii::DescriptorSetLayout descriptorSetLayout = nullptr;            // Lighting pipeline
+    vk::raii::DescriptorSetLayout globalDescriptorSetLayout = nullptr;      // Set 0: uniforms, lights, objects
+    vk::raii::DescriptorSetLayout transparentDescriptorSetLayout = nullptr; // Set 1: opaque scene color
+    vk::raii::DescriptorSetLayout bindlessDescriptorSetLayout = nullptr;    // Set 2: textures, materials
     vk::raii::PipelineLayout pbrTransparentPipelineLayout = nullptr;
 
     // The texture that will hold a snapshot of the opaque scene
@@ -632,27 +1025,83 @@ private:
     // Fallback descriptor sets for opaque pass (binds a default SHADER_READ_ONLY texture as Set 1)
     std::vector<vk::raii::DescriptorSet> transparentFallbackDescriptorSets;
 
+    // Per-frame global descriptor sets (Set 0), shared by every draw
+    std::vector<vk::raii::DescriptorSet> globalDescriptorSets;
+
+    // Bindless textures and materials (Set 2). Draws select their material with a push
+    // constant and materials reference textures by slot, so streaming a texture in only
+    // rewrites its slot. One set per frame in flight; a frame's set is only written after
+    // its fence has been waited on.
+    static constexpr uint32_t MAX_BINDLESS_TEXTURES = 4096;
+    uint32_t bindlessTextureCapacity = MAX_BINDLESS_TEXTURES; // Clamped to the update-after-bind sampler limits
+    vk::raii::DescriptorPool bindlessDescriptorPool = nullptr;
+    std::vector<vk::raii::DescriptorSet> bindlessDescriptorSets;
+
+    // Guards the texture slots, the material table and the pending descriptor writes
+    std::mutex bindlessMutex;
+    std::unordered_map<std::string, uint32_t> bindlessTextureSlots; // Canonical texture ID -> slot
+    std::vector<std::string> bindlessSlotTextureIds;                // Slot -> canonical texture ID (slot 0 is the default texture)
+    std::vector<std::vector<uint32_t>> pendingBindlessSlots;        // Per frame in flight: slots to rewrite
+    bool bindlessSlotsExhaustedWarned = false;
+
+    // Unique materials; identical parameter sets share one entry
+    std::vector<MaterialData> materials;
+    std::unordered_map<std::string, uint32_t> materialIndices;      // Raw MaterialData bytes -> index
+    std::vector<uint32_t> materialAlphaHintSlots;                   // Base color slot that can still turn on alpha masking (UINT32_MAX if none)
+    struct MaterialBuffer {
+        vk::raii::Buffer buffer = nullptr;
+        std::unique_ptr<MemoryPool::Allocation> allocation = nullptr;
+        void* mapped = nullptr;
+        size_t capacity = 0;    // In materials
+        size_t count = 0;       // Materials visible to the frame
+        size_t dirtyBegin = 0;  // Materials this buffer has not received yet
+        size_t dirtyEnd = 0;    // (empty when begin == end)
+    };
+    std::vector<MaterialBuffer> materialBuffers; // One per frame in flight
+
     // Mesh resources
+    // Keyed by geometry, so all components referencing the same MeshGeometry draw from one upload
     struct MeshResources {
-        // Device-local vertex/index buffers used for rendering
-        vk::raii::Buffer vertexBuffer = nullptr;
-        std::unique_ptr<MemoryPool::Allocation> vertexBufferAllocation = nullptr;
-        vk::raii::Buffer indexBuffer = nullptr;
-        std::unique_ptr<MemoryPool::Allocation> indexBufferAllocation = nullptr;
-        uint32_t indexCount = 0;
-
-        // Optional per-mesh staging buffers used when uploads are batched.
-        // These are populated when createMeshResources(..., deferUpload=true) is used
-        // and are consumed and cleared by preAllocateEntityResourcesBatch().
-        vk::raii::Buffer stagingVertexBuffer = nullptr;
-        vk::raii::DeviceMemory stagingVertexBufferMemory = nullptr;
-        vk::DeviceSize vertexBufferSizeBytes = 0;
-
-        vk::raii::Buffer stagingIndexBuffer = nullptr;
-        vk::raii::DeviceMemory stagingIndexBufferMemory = nullptr;
-        vk::DeviceSize indexBufferSizeBytes = 0;
+        std::shared_ptr<const MeshGeometry> geometry; // Keeps the key alive while the ranges are resident
+        uint32_t references = 0;         // Entity resources drawing from these ranges (one each)
+
+        // Ranges of the shared geometry arenas used for rendering
+        uint32_t vertexArena = 0;
+        int32_t vertexOffset = 0;        // First vertex within the vertex arena
+        uint32_t indexArena = 0;
+        uint32_t firstIndex = 0;         // First index within the index arena
+        uint32_t indexCount = 0;         // Base level; coarser levels follow it in the index arena
+        VertexQuantization quantization; // Used when the vertex buffer holds PackedVertex data
+        std::vector<MeshLod> lods;       // Base level first; empty if the mesh has a single level
+        glm::vec3 boundsCenter = glm::vec3(0.0f); // Mesh-space bounding sphere for LOD selection
+        float boundsRadius = 0.0f;
+        uint32_t vertexCount = 0;        // Size of the vertex arena range
+        uint32_t indexRangeCount = 0;    // Size of the index arena range (all levels)
+    };
+    std::unordered_map<const MeshGeometry*, MeshResources> meshResources;
+
+    // Device-local buffers that static geometry is sub-allocated from, so a pass binds
+    // them once instead of per mesh. Ranges of released meshes are reused (first fit).
+    // Meshes are only uploaded and released on the main thread, so the arenas need no lock.
+    struct GeometryArena {
+        vk::raii::Buffer buffer = nullptr;
+        std::unique_ptr<MemoryPool::Allocation> allocation = nullptr;
+        uint32_t capacity = 0;  // In elements (vertices or indices)
+        uint32_t used = 0;      // End of the allocated prefix
+        std::vector<std::pair<uint32_t, uint32_t>> freeRanges; // (first, count) below used, sorted and coalesced
     };
-    std::unordered_map<MeshComponent*, MeshResources> meshResources;
+    static constexpr vk::DeviceSize GEOMETRY_ARENA_BYTES = 64ull * 1024 * 1024;
+    std::vector<GeometryArena> vertexArenas;
+    std::vector<GeometryArena> indexArenas;
+
+    // Per-frame indirect draw commands for the opaque pass (host-visible, grown between frames)
+    std::vector<vk::raii::Buffer> indirectBuffers;
+    std::vector<std::unique_ptr<MemoryPool::Allocation>> indirectBufferAllocations;
+    std::vector<uint32_t> indirectBufferCapacity;
+    uint32_t indirectCommandsNeeded = 0;
+    bool multiDrawIndirectSupported = false;
+    uint32_t maxDrawIndirectCount = 1;
+    bool drawIndirectFirstInstanceSupported = false;
 
     // Texture resources
     struct TextureResources {
@@ -667,6 +1116,32 @@ private:
     };
     std::unordered_map<std::string, TextureResources> textureResources;
 
+    // Texture residency: LRU eviction against the device memory budget. The policy is
+    // keyed by bindless slot and guarded by bindlessMutex. Evicted textures are released
+    // once every frame's bindless set has been pointed back at the default texture.
+    static constexpr uint64_t RESIDENCY_UPDATE_INTERVAL = 10;   // Frames between budget checks
+    static constexpr uint64_t RESIDENCY_MIN_IDLE_FRAMES = 120;  // Frames a texture must be unused before eviction
+    TextureResidency textureResidency;
+    uint64_t textureBudgetOverride = 0;
+    bool memoryBudgetSupported = false;
+    uint64_t renderedFrameCount = 0;             // Render thread only; serial of the frame being recorded
+    uint64_t lastResidencyUpdateFrame = 0;
+    std::vector<uint64_t> materialLastUsedFrame; // Render thread only; written by the draw loops
+
+    // GPU objects retired while frames in flight may still use them. Each frame slot remembers
+    // the serial it last submitted; once its fence has signaled, everything retired with that
+    // serial or an older one is released.
+    DeletionQueue deletionQueue;
+    std::vector<uint64_t> frameSlotSerials;      // Per frame in flight
+    uint64_t completedFrameSerial = 0;
+
+    // Memory pool compaction. The per-frame instance storage and indirect buffers are the
+    // allocations the renderer can move; without candidates the step is retried every DEFRAGMENTATION_IDLE_FRAMES.
+    static constexpr uint64_t DEFRAGMENTATION_IDLE_FRAMES = 60;
+    uint64_t memoryDefragmentationBudget = 256 * 1024;
+    uint64_t nextDefragmentationFrame = 0;
+    MemoryDefragmentationStats memoryDefragmentationStats;
+
     // Pending texture jobs that require GPU-side work. Worker threads
     // enqueue these jobs; the main thread drains them and performs the
     // actual LoadTexture/LoadTextureFromMemory calls.
@@ -678,10 +1153,21 @@ private:
         int width = 0;
         int height = 0;
         int channels = 0;
+        uint64_t bytes = 0; // File size (FromFile) or decoded size (FromMemory), for the upload cost model
+        uint32_t waitedFrames = 0; // Frames the scheduler left the job pending
     };
 
     std::mutex pendingTextureJobsMutex;
     std::vector<PendingTextureJob> pendingTextureJobs;
+    // Streaming order and budget. Materials record the screen coverage of their entities
+    // while jobs are pending; the next frame ranks the jobs by the coverage of their slots.
+    static constexpr double LOADING_TEXTURE_STREAMING_BUDGET_MS = 25.0; // Behind the loading screen
+    double textureStreamingBudgetMs = 2.0;
+    TextureStreamScheduler textureStreamScheduler;
+    TextureStreamingStats lastTextureStreamingStats;
+    bool textureStreamingActive = false;         // Render thread only: jobs were pending at frame start
+    std::vector<float> materialScreenCoverage;   // Render thread only; pixels covered by each material's entities
+
     // Track outstanding critical texture jobs (for IsLoading)
     std::atomic<uint32_t> criticalJobsOutstanding{0};
 
@@ -690,17 +1176,17 @@ private:
     std::atomic<uint32_t> uploadJobsTotal{0};
     std::atomic<uint32_t> uploadJobsCompleted{0};
 
-    // Reverse mapping from texture ID to entities that reference it. Used to
-    // update descriptor sets when a streamed texture finishes uploading.
-    std::mutex textureUsersMutex;
-    std::unordered_map<std::string, std::vector<Entity*>> textureToEntities;
-
     // Protect concurrent access to textureResources
     mutable std::shared_mutex textureResourcesMutex;
 
     // Texture aliasing: maps alias (canonical) IDs to actual loaded keys
     std::unordered_map<std::string, std::string> textureAliases;
 
+    // Content identity of in-memory images: hash of pixels, size and format -> owning texture ID.
+    // Guarded by textureResourcesMutex like the alias map.
+    std::unordered_map<uint64_t, std::string> textureContentOwners;
+    TextureDedupStats textureDedupStats;
+
     // Per-texture load de-duplication (serialize loads of the same texture ID only)
     mutable std::mutex textureLoadStateMutex;
     std::condition_variable textureLoadStateCv;
@@ -739,22 +1225,75 @@ private:
     };
     std::vector<LightStorageBuffer> lightStorageBuffers; // One per frame in flight
 
-    // Entity resources (contains descriptor sets - must be declared before descriptor pool)
+    // Per-frame global uniforms (camera, tone mapping, light count), written once per frame
+    std::vector<vk::raii::Buffer> globalUniformBuffers;
+    std::vector<std::unique_ptr<MemoryPool::Allocation>> globalUniformBufferAllocations;
+    std::vector<void*> globalUniformBuffersMapped;
+
+    // Per-frame object data. Every entity owns a slot, named by its instance records.
+    struct ObjectStorageBuffer {
+        vk::raii::Buffer buffer = nullptr;
+        std::unique_ptr<MemoryPool::Allocation> allocation = nullptr;
+        void* mapped = nullptr;
+        size_t capacity = 0;  // In object slots
+    };
+    std::vector<ObjectStorageBuffer> objectStorageBuffers; // One per frame in flight
+    static constexpr vk::DeviceSize objectDataStride = sizeof(ObjectData);  // Array stride of the shader's StructuredBuffer
+    std::atomic<uint32_t> objectSlotCount{0};
+    std::mutex objectSlotMutex;              // Guards freeObjectSlots
+    std::vector<uint32_t> freeObjectSlots;   // Slots of released entities, reused before growing
+    std::mutex objectStorageBufferMutex;  // Guards buffer replacement against descriptor writes
+    // Objects per fill job; smaller frames are filled on the render thread alone
+    static constexpr size_t OBJECT_FILL_CHUNK = 2048;
+
+    // Per-frame instance records of all entities. Every entity owns a range (the same in each
+    // frame's buffer), so the passes bind the buffer once and select entities with firstInstance.
+    // Ranges are handed out by any thread; a frame's buffer only grows on the render thread
+    // before that frame's draws are recorded.
+    struct InstanceStorageBuffer {
+        vk::raii::Buffer buffer = nullptr;
+        std::unique_ptr<MemoryPool::Allocation> allocation = nullptr;
+        void* mapped = nullptr;
+        uint32_t capacity = 0;  // In instance records
+    };
+    std::vector<InstanceStorageBuffer> instanceStorageBuffers; // One per frame in flight
+    std::mutex instanceRangeMutex;  // Guards instanceRangeEnd and freeInstanceRanges
+    uint32_t instanceRangeEnd = 0;  // End of the allocated prefix
+    std::vector<std::pair<uint32_t, uint32_t>> freeInstanceRanges; // (first, count) below the end, sorted and coalesced
+
+    // Entity resources
     struct EntityResources {
-        std::vector<vk::raii::Buffer> uniformBuffers;
-        std::vector<std::unique_ptr<MemoryPool::Allocation>> uniformBufferAllocations;
-        std::vector<void*> uniformBuffersMapped;
-        std::vector<vk::raii::DescriptorSet> basicDescriptorSets;  // For basic pipeline
-        std::vector<vk::raii::DescriptorSet> pbrDescriptorSets;    // For PBR pipeline
-
-        // Instance buffer for instanced rendering
-        vk::raii::Buffer instanceBuffer = nullptr;
-        std::unique_ptr<MemoryPool::Allocation> instanceBufferAllocation = nullptr;
-        void* instanceBufferMapped = nullptr;
+        uint32_t objectIndex = 0;    // Slot in the object storage buffers
+        uint32_t materialIndex = 0;  // Entry in the material buffers
+        // meshResources key the entity holds a reference on; fixed at creation, so replacing
+        // the component's geometry later neither draws nor releases the wrong mesh
+        const MeshGeometry* geometry = nullptr;
+
+        // Range of the instance storage buffers holding the entity's instance records
+        uint32_t firstInstance = 0;
+        uint32_t instanceCapacity = 0;
+        // Records each frame's buffer has not received yet (empty when begin == end), so
+        // instances can change while earlier frames still read them
+        struct DirtyRange {
+            size_t begin = 0;
+            size_t end = 0;
+        };
+        std::vector<DirtyRange> instanceDirty; // One per frame in flight
+
+        void MarkInstancesDirty(size_t begin, size_t end) {
+            for (DirtyRange& range : instanceDirty) {
+                range.begin = range.begin == range.end ? begin : std::min(range.begin, begin);
+                range.end = std::max(range.end, end);
+            }
+        }
+
+        uint32_t lodLevel = 0; // Level of detail drawn last frame (for hysteresis)
     };
     std::unordered_map<Entity*, EntityResources> entityResources;
 
-    // Descriptor pool (declared after entity resources to ensure proper destruction order)
+    EntityBatchStats entityBatchStats;
+
+    // Descriptor pool for the global and scene color sets
     vk::raii::DescriptorPool descriptorPool = nullptr;
 
     // Current frame index
@@ -778,7 +1317,8 @@ private:
         VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
         VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME,
         VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME,
-        VK_EXT_ATTACHMENT_FEEDBACK_LOOP_DYNAMIC_STATE_EXTENSION_NAME
+        VK_EXT_ATTACHMENT_FEEDBACK_LOOP_DYNAMIC_STATE_EXTENSION_NAME,
+        VK_EXT_MEMORY_BUDGET_EXTENSION_NAME
     };
 
     // All device extensions (required + optional)
@@ -802,16 +1342,19 @@ private:
     void addSupportedOptionalExtensions();
     bool createLogicalDevice(bool enableValidationLayers);
     bool createSwapChain();
+    bool createHeadlessRenderTargets();
     bool createImageViews();
     bool setupDynamicRendering();
     bool createDescriptorSetLayout();
     bool createPBRDescriptorSetLayout();
+    bool createPipelineCache();
+    void savePipelineCache();
     bool createGraphicsPipeline();
 
     bool createPBRPipeline();
     bool createLightingPipeline();
     bool createComputePipeline();
-    void pushMaterialProperties(vk::CommandBuffer commandBuffer, const MaterialProperties& material) const;
+    bool createPipelinesInParallel(bool includeCompute);
     bool createCommandPool();
 
     // Shadow mapping methods
@@ -822,12 +1365,100 @@ private:
     bool createTextureSampler(TextureResources& resources);
     bool createDefaultTextureResources();
     bool createSharedDefaultPBRTextures();
-    bool createMeshResources(MeshComponent* meshComponent, bool deferUpload = false);
+    // Make a component's geometry resident; the caller takes the reference once the entity's resources exist
+    bool createMeshResources(MeshComponent* meshComponent);
+    // Upload new geometries (without references) through one staging buffer and one submission
+    bool uploadMeshes(const std::vector<std::shared_ptr<const MeshGeometry>>& meshes);
+    // Sub-allocate the arena ranges of a geometry (no references); the data is written by encodeMeshData
+    MeshResources allocateMeshResources(const std::shared_ptr<const MeshGeometry>& geometry);
+    // Undo a failed pre-allocation: release the resources created for the entities, which hold no
+    // mesh references yet, and the meshes uploaded for them that nothing references
+    void rollBackEntityResources(const std::vector<Entity*>& createdEntities,
+                                 const std::vector<std::shared_ptr<const MeshGeometry>>& uploadedMeshes);
+    // Write a geometry's vertices (packed if enabled) and its indices of all levels to staging memory
+    VertexQuantization encodeMeshData(const MeshGeometry& geometry, void* vertexData, void* indexData);
     bool createUniformBuffers(Entity* entity);
     bool createDescriptorPool();
-    bool createDescriptorSets(Entity* entity, const std::string& texturePath, bool usePBR = false);
+    bool createBindlessDescriptorSets();
+
+    /**
+     * @brief Get the bindless slot of a texture, assigning one on first use.
+     * A new slot shows the default texture until the texture has been uploaded.
+     * @param textureId The texture ID (aliases are resolved).
+     * @return The slot, or 0 (the default texture) if the array is full.
+     */
+    uint32_t getBindlessTextureSlot(const std::string& textureId);
+
+    /**
+     * @brief Build an entity's material from its model material and mesh textures.
+     * Identical materials are shared.
+     * @param entity The entity (its resources must exist).
+     * @return True if successful, false otherwise.
+     */
+    bool createEntityMaterial(Entity* entity);
+
+    /**
+     * @brief Write a frame's pending texture slots and material changes.
+     * @param frame The frame in flight (its previous submission must have completed).
+     * @return The number of materials the frame can reference.
+     */
+    size_t updateBindlessDescriptors(uint32_t frame);
+
+    /**
+     * @brief Track a newly uploaded texture for residency.
+     * @param textureId The texture ID.
+     * @param bytes The device memory of the texture.
+     * @param evictable True if the texture can be loaded again from its file.
+     */
+    void registerTextureResidency(const std::string& textureId, vk::DeviceSize bytes, bool evictable);
+
+    // Alias registration with textureResourcesMutex already held exclusively
+    void registerTextureAliasLocked(const std::string& aliasId, const std::string& targetId);
+
+    /**
+     * @brief Alias a texture ID to an already known image with identical content.
+     *
+     * The first ID seen with a given payload owns it; later IDs with the same pixels,
+     * size and format become aliases of the owner and are not uploaded again.
+     *
+     * @param textureId The texture ID.
+     * @param imageData The raw image data.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @param channels The number of channels in the image.
+     * @return True if the ID was aliased to another texture, false if it owns its payload.
+     */
+    bool deduplicateTextureContent(const std::string& textureId, const unsigned char* imageData,
+                                   int width, int height, int channels);
+
+    // Upload an in-memory image under its resolved ID (no content deduplication)
+    bool createTextureFromMemory(const std::string& textureId, const unsigned char* imageData,
+                                 int width, int height, int channels);
+
+    /**
+     * @brief Get the device memory textures may occupy.
+     * @return The budget in bytes.
+     */
+    uint64_t queryTextureMemoryBudget();
+
+    /**
+     * @brief Record texture use from the drawn materials, evict least recently used textures
+     * over the budget, stream evicted textures that are drawn again and release evicted
+     * textures no frame can reference anymore. Called once per frame before the bindless update.
+     */
+    void updateTextureResidency();
+
+    /**
+     * @brief Release memory pool blocks that stayed empty and move the instance storage and
+     * indirect buffers of a frame slot out of the sparsest host-visible block, within the
+     * per-frame budget.
+     * Called once the slot's previous frame has completed, before it is recorded.
+     * @param frame The frame slot.
+     */
+    void compactMemoryPool(uint32_t frame);
     bool createCommandBuffers();
     bool createSyncObjects();
+    bool createGpuProfiler();
 
     void cleanupSwapChain();
 
@@ -835,9 +1466,62 @@ private:
     void ensureThreadLocalVulkanInit() const;
     void recreateSwapChain();
 
-    void updateUniformBuffer(uint32_t currentImage, Entity* entity, CameraComponent* camera);
-    void updateUniformBuffer(uint32_t currentImage, Entity* entity, CameraComponent* camera, const glm::mat4& customTransform);
-    void updateUniformBufferInternal(uint32_t currentImage, Entity* entity, CameraComponent* camera, UniformBufferObject& ubo);
+    /**
+     * @brief Create the per-frame global uniform buffers and the initial object storage buffers.
+     * @return True if successful, false otherwise.
+     */
+    bool createGlobalUniformBuffers();
+
+    /**
+     * @brief Write the global uniforms and the light storage buffer of a frame.
+     * @param currentImage The frame in flight.
+     * @param camera The camera.
+     * @return The number of bytes written.
+     */
+    vk::DeviceSize updateGlobalUniformBuffer(uint32_t currentImage, CameraComponent* camera);
+
+    /**
+     * @brief Write the object data of every drawable entity into a frame's object storage buffer.
+     * Large scenes are split into jobs on the thread pool; the render thread fills chunks as well.
+     * @param currentImage The frame in flight.
+     * @param entities The scene entities.
+     * @return The number of bytes written.
+     */
+    vk::DeviceSize updateObjectStorageBuffer(uint32_t currentImage, const std::vector<std::unique_ptr<Entity>>& entities);
+
+    /**
+     * @brief Collect the visible meshlets of a mesh into meshletDrawRanges, merging adjacent ranges.
+     * @param meshComponent The mesh to cull.
+     * @param entityModel The entity model matrix.
+     * @param frustumPlanes The normalized world-space frustum planes (xyz = normal, w = distance).
+     * @param cameraPosition The camera position in world space.
+     * @return True if the ranges should be drawn instead of the whole mesh, false if the mesh cannot be culled.
+     */
+    bool cullMeshlets(const MeshComponent* meshComponent, const glm::mat4& entityModel,
+                      const std::array<glm::vec4, 6>& frustumPlanes, const glm::vec3& cameraPosition);
+
+    /**
+     * @brief Select the level of detail of a mesh from its projected screen-space error.
+     * @param meshComponent The mesh (its instances are considered).
+     * @param meshResources The mesh resources holding the levels and bounds.
+     * @param entityResources The entity resources holding the previous level.
+     * @param entityModel The entity model matrix.
+     * @param camera The camera.
+     * @return The level to draw (0 is the base mesh).
+     */
+    uint32_t selectLod(const MeshComponent* meshComponent, const MeshResources& meshResources, EntityResources& entityResources,
+                       const glm::mat4& entityModel, CameraComponent* camera);
+
+    /**
+     * @brief Estimate the screen area covered by a mesh, for texture streaming priority.
+     * @param meshComponent The mesh (its instances are summed).
+     * @param meshResources The mesh resources holding the bounds.
+     * @param entityModel The entity model matrix.
+     * @param camera The camera.
+     * @return The projected bounding sphere area in pixels, clamped to the viewport.
+     */
+    float projectedScreenCoverage(const MeshComponent* meshComponent, const MeshResources& meshResources,
+                                  const glm::mat4& entityModel, CameraComponent* camera) const;
 
     vk::raii::ShaderModule createShaderModule(const std::vector<char>& code);
 
@@ -857,7 +1541,96 @@ private:
     void createTransparentDescriptorSets();
     void createTransparentFallbackDescriptorSets();
     std::pair<vk::raii::Buffer, std::unique_ptr<MemoryPool::Allocation>> createBufferPooled(vk::DeviceSize size, vk::BufferUsageFlags usage, vk::MemoryPropertyFlags properties);
-    void copyBuffer(vk::raii::Buffer& srcBuffer, vk::raii::Buffer& dstBuffer, vk::DeviceSize size);
+    void copyBuffer(vk::raii::Buffer& srcBuffer, vk::raii::Buffer& dstBuffer, vk::DeviceSize size, vk::DeviceSize dstOffset = 0);
+
+    /**
+     * @brief Sub-allocate a range of a geometry arena, creating a new arena when none has room.
+     * @param arenas The vertex or index arenas.
+     * @param elementCount The number of vertices or indices to allocate.
+     * @param elementSize The size of one element in bytes.
+     * @param usage The buffer usage of a new arena.
+     * @param arenaIndex Receives the arena index.
+     * @return The first element of the range.
+     */
+    uint32_t allocateGeometry(std::vector<GeometryArena>& arenas, uint32_t elementCount, vk::DeviceSize elementSize,
+                              vk::BufferUsageFlags usage, uint32_t& arenaIndex);
+
+    /**
+     * @brief Return a range to its geometry arena for reuse.
+     * @param arenas The vertex or index arenas.
+     * @param arenaIndex The arena of the range.
+     * @param first The first element of the range.
+     * @param elementCount The number of elements.
+     */
+    void freeGeometry(std::vector<GeometryArena>& arenas, uint32_t arenaIndex, uint32_t first, uint32_t elementCount);
+
+    /**
+     * @brief Take a range from a sorted, coalesced free list (first fit).
+     * @param freeRanges The (first, count) free ranges.
+     * @param count The number of elements.
+     * @param first Receives the first element of the range.
+     * @return False if no free range is large enough.
+     */
+    static bool takeFreeRange(std::vector<std::pair<uint32_t, uint32_t>>& freeRanges, uint32_t count, uint32_t& first);
+
+    /**
+     * @brief Return a range to a free list, merging it with its neighbours.
+     * A range that ends at the allocated prefix shrinks the prefix instead.
+     * @param freeRanges The (first, count) free ranges.
+     * @param used The end of the allocated prefix.
+     * @param first The first element of the range.
+     * @param count The number of elements.
+     */
+    static void returnFreeRange(std::vector<std::pair<uint32_t, uint32_t>>& freeRanges, uint32_t& used, uint32_t first, uint32_t count);
+
+    /**
+     * @brief Give an entity an instance storage range for at least the given number of instances.
+     *
+     * A range that is too small is replaced (growing geometrically) and the old one is
+     * retired until the frames recorded so far have completed. A new range is queued for
+     * upload in every frame's buffer.
+     *
+     * @param resources The entity's resources.
+     * @param instanceCount The number of instances.
+     */
+    void reserveInstanceRange(EntityResources& resources, uint32_t instanceCount);
+
+    /**
+     * @brief Bring the instance storage buffer of a frame in flight up to date.
+     *
+     * Instance ranges the mesh components report as modified are queued on every frame's
+     * buffer; only the queued records of the given frame are copied. Called before the
+     * frame's draws are recorded, since the buffers may be reallocated.
+     *
+     * @param frame The frame in flight (its previous submission must have completed).
+     * @param entities The scene's entities.
+     * @return The number of bytes uploaded.
+     */
+    vk::DeviceSize updateInstanceStorage(uint32_t frame, const std::vector<std::unique_ptr<Entity>>& entities);
+
+    /**
+     * @brief Release a pooled buffer once the frames recorded so far have completed.
+     * @param buffer The buffer.
+     * @param allocation Its memory pool allocation (returned to the pool).
+     */
+    void retirePooledBuffer(vk::raii::Buffer&& buffer, std::unique_ptr<MemoryPool::Allocation>&& allocation);
+
+    /**
+     * @brief Make sure the indirect buffer of a frame holds at least the given number of commands.
+     * @param frame The frame in flight (its previous submission must have completed).
+     * @param commandCount The number of commands needed.
+     * @return True if the buffer is large enough, false otherwise.
+     */
+    bool ensureIndirectBufferCapacity(uint32_t frame, uint32_t commandCount);
+
+    /**
+     * @brief Make sure the instance storage buffer of a frame holds at least the given number of records.
+     * A grown buffer keeps the records of the old one.
+     * @param frame The frame in flight (its previous submission must have completed).
+     * @param instanceCount The number of instance records needed.
+     * @return True if the buffer is large enough, false otherwise.
+     */
+    bool ensureInstanceStorageCapacity(uint32_t frame, uint32_t instanceCount);
 
     std::pair<vk::raii::Image, vk::raii::DeviceMemory> createImage(uint32_t width, uint32_t height, vk::Format format, vk::ImageTiling tiling, vk::ImageUsageFlags usage, vk::MemoryPropertyFlags properties);
     std::pair<vk::raii::Image, std::unique_ptr<MemoryPool::Allocation>> createImagePooled(uint32_t width, uint32_t height, vk::Format format, vk::ImageTiling tiling, vk::ImageUsageFlags usage, vk::MemoryPropertyFlags properties, uint32_t mipLevels = 1);
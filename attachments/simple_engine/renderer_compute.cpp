@@ -76,7 +76,7 @@ bool Renderer::createComputePipeline() {
             .layout = *computePipelineLayout
         };
 
-        computePipeline = vk::raii::Pipeline(device, nullptr, pipelineInfo);
+        computePipeline = vk::raii::Pipeline(device, pipelineCache, pipelineInfo);
 
         // Create compute descriptor pool
         std::array<vk::DescriptorPoolSize, 2> poolSizes = {
@@ -229,8 +229,11 @@ vk::raii::Fence Renderer::DispatchCompute(uint32_t groupCountX, uint32_t groupCo
         descriptorSetsToBindRaw.push_back(*computeDescriptorSets[0]);
         commandBufferRaii.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *computePipelineLayout, 0, descriptorSetsToBindRaw, {});
 
-        // Dispatch compute shader
-        commandBufferRaii.dispatch(groupCountX, groupCountY, groupCountZ);
+        // Dispatch compute shader (the renderer's compute pipeline runs the HRTF kernel)
+        {
+            GPU_PROFILE_COMPUTE_ZONE(gpuProfiler, commandBufferRaii, "HRTFCompute");
+            commandBufferRaii.dispatch(groupCountX, groupCountY, groupCountZ);
+        }
 
         // End command buffer
         commandBufferRaii.end();
@@ -251,6 +254,7 @@ vk::raii::Fence Renderer::DispatchCompute(uint32_t groupCountX, uint32_t groupCo
             std::lock_guard<std::mutex> lock(queueMutex);
             computeQueue.submit(submitInfo, *computeFence);
         }
+        gpuProfiler.SubmitZones(rawCommandBuffer);
 
         // Return fence for non-blocking synchronization
         return computeFence;
@@ -32,10 +32,18 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallbackVkRaii(
 
 // Renderer core implementation for the "Rendering Pipeline" chapter of the tutorial.
 Renderer::Renderer(Platform* platform)
-    : platform(platform) {
+    : platform(platform), headless(platform && platform->IsHeadless()) {
     // Initialize deviceExtensions with required extensions only
     // Optional extensions will be added later after checking device support
     deviceExtensions = requiredDeviceExtensions;
+
+    // Headless rendering never presents, so the swapchain extension is not needed
+    // (software ICDs used on CI machines may not expose it without a WSI surface)
+    if (headless) {
+        std::erase_if(deviceExtensions, [](const char* ext) {
+            return std::strcmp(ext, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0;
+        });
+    }
 }
 
 // Destructor
@@ -58,8 +66,8 @@ bool Renderer::Initialize(const std::string& appName, bool enableValidationLayer
         return false;
     }
 
-    // Create surface
-    if (!createSurface()) {
+    // Create surface (headless rendering has no window to present to)
+    if (!headless && !createSurface()) {
         return false;
     }
 
@@ -111,25 +119,19 @@ bool Renderer::Initialize(const std::string& appName, bool enableValidationLayer
         return false;
     }
 
-    // Create the graphics pipeline
-    if (!createGraphicsPipeline()) {
+    // Create the global, scene color and bindless set layouts used by the basic and PBR pipelines
+    if (!createPBRDescriptorSetLayout()) {
         return false;
     }
 
-    // Create PBR pipeline
-    if (!createPBRPipeline()) {
+    // Create the pipeline cache (warm if a cache from a previous run on this device exists)
+    if (!createPipelineCache()) {
         return false;
     }
 
-    // Create the lighting pipeline
-    if (!createLightingPipeline()) {
-        std::cerr << "Failed to create lighting pipeline" << std::endl;
-        return false;
-    }
-
-    // Create compute pipeline
-    if (!createComputePipeline()) {
-        std::cerr << "Failed to create compute pipeline" << std::endl;
+    // Create the graphics, PBR, lighting and compute pipelines in parallel
+    if (!createPipelinesInParallel(true)) {
+        std::cerr << "Failed to create pipelines" << std::endl;
         return false;
     }
 
@@ -153,6 +155,10 @@ bool Renderer::Initialize(const std::string& appName, bool enableValidationLayer
         return false;
     }
 
+    if (!createGlobalUniformBuffers()) {
+        return false;
+    }
+
     if (!createOpaqueSceneColorResources()) {
         return false;
     }
@@ -174,6 +180,11 @@ bool Renderer::Initialize(const std::string& appName, bool enableValidationLayer
         return false;
     }
 
+    // Create the global and bindless descriptor sets (must occur after the default texture and buffers exist)
+    if (!createBindlessDescriptorSets()) {
+        return false;
+    }
+
 
     // Create command buffers
     if (!createCommandBuffers()) {
@@ -185,6 +196,11 @@ bool Renderer::Initialize(const std::string& appName, bool enableValidationLayer
         return false;
     }
 
+    // Create GPU timestamp queries (frame/pass/dispatch timing for profiling and benchmarks)
+    if (!createGpuProfiler()) {
+        return false;
+    }
+
     // Initialize background thread pool for async tasks (textures, etc.) AFTER all Vulkan resources are ready
     try {
         // Size the thread pool based on hardware concurrency, clamped to a sensible range
@@ -235,18 +251,15 @@ void Renderer::Cleanup() {
 
         // Wait for the device to be idle before cleaning up
         device.waitIdle();
-        for (auto& resources : entityResources | std::views::values) {
-            // Memory pool handles unmapping automatically, no need to manually unmap
-            resources.basicDescriptorSets.clear();
-            resources.pbrDescriptorSets.clear();
-            resources.uniformBuffers.clear();
-            resources.uniformBufferAllocations.clear();
-            resources.uniformBuffersMapped.clear();
-        }
-        // Also clear global descriptor sets that are allocated from descriptorPool, so they are
+        deletionQueue.Flush();
+        savePipelineCache();
+        gpuProfiler.Cleanup();
+        // Clear global descriptor sets that are allocated from descriptorPool, so they are
         // destroyed while the pool is still valid (avoid vkFreeDescriptorSets invalid pool errors)
         transparentDescriptorSets.clear();
         transparentFallbackDescriptorSets.clear();
+        globalDescriptorSets.clear();
+        bindlessDescriptorSets.clear();
         computeDescriptorSets.clear();
         std::cout << "Renderer cleanup completed." << std::endl;
         initialized = false;
@@ -270,9 +283,11 @@ bool Renderer::createInstance(const std::string& appName, bool enableValidationL
 
         // Add required extensions for GLFW
 #if defined(PLATFORM_DESKTOP)
-        uint32_t glfwExtensionCount = 0;
-        const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-        extensions.insert(extensions.end(), glfwExtensions, glfwExtensions + glfwExtensionCount);
+        if (!headless) {
+            uint32_t glfwExtensionCount = 0;
+            const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+            extensions.insert(extensions.end(), glfwExtensions, glfwExtensions + glfwExtensionCount);
+        }
 #endif
 
         // Add debug extension if validation layers are enabled
@@ -407,21 +422,30 @@ bool Renderer::pickPhysicalDevice() {
                 continue;
             }
 
-            // Check swap chain support
-            SwapChainSupportDetails swapChainSupport = querySwapChainSupport(_device);
-            bool swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
-            if (!swapChainAdequate) {
-                std::cout << "  - Inadequate swap chain support" << std::endl;
-                continue;
+            // Check swap chain support (not needed when rendering offscreen)
+            if (!headless) {
+                SwapChainSupportDetails swapChainSupport = querySwapChainSupport(_device);
+                bool swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
+                if (!swapChainAdequate) {
+                    std::cout << "  - Inadequate swap chain support" << std::endl;
+                    continue;
+                }
             }
 
             // Check for required features
-            auto features = _device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan13Features>();
+            auto features = _device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan13Features, vk::PhysicalDeviceDescriptorIndexingFeatures>();
             bool supportsRequiredFeatures = features.get<vk::PhysicalDeviceVulkan13Features>().dynamicRendering;
             if (!supportsRequiredFeatures) {
                 std::cout << "  - Does not support required features (dynamicRendering)" << std::endl;
                 continue;
             }
+            const auto& indexing = features.get<vk::PhysicalDeviceDescriptorIndexingFeatures>();
+            if (!indexing.runtimeDescriptorArray || !indexing.descriptorBindingPartiallyBound ||
+                !indexing.shaderSampledImageArrayNonUniformIndexing ||
+                !indexing.descriptorBindingSampledImageUpdateAfterBind || !indexing.descriptorBindingStorageBufferUpdateAfterBind) {
+                std::cout << "  - Does not support required features (descriptor indexing)" << std::endl;
+                continue;
+            }
 
             // Calculate suitability score - prioritize discrete GPUs
             int score = 0;
@@ -436,6 +460,11 @@ bool Renderer::pickPhysicalDevice() {
                 score += 100;
                 std::cout << "  - Integrated GPU: +100 points" << std::endl;
             }
+            // Software rasterizers (lavapipe, SwiftShader) are still usable for headless benchmarks
+            else if (deviceProperties.deviceType == vk::PhysicalDeviceType::eCpu) {
+                score += 1;
+                std::cout << "  - CPU (software) device: +1 point" << std::endl;
+            }
 
             // Add points for memory size (more VRAM is better)
             vk::PhysicalDeviceMemoryProperties memProperties = _device.getMemoryProperties();
@@ -539,6 +568,20 @@ bool Renderer::createLogicalDevice(bool enableValidationLayers) {
         features.features.samplerAnisotropy = vk::True;
         features.features.depthBiasClamp = vk::True;
 
+        // Multi-draw indirect is optional; without it each indirect command is its own call
+        multiDrawIndirectSupported = features.features.multiDrawIndirect == vk::True;
+        maxDrawIndirectCount = multiDrawIndirectSupported ? physicalDevice.getProperties().limits.maxDrawIndirectCount : 1u;
+        // Indirect commands carry each entity's firstInstance; without this feature it must be zero,
+        // so the opaque pass records direct draws instead
+        drawIndirectFirstInstanceSupported = features.features.drawIndirectFirstInstance == vk::True;
+        features.features.multiDrawIndirect = multiDrawIndirectSupported ? vk::True : vk::False;
+        features.features.drawIndirectFirstInstance = drawIndirectFirstInstanceSupported ? vk::True : vk::False;
+
+        // Heap budgets for texture residency; without the extension the heap sizes are used
+        memoryBudgetSupported = std::ranges::any_of(deviceExtensions, [](const char* ext) {
+            return std::strcmp(ext, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0;
+        });
+
         // Explicitly configure device features to prevent validation layer warnings
         // These features are required by extensions or other features, so we enable them explicitly
 
@@ -559,16 +602,34 @@ bool Renderer::createLogicalDevice(bool enableValidationLayers) {
         vk::PhysicalDevice8BitStorageFeatures storage8BitFeatures;
         storage8BitFeatures.storageBuffer8BitAccess = vk::True;
 
+        // Descriptor indexing features (bindless texture array and material buffer)
+        vk::PhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures;
+        descriptorIndexingFeatures.runtimeDescriptorArray = vk::True;
+        descriptorIndexingFeatures.descriptorBindingPartiallyBound = vk::True;
+        descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = vk::True;
+        descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = vk::True;
+        descriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = vk::True;
+
         // Enable Vulkan 1.3 features
         vk::PhysicalDeviceVulkan13Features vulkan13Features;
         vulkan13Features.dynamicRendering = vk::True;
         vulkan13Features.synchronization2 = vk::True;
 
+        // Host query reset (optional, lets GPU timing zones recycle queries without recording resets)
+        auto queryResetSupport = physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceHostQueryResetFeatures>();
+        hostQueryResetEnabled = queryResetSupport.get<vk::PhysicalDeviceHostQueryResetFeatures>().hostQueryReset;
+        vk::PhysicalDeviceHostQueryResetFeatures hostQueryResetFeatures;
+        hostQueryResetFeatures.hostQueryReset = vk::True;
+        if (hostQueryResetEnabled) {
+            vulkan13Features.pNext = &hostQueryResetFeatures;
+        }
+
         // Chain the feature structures together
         timelineSemaphoreFeatures.pNext = &memoryModelFeatures;
         memoryModelFeatures.pNext = &bufferDeviceAddressFeatures;
         bufferDeviceAddressFeatures.pNext = &storage8BitFeatures;
-        storage8BitFeatures.pNext = &vulkan13Features;
+        storage8BitFeatures.pNext = &descriptorIndexingFeatures;
+        descriptorIndexingFeatures.pNext = &vulkan13Features;
         features.pNext = &timelineSemaphoreFeatures;
 
         // Create a device. Device layers are deprecated and ignored, so we
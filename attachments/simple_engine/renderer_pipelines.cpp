@@ -1,8 +1,11 @@
 #include "renderer.h"
 #include <fstream>
 #include <array>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
 #include "mesh_component.h"
+#include "pipeline_cache_header.h"
 
 // This file contains pipeline-related methods from the Renderer class
 
@@ -42,11 +45,11 @@ bool Renderer::createDescriptorSetLayout() {
     }
 }
 
-// Create PBR descriptor set layout
+// Create the descriptor set layouts shared by the basic and PBR pipelines
 bool Renderer::createPBRDescriptorSetLayout() {
     try {
-        // Create descriptor set layout bindings for PBR shader
-        std::array bindings = {
+        // Layout for Set 0: per-frame data shared by every draw
+        std::array globalBindings = {
             // Binding 0: Uniform buffer (UBO)
             vk::DescriptorSetLayoutBinding{
                 .binding = 0,
@@ -55,72 +58,81 @@ bool Renderer::createPBRDescriptorSetLayout() {
                 .stageFlags = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
                 .pImmutableSamplers = nullptr
             },
-            // Binding 1: Base color map and sampler
+            // Binding 1: Light storage buffer
             vk::DescriptorSetLayoutBinding{
                 .binding = 1,
-                .descriptorType = vk::DescriptorType::eCombinedImageSampler,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
                 .descriptorCount = 1,
                 .stageFlags = vk::ShaderStageFlagBits::eFragment,
                 .pImmutableSamplers = nullptr
             },
-            // Binding 2: Metallic roughness map and sampler
+            // Binding 2: Object storage buffer (indexed with the instance records' object slot)
             vk::DescriptorSetLayoutBinding{
                 .binding = 2,
-                .descriptorType = vk::DescriptorType::eCombinedImageSampler,
-                .descriptorCount = 1,
-                .stageFlags = vk::ShaderStageFlagBits::eFragment,
-                .pImmutableSamplers = nullptr
-            },
-            // Binding 3: Normal map and sampler
-            vk::DescriptorSetLayoutBinding{
-                .binding = 3,
-                .descriptorType = vk::DescriptorType::eCombinedImageSampler,
-                .descriptorCount = 1,
-                .stageFlags = vk::ShaderStageFlagBits::eFragment,
-                .pImmutableSamplers = nullptr
-            },
-            // Binding 4: Occlusion map and sampler
-            vk::DescriptorSetLayoutBinding{
-                .binding = 4,
-                .descriptorType = vk::DescriptorType::eCombinedImageSampler,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
                 .descriptorCount = 1,
-                .stageFlags = vk::ShaderStageFlagBits::eFragment,
+                .stageFlags = vk::ShaderStageFlagBits::eVertex,
                 .pImmutableSamplers = nullptr
-            },
-            // Binding 5: Emissive map and sampler
+            }
+        };
+        vk::DescriptorSetLayoutCreateInfo globalLayoutInfo{
+            .bindingCount = static_cast<uint32_t>(globalBindings.size()),
+            .pBindings = globalBindings.data()
+        };
+        globalDescriptorSetLayout = vk::raii::DescriptorSetLayout(device, globalLayoutInfo);
+
+        // Layout for Set 1: Just the scene color texture (transparent passes input)
+        vk::DescriptorSetLayoutBinding sceneColorBinding{
+            .binding = 0, .descriptorType = vk::DescriptorType::eCombinedImageSampler, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eFragment
+        };
+        vk::DescriptorSetLayoutCreateInfo transparentLayoutInfo{ .bindingCount = 1, .pBindings = &sceneColorBinding };
+        transparentDescriptorSetLayout = vk::raii::DescriptorSetLayout(device, transparentLayoutInfo);
+
+        // Layout for Set 2: bindless texture array and material buffer. Slots that no material
+        // references yet may stay unwritten, and slots are rewritten while earlier frames'
+        // command buffers still hold the set bound.
+        auto indexingProperties = physicalDevice.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceDescriptorIndexingProperties>()
+                                      .get<vk::PhysicalDeviceDescriptorIndexingProperties>();
+        uint32_t samplerLimit = std::min(indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers,
+                                         indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages);
+        // Leave room for the scene color sampler of Set 1
+        bindlessTextureCapacity = std::min(MAX_BINDLESS_TEXTURES, samplerLimit > 16 ? samplerLimit - 16 : samplerLimit);
+
+        std::array bindlessBindings = {
+            // Binding 0: Texture array (indexed with material texture slots)
             vk::DescriptorSetLayoutBinding{
-                .binding = 5,
+                .binding = 0,
                 .descriptorType = vk::DescriptorType::eCombinedImageSampler,
-                .descriptorCount = 1,
+                .descriptorCount = bindlessTextureCapacity,
                 .stageFlags = vk::ShaderStageFlagBits::eFragment,
                 .pImmutableSamplers = nullptr
             },
-            // Binding 6: Light storage buffer (shadows removed)
+            // Binding 1: Material storage buffer (indexed with the instance records' material entry)
             vk::DescriptorSetLayoutBinding{
-                .binding = 6,
+                .binding = 1,
                 .descriptorType = vk::DescriptorType::eStorageBuffer,
                 .descriptorCount = 1,
                 .stageFlags = vk::ShaderStageFlagBits::eFragment,
                 .pImmutableSamplers = nullptr
             }
         };
-
-        // Create a descriptor set layout
-        vk::DescriptorSetLayoutCreateInfo layoutInfo{
-            .bindingCount = static_cast<uint32_t>(bindings.size()),
-            .pBindings = bindings.data()
+        std::array<vk::DescriptorBindingFlags, 2> bindlessFlags = {
+            vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind,
+            vk::DescriptorBindingFlagBits::eUpdateAfterBind
         };
-
-        pbrDescriptorSetLayout = vk::raii::DescriptorSetLayout(device, layoutInfo);
-
-        // Binding 7: transparent passes input
-        // Layout for Set 1: Just the scene color texture
-        vk::DescriptorSetLayoutBinding sceneColorBinding{
-            .binding = 0, .descriptorType = vk::DescriptorType::eCombinedImageSampler, .descriptorCount = 1, .stageFlags = vk::ShaderStageFlagBits::eFragment
+        vk::DescriptorSetLayoutBindingFlagsCreateInfo bindlessFlagsInfo{
+            .bindingCount = static_cast<uint32_t>(bindlessFlags.size()),
+            .pBindingFlags = bindlessFlags.data()
         };
-        vk::DescriptorSetLayoutCreateInfo transparentLayoutInfo{ .bindingCount = 1, .pBindings = &sceneColorBinding };
-        transparentDescriptorSetLayout = vk::raii::DescriptorSetLayout(device, transparentLayoutInfo);
+        vk::DescriptorSetLayoutCreateInfo bindlessLayoutInfo{
+            .pNext = &bindlessFlagsInfo,
+            .flags = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
+            .bindingCount = static_cast<uint32_t>(bindlessBindings.size()),
+            .pBindings = bindlessBindings.data()
+        };
+        bindlessDescriptorSetLayout = vk::raii::DescriptorSetLayout(device, bindlessLayoutInfo);
 
+        std::cout << "Bindless texture array: " << bindlessTextureCapacity << " slots" << std::endl;
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Failed to create PBR descriptor set layout: " << e.what() << std::endl;
@@ -128,6 +140,114 @@ bool Renderer::createPBRDescriptorSetLayout() {
     }
 }
 
+// Create the pipeline cache, seeded from disk when the stored data matches this device and driver
+bool Renderer::createPipelineCache() {
+    std::vector<char> initialData;
+    std::ifstream file(PIPELINE_CACHE_PATH, std::ios::binary | std::ios::ate);
+    if (file.is_open()) {
+        auto size = static_cast<size_t>(file.tellg());
+        if (size >= sizeof(VkPipelineCacheHeaderVersionOne)) {
+            initialData.resize(size);
+            file.seekg(0);
+            if (!file.read(initialData.data(), static_cast<std::streamsize>(size))) {
+                initialData.clear();
+            }
+        }
+    }
+
+    if (!initialData.empty()) {
+        vk::PhysicalDeviceProperties properties = physicalDevice.getProperties();
+        if (!PipelineCacheHeader::Matches(initialData.data(), initialData.size(), properties.vendorID, properties.deviceID,
+                                          properties.pipelineCacheUUID.data())) {
+            std::cout << "Pipeline cache " << PIPELINE_CACHE_PATH << " was written by a different device or driver, starting cold" << std::endl;
+            initialData.clear();
+        }
+    }
+
+    try {
+        vk::PipelineCacheCreateInfo createInfo{
+            .initialDataSize = initialData.size(),
+            .pInitialData = initialData.empty() ? nullptr : initialData.data()
+        };
+        pipelineCache = vk::raii::PipelineCache(device, createInfo);
+        pipelineCacheWarm = !initialData.empty();
+    } catch (const std::exception& e) {
+        // Retry without the stored data; an empty cache only costs compile time
+        std::cerr << "Failed to load pipeline cache, starting cold: " << e.what() << std::endl;
+        try {
+            pipelineCache = vk::raii::PipelineCache(device, vk::PipelineCacheCreateInfo{});
+            pipelineCacheWarm = false;
+        } catch (const std::exception& e2) {
+            std::cerr << "Failed to create pipeline cache: " << e2.what() << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "Pipeline cache: " << (pipelineCacheWarm ? "loaded " + std::to_string(initialData.size()) + " bytes" : std::string("empty")) << std::endl;
+    return true;
+}
+
+// Write the pipeline cache to disk (via a temporary file that is renamed into place)
+void Renderer::savePipelineCache() {
+    if (!*pipelineCache) {
+        return;
+    }
+    try {
+        std::vector<uint8_t> data = pipelineCache.getData();
+        const std::string tempPath = std::string(PIPELINE_CACHE_PATH) + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open() || !file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+                std::cerr << "Failed to write pipeline cache: " << tempPath << std::endl;
+                return;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tempPath, PIPELINE_CACHE_PATH, ec);
+        if (ec) {
+            std::cerr << "Failed to save pipeline cache: " << ec.message() << std::endl;
+            return;
+        }
+        std::cout << "Saved pipeline cache (" << data.size() << " bytes)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to save pipeline cache: " << e.what() << std::endl;
+    }
+}
+
+// Create the renderer's pipelines on worker threads. Each create function writes its own
+// layouts and pipelines; the only shared object is the (internally synchronized) pipeline cache.
+bool Renderer::createPipelinesInParallel(bool includeCompute) {
+    auto start = std::chrono::steady_clock::now();
+
+    auto launch = [this](bool (Renderer::*create)()) {
+        return std::async(std::launch::async, [this, create] {
+            ensureThreadLocalVulkanInit();
+            return (this->*create)();
+        });
+    };
+    std::vector<std::future<bool>> tasks;
+    tasks.push_back(launch(&Renderer::createGraphicsPipeline));
+    tasks.push_back(launch(&Renderer::createPBRPipeline));
+    tasks.push_back(launch(&Renderer::createLightingPipeline));
+    if (includeCompute) {
+        tasks.push_back(launch(&Renderer::createComputePipeline));
+    }
+
+    // Wait for every task before returning, even after a failure, so none outlives this call
+    bool success = true;
+    for (auto& task : tasks) {
+        success = task.get() && success;
+    }
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (includeCompute) {
+        pipelineCreationMs = elapsedMs;
+    }
+    std::cout << "Created " << tasks.size() << " pipeline groups in " << elapsedMs << " ms ("
+              << (pipelineCacheWarm ? "warm" : "cold") << " pipeline cache)" << std::endl;
+    return success;
+}
+
 // Create a graphics pipeline
 bool Renderer::createGraphicsPipeline() {
     try {
@@ -141,7 +261,7 @@ bool Renderer::createGraphicsPipeline() {
         vk::PipelineShaderStageCreateInfo vertShaderStageInfo{
             .stage = vk::ShaderStageFlagBits::eVertex,
             .module = *shaderModule,
-            .pName = "VSMain"
+            .pName = usePackedVertices ? "VSMainPacked" : "VSMain"
         };
 
         vk::PipelineShaderStageCreateInfo fragShaderStageInfo{
@@ -160,24 +280,21 @@ bool Renderer::createGraphicsPipeline() {
         vk::PipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
         // Create vertex input info with instancing support
-        auto vertexBindingDescription = Vertex::getBindingDescription();
-        auto instanceBindingDescription = InstanceData::getBindingDescription();
+        auto vertexBindingDescription = usePackedVertices ? PackedVertex::getBindingDescription() : Vertex::getBindingDescription();
+        auto instanceBindingDescription = InstanceRecord::getBindingDescription();
         std::array<vk::VertexInputBindingDescription, 2> bindingDescriptions = {
             vertexBindingDescription,
             instanceBindingDescription
         };
 
-        auto vertexAttributeDescriptions = Vertex::getAttributeDescriptions();
-        auto instanceAttributeDescriptions = InstanceData::getAttributeDescriptions();
+        auto vertexAttributeDescriptions = usePackedVertices ? PackedVertex::getAttributeDescriptions() : Vertex::getAttributeDescriptions();
+        auto instanceAttributeDescriptions = InstanceRecord::getAttributeDescriptions();
 
         // Combine all attribute descriptions (no duplicates)
         std::vector<vk::VertexInputAttributeDescription> allAttributeDescriptions;
         allAttributeDescriptions.insert(allAttributeDescriptions.end(), vertexAttributeDescriptions.begin(), vertexAttributeDescriptions.end());
         allAttributeDescriptions.insert(allAttributeDescriptions.end(), instanceAttributeDescriptions.begin(), instanceAttributeDescriptions.end());
 
-        // Note: materialIndex attribute (Location 11) is not used by current shaders
-        // Removed to fix validation layer error - shaders don't expect input at location 11
-
         vk::PipelineVertexInputStateCreateInfo vertexInputInfo{
             .vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size()),
             .pVertexBindingDescriptions = bindingDescriptions.data(),
@@ -248,12 +365,13 @@ bool Renderer::createGraphicsPipeline() {
             .pDynamicStates = dynamicStates.data()
         };
 
-        // Create pipeline layout
+        // Create pipeline layout. It matches the PBR layout, so the global and bindless
+        // sets stay bound when the opaque pass switches between the two pipelines. Object
+        // and material indices come with the instance records, so there are no push constants.
+        std::array<vk::DescriptorSetLayout, 3> setLayouts = {*globalDescriptorSetLayout, *transparentDescriptorSetLayout, *bindlessDescriptorSetLayout};
         vk::PipelineLayoutCreateInfo pipelineLayoutInfo{
-            .setLayoutCount = 1,
-            .pSetLayouts = &*descriptorSetLayout,
-            .pushConstantRangeCount = 0,
-            .pPushConstantRanges = nullptr
+            .setLayoutCount = static_cast<uint32_t>(setLayouts.size()),
+            .pSetLayouts = setLayouts.data()
         };
 
         pipelineLayout = vk::raii::PipelineLayout(device, pipelineLayoutInfo);
@@ -297,7 +415,7 @@ bool Renderer::createGraphicsPipeline() {
             .basePipelineIndex = -1
         };
 
-        graphicsPipeline = vk::raii::Pipeline(device, nullptr, pipelineInfo);
+        graphicsPipeline = vk::raii::Pipeline(device, pipelineCache, pipelineInfo);
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Failed to create graphics pipeline: " << e.what() << std::endl;
@@ -308,11 +426,6 @@ bool Renderer::createGraphicsPipeline() {
 // Create PBR pipeline
 bool Renderer::createPBRPipeline() {
     try {
-        // Create PBR descriptor set layout
-        if (!createPBRDescriptorSetLayout()) {
-            return false;
-        }
-
         // Read shader code
         auto shaderCode = readFile("shaders/pbr.spv");
 
@@ -323,7 +436,7 @@ bool Renderer::createPBRPipeline() {
         vk::PipelineShaderStageCreateInfo vertShaderStageInfo{
             .stage = vk::ShaderStageFlagBits::eVertex,
             .module = *shaderModule,
-            .pName = "VSMain"
+            .pName = usePackedVertices ? "VSMainPacked" : "VSMain"
         };
 
         vk::PipelineShaderStageCreateInfo fragShaderStageInfo{
@@ -342,23 +455,21 @@ bool Renderer::createPBRPipeline() {
         vk::PipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
         // Define vertex and instance binding descriptions
-        auto vertexBindingDescription = Vertex::getBindingDescription();
-        auto instanceBindingDescription = InstanceData::getBindingDescription();
+        auto vertexBindingDescription = usePackedVertices ? PackedVertex::getBindingDescription() : Vertex::getBindingDescription();
+        auto instanceBindingDescription = InstanceRecord::getBindingDescription();
         std::array<vk::VertexInputBindingDescription, 2> bindingDescriptions = {
             vertexBindingDescription,
             instanceBindingDescription
         };
 
         // Define vertex and instance attribute descriptions
-        auto vertexAttributeDescriptions = Vertex::getAttributeDescriptions();
-        auto instanceModelMatrixAttributes = InstanceData::getModelMatrixAttributeDescriptions();
-        auto instanceNormalMatrixAttributes = InstanceData::getNormalMatrixAttributeDescriptions();
+        auto vertexAttributeDescriptions = usePackedVertices ? PackedVertex::getAttributeDescriptions() : Vertex::getAttributeDescriptions();
+        auto instanceAttributeDescriptions = InstanceRecord::getAttributeDescriptions();
 
         // Combine all attribute descriptions
         std::vector<vk::VertexInputAttributeDescription> allAttributeDescriptions;
         allAttributeDescriptions.insert(allAttributeDescriptions.end(), vertexAttributeDescriptions.begin(), vertexAttributeDescriptions.end());
-        allAttributeDescriptions.insert(allAttributeDescriptions.end(), instanceModelMatrixAttributes.begin(), instanceModelMatrixAttributes.end());
-        allAttributeDescriptions.insert(allAttributeDescriptions.end(), instanceNormalMatrixAttributes.begin(), instanceNormalMatrixAttributes.end());
+        allAttributeDescriptions.insert(allAttributeDescriptions.end(), instanceAttributeDescriptions.begin(), instanceAttributeDescriptions.end());
 
         vk::PipelineVertexInputStateCreateInfo vertexInputInfo{
             .vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size()),
@@ -430,28 +541,18 @@ bool Renderer::createPBRPipeline() {
             .pDynamicStates = dynamicStates.data()
         };
 
-        // Create push constant range for material properties
-        vk::PushConstantRange pushConstantRange{
-            .stageFlags = vk::ShaderStageFlagBits::eFragment,
-            .offset = 0,
-            .size = sizeof(MaterialProperties)
-        };
-
-        std::array<vk::DescriptorSetLayout, 2> transparentSetLayouts = {*pbrDescriptorSetLayout, *transparentDescriptorSetLayout};
-        // Create a pipeline layout for opaque PBR with only the PBR descriptor set (set 0)
-        std::array<vk::DescriptorSetLayout, 1> pbrOnlySetLayouts = {*pbrDescriptorSetLayout};
-        // Create BOTH pipeline layouts with two descriptor sets (PBR set 0 + scene color set 1)
+        // Create BOTH pipeline layouts with three descriptor sets (global set 0 + scene color set 1 + bindless set 2);
+        // the object and material indices come with the instance records
+        std::array<vk::DescriptorSetLayout, 3> transparentSetLayouts = {*globalDescriptorSetLayout, *transparentDescriptorSetLayout, *bindlessDescriptorSetLayout};
         vk::PipelineLayoutCreateInfo pipelineLayoutInfo{
             .setLayoutCount = static_cast<uint32_t>(transparentSetLayouts.size()),
-            .pSetLayouts = transparentSetLayouts.data(),
-            .pushConstantRangeCount = 1,
-            .pPushConstantRanges = &pushConstantRange
+            .pSetLayouts = transparentSetLayouts.data()
         };
 
         pbrPipelineLayout = vk::raii::PipelineLayout(device, pipelineLayoutInfo);
 
         // Transparent PBR layout uses the same two-set layout
-        vk::PipelineLayoutCreateInfo transparentPipelineLayoutInfo{ .setLayoutCount = static_cast<uint32_t>(transparentSetLayouts.size()), .pSetLayouts = transparentSetLayouts.data(), .pushConstantRangeCount = 1, .pPushConstantRanges = &pushConstantRange };
+        vk::PipelineLayoutCreateInfo transparentPipelineLayoutInfo{ .setLayoutCount = static_cast<uint32_t>(transparentSetLayouts.size()), .pSetLayouts = transparentSetLayouts.data() };
         pbrTransparentPipelineLayout = vk::raii::PipelineLayout(device, transparentPipelineLayoutInfo);
 
         // Create pipeline rendering info
@@ -509,7 +610,7 @@ bool Renderer::createPBRPipeline() {
             .basePipelineHandle = nullptr,
             .basePipelineIndex = -1
         };
-        pbrGraphicsPipeline = vk::raii::Pipeline(device, nullptr, opaquePipelineInfo);
+        pbrGraphicsPipeline = vk::raii::Pipeline(device, pipelineCache, opaquePipelineInfo);
 
         // 2) Blended PBR pipeline (alpha blending, depth writes disabled for translucency)
         vk::PipelineColorBlendAttachmentState blendedAttachment = colorBlendAttachment;
@@ -547,7 +648,7 @@ bool Renderer::createPBRPipeline() {
             .basePipelineHandle = nullptr,
             .basePipelineIndex = -1
         };
-        pbrBlendGraphicsPipeline = vk::raii::Pipeline(device, nullptr, blendedPipelineInfo);
+        pbrBlendGraphicsPipeline = vk::raii::Pipeline(device, pipelineCache, blendedPipelineInfo);
 
         // 3) Glass pipeline (architectural glass) - uses the same vertex input and
         // descriptor layouts, but a dedicated fragment shader entry point
@@ -574,7 +675,7 @@ bool Renderer::createPBRPipeline() {
             .basePipelineHandle = nullptr,
             .basePipelineIndex = -1
         };
-        glassGraphicsPipeline = vk::raii::Pipeline(device, nullptr, glassPipelineInfo);
+        glassGraphicsPipeline = vk::raii::Pipeline(device, pipelineCache, glassPipelineInfo);
 
         return true;
     } catch (const std::exception& e) {
@@ -742,15 +843,10 @@ bool Renderer::createLightingPipeline() {
             .basePipelineIndex = -1
         };
 
-        lightingPipeline = vk::raii::Pipeline(device, nullptr, pipelineInfo);
+        lightingPipeline = vk::raii::Pipeline(device, pipelineCache, pipelineInfo);
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Failed to create lighting pipeline: " << e.what() << std::endl;
         return false;
     }
 }
-
-// Push material properties to the pipeline
-void Renderer::pushMaterialProperties(vk::CommandBuffer commandBuffer, const MaterialProperties& material) const {
-    commandBuffer.pushConstants(*pbrPipelineLayout, vk::ShaderStageFlagBits::eFragment, 0, sizeof(MaterialProperties), &material);
-}
@@ -2,6 +2,7 @@
 #include "imgui_system.h"
 #include "imgui/imgui.h"
 #include "model_loader.h"
+#include "profiler.h"
 #include <fstream>
 #include <stdexcept>
 #include <array>
@@ -9,13 +10,19 @@
 #include <iostream>
 #include <ranges>
 #include <cmath>
+#include <chrono>
 #include <ctime>
+#include <glm/gtc/constants.hpp>
 #include <glm/gtx/norm.hpp>
 
 // This file contains rendering-related methods from the Renderer class
 
 // Create swap chain
 bool Renderer::createSwapChain() {
+    if (headless) {
+        return createHeadlessRenderTargets();
+    }
+
     try {
         // Query swap chain support
         SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice);
@@ -79,6 +86,53 @@ bool Renderer::createSwapChain() {
     }
 }
 
+// Create offscreen render targets that stand in for swapchain images when running headless
+bool Renderer::createHeadlessRenderTargets() {
+    try {
+        int width = 0, height = 0;
+        platform->GetWindowSize(&width, &height);
+        if (width <= 0 || height <= 0) {
+            std::cerr << "Invalid headless render target size " << width << "x" << height << std::endl;
+            return false;
+        }
+
+        // Prefer the same sRGB format a desktop swapchain would typically use so output matches
+        vk::Format format = findSupportedFormat(
+            {vk::Format::eB8G8R8A8Srgb, vk::Format::eR8G8B8A8Srgb, vk::Format::eR8G8B8A8Unorm},
+            vk::ImageTiling::eOptimal,
+            vk::FormatFeatureFlagBits::eColorAttachment | vk::FormatFeatureFlagBits::eTransferDst
+        );
+
+        headlessImages.clear();
+        headlessImageAllocations.clear();
+        swapChainImages.clear();
+
+        // One target per frame in flight: the in-flight fence guarantees the target is idle before reuse
+        for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+            auto [image, allocation] = createImagePooled(
+                static_cast<uint32_t>(width),
+                static_cast<uint32_t>(height),
+                format,
+                vk::ImageTiling::eOptimal,
+                vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eTransferSrc,
+                vk::MemoryPropertyFlagBits::eDeviceLocal);
+            swapChainImages.push_back(*image);
+            headlessImages.push_back(std::move(image));
+            headlessImageAllocations.push_back(std::move(allocation));
+        }
+
+        swapChainImageFormat = format;
+        swapChainExtent = vk::Extent2D{static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+
+        std::cout << "Created " << headlessImages.size() << " headless render targets ("
+                  << width << "x" << height << ", " << vk::to_string(format) << ")" << std::endl;
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create headless render targets: " << e.what() << std::endl;
+        return false;
+    }
+}
+
 // Create image views
 bool Renderer::createImageViews() {
     try {
@@ -237,6 +291,7 @@ bool Renderer::createSyncObjects() {
         for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
             inFlightFences.emplace_back(device, fenceInfo);
         }
+        frameSlotSerials.resize(MAX_FRAMES_IN_FLIGHT, 0);
 
         // Ensure uploads timeline semaphore exists (created early in createLogicalDevice)
         // No action needed here unless reinitializing after swapchain recreation.
@@ -247,6 +302,18 @@ bool Renderer::createSyncObjects() {
     }
 }
 
+// Create GPU timestamp queries
+bool Renderer::createGpuProfiler() {
+    // Zones recycle their queries with host resets; without the feature GPU timing is skipped
+    if (!hostQueryResetEnabled) {
+        std::cout << "hostQueryReset not supported; GPU timings unavailable" << std::endl;
+        return true;
+    }
+    return gpuProfiler.Initialize(device, physicalDevice,
+                                  queueFamilyIndices.graphicsFamily.value(),
+                                  queueFamilyIndices.computeFamily.value());
+}
+
 // Clean up swap chain
 void Renderer::cleanupSwapChain() {
     // Clean up depth resources
@@ -274,8 +341,10 @@ void Renderer::cleanupSwapChain() {
     imageAvailableSemaphores.clear();
     renderFinishedSemaphores.clear();
 
-    // Clean up swap chain
+    // Clean up swap chain (or the offscreen targets standing in for it)
     swapChain = nullptr;
+    headlessImages.clear();
+    headlessImageAllocations.clear();
 }
 
 // Recreate swap chain
@@ -315,94 +384,32 @@ void Renderer::recreateSwapChain() {
         if (device.waitForFences(*fence, VK_TRUE, UINT64_MAX) != vk::Result::eSuccess) {}
     }
 
-    // Clear all entity descriptor sets since they're now invalid (allocated from the old pool)
-    for (auto& resources : entityResources | std::views::values) {
-        resources.basicDescriptorSets.clear();
-        resources.pbrDescriptorSets.clear();
-    }
-
-    createGraphicsPipeline();
-    createPBRPipeline();
-    createLightingPipeline();
+    createPipelinesInParallel(false);
 
     // Re-create command buffers to ensure fresh recording against new swapchain state
     commandBuffers.clear();
     createCommandBuffers();
     currentFrame = 0;
-
-    // Recreate descriptor sets for all entities after swapchain/pipeline rebuild
-    for (const auto& entity : entityResources | std::views::keys) {
-        if (!entity) continue;
-        auto meshComponent = entity->GetComponent<MeshComponent>();
-        if (!meshComponent) continue;
-
-        std::string texturePath = meshComponent->GetTexturePath();
-        // Fallback for basic pipeline: use baseColor when legacy path is empty
-        if (texturePath.empty()) {
-            const std::string& baseColor = meshComponent->GetBaseColorTexturePath();
-            if (!baseColor.empty()) {
-                texturePath = baseColor;
-            }
-        }
-        // Recreate basic descriptor sets (ignore failures here to avoid breaking resize)
-        createDescriptorSets(entity, texturePath, false);
-        // Recreate PBR descriptor sets
-        createDescriptorSets(entity, texturePath, true);
-    }
 }
 
-// Update uniform buffer
-void Renderer::updateUniformBuffer(uint32_t currentImage, Entity* entity, CameraComponent* camera) {
-    // Get entity resources
-    auto entityIt = entityResources.find(entity);
-    if (entityIt == entityResources.end()) {
-        return;
-    }
-
-    // Get transform component
-    auto transformComponent = entity->GetComponent<TransformComponent>();
-    if (!transformComponent) {
-        return;
+// Write the per-frame global uniforms (and the lights they count) once per frame
+vk::DeviceSize Renderer::updateGlobalUniformBuffer(uint32_t currentImage, CameraComponent* camera) {
+    if (currentImage >= globalUniformBuffersMapped.size() || !globalUniformBuffersMapped[currentImage]) {
+        return 0;
     }
 
-    // Create uniform buffer object
-    UniformBufferObject ubo{};
-    ubo.model = transformComponent->GetModelMatrix();
-    ubo.view = camera->GetViewMatrix();
-    ubo.proj = camera->GetProjectionMatrix();
-    ubo.proj[1][1] *= -1; // Flip Y for Vulkan
-
-    // Continue with the rest of the uniform buffer setup
-    updateUniformBufferInternal(currentImage, entity, camera, ubo);
-}
-
-// Overloaded version that accepts a custom transform matrix
-void Renderer::updateUniformBuffer(uint32_t currentImage, Entity* entity, CameraComponent* camera, const glm::mat4& customTransform) {
-    // Create the uniform buffer object with custom transform
     UniformBufferObject ubo{};
-    ubo.model = customTransform;
     ubo.view = camera->GetViewMatrix();
     ubo.proj = camera->GetProjectionMatrix();
     ubo.proj[1][1] *= -1; // Flip Y for Vulkan
 
-    // Continue with the rest of the uniform buffer setup
-    updateUniformBufferInternal(currentImage, entity, camera, ubo);
-}
-
-// Internal helper function to complete uniform buffer setup
-void Renderer::updateUniformBufferInternal(uint32_t currentImage, Entity* entity, CameraComponent* camera, UniformBufferObject& ubo) {
-    // Get entity resources
-    auto entityIt = entityResources.find(entity);
-    if (entityIt == entityResources.end()) {
-        return;
-    }
-
     // Use static lights loaded during model initialization. For the
     // current tutorial we render a fixed "night" scene lit only by
     // emissive-derived lights from the GLTF; any punctual
     // directional/point/spot lights are ignored.
     const std::vector<ExtractedLight>& extractedLights = staticLights;
 
+    vk::DeviceSize bytesWritten = 0;
     if (!extractedLights.empty()) {
         std::vector<ExtractedLight> lightsSubset;
         lightsSubset.reserve(std::min(extractedLights.size(), static_cast<size_t>(MAX_ACTIVE_LIGHTS)));
@@ -421,6 +428,7 @@ void Renderer::updateUniformBufferInternal(uint32_t currentImage, Entity* entity
             // Update the light storage buffer with emissive lights only
             updateLightStorageBuffer(currentImage, lightsSubset);
             ubo.lightCount = static_cast<int>(lightsSubset.size());
+            bytesWritten += sizeof(LightData) * lightsSubset.size();
         } else {
             ubo.lightCount = 0;
         }
@@ -447,49 +455,360 @@ void Renderer::updateUniformBufferInternal(uint32_t currentImage, Entity* entity
     ubo.padding0 = outputIsSRGB;
 
     // Copy to uniform buffer
-    std::memcpy(entityIt->second.uniformBuffersMapped[currentImage], &ubo, sizeof(ubo));
+    std::memcpy(globalUniformBuffersMapped[currentImage], &ubo, sizeof(ubo));
+    return bytesWritten + sizeof(ubo);
+}
+
+// Write one ObjectData slot per drawable entity, in parallel jobs for large scenes
+vk::DeviceSize Renderer::updateObjectStorageBuffer(uint32_t currentImage, const std::vector<std::unique_ptr<Entity>>& entities) {
+    if (!createOrResizeObjectStorageBuffers(objectSlotCount.load())) {
+        return 0;
+    }
+    auto* mapped = static_cast<char*>(objectStorageBuffers[currentImage].mapped);
+    if (!mapped) {
+        return 0;
+    }
+    const size_t capacity = objectStorageBuffers[currentImage].capacity;
+
+    // Resolve everything that touches shared maps on the render thread; the jobs then only
+    // read the entities' own transforms
+    struct ObjectFill {
+        TransformComponent* transform;
+        const VertexQuantization* quantization;
+        uint32_t objectIndex;
+    };
+    auto fills = std::make_shared<std::vector<ObjectFill>>();
+    fills->reserve(entityResources.size());
+    for (const auto& uptr : entities) {
+        Entity* entity = uptr.get();
+        if (!entity || !entity->IsActive()) continue;
+        auto* meshComponent = entity->GetComponent<MeshComponent>();
+        auto* transformComponent = entity->GetComponent<TransformComponent>();
+        if (!meshComponent || !transformComponent) continue;
+        auto entityIt = entityResources.find(entity);
+        if (entityIt == entityResources.end() || entityIt->second.objectIndex >= capacity) continue;
+        const VertexQuantization* quantization = nullptr;
+        if (usePackedVertices) {
+            auto meshIt = meshResources.find(entityIt->second.geometry);
+            if (meshIt != meshResources.end()) {
+                quantization = &meshIt->second.quantization;
+            }
+        }
+        fills->push_back({transformComponent, quantization, entityIt->second.objectIndex});
+    }
+
+    const vk::DeviceSize stride = objectDataStride;
+    auto fillRange = [fills, mapped, stride](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const ObjectFill& fill = (*fills)[i];
+            ObjectData object{};
+            object.model = fill.transform->GetModelMatrix();
+            // Dequantization range of packed vertex buffers (identity otherwise)
+            object.positionScale = fill.quantization ? glm::vec4(fill.quantization->positionScale, 1.0f) : glm::vec4(1.0f);
+            object.positionOffset = fill.quantization ? glm::vec4(fill.quantization->positionOffset, 0.0f) : glm::vec4(0.0f);
+            std::memcpy(mapped + fill.objectIndex * stride, &object, sizeof(object));
+        }
+    };
+
+    // Chunks are claimed by the render thread and any pool worker that gets to them, so a
+    // pool busy with texture jobs never delays the frame beyond the work itself
+    const size_t chunkCount = (fills->size() + OBJECT_FILL_CHUNK - 1) / OBJECT_FILL_CHUNK;
+    auto nextChunk = std::make_shared<std::atomic<size_t>>(0);
+    auto doneChunks = std::make_shared<std::atomic<size_t>>(0);
+    auto runChunks = [fills, fillRange, nextChunk, doneChunks, chunkCount]() {
+        for (size_t chunk = nextChunk->fetch_add(1); chunk < chunkCount; chunk = nextChunk->fetch_add(1)) {
+            fillRange(chunk * OBJECT_FILL_CHUNK, std::min(fills->size(), (chunk + 1) * OBJECT_FILL_CHUNK));
+            if (doneChunks->fetch_add(1) + 1 == chunkCount) {
+                doneChunks->notify_all();
+            }
+        }
+    };
+    if (chunkCount > 1) {
+        std::shared_lock<std::shared_mutex> lock(threadPoolMutex);
+        if (threadPool) {
+            for (size_t i = 1; i < chunkCount; ++i) {
+                threadPool->enqueue(runChunks);
+            }
+        }
+    }
+    runChunks();
+    for (size_t done = doneChunks->load(); done < chunkCount; done = doneChunks->load()) {
+        doneChunks->wait(done);
+    }
+    return fills->size() * sizeof(ObjectData);
+}
+
+// Write the instance records a frame's storage buffer has not received yet
+vk::DeviceSize Renderer::updateInstanceStorage(uint32_t frame, const std::vector<std::unique_ptr<Entity>>& entities) {
+    // Meshes without instance data draw a single identity instance to avoid a double
+    // transform with the object's model matrix
+    static const InstanceData identityInstance = [] {
+        InstanceData instance;
+        instance.setModelMatrix(glm::mat4(1.0f));
+        return instance;
+    }();
+
+    // Ranges first: an entity whose instance count outgrew its range moves to a new one
+    for (const auto& uptr : entities) {
+        Entity* entity = uptr.get();
+        if (!entity || !entity->IsActive()) continue;
+        auto* meshComponent = entity->GetComponent<MeshComponent>();
+        auto entityIt = meshComponent ? entityResources.find(entity) : entityResources.end();
+        if (entityIt == entityResources.end()) continue;
+        EntityResources& resources = entityIt->second;
+        reserveInstanceRange(resources, static_cast<uint32_t>(std::max<size_t>(meshComponent->GetInstanceCount(), 1)));
+        // Changes are queued on every frame's buffer, since each of them has to receive them once
+        size_t first = 0;
+        size_t last = 0;
+        if (meshComponent->TakeDirtyInstanceRange(first, last)) {
+            resources.MarkInstancesDirty(first, last);
+        }
+    }
+
+    uint32_t rangeEnd = 0;
+    {
+        std::lock_guard<std::mutex> lock(instanceRangeMutex);
+        rangeEnd = instanceRangeEnd;
+    }
+    if (!ensureInstanceStorageCapacity(frame, rangeEnd)) {
+        return 0;
+    }
+    InstanceStorageBuffer& storage = instanceStorageBuffers[frame];
+    auto* records = static_cast<InstanceRecord*>(storage.mapped);
+
+    vk::DeviceSize uploaded = 0;
+    for (const auto& uptr : entities) {
+        Entity* entity = uptr.get();
+        if (!entity || !entity->IsActive()) continue;
+        auto* meshComponent = entity->GetComponent<MeshComponent>();
+        auto entityIt = meshComponent ? entityResources.find(entity) : entityResources.end();
+        if (entityIt == entityResources.end()) continue;
+        EntityResources& resources = entityIt->second;
+        // Ranges handed out by loader threads since the capacity check are written next frame
+        if (resources.firstInstance + resources.instanceCapacity > storage.capacity) continue;
+
+        auto& dirty = resources.instanceDirty[frame];
+        const std::vector<InstanceData>& instances = meshComponent->GetInstances();
+        const InstanceData* source = instances.empty() ? &identityInstance : instances.data();
+        size_t count = std::max<size_t>(instances.size(), 1);
+        size_t dirtyEnd = std::min(dirty.end, count);
+        for (size_t i = dirty.begin; i < dirtyEnd; ++i) {
+            InstanceRecord& record = records[resources.firstInstance + i];
+            record.instance = source[i];
+            record.objectIndex = resources.objectIndex;
+            record.materialIndex = resources.materialIndex;
+        }
+        if (dirty.begin < dirtyEnd) {
+            uploaded += sizeof(InstanceRecord) * (dirtyEnd - dirty.begin);
+        }
+        dirty = {};
+    }
+    return uploaded;
+}
+
+// Pick the coarsest level whose projected error stays below the threshold for every instance
+uint32_t Renderer::selectLod(const MeshComponent* meshComponent, const MeshResources& meshResources, EntityResources& entityResources,
+                             const glm::mat4& entityModel, CameraComponent* camera) {
+    const std::vector<MeshLod>& lods = meshResources.lods;
+    if (!lodEnabled || !camera || lods.size() < 2) {
+        entityResources.lodLevel = 0;
+        return 0;
+    }
+
+    // Closest instance in mesh units (distance over scale), measured to the bounding sphere
+    // so a camera inside it always gets full detail
+    glm::vec3 cameraPosition = camera->GetPosition();
+    const std::vector<InstanceData>& instances = meshComponent->GetInstances();
+    size_t instanceCount = std::max<size_t>(1, instances.size());
+    float closestDistance = INFINITY;
+    for (size_t i = 0; i < instanceCount; ++i) {
+        glm::mat4 world = instances.empty() ? entityModel : entityModel * instances[i].getModelMatrix();
+        float scale = std::sqrt(std::max({glm::length2(glm::vec3(world[0])),
+                                          glm::length2(glm::vec3(world[1])),
+                                          glm::length2(glm::vec3(world[2]))}));
+        glm::vec3 center = glm::vec3(world * glm::vec4(meshResources.boundsCenter, 1.0f));
+        float distance = glm::length(center - cameraPosition) - meshResources.boundsRadius * scale;
+        if (distance <= 0.0f) {
+            entityResources.lodLevel = 0;
+            return 0;
+        }
+        closestDistance = std::min(closestDistance, distance / std::max(scale, 1e-6f));
+    }
+
+    auto projectedError = [&](uint32_t level) {
+        return camera->GetScreenSpaceError(lods[level].error, closestDistance, static_cast<float>(swapChainExtent.height));
+    };
+
+    uint32_t level = std::min(entityResources.lodLevel, static_cast<uint32_t>(lods.size() - 1));
+    while (level > 0 && projectedError(level) > lodErrorThreshold) {
+        level--;
+    }
+    while (level + 1 < lods.size() && projectedError(level + 1) <= lodErrorThreshold * (1.0f - LOD_HYSTERESIS)) {
+        level++;
+    }
+    entityResources.lodLevel = level;
+    return level;
+}
+
+// Projected bounding sphere area of all instances of a mesh, in pixels
+float Renderer::projectedScreenCoverage(const MeshComponent* meshComponent, const MeshResources& meshResources,
+                                        const glm::mat4& entityModel, CameraComponent* camera) const {
+    const float viewportArea = static_cast<float>(swapChainExtent.width) * static_cast<float>(swapChainExtent.height);
+    if (!camera) {
+        return 0.0f;
+    }
+
+    glm::vec3 cameraPosition = camera->GetPosition();
+    const std::vector<InstanceData>& instances = meshComponent->GetInstances();
+    size_t instanceCount = std::max<size_t>(1, instances.size());
+    float coverage = 0.0f;
+    for (size_t i = 0; i < instanceCount && coverage < viewportArea; ++i) {
+        glm::mat4 world = instances.empty() ? entityModel : entityModel * instances[i].getModelMatrix();
+        float scale = std::sqrt(std::max({glm::length2(glm::vec3(world[0])),
+                                          glm::length2(glm::vec3(world[1])),
+                                          glm::length2(glm::vec3(world[2]))}));
+        float radius = meshResources.boundsRadius * scale;
+        glm::vec3 center = glm::vec3(world * glm::vec4(meshResources.boundsCenter, 1.0f));
+        float distance = glm::length(center - cameraPosition) - radius;
+        if (distance <= 0.0f) {
+            // Camera inside the bounds
+            return viewportArea;
+        }
+        float radiusPixels = camera->GetScreenSpaceError(radius, distance, static_cast<float>(swapChainExtent.height));
+        coverage += glm::pi<float>() * radiusPixels * radiusPixels;
+    }
+    return std::min(coverage, viewportArea);
+}
+
+// Cull the meshlets of a mesh against the frustum and their normal cones
+bool Renderer::cullMeshlets(const MeshComponent* meshComponent, const glm::mat4& entityModel,
+                            const std::array<glm::vec4, 6>& frustumPlanes, const glm::vec3& cameraPosition) {
+    const std::vector<Meshlet>& meshlets = meshComponent->GetMeshlets();
+    const std::vector<InstanceData>& instances = meshComponent->GetInstances();
+    if (meshlets.size() < 2 || instances.size() > MAX_MESHLET_CULLING_INSTANCES ||
+        meshlets.back().firstIndex + meshlets.back().indexCount != meshComponent->GetIndices().size()) {
+        return false;
+    }
+
+    // World transform and mesh-space camera per instance. The cone test is skipped for
+    // mirrored transforms, which flip the winding and therefore the facing.
+    struct InstanceCullData {
+        glm::mat4 world;
+        float radiusScale;
+        glm::vec3 localCamera;
+        bool coneTest;
+    };
+    std::array<InstanceCullData, MAX_MESHLET_CULLING_INSTANCES> instanceData;
+    size_t instanceCount = std::max<size_t>(1, instances.size());
+    for (size_t i = 0; i < instanceCount; ++i) {
+        InstanceCullData& data = instanceData[i];
+        data.world = instances.empty() ? entityModel : entityModel * instances[i].getModelMatrix();
+        data.radiusScale = std::sqrt(std::max({glm::length2(glm::vec3(data.world[0])),
+                                               glm::length2(glm::vec3(data.world[1])),
+                                               glm::length2(glm::vec3(data.world[2]))}));
+        float det = glm::determinant(glm::mat3(data.world));
+        data.coneTest = det > 0.0f;
+        data.localCamera = data.coneTest ? glm::vec3(glm::inverse(data.world) * glm::vec4(cameraPosition, 1.0f)) : glm::vec3(0.0f);
+    }
+
+    meshletDrawRanges.clear();
+    for (const Meshlet& meshlet : meshlets) {
+        glm::vec3 center(meshlet.center[0], meshlet.center[1], meshlet.center[2]);
+
+        // A meshlet is drawn for every instance if any instance can see it
+        bool visible = false;
+        for (size_t i = 0; i < instanceCount && !visible; ++i) {
+            const InstanceCullData& data = instanceData[i];
+            glm::vec3 worldCenter = glm::vec3(data.world * glm::vec4(center, 1.0f));
+            float worldRadius = meshlet.radius * data.radiusScale;
+            bool inside = true;
+            for (const glm::vec4& plane : frustumPlanes) {
+                if (glm::dot(glm::vec3(plane), worldCenter) + plane.w < -worldRadius) {
+                    inside = false;
+                    break;
+                }
+            }
+            if (!inside) continue;
+            if (data.coneTest && MeshOptimizer::IsMeshletBackFacing(meshlet, &data.localCamera[0])) {
+                continue;
+            }
+            visible = true;
+        }
+
+        opaquePassStats.meshletsTested++;
+        if (!visible) continue;
+        opaquePassStats.meshletsVisible++;
+
+        // Meshlets are stored back to back in the index buffer, so neighbours merge into one draw
+        if (!meshletDrawRanges.empty() && meshletDrawRanges.back().first + meshletDrawRanges.back().second == meshlet.firstIndex) {
+            meshletDrawRanges.back().second += meshlet.indexCount;
+        } else {
+            meshletDrawRanges.emplace_back(meshlet.firstIndex, meshlet.indexCount);
+        }
+    }
+    return true;
 }
 
 // Render the scene
 void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, CameraComponent* camera, ImGuiSystem* imguiSystem) {
+    PROFILE_SCOPE("Renderer::Render");
     if (memoryPool) memoryPool->setRenderingActive(true);
     struct RenderingStateGuard { MemoryPool* pool; explicit RenderingStateGuard(MemoryPool* p) : pool(p) {} ~RenderingStateGuard() { if (pool) pool->setRenderingActive(false); } } guard(memoryPool.get());
 
-    if (device.waitForFences(*inFlightFences[currentFrame], VK_TRUE, UINT64_MAX) != vk::Result::eSuccess) {}
+    {
+        PROFILE_SCOPE("WaitForFrameFence");
+        if (device.waitForFences(*inFlightFences[currentFrame], VK_TRUE, UINT64_MAX) != vk::Result::eSuccess) {}
+    }
+
+    // Everything the slot's previous frame could reference is free now
+    completedFrameSerial = std::max(completedFrameSerial, frameSlotSerials[currentFrame]);
+    deletionQueue.Collect(completedFrameSerial);
+    compactMemoryPool(currentFrame);
+
+    // Resolve GPU zones of earlier frames and dispatches that have finished (never waits)
+    gpuProfiler.CollectResults(completedFrameSerial);
+    renderedFrameCount++;
 
     uint32_t imageIndex;
     vk::ResultValue<uint32_t> result{{},0};
-    try {
-        result = swapChain.acquireNextImage(UINT64_MAX, *imageAvailableSemaphores[currentFrame]);
-    } catch (const vk::OutOfDateKHRError&) {
-        // Swapchain is out of date (e.g., window resized) before we could
-        // query the result. Trigger recreation and exit this frame cleanly.
-        framebufferResized.store(true, std::memory_order_relaxed);
-        if (imguiSystem) ImGui::EndFrame();
-        recreateSwapChain();
-        return;
-    }
+    if (headless) {
+        // No presentation engine: each frame in flight owns one offscreen target
+        imageIndex = currentFrame;
+    } else {
+        PROFILE_SCOPE("AcquireNextImage");
+        try {
+            result = swapChain.acquireNextImage(UINT64_MAX, *imageAvailableSemaphores[currentFrame]);
+        } catch (const vk::OutOfDateKHRError&) {
+            // Swapchain is out of date (e.g., window resized) before we could
+            // query the result. Trigger recreation and exit this frame cleanly.
+            framebufferResized.store(true, std::memory_order_relaxed);
+            if (imguiSystem) ImGui::EndFrame();
+            recreateSwapChain();
+            return;
+        }
 
-    imageIndex = result.value;
+        imageIndex = result.value;
 
-    if (result.result == vk::Result::eErrorOutOfDateKHR || result.result == vk::Result::eSuboptimalKHR || framebufferResized.load(std::memory_order_relaxed)) {
-        framebufferResized.store(false, std::memory_order_relaxed);
-        if (imguiSystem) ImGui::EndFrame();
-        recreateSwapChain();
-        return;
-    }
-    if (result.result != vk::Result::eSuccess) {
-        throw std::runtime_error("Failed to acquire swap chain image");
+        if (result.result == vk::Result::eErrorOutOfDateKHR || result.result == vk::Result::eSuboptimalKHR || framebufferResized.load(std::memory_order_relaxed)) {
+            framebufferResized.store(false, std::memory_order_relaxed);
+            if (imguiSystem) ImGui::EndFrame();
+            recreateSwapChain();
+            return;
+        }
+        if (result.result != vk::Result::eSuccess) {
+            throw std::runtime_error("Failed to acquire swap chain image");
+        }
     }
 
     device.resetFences(*inFlightFences[currentFrame]);
+    frameSlotSerials[currentFrame] = renderedFrameCount;
     if (framebufferResized.load(std::memory_order_relaxed)) { recreateSwapChain(); return; }
 
     commandBuffers[currentFrame].reset();
     commandBuffers[currentFrame].begin(vk::CommandBufferBeginInfo());
     if (framebufferResized.load(std::memory_order_relaxed)) { commandBuffers[currentFrame].end(); recreateSwapChain(); return; }
 
-    // Process texture streaming uploads (see Renderer::ProcessPendingTextureJobs)
+    uint32_t gpuFrameZone = gpuProfiler.BeginZone(commandBuffers[currentFrame], "Frame");
 
     vk::raii::Pipeline* currentPipeline = nullptr;
     vk::raii::PipelineLayout* currentLayout = nullptr;
@@ -498,23 +817,22 @@ void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, Came
 
     // Incrementally process pending texture uploads on the main thread so that
     // all Vulkan submits happen from a single place while worker threads only
-    // handle CPU-side decoding. While the loading screen is up, prioritize
-    // critical textures so the first rendered frame looks mostly correct.
-    if (IsLoading()) {
-        // Larger budget while loading screen is visible so we don't stall
-        // streaming of near-field baseColor textures.
-        ProcessPendingTextureJobs(/*maxJobs=*/16, /*includeCritical=*/true, /*includeNonCritical=*/false);
-    } else {
-        // After loading screen disappears, we want the scene to remain
-        // responsive (~20 fps) while textures stream in. Limit the number
-        // of non-critical uploads per frame so we don't tank frame time.
-        static uint32_t streamingFrameCounter = 0;
-        streamingFrameCounter++;
-        // Only perform a small amount of streaming work every few frames.
-        if ((streamingFrameCounter % 3) == 0) {
-            ProcessPendingTextureJobs(/*maxJobs=*/1, /*includeCritical=*/false, /*includeNonCritical=*/true);
+    // handle CPU-side decoding. While the loading screen is up, only critical
+    // textures are uploaded, with a larger budget so the first rendered frame
+    // looks mostly correct. Afterwards the budget keeps the frame time steady.
+    {
+        PROFILE_SCOPE("TextureStreaming");
+        if (IsLoading()) {
+            ProcessPendingTextureJobs(LOADING_TEXTURE_STREAMING_BUDGET_MS, /*includeCritical=*/true, /*includeNonCritical=*/false);
+        } else {
+            ProcessPendingTextureJobs(textureStreamingBudgetMs, /*includeCritical=*/true, /*includeNonCritical=*/true);
         }
     }
+    // Record screen coverage for the next frame's streaming order only while jobs are pending
+    {
+        std::lock_guard<std::mutex> lk(pendingTextureJobsMutex);
+        textureStreamingActive = !pendingTextureJobs.empty();
+    }
 
     bool blockScene = false;
     if (imguiSystem) {
@@ -522,6 +840,7 @@ void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, Came
     }
 
     if (!blockScene) {
+        PROFILE_SCOPE("ClassifyTransparent");
         for (const auto& uptr : entities) {
             Entity* entity = uptr.get();
             if (!entity || !entity->IsActive()) continue;
@@ -557,6 +876,7 @@ void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, Came
 
     // Sort transparent entities back-to-front for correct blending of nested glass/liquids
     if (!blendedQueue.empty()) {
+        PROFILE_SCOPE("SortTransparent");
         // Sort by squared distance from the camera in world space.
         // Farther objects must be rendered first so that nearer glass correctly
         // appears in front (standard back-to-front transparency ordering).
@@ -618,8 +938,54 @@ void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, Came
         });
     }
 
+    // Evict textures over the memory budget before their slots are rewritten below
+    {
+        PROFILE_SCOPE("TextureResidency");
+        updateTextureResidency();
+    }
+
+    // Texture slots and materials that changed since this frame's bindless set was last written
+    size_t materialCount = 0;
+    {
+        PROFILE_SCOPE("UpdateBindless");
+        materialCount = updateBindlessDescriptors(currentFrame);
+    }
+    if (materialLastUsedFrame.size() < materialCount) {
+        materialLastUsedFrame.resize(materialCount, 0);
+    }
+    if (textureStreamingActive) {
+        materialScreenCoverage.assign(materialCount, 0.0f);
+    }
+
+    // Global uniforms once per frame, then one object slot per drawable entity
+    vk::DeviceSize uniformBytesWritten = 0;
+    double uniformUpdateMs = 0.0;
+    if (!blockScene && camera) {
+        PROFILE_SCOPE("UpdateUniforms");
+        auto uniformStart = std::chrono::steady_clock::now();
+        uniformBytesWritten = updateGlobalUniformBuffer(currentFrame, camera) + updateObjectStorageBuffer(currentFrame, entities);
+        uniformUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - uniformStart).count();
+    }
+    const size_t objectCapacity = objectStorageBuffers.empty() ? 0 : objectStorageBuffers[currentFrame].capacity;
+
+    // Instance records before any draw is recorded, since the frame's buffer may be reallocated
+    vk::DeviceSize instanceBytesUploaded = 0;
+    if (!blockScene) {
+        PROFILE_SCOPE("UpdateInstances");
+        instanceBytesUploaded = updateInstanceStorage(currentFrame, entities);
+    }
+    const InstanceStorageBuffer* instanceStorage =
+        currentFrame < instanceStorageBuffers.size() && *instanceStorageBuffers[currentFrame].buffer ? &instanceStorageBuffers[currentFrame] : nullptr;
+    // Entities whose range the frame's buffer does not cover yet are skipped for a frame
+    auto hasInstanceRecords = [instanceStorage](const EntityResources& resources) {
+        return instanceStorage && resources.instanceCapacity > 0 &&
+               resources.firstInstance + resources.instanceCapacity <= instanceStorage->capacity;
+    };
+
     // PASS 1: RENDER OPAQUE OBJECTS TO OFF-SCREEN TEXTURE
     {
+        PROFILE_SCOPE("OpaquePass");
+        GPU_PROFILE_ZONE(gpuProfiler, commandBuffers[currentFrame], "OpaquePass");
         vk::ImageMemoryBarrier barrier{ .srcAccessMask = vk::AccessFlagBits::eNone, .dstAccessMask = vk::AccessFlagBits::eColorAttachmentWrite, .oldLayout = vk::ImageLayout::eUndefined, .newLayout = vk::ImageLayout::eColorAttachmentOptimal, .image = *opaqueSceneColorImage, .subresourceRange = {vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1} };
         commandBuffers[currentFrame].pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eColorAttachmentOutput, {}, {}, {}, barrier);
         vk::RenderingAttachmentInfo colorAttachment{ .imageView = *opaqueSceneColorImageView, .imageLayout = vk::ImageLayout::eColorAttachmentOptimal, .loadOp = vk::AttachmentLoadOp::eClear, .storeOp = vk::AttachmentStoreOp::eStore, .clearValue = vk::ClearColorValue(std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f}) };
@@ -631,6 +997,71 @@ void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, Came
         commandBuffers[currentFrame].setViewport(0, viewport);
         vk::Rect2D scissor({0, 0}, swapChainExtent);
         commandBuffers[currentFrame].setScissor(0, scissor);
+
+        auto recordStart = std::chrono::steady_clock::now();
+        opaquePassStats = {};
+        opaquePassStats.uniformBytesWritten = uniformBytesWritten;
+        opaquePassStats.uniformUpdateMs = uniformUpdateMs;
+        opaquePassStats.instanceBytesUploaded = instanceBytesUploaded;
+
+        // Draws are written into this frame's indirect buffer, sized from the previous frame's
+        // demand; anything beyond its capacity falls back to direct draws for this frame.
+        // Devices without drawIndirectFirstInstance always draw directly.
+        bool useIndirectDraws = indirectDrawEnabled && drawIndirectFirstInstanceSupported;
+        vk::DrawIndexedIndirectCommand* indirectCommands = nullptr;
+        uint32_t indirectCapacity = 0;
+        uint32_t indirectCount = 0;
+        if (useIndirectDraws && ensureIndirectBufferCapacity(currentFrame, indirectCommandsNeeded) && indirectBufferAllocations[currentFrame]) {
+            indirectCommands = static_cast<vk::DrawIndexedIndirectCommand*>(indirectBufferAllocations[currentFrame]->mappedPtr);
+            indirectCapacity = indirectCommands ? indirectBufferCapacity[currentFrame] : 0;
+        }
+        uint32_t indirectDemand = 0;
+        uint32_t boundVertexArena = UINT32_MAX;
+        uint32_t boundIndexArena = UINT32_MAX;
+
+        // Commands gathered since the last flush share the pipeline and the bound arenas, and
+        // entities differ only in firstInstance, so they go out as one multi-draw
+        uint32_t pendingCommand = 0;
+        auto flushIndirectDraws = [&]() {
+            constexpr uint32_t stride = sizeof(vk::DrawIndexedIndirectCommand);
+            for (uint32_t command = pendingCommand; command < indirectCount; ) {
+                uint32_t drawCount = std::min(indirectCount - command, maxDrawIndirectCount);
+                commandBuffers[currentFrame].drawIndexedIndirect(*indirectBuffers[currentFrame], static_cast<vk::DeviceSize>(command) * stride, drawCount, stride);
+                command += drawCount;
+                opaquePassStats.drawCalls++;
+            }
+            pendingCommand = indirectCount;
+        };
+
+        // The basic and PBR layouts are identical, so these stay bound across pipeline switches:
+        // global set 0, a valid set 1 (fallback scene color) and the bindless set 2
+        commandBuffers[currentFrame].bindDescriptorSets(
+            vk::PipelineBindPoint::eGraphics,
+            *pbrPipelineLayout,
+            0,
+            { *globalDescriptorSets[currentFrame], *transparentFallbackDescriptorSets[currentFrame], *bindlessDescriptorSets[currentFrame] },
+            {}
+        );
+        // Instance records of all entities, bound once for the pass
+        if (instanceStorage) {
+            commandBuffers[currentFrame].bindVertexBuffers(1, {*instanceStorage->buffer}, {0});
+            opaquePassStats.bufferBinds++;
+        }
+
+        // World-space frustum planes for meshlet culling (Gribb/Hartmann). The near plane
+        // is taken as -w <= z, which also contains a [0, 1] depth range.
+        std::array<glm::vec4, 6> frustumPlanes{};
+        if (camera) {
+            glm::mat4 viewProj = glm::transpose(camera->GetProjectionMatrix() * camera->GetViewMatrix());
+            frustumPlanes = {viewProj[3] + viewProj[0], viewProj[3] - viewProj[0],
+                             viewProj[3] + viewProj[1], viewProj[3] - viewProj[1],
+                             viewProj[3] + viewProj[2], viewProj[3] - viewProj[2]};
+            for (glm::vec4& plane : frustumPlanes) {
+                float length = glm::length(glm::vec3(plane));
+                if (length > 0.0f) plane /= length;
+            }
+        }
+
         if (!blockScene) {
             for (const auto& uptr : entities) {
                 Entity* entity = uptr.get();
@@ -641,146 +1072,91 @@ void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, Came
                 vk::raii::Pipeline* selectedPipeline = useBasic ? &graphicsPipeline : &pbrGraphicsPipeline;
                 vk::raii::PipelineLayout* selectedLayout = useBasic ? &pipelineLayout : &pbrPipelineLayout;
                 if (currentPipeline != selectedPipeline) {
+                    flushIndirectDraws();
                     commandBuffers[currentFrame].bindPipeline(vk::PipelineBindPoint::eGraphics, **selectedPipeline);
                     currentPipeline = selectedPipeline;
                     currentLayout = selectedLayout;
                 }
-                auto meshIt = meshResources.find(meshComponent);
                 auto entityIt = entityResources.find(entity);
-                if (meshIt == meshResources.end() || entityIt == entityResources.end()) continue;
-                std::array<vk::Buffer, 2> buffers = {*meshIt->second.vertexBuffer, *entityIt->second.instanceBuffer};
-                std::array<vk::DeviceSize, 2> offsets = {0, 0};
-                commandBuffers[currentFrame].bindVertexBuffers(0, buffers, offsets);
-                commandBuffers[currentFrame].bindIndexBuffer(*meshIt->second.indexBuffer, 0, vk::IndexType::eUint32);
-                updateUniformBuffer(currentFrame, entity, camera);
-                auto& descSets = useBasic ? entityIt->second.basicDescriptorSets : entityIt->second.pbrDescriptorSets;
-                if (descSets.empty() || currentFrame >= descSets.size()) continue;
-                if (useBasic) {
-                    // Basic pipeline expects only set 0
-                    commandBuffers[currentFrame].bindDescriptorSets(
-                        vk::PipelineBindPoint::eGraphics,
-                        **currentLayout,
-                        0,
-                        { *descSets[currentFrame] },
-                        {}
-                    );
-                } else {
-                    // Opaque PBR pipeline: bind set 0 (PBR) and a valid set 1 (fallback scene color)
-                    vk::DescriptorSet set1Opaque = *transparentFallbackDescriptorSets[currentFrame];
-                    commandBuffers[currentFrame].bindDescriptorSets(
-                        vk::PipelineBindPoint::eGraphics,
-                        **currentLayout,
-                        0,
-                        { *descSets[currentFrame], set1Opaque },
-                        {}
-                    );
+                auto meshIt = entityIt != entityResources.end() ? meshResources.find(entityIt->second.geometry) : meshResources.end();
+                // Entities created after this frame's object and material data were written have no slot yet
+                if (meshIt == meshResources.end() || entityIt == entityResources.end() || !hasInstanceRecords(entityIt->second) ||
+                    entityIt->second.objectIndex >= objectCapacity || entityIt->second.materialIndex >= materialCount) continue;
+                // Arenas stay bound across meshes; switching one ends the current multi-draw
+                const MeshResources& mesh = meshIt->second;
+                const EntityResources& resources = entityIt->second;
+                if (boundVertexArena != mesh.vertexArena) {
+                    flushIndirectDraws();
+                    commandBuffers[currentFrame].bindVertexBuffers(0, {*vertexArenas[mesh.vertexArena].buffer}, {0});
+                    boundVertexArena = mesh.vertexArena;
+                    opaquePassStats.bufferBinds++;
                 }
-                if (!useBasic) {
-                    MaterialProperties pushConstants{};
-                    // Sensible defaults for entities without explicit material
-                    pushConstants.baseColorFactor = glm::vec4(1.0f);
-                    pushConstants.metallicFactor = 0.0f;
-                    pushConstants.roughnessFactor = 1.0f;
-                    pushConstants.baseColorTextureSet = 0; // sample bound baseColor (falls back to shared default if none)
-                    pushConstants.physicalDescriptorTextureSet = 0; // default to sampling metallic-roughness on binding 2
-                    pushConstants.normalTextureSet = -1;
-                    pushConstants.occlusionTextureSet = -1;
-                    pushConstants.emissiveTextureSet = -1;
-                    pushConstants.alphaMask = 0.0f;
-                    pushConstants.alphaMaskCutoff = 0.5f;
-                    pushConstants.emissiveFactor = glm::vec3(0.0f);
-                    pushConstants.emissiveStrength = 1.0f;
-                    pushConstants.hasEmissiveStrengthExtension = false; // Default entities don't have emissive strength extension
-                    pushConstants.transmissionFactor = 0.0f;
-                    pushConstants.useSpecGlossWorkflow = 0;
-                    pushConstants.glossinessFactor = 0.0f;
-                    pushConstants.specularFactor = glm::vec3(1.0f);
-                    // pushConstants.ior already 1.5f default
-                    if (modelLoader && entity->GetName().find("_Material_") != std::string::npos) {
-                        std::string entityName = entity->GetName();
-                        size_t tagPos = entityName.find("_Material_");
-                        if (tagPos != std::string::npos) {
-                            size_t afterTag = tagPos + std::string("_Material_").size();
-                            if (afterTag < entityName.length()) {
-                                // Entity name format: "modelName_Material_<index>_<materialName>"
-                                // Find the next underscore after the material index to get the actual material name
-                                std::string remainder = entityName.substr(afterTag);
-                                size_t nextUnderscore = remainder.find('_');
-                                if (nextUnderscore != std::string::npos && nextUnderscore + 1 < remainder.length()) {
-                                    std::string materialName = remainder.substr(nextUnderscore + 1);
-                                    Material* material = modelLoader->GetMaterial(materialName);
-                                    if (material) {
-                                        // Base factors
-                                        pushConstants.baseColorFactor = glm::vec4(material->albedo, material->alpha);
-                                        pushConstants.metallicFactor = material->metallic;
-                                        pushConstants.roughnessFactor = material->roughness;
-
-                                        // Texture set flags (-1 = no texture)
-                                        pushConstants.baseColorTextureSet = material->albedoTexturePath.empty() ? -1 : 0;
-                                        // physical descriptor: MR or SpecGloss
-                                        if (material->useSpecularGlossiness) {
-                                            pushConstants.useSpecGlossWorkflow = 1;
-                                            pushConstants.physicalDescriptorTextureSet = material->specGlossTexturePath.empty() ? -1 : 0;
-                                            pushConstants.glossinessFactor = material->glossinessFactor;
-                                            pushConstants.specularFactor = material->specularFactor;
-                                        } else {
-                                            pushConstants.useSpecGlossWorkflow = 0;
-                                            pushConstants.physicalDescriptorTextureSet = material->metallicRoughnessTexturePath.empty() ? -1 : 0;
-                                        }
-                                        pushConstants.normalTextureSet = material->normalTexturePath.empty() ? -1 : 0;
-                                        pushConstants.occlusionTextureSet = material->occlusionTexturePath.empty() ? -1 : 0;
-                                        pushConstants.emissiveTextureSet = material->emissiveTexturePath.empty() ? -1 : 0;
-
-                                        // Emissive and transmission/IOR
-                                        pushConstants.emissiveFactor = material->emissive;
-                                        pushConstants.emissiveStrength = material->emissiveStrength;
-                                        pushConstants.hasEmissiveStrengthExtension = false; // Material has emissive strength data
-                                        pushConstants.transmissionFactor = material->transmissionFactor;
-                                        pushConstants.ior = material->ior;
-
-                                        // Alpha mask handling
-                                        pushConstants.alphaMask = (material->alphaMode == "MASK") ? 1.0f : 0.0f;
-                                        pushConstants.alphaMaskCutoff = material->alphaCutoff;
-                                    }
-                                }
-                            }
-                        }
+                if (boundIndexArena != mesh.indexArena) {
+                    flushIndirectDraws();
+                    commandBuffers[currentFrame].bindIndexBuffer(*indexArenas[mesh.indexArena].buffer, 0, vk::IndexType::eUint32);
+                    boundIndexArena = mesh.indexArena;
+                    opaquePassStats.bufferBinds++;
+                }
+                uint32_t instanceCount = std::max(1u, static_cast<uint32_t>(meshComponent->GetInstanceCount()));
+                opaquePassStats.trianglesTotal += static_cast<uint64_t>(mesh.indexCount / 3) * instanceCount;
+
+                // Index ranges to draw, relative to the mesh: a coarser level, the visible meshlets
+                // (which only cover the base level) or the whole base level
+                auto transformComponent = entity->GetComponent<TransformComponent>();
+                uint32_t lodLevel = transformComponent ? selectLod(meshComponent, mesh, entityIt->second, transformComponent->GetModelMatrix(), camera) : 0;
+                if (lodLevel > 0) {
+                    meshletDrawRanges.assign(1, {mesh.lods[lodLevel].firstIndex, mesh.lods[lodLevel].indexCount});
+                    opaquePassStats.reducedLodDraws++;
+                } else if (!(meshletCullingEnabled && camera && transformComponent &&
+                             cullMeshlets(meshComponent, transformComponent->GetModelMatrix(), frustumPlanes, camera->GetPosition()))) {
+                    meshletDrawRanges.assign(1, {0u, mesh.indexCount});
+                }
+
+                auto rangeCount = static_cast<uint32_t>(meshletDrawRanges.size());
+                // Textures of culled entities count as unused for residency
+                if (rangeCount > 0) {
+                    materialLastUsedFrame[resources.materialIndex] = renderedFrameCount;
+                    if (textureStreamingActive) {
+                        float& coverage = materialScreenCoverage[resources.materialIndex];
+                        coverage = std::max(coverage, projectedScreenCoverage(meshComponent, mesh, transformComponent ? transformComponent->GetModelMatrix() : glm::mat4(1.0f), camera));
                     }
-                    // If no explicit MASK from a material, infer it from the baseColor texture's alpha usage
-                    if (pushConstants.alphaMask < 0.5f) {
-                        std::string baseColorPath;
-                        if (meshComponent) {
-                            if (!meshComponent->GetBaseColorTexturePath().empty()) {
-                                baseColorPath = meshComponent->GetBaseColorTexturePath();
-                            } else if (!meshComponent->GetTexturePath().empty()) {
-                                baseColorPath = meshComponent->GetTexturePath();
-                            } else {
-                                baseColorPath = SHARED_DEFAULT_ALBEDO_ID;
-                            }
-                        } else {
-                            baseColorPath = SHARED_DEFAULT_ALBEDO_ID;
-                        }
-                        // Avoid inferring MASK from the shared default albedo (semi-transparent placeholder)
-                        if (baseColorPath != SHARED_DEFAULT_ALBEDO_ID) {
-                            const std::string resolvedBase = ResolveTextureId(baseColorPath);
-                            std::shared_lock<std::shared_mutex> texLock(textureResourcesMutex);
-                            auto itTex = textureResources.find(resolvedBase);
-                            if (itTex != textureResources.end() && itTex->second.alphaMaskedHint) {
-                                pushConstants.alphaMask = 1.0f;
-                                pushConstants.alphaMaskCutoff = 0.5f;
-                            }
-                        }
+                }
+                indirectDemand += rangeCount;
+                if (indirectCount + rangeCount <= indirectCapacity) {
+                    // Issued with the next flush; without multiDrawIndirect every command is its own call
+                    for (const auto& [firstIndex, indexCount] : meshletDrawRanges) {
+                        indirectCommands[indirectCount++] = vk::DrawIndexedIndirectCommand{
+                            .indexCount = indexCount,
+                            .instanceCount = instanceCount,
+                            .firstIndex = mesh.firstIndex + firstIndex,
+                            .vertexOffset = mesh.vertexOffset,
+                            .firstInstance = resources.firstInstance
+                        };
+                    }
+                } else {
+                    for (const auto& [firstIndex, indexCount] : meshletDrawRanges) {
+                        commandBuffers[currentFrame].drawIndexed(indexCount, instanceCount, mesh.firstIndex + firstIndex, mesh.vertexOffset, resources.firstInstance);
+                        opaquePassStats.drawCalls++;
                     }
-                    commandBuffers[currentFrame].pushConstants<MaterialProperties>(**currentLayout, vk::ShaderStageFlagBits::eFragment, 0, { pushConstants });
                 }
-                uint32_t instanceCount = std::max(1u, static_cast<uint32_t>(meshComponent->GetInstanceCount()));
-                commandBuffers[currentFrame].drawIndexed(meshIt->second.indexCount, instanceCount, 0, 0, 0);
+                for (const auto& [firstIndex, indexCount] : meshletDrawRanges) {
+                    opaquePassStats.trianglesSubmitted += static_cast<uint64_t>(indexCount / 3) * instanceCount;
+                }
+                opaquePassStats.drawCommands += rangeCount;
             }
+            flushIndirectDraws();
+        }
+        if (useIndirectDraws) {
+            indirectCommandsNeeded = indirectDemand;
         }
+        opaquePassStats.recordMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - recordStart).count();
+        lastOpaquePassStats = opaquePassStats;
         commandBuffers[currentFrame].endRendering();
     }
     // BARRIER AND COPY
     {
+        PROFILE_SCOPE("CopyOpaqueToTarget");
+        GPU_PROFILE_ZONE(gpuProfiler, commandBuffers[currentFrame], "CopyOpaqueToTarget");
         vk::ImageMemoryBarrier opaqueSrcBarrier{ .srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite, .dstAccessMask = vk::AccessFlagBits::eTransferRead, .oldLayout = vk::ImageLayout::eColorAttachmentOptimal, .newLayout = vk::ImageLayout::eTransferSrcOptimal, .image = *opaqueSceneColorImage, .subresourceRange = {vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1} };
         commandBuffers[currentFrame].pipelineBarrier(vk::PipelineStageFlagBits::eColorAttachmentOutput, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, opaqueSrcBarrier);
         vk::ImageMemoryBarrier swapchainDstBarrier{ .srcAccessMask = vk::AccessFlagBits::eNone, .dstAccessMask = vk::AccessFlagBits::eTransferWrite, .oldLayout = vk::ImageLayout::eUndefined, .newLayout = vk::ImageLayout::eTransferDstOptimal, .image = swapChainImages[imageIndex], .subresourceRange = {vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1} };
@@ -794,6 +1170,8 @@ void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, Came
     }
     // PASS 2: RENDER TRANSPARENT OBJECTS TO THE SWAPCHAIN
     {
+        PROFILE_SCOPE("TransparentPass");
+        GPU_PROFILE_ZONE(gpuProfiler, commandBuffers[currentFrame], "TransparentPass");
         colorAttachments[0].imageView = *swapChainImageViews[imageIndex];
         colorAttachments[0].loadOp = vk::AttachmentLoadOp::eLoad;
         depthAttachment.loadOp = vk::AttachmentLoadOp::eLoad;
@@ -807,16 +1185,31 @@ void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, Came
         if (!blendedQueue.empty()) {
             currentLayout = &pbrTransparentPipelineLayout;
 
+            // Bind global (set 0), scene color (set 1) and bindless (set 2) once for the pass.
+            // If primary set 1 is unavailable, use fallback.
+            vk::DescriptorSet set1 = transparentDescriptorSets.empty()
+                ? *transparentFallbackDescriptorSets[currentFrame]
+                : *transparentDescriptorSets[currentFrame];
+            commandBuffers[currentFrame].bindDescriptorSets(
+                vk::PipelineBindPoint::eGraphics,
+                **currentLayout,
+                0,
+                { *globalDescriptorSets[currentFrame], set1, *bindlessDescriptorSets[currentFrame] },
+                {}
+            );
+
             // Track currently bound pipeline so we only rebind when needed
             vk::raii::Pipeline* activeTransparentPipeline = nullptr;
 
             for (Entity* entity : blendedQueue) {
                 auto meshComponent = entity->GetComponent<MeshComponent>();
                 auto entityIt = entityResources.find(entity);
-                auto meshIt = meshResources.find(meshComponent);
-                if (!meshComponent || entityIt == entityResources.end() || meshIt == meshResources.end()) continue;
+                auto meshIt = entityIt != entityResources.end() ? meshResources.find(entityIt->second.geometry) : meshResources.end();
+                if (!meshComponent || entityIt == entityResources.end() || meshIt == meshResources.end() ||
+                    !hasInstanceRecords(entityIt->second) || entityIt->second.objectIndex >= objectCapacity ||
+                    entityIt->second.materialIndex >= materialCount) continue;
 
-                // Resolve material for this entity (if any)
+                // Resolve material for this entity (if any) to pick the pipeline
                 Material* material = nullptr;
                 if (modelLoader && entity->GetName().find("_Material_") != std::string::npos) {
                     std::string entityName = entity->GetName();
@@ -845,106 +1238,52 @@ void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, Came
                     activeTransparentPipeline = desiredPipeline;
                 }
 
-                std::array<vk::Buffer, 2> buffers = {*meshIt->second.vertexBuffer, *entityIt->second.instanceBuffer};
+                std::array<vk::Buffer, 2> buffers = {*vertexArenas[meshIt->second.vertexArena].buffer, *instanceStorage->buffer};
                 std::array<vk::DeviceSize, 2> offsets = {0, 0};
                 commandBuffers[currentFrame].bindVertexBuffers(0, buffers, offsets);
-                commandBuffers[currentFrame].bindIndexBuffer(*meshIt->second.indexBuffer, 0, vk::IndexType::eUint32);
-                updateUniformBuffer(currentFrame, entity, camera);
-
-                auto& pbrDescSets = entityIt->second.pbrDescriptorSets;
-                if (pbrDescSets.empty() || currentFrame >= pbrDescSets.size()) continue;
-
-                // Bind PBR (set 0) and scene color (set 1). If primary set 1 is unavailable, use fallback.
-                vk::DescriptorSet set1 = transparentDescriptorSets.empty()
-                    ? *transparentFallbackDescriptorSets[currentFrame]
-                    : *transparentDescriptorSets[currentFrame];
-                commandBuffers[currentFrame].bindDescriptorSets(
-                    vk::PipelineBindPoint::eGraphics,
-                    **currentLayout,
-                    0,
-                    { *pbrDescSets[currentFrame], set1 },
-                    {}
-                );
-
-                MaterialProperties pushConstants{};
-                // Sensible defaults for entities without explicit material
-                pushConstants.baseColorFactor = glm::vec4(1.0f);
-                pushConstants.metallicFactor = 0.0f;
-                pushConstants.roughnessFactor = 1.0f;
-                pushConstants.baseColorTextureSet = 0; // sample bound baseColor (falls back to shared default if none)
-                pushConstants.physicalDescriptorTextureSet = 0; // default to sampling metallic-roughness on binding 2
-                pushConstants.normalTextureSet = -1;
-                pushConstants.occlusionTextureSet = -1;
-                pushConstants.emissiveTextureSet = -1;
-                pushConstants.alphaMask = 0.0f;
-                pushConstants.alphaMaskCutoff = 0.5f;
-                pushConstants.emissiveFactor = glm::vec3(0.0f);
-                pushConstants.emissiveStrength = 1.0f;
-                pushConstants.hasEmissiveStrengthExtension = false;
-                pushConstants.transmissionFactor = 0.0f;
-                pushConstants.useSpecGlossWorkflow = 0;
-                pushConstants.glossinessFactor = 0.0f;
-                pushConstants.specularFactor = glm::vec3(1.0f);
-                // pushConstants.ior already 1.5f default
-                if (material) {
-                    // Base factors
-                    pushConstants.baseColorFactor = glm::vec4(material->albedo, material->alpha);
-                    pushConstants.metallicFactor = material->metallic;
-                    pushConstants.roughnessFactor = material->roughness;
-
-                    // Texture set flags (-1 = no texture)
-                    pushConstants.baseColorTextureSet = material->albedoTexturePath.empty() ? -1 : 0;
-                    if (material->useSpecularGlossiness) {
-                        pushConstants.useSpecGlossWorkflow = 1;
-                        pushConstants.physicalDescriptorTextureSet = material->specGlossTexturePath.empty() ? -1 : 0;
-                        pushConstants.glossinessFactor = material->glossinessFactor;
-                        pushConstants.specularFactor = material->specularFactor;
-                    } else {
-                        pushConstants.useSpecGlossWorkflow = 0;
-                        pushConstants.physicalDescriptorTextureSet = material->metallicRoughnessTexturePath.empty() ? -1 : 0;
-                    }
-                    pushConstants.normalTextureSet = material->normalTexturePath.empty() ? -1 : 0;
-                    pushConstants.occlusionTextureSet = material->occlusionTexturePath.empty() ? -1 : 0;
-                    pushConstants.emissiveTextureSet = material->emissiveTexturePath.empty() ? -1 : 0;
-
-                    // Emissive and transmission/IOR
-                    pushConstants.emissiveFactor = material->emissive;
-                    pushConstants.emissiveStrength = material->emissiveStrength;
-                    pushConstants.hasEmissiveStrengthExtension = false; // Material has emissive strength data
-                    pushConstants.transmissionFactor = material->transmissionFactor;
-                    pushConstants.ior = material->ior;
-
-                    // Alpha mask handling
-                    pushConstants.alphaMask = (material->alphaMode == "MASK") ? 1.0f : 0.0f;
-                    pushConstants.alphaMaskCutoff = material->alphaCutoff;
-
-                    // For bar liquids and similar volumes, we want the fill to be
-                    // clearly visible rather than fully transmissive. For these
-                    // materials, disable the transmission branch in the PBR shader
-                    // and treat them as regular alpha-blended PBR surfaces.
-                    if (material->isLiquid) {
-                        pushConstants.transmissionFactor = 0.0f;
-                    }
+                commandBuffers[currentFrame].bindIndexBuffer(*indexArenas[meshIt->second.indexArena].buffer, 0, vk::IndexType::eUint32);
+
+                const uint32_t materialIndex = entityIt->second.materialIndex;
+                materialLastUsedFrame[materialIndex] = renderedFrameCount;
+                if (textureStreamingActive) {
+                    auto* transformComponent = entity->GetComponent<TransformComponent>();
+                    float& coverage = materialScreenCoverage[materialIndex];
+                    coverage = std::max(coverage, projectedScreenCoverage(meshComponent, meshIt->second, transformComponent ? transformComponent->GetModelMatrix() : glm::mat4(1.0f), camera));
                 }
-                commandBuffers[currentFrame].pushConstants<MaterialProperties>(**currentLayout, vk::ShaderStageFlagBits::eFragment, 0, { pushConstants });
                 uint32_t instanceCountT = std::max(1u, static_cast<uint32_t>(meshComponent->GetInstanceCount()));
-                commandBuffers[currentFrame].drawIndexed(meshIt->second.indexCount, instanceCountT, 0, 0, 0);
+                commandBuffers[currentFrame].drawIndexed(meshIt->second.indexCount, instanceCountT, meshIt->second.firstIndex, meshIt->second.vertexOffset,
+                                                         entityIt->second.firstInstance);
             }
         }
 
         if (imguiSystem) {
+            PROFILE_SCOPE("ImGui::Render");
+            GPU_PROFILE_ZONE(gpuProfiler, commandBuffers[currentFrame], "ImGui");
             imguiSystem->Render(commandBuffers[currentFrame], currentFrame);
         }
         commandBuffers[currentFrame].endRendering();
     }
 
-    // Final layout transition and present
-    vk::ImageMemoryBarrier presentBarrier{ .srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite, .dstAccessMask = vk::AccessFlagBits::eNone, .oldLayout = vk::ImageLayout::eColorAttachmentOptimal, .newLayout = vk::ImageLayout::ePresentSrcKHR, .image = swapChainImages[imageIndex], .subresourceRange = {vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1} };
+    // Final layout transition and present (headless targets are left ready for readback instead)
+    vk::ImageLayout finalLayout = headless ? vk::ImageLayout::eTransferSrcOptimal : vk::ImageLayout::ePresentSrcKHR;
+    vk::ImageMemoryBarrier presentBarrier{ .srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite, .dstAccessMask = vk::AccessFlagBits::eNone, .oldLayout = vk::ImageLayout::eColorAttachmentOptimal, .newLayout = finalLayout, .image = swapChainImages[imageIndex], .subresourceRange = {vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1} };
     commandBuffers[currentFrame].pipelineBarrier(vk::PipelineStageFlagBits::eColorAttachmentOutput, vk::PipelineStageFlagBits::eBottomOfPipe, {}, {}, {}, presentBarrier);
+    gpuProfiler.EndZone(commandBuffers[currentFrame], gpuFrameZone);
     commandBuffers[currentFrame].end();
+    uint64_t uploadsValueToWait = uploadTimelineLastSubmitted.load(std::memory_order_relaxed);
+    if (headless) {
+        // Nothing to acquire or present: only wait for pending texture uploads
+        vk::Semaphore uploadsSemaphore = *uploadsTimeline;
+        vk::PipelineStageFlags uploadsWaitStage = vk::PipelineStageFlagBits::eFragmentShader;
+        vk::TimelineSemaphoreSubmitInfo headlessTimelineInfo{ .waitSemaphoreValueCount = 1, .pWaitSemaphoreValues = &uploadsValueToWait };
+        vk::SubmitInfo headlessSubmitInfo{ .pNext = &headlessTimelineInfo, .waitSemaphoreCount = 1, .pWaitSemaphores = &uploadsSemaphore, .pWaitDstStageMask = &uploadsWaitStage, .commandBufferCount = 1, .pCommandBuffers = &*commandBuffers[currentFrame] };
+        { std::lock_guard<std::mutex> lock(queueMutex); graphicsQueue.submit(headlessSubmitInfo, *inFlightFences[currentFrame]); }
+        gpuProfiler.SubmitZones(*commandBuffers[currentFrame], frameSlotSerials[currentFrame]);
+        currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+        return;
+    }
     std::array<vk::Semaphore, 2> waitSems = { *imageAvailableSemaphores[currentFrame], *uploadsTimeline };
     std::array<vk::PipelineStageFlags, 2> waitStages = { vk::PipelineStageFlagBits::eColorAttachmentOutput, vk::PipelineStageFlagBits::eFragmentShader };
-    uint64_t uploadsValueToWait = uploadTimelineLastSubmitted.load(std::memory_order_relaxed);
     std::array<uint64_t, 2> waitValues = { 0ull, uploadsValueToWait };
     vk::TimelineSemaphoreSubmitInfo timelineWaitInfo{ .waitSemaphoreValueCount = static_cast<uint32_t>(waitValues.size()), .pWaitSemaphoreValues = waitValues.data() };
     vk::SubmitInfo submitInfo{ .pNext = &timelineWaitInfo, .waitSemaphoreCount = static_cast<uint32_t>(waitSems.size()), .pWaitSemaphores = waitSems.data(), .pWaitDstStageMask = waitStages.data(), .commandBufferCount = 1, .pCommandBuffers = &*commandBuffers[currentFrame], .signalSemaphoreCount = 1, .pSignalSemaphores = &*renderFinishedSemaphores[imageIndex] };
@@ -954,9 +1293,15 @@ void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, Came
         recreateSwapChain();
         return;
     }
-    { std::lock_guard<std::mutex> lock(queueMutex); graphicsQueue.submit(submitInfo, *inFlightFences[currentFrame]); }
+    {
+        PROFILE_SCOPE("QueueSubmit");
+        std::lock_guard<std::mutex> lock(queueMutex);
+        graphicsQueue.submit(submitInfo, *inFlightFences[currentFrame]);
+    }
+    gpuProfiler.SubmitZones(*commandBuffers[currentFrame], frameSlotSerials[currentFrame]);
     vk::PresentInfoKHR presentInfo{ .waitSemaphoreCount = 1, .pWaitSemaphores = &*renderFinishedSemaphores[imageIndex], .swapchainCount = 1, .pSwapchains = &*swapChain, .pImageIndices = &imageIndex };
     try {
+        PROFILE_SCOPE("QueuePresent");
         std::lock_guard<std::mutex> lock(queueMutex);
         result.result = presentQueue.presentKHR(presentInfo);
     } catch (const vk::OutOfDateKHRError&) {
@@ -2,6 +2,10 @@
 #include "model_loader.h"
 #include "mesh_component.h"
 #include "transform_component.h"
+#include "profiler.h"
+#include "debug_system.h"
+#include "content_hash.h"
+#include <algorithm>
 #include <fstream>
 #include <stdexcept>
 #include <array>
@@ -9,6 +13,8 @@
 #include <filesystem>
 #include <cstring>
 #include <functional>
+#include <chrono>
+#include <tuple>
 
 // stb_image dependency removed; all GLTF textures are uploaded via memory path from ModelLoader.
 
@@ -89,6 +95,7 @@ static vk::Format CoerceFormatSRGB(vk::Format fmt, bool wantSRGB) {
 
 // Create texture image
 bool Renderer::createTextureImage(const std::string& texturePath_, TextureResources& resources) {
+    PROFILE_SCOPE("Renderer::createTextureImage");
     try {
         ensureThreadLocalVulkanInit();
         const std::string textureId = ResolveTextureId(texturePath_);
@@ -373,11 +380,14 @@ bool Renderer::createTextureImage(const std::string& texturePath_, TextureResour
         }
 
         // Add to texture resources map (guarded)
+        vk::DeviceSize textureBytes = resources.textureImageAllocation ? resources.textureImageAllocation->size : 0;
         {
             std::unique_lock<std::shared_mutex> texLock(textureResourcesMutex);
             textureResources[textureId] = std::move(resources);
         }
 
+        // File-backed textures can be evicted and read again
+        registerTextureResidency(textureId, textureBytes, true);
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Failed to create texture image: " << e.what() << std::endl;
@@ -405,42 +415,42 @@ bool Renderer::createTextureImageView(TextureResources& resources) {
 bool Renderer::createSharedDefaultPBRTextures() {
     try {
         unsigned char translucentPixel[4] = {128, 128, 128, 125}; // 50% alpha
-        if (!LoadTextureFromMemory(SHARED_DEFAULT_ALBEDO_ID, translucentPixel, 1, 1, 4)) {
+        if (!createTextureFromMemory(SHARED_DEFAULT_ALBEDO_ID, translucentPixel, 1, 1, 4)) {
             std::cerr << "Failed to create shared default albedo texture" << std::endl;
             return false;
         }
 
         // Create shared default normal texture (flat normal)
         unsigned char normalPixel[4] = {128, 128, 255, 255}; // (0.5, 0.5, 1.0, 1.0) in 0-255 range
-        if (!LoadTextureFromMemory(SHARED_DEFAULT_NORMAL_ID, normalPixel, 1, 1, 4)) {
+        if (!createTextureFromMemory(SHARED_DEFAULT_NORMAL_ID, normalPixel, 1, 1, 4)) {
             std::cerr << "Failed to create shared default normal texture" << std::endl;
             return false;
         }
 
         // Create shared default metallic-roughness texture (non-metallic, fully rough)
         unsigned char metallicRoughnessPixel[4] = {0, 255, 0, 255}; // (unused, roughness=1.0, metallic=0.0, alpha=1.0)
-        if (!LoadTextureFromMemory(SHARED_DEFAULT_METALLIC_ROUGHNESS_ID, metallicRoughnessPixel, 1, 1, 4)) {
+        if (!createTextureFromMemory(SHARED_DEFAULT_METALLIC_ROUGHNESS_ID, metallicRoughnessPixel, 1, 1, 4)) {
             std::cerr << "Failed to create shared default metallic-roughness texture" << std::endl;
             return false;
         }
 
         // Create shared default occlusion texture (white - no occlusion)
         unsigned char occlusionPixel[4] = {255, 255, 255, 255};
-        if (!LoadTextureFromMemory(SHARED_DEFAULT_OCCLUSION_ID, occlusionPixel, 1, 1, 4)) {
+        if (!createTextureFromMemory(SHARED_DEFAULT_OCCLUSION_ID, occlusionPixel, 1, 1, 4)) {
             std::cerr << "Failed to create shared default occlusion texture" << std::endl;
             return false;
         }
 
         // Create shared default emissive texture (black - no emission)
         unsigned char emissivePixel[4] = {0, 0, 0, 255};
-        if (!LoadTextureFromMemory(SHARED_DEFAULT_EMISSIVE_ID, emissivePixel, 1, 1, 4)) {
+        if (!createTextureFromMemory(SHARED_DEFAULT_EMISSIVE_ID, emissivePixel, 1, 1, 4)) {
             std::cerr << "Failed to create shared default emissive texture" << std::endl;
             return false;
         }
 
         // Create shared bright red texture for ball visibility
         unsigned char brightRedPixel[4] = {255, 0, 0, 255}; // Bright red (R=255, G=0, B=0, A=255)
-        if (!LoadTextureFromMemory(SHARED_BRIGHT_RED_ID, brightRedPixel, 1, 1, 4)) {
+        if (!createTextureFromMemory(SHARED_BRIGHT_RED_ID, brightRedPixel, 1, 1, 4)) {
             std::cerr << "Failed to create shared bright red texture" << std::endl;
             return false;
         }
@@ -576,6 +586,7 @@ bool Renderer::createTextureSampler(TextureResources& resources) {
 
 // Load texture from file (public wrapper for createTextureImage)
 bool Renderer::LoadTexture(const std::string& texturePath) {
+    PROFILE_SCOPE("Renderer::LoadTexture");
     ensureThreadLocalVulkanInit();
     if (texturePath.empty()) {
         std::cerr << "LoadTexture: Empty texture path provided" << std::endl;
@@ -641,12 +652,73 @@ vk::Format Renderer::determineTextureFormat(const std::string& textureId) {
     return vk::Format::eR8G8B8A8Unorm;
 }
 
+// Keep the alias map flat so ResolveTextureId needs a single lookup
+void Renderer::registerTextureAliasLocked(const std::string& aliasId, const std::string& targetId) {
+    if (aliasId.empty() || targetId.empty()) return;
+    auto targetIt = textureAliases.find(targetId);
+    const std::string resolved = targetIt != textureAliases.end() ? targetIt->second : targetId;
+    if (aliasId == resolved) {
+        textureAliases.erase(aliasId);
+        return;
+    }
+    // IDs that aliased aliasId now alias its target directly
+    for (auto& [alias, target] : textureAliases) {
+        if (target == aliasId) {
+            target = resolved;
+        }
+    }
+    textureAliases[aliasId] = resolved;
+}
+
+// Identify an in-memory image by content and alias it to an identical one that is already known
+bool Renderer::deduplicateTextureContent(const std::string& textureId, const unsigned char* imageData,
+                                         int width, int height, int channels) {
+    PROFILE_SCOPE("Renderer::deduplicateTextureContent");
+    // The same pixels uploaded as sRGB and as linear data are different images
+    struct {
+        int32_t width, height, channels;
+        vk::Format format;
+    } header{width, height, channels, determineTextureFormat(textureId)};
+    size_t srcSize = static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(channels);
+    uint64_t contentKey = ContentHash::Hash(imageData, srcSize, ContentHash::Hash(&header, sizeof(header)));
+
+    std::unique_lock<std::shared_mutex> lock(textureResourcesMutex);
+    auto aliasIt = textureAliases.find(textureId);
+    const std::string resolvedId = aliasIt != textureAliases.end() ? aliasIt->second : textureId;
+    auto [ownerIt, inserted] = textureContentOwners.try_emplace(contentKey, resolvedId);
+    if (inserted) {
+        textureDedupStats.uniqueImages++;
+        return false;
+    }
+    if (ownerIt->second == resolvedId) {
+        // Same ID requested again; the regular load de-duplication handles it
+        return false;
+    }
+    registerTextureAliasLocked(textureId, ownerIt->second);
+    textureDedupStats.duplicateImages++;
+    textureDedupStats.duplicateBytesAvoided += static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * 4;
+    return true;
+}
+
 // Load texture from raw image data in memory
 bool Renderer::LoadTextureFromMemory(const std::string& textureId, const unsigned char* imageData,
                                     int width, int height, int channels) {
+    if (!textureId.empty() && imageData && width > 0 && height > 0 && channels > 0 &&
+        deduplicateTextureContent(textureId, imageData, width, height, channels)) {
+        // An identical image is already loaded or queued under another ID
+        return true;
+    }
+    return createTextureFromMemory(textureId, imageData, width, height, channels);
+}
+
+// Upload raw image data under the texture's resolved ID
+bool Renderer::createTextureFromMemory(const std::string& textureId, const unsigned char* imageData,
+                                       int width, int height, int channels) {
+    PROFILE_SCOPE("Renderer::LoadTextureFromMemory");
     ensureThreadLocalVulkanInit();
     const std::string resolvedId = ResolveTextureId(textureId);
-    std::cout << "[LoadTextureFromMemory] start id=" << textureId << " -> resolved=" << resolvedId << " size=" << width << "x" << height << " ch=" << channels << std::endl;
+    LOG_DEBUG("Renderer", "[LoadTextureFromMemory] start id=" + textureId + " -> resolved=" + resolvedId + " size=" +
+              std::to_string(width) + "x" + std::to_string(height) + " ch=" + std::to_string(channels));
     if (resolvedId.empty() || !imageData || width <= 0 || height <= 0 || channels <= 0) {
         std::cerr << "LoadTextureFromMemory: Invalid parameters" << std::endl;
         return false;
@@ -799,11 +871,15 @@ bool Renderer::LoadTextureFromMemory(const std::string& textureId, const unsigne
         }
 
         // Add to texture resources map (guarded)
+        vk::DeviceSize textureBytes = resources.textureImageAllocation ? resources.textureImageAllocation->size : 0;
         {
             std::unique_lock<std::shared_mutex> texLock(textureResourcesMutex);
             textureResources[cacheId] = std::move(resources);
         }
 
+        // The pixels are not kept after the upload, so these stay resident
+        registerTextureResidency(cacheId, textureBytes, false);
+
         std::cout << "Successfully loaded texture from memory: " << cacheId
                   << " (" << width << "x" << height << ", " << channels << " channels)" << std::endl;
         return true;
@@ -815,92 +891,410 @@ bool Renderer::LoadTextureFromMemory(const std::string& textureId, const unsigne
 }
 
 // Create mesh resources
-bool Renderer::createMeshResources(MeshComponent* meshComponent, bool deferUpload) {
+bool Renderer::createMeshResources(MeshComponent* meshComponent) {
+    // Components referencing geometry that is already resident draw from its ranges
+    const std::shared_ptr<const MeshGeometry>& geometry = meshComponent->GetGeometry();
+    if (meshResources.contains(geometry.get())) {
+        return true;
+    }
+    return uploadMeshes({geometry});
+}
+
+// Upload new geometries through one staging buffer and one transfer submission
+bool Renderer::uploadMeshes(const std::vector<std::shared_ptr<const MeshGeometry>>& meshes) {
     ensureThreadLocalVulkanInit();
+    // Released again if the upload fails
+    std::vector<MeshResources> resources;
+    vk::raii::Buffer stagingBuffer = nullptr;
+    std::unique_ptr<MemoryPool::Allocation> stagingAllocation;
     try {
-        // If resources already exist, no need to recreate them.
-        auto it = meshResources.find(meshComponent);
-        if (it != meshResources.end()) {
-            return true;
+        for (const auto& geometry : meshes) {
+            if (geometry->vertices.empty() || geometry->indices.empty()) {
+                std::cerr << "Mesh has no vertices or indices" << std::endl;
+                return false;
+            }
         }
 
-        // Get mesh data
-        const auto& vertices = meshComponent->GetVertices();
-        const auto& indices = meshComponent->GetIndices();
-
-        if (vertices.empty() || indices.empty()) {
-            std::cerr << "Mesh has no vertices or indices" << std::endl;
-            return false;
+        // --- 1. Sub-allocate the arena ranges and lay out each mesh's data in the staging buffer ---
+        const vk::DeviceSize vertexStride = usePackedVertices ? sizeof(PackedVertex) : sizeof(Vertex);
+        std::vector<vk::DeviceSize> stagingOffsets;
+        resources.reserve(meshes.size());
+        stagingOffsets.reserve(meshes.size());
+        vk::DeviceSize stagingSize = 0;
+        for (const auto& geometry : meshes) {
+            resources.push_back(allocateMeshResources(geometry));
+            // Index data follows the vertices; keep every mesh 16-byte aligned for the copies
+            stagingSize = (stagingSize + 15) & ~vk::DeviceSize(15);
+            stagingOffsets.push_back(stagingSize);
+            stagingSize += vertexStride * resources.back().vertexCount + sizeof(uint32_t) * resources.back().indexRangeCount;
         }
 
-        // --- 1. Create and fill per-mesh staging buffers on the host ---
-        vk::DeviceSize vertexBufferSize = sizeof(vertices[0]) * vertices.size();
-        auto [stagingVertexBuffer, stagingVertexBufferMemory] = createBuffer(
-            vertexBufferSize,
+        // --- 2. Fill one pooled staging buffer ---
+        std::tie(stagingBuffer, stagingAllocation) = createBufferPooled(
+            stagingSize,
             vk::BufferUsageFlagBits::eTransferSrc,
             vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
         );
+        auto* stagingData = static_cast<unsigned char*>(stagingAllocation->mappedPtr);
+        if (!stagingData) {
+            throw std::runtime_error("staging buffer is not mapped");
+        }
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            unsigned char* vertexData = stagingData + stagingOffsets[i];
+            resources[i].quantization = encodeMeshData(*meshes[i], vertexData,
+                                                       vertexData + vertexStride * resources[i].vertexCount);
+        }
+
+        // --- 3. Record all copies into one command buffer ---
+        vk::CommandPoolCreateInfo poolInfo{
+            .flags = vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+            .queueFamilyIndex = queueFamilyIndices.transferFamily.value()
+        };
+        vk::raii::CommandPool tempPool(device, poolInfo);
 
-        void* vertexData = stagingVertexBufferMemory.mapMemory(0, vertexBufferSize);
-        std::memcpy(vertexData, vertices.data(), static_cast<size_t>(vertexBufferSize));
-        stagingVertexBufferMemory.unmapMemory();
+        vk::CommandBufferAllocateInfo allocInfo{
+            .commandPool = *tempPool,
+            .level = vk::CommandBufferLevel::ePrimary,
+            .commandBufferCount = 1
+        };
+        vk::raii::CommandBuffers commandBuffers(device, allocInfo);
+        vk::raii::CommandBuffer& commandBuffer = commandBuffers[0];
 
-        vk::DeviceSize indexBufferSize = sizeof(indices[0]) * indices.size();
-        auto [stagingIndexBuffer, stagingIndexBufferMemory] = createBuffer(
-            indexBufferSize,
-            vk::BufferUsageFlagBits::eTransferSrc,
-            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
-        );
+        vk::CommandBufferBeginInfo beginInfo{
+            .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+        };
+        commandBuffer.begin(beginInfo);
 
-        void* indexData = stagingIndexBufferMemory.mapMemory(0, indexBufferSize);
-        std::memcpy(indexData, indices.data(), static_cast<size_t>(indexBufferSize));
-        stagingIndexBufferMemory.unmapMemory();
+        for (size_t i = 0; i < resources.size(); ++i) {
+            const MeshResources& res = resources[i];
+            const vk::DeviceSize vertexBytes = vertexStride * res.vertexCount;
+            vk::BufferCopy vertexRegion{
+                .srcOffset = stagingOffsets[i],
+                .dstOffset = static_cast<vk::DeviceSize>(res.vertexOffset) * vertexStride,
+                .size = vertexBytes
+            };
+            commandBuffer.copyBuffer(*stagingBuffer, *vertexArenas[res.vertexArena].buffer, vertexRegion);
 
-        // --- 2. Create device-local vertex and index buffers via the memory pool ---
-        auto [vertexBuffer, vertexBufferAllocation] = createBufferPooled(
-            vertexBufferSize,
-            vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer,
-            vk::MemoryPropertyFlagBits::eDeviceLocal
-        );
+            vk::BufferCopy indexRegion{
+                .srcOffset = stagingOffsets[i] + vertexBytes,
+                .dstOffset = static_cast<vk::DeviceSize>(res.firstIndex) * sizeof(uint32_t),
+                .size = sizeof(uint32_t) * res.indexRangeCount
+            };
+            commandBuffer.copyBuffer(*stagingBuffer, *indexArenas[res.indexArena].buffer, indexRegion);
+        }
 
-        auto [indexBuffer, indexBufferAllocation] = createBufferPooled(
-            indexBufferSize,
-            vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer,
-            vk::MemoryPropertyFlagBits::eDeviceLocal
-        );
+        commandBuffer.end();
 
-        // --- 3. Either copy now (legacy path) or defer copies for batched submission ---
-        MeshResources resources;
-        resources.vertexBuffer = std::move(vertexBuffer);
-        resources.vertexBufferAllocation = std::move(vertexBufferAllocation);
-        resources.indexBuffer = std::move(indexBuffer);
-        resources.indexBufferAllocation = std::move(indexBufferAllocation);
-        resources.indexCount = static_cast<uint32_t>(indices.size());
-
-        if (deferUpload) {
-            // Keep staging buffers alive and record their sizes; copies will be
-            // performed later by preAllocateEntityResourcesBatch().
-            resources.stagingVertexBuffer = std::move(stagingVertexBuffer);
-            resources.stagingVertexBufferMemory = std::move(stagingVertexBufferMemory);
-            resources.vertexBufferSizeBytes = vertexBufferSize;
-
-            resources.stagingIndexBuffer = std::move(stagingIndexBuffer);
-            resources.stagingIndexBufferMemory = std::move(stagingIndexBufferMemory);
-            resources.indexBufferSizeBytes = indexBufferSize;
-        } else {
-            // Immediate upload path used by preAllocateEntityResources() and other
-            // small-object callers. This preserves existing behaviour.
-            copyBuffer(stagingVertexBuffer, resources.vertexBuffer, vertexBufferSize);
-            copyBuffer(stagingIndexBuffer, resources.indexBuffer, indexBufferSize);
-            // staging* buffers are RAII objects and will be destroyed on scope exit.
+        vk::SubmitInfo submitInfo{
+            .commandBufferCount = 1,
+            .pCommandBuffers = &*commandBuffer
+        };
+
+        vk::raii::Fence fence(device, vk::FenceCreateInfo{});
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            transferQueue.submit(submitInfo, *fence);
         }
+        [[maybe_unused]] auto fenceResult = device.waitForFences({*fence}, VK_TRUE, UINT64_MAX);
 
-        // Add to mesh resources map
-        meshResources[meshComponent] = std::move(resources);
+        // The staging range goes back to the pool right away
+        stagingBuffer = nullptr;
+        memoryPool->deallocate(std::move(stagingAllocation));
 
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            meshResources[meshes[i].get()] = std::move(resources[i]);
+        }
+        entityBatchStats.meshUploads += meshes.size();
+        entityBatchStats.stagingBytes += stagingSize;
+        entityBatchStats.buffersCreated++;
+        entityBatchStats.submissions++;
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Failed to create mesh resources: " << e.what() << std::endl;
+        // Nothing reads the staging buffer anymore (not submitted, or the device was lost)
+        stagingBuffer = nullptr;
+        if (stagingAllocation) {
+            memoryPool->deallocate(std::move(stagingAllocation));
+        }
+        for (const MeshResources& res : resources) {
+            freeGeometry(vertexArenas, res.vertexArena, static_cast<uint32_t>(res.vertexOffset), res.vertexCount);
+            freeGeometry(indexArenas, res.indexArena, res.firstIndex, res.indexRangeCount);
+        }
+        return false;
+    }
+}
+
+Renderer::MeshResources Renderer::allocateMeshResources(const std::shared_ptr<const MeshGeometry>& geometry) {
+    const auto& vertices = geometry->vertices;
+    const auto& indices = geometry->indices;
+
+    // Coarser levels of detail follow the base indices in the same range
+    const size_t vertexStride = usePackedVertices ? sizeof(PackedVertex) : sizeof(Vertex);
+    const auto indexRangeCount = static_cast<uint32_t>(indices.size() + geometry->lodIndices.size());
+
+    MeshResources resources;
+    resources.geometry = geometry;
+    resources.vertexOffset = static_cast<int32_t>(allocateGeometry(
+        vertexArenas, static_cast<uint32_t>(vertices.size()), vertexStride,
+        vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer, resources.vertexArena));
+    try {
+        resources.firstIndex = allocateGeometry(
+            indexArenas, indexRangeCount, sizeof(uint32_t),
+            vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eIndexBuffer, resources.indexArena);
+    } catch (...) {
+        // The caller only frees the ranges of meshes it got back
+        freeGeometry(vertexArenas, resources.vertexArena, static_cast<uint32_t>(resources.vertexOffset),
+                     static_cast<uint32_t>(vertices.size()));
+        throw;
+    }
+
+    resources.indexCount = static_cast<uint32_t>(indices.size());
+    resources.vertexCount = static_cast<uint32_t>(vertices.size());
+    resources.indexRangeCount = indexRangeCount;
+    resources.lods = geometry->lods;
+    if (geometry->aabbValid) {
+        resources.boundsCenter = 0.5f * (geometry->aabbMin + geometry->aabbMax);
+        resources.boundsRadius = 0.5f * glm::length(geometry->aabbMax - geometry->aabbMin);
+    }
+    return resources;
+}
+
+VertexQuantization Renderer::encodeMeshData(const MeshGeometry& geometry, void* vertexData, void* indexData) {
+    const auto& vertices = geometry.vertices;
+    const auto& indices = geometry.indices;
+
+    VertexQuantization quantization;
+    if (usePackedVertices) {
+        // Encode straight into the staging buffer and measure the round-trip error on the way
+        quantization = PackedVertex::ComputeQuantization(vertices);
+        auto* packedVertices = static_cast<PackedVertex*>(vertexData);
+        float maxPositionError = 0.0f;
+        float minNormalCos = 1.0f;
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            const Vertex& vertex = vertices[i];
+            PackedVertex packed = PackedVertex::Encode(vertex, quantization);
+            packedVertices[i] = packed;
+
+            Vertex decoded = packed.Decode(quantization);
+            glm::vec3 positionError = glm::abs(decoded.position - vertex.position);
+            maxPositionError = std::max({maxPositionError, positionError.x, positionError.y, positionError.z});
+            float normalLength = glm::length(vertex.normal);
+            if (normalLength > 0.0f) {
+                minNormalCos = std::min(minNormalCos, glm::dot(decoded.normal, vertex.normal / normalLength));
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(vertexPackingStatsMutex);
+        vertexPackingStats.meshCount++;
+        vertexPackingStats.vertexCount += vertices.size();
+        vertexPackingStats.packedBytes += sizeof(PackedVertex) * vertices.size();
+        vertexPackingStats.unpackedBytes += sizeof(Vertex) * vertices.size();
+        vertexPackingStats.maxPositionError = std::max(vertexPackingStats.maxPositionError, maxPositionError);
+        float normalErrorDegrees = glm::degrees(std::acos(std::clamp(minNormalCos, -1.0f, 1.0f)));
+        vertexPackingStats.maxNormalErrorDegrees = std::max(vertexPackingStats.maxNormalErrorDegrees, normalErrorDegrees);
+    } else {
+        std::memcpy(vertexData, vertices.data(), sizeof(Vertex) * vertices.size());
+    }
+
+    auto* indexBytes = static_cast<unsigned char*>(indexData);
+    std::memcpy(indexBytes, indices.data(), sizeof(uint32_t) * indices.size());
+    if (!geometry.lodIndices.empty()) {
+        std::memcpy(indexBytes + sizeof(uint32_t) * indices.size(), geometry.lodIndices.data(),
+                    sizeof(uint32_t) * geometry.lodIndices.size());
+    }
+    return quantization;
+}
+
+// Sub-allocate geometry from the first arena with room (first fit, released ranges first)
+uint32_t Renderer::allocateGeometry(std::vector<GeometryArena>& arenas, uint32_t elementCount, vk::DeviceSize elementSize,
+                                    vk::BufferUsageFlags usage, uint32_t& arenaIndex) {
+    for (uint32_t i = 0; i < arenas.size(); ++i) {
+        uint32_t first = 0;
+        if (takeFreeRange(arenas[i].freeRanges, elementCount, first)) {
+            arenaIndex = i;
+            return first;
+        }
+    }
+    for (uint32_t i = 0; i < arenas.size(); ++i) {
+        if (arenas[i].capacity - arenas[i].used >= elementCount) {
+            arenaIndex = i;
+            uint32_t first = arenas[i].used;
+            arenas[i].used += elementCount;
+            return first;
+        }
+    }
+
+    // Meshes larger than an arena get an arena of their own
+    GeometryArena arena;
+    arena.capacity = std::max(elementCount, static_cast<uint32_t>(GEOMETRY_ARENA_BYTES / elementSize));
+    auto [buffer, allocation] = createBufferPooled(arena.capacity * elementSize, usage, vk::MemoryPropertyFlagBits::eDeviceLocal);
+    arena.buffer = std::move(buffer);
+    arena.allocation = std::move(allocation);
+    arena.used = elementCount;
+    arenaIndex = static_cast<uint32_t>(arenas.size());
+    arenas.push_back(std::move(arena));
+    return 0;
+}
+
+// Return a released range to its arena, merging it with adjacent free ranges
+void Renderer::freeGeometry(std::vector<GeometryArena>& arenas, uint32_t arenaIndex, uint32_t first, uint32_t elementCount) {
+    if (arenaIndex >= arenas.size() || elementCount == 0) {
+        return;
+    }
+    returnFreeRange(arenas[arenaIndex].freeRanges, arenas[arenaIndex].used, first, elementCount);
+}
+
+bool Renderer::takeFreeRange(std::vector<std::pair<uint32_t, uint32_t>>& freeRanges, uint32_t count, uint32_t& first) {
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+        if (it->second < count) continue;
+        first = it->first;
+        it->first += count;
+        it->second -= count;
+        if (it->second == 0) {
+            freeRanges.erase(it);
+        }
+        return true;
+    }
+    return false;
+}
+
+void Renderer::returnFreeRange(std::vector<std::pair<uint32_t, uint32_t>>& freeRanges, uint32_t& used, uint32_t first, uint32_t count) {
+    auto next = std::ranges::lower_bound(freeRanges, first, {}, &std::pair<uint32_t, uint32_t>::first);
+    auto it = freeRanges.insert(next, { first, count });
+    if (auto following = std::next(it); following != freeRanges.end() && it->first + it->second == following->first) {
+        it->second += following->second;
+        freeRanges.erase(following);
+    }
+    if (it != freeRanges.begin()) {
+        auto previous = std::prev(it);
+        if (previous->first + previous->second == it->first) {
+            previous->second += it->second;
+            it = std::prev(freeRanges.erase(it));
+        }
+    }
+    // A free range at the end shrinks the allocated prefix instead
+    if (it->first + it->second == used) {
+        used = it->first;
+        freeRanges.erase(it);
+    }
+}
+
+// Create or grow the instance storage buffer of a frame in flight
+bool Renderer::ensureInstanceStorageCapacity(uint32_t frame, uint32_t instanceCount) {
+    if (instanceStorageBuffers.size() != MAX_FRAMES_IN_FLIGHT) {
+        instanceStorageBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    }
+    InstanceStorageBuffer& storage = instanceStorageBuffers[frame];
+    if (storage.capacity >= instanceCount) {
+        return true;
+    }
+
+    try {
+        // Grow geometrically so a growing scene does not reallocate every frame
+        uint32_t capacity = std::max({instanceCount, storage.capacity * 2, 4096u});
+        auto [buffer, allocation] = createBufferPooled(
+            sizeof(InstanceRecord) * capacity,
+            vk::BufferUsageFlagBits::eVertexBuffer,
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+        );
+        if (!allocation->mappedPtr) {
+            std::cerr << "Failed to map instance storage buffer" << std::endl;
+            memoryPool->deallocate(std::move(allocation));
+            return false;
+        }
+        // Records carry over, so the dirty ranges pending for this frame stay valid
+        if (storage.allocation) {
+            std::memcpy(allocation->mappedPtr, storage.mapped, sizeof(InstanceRecord) * storage.capacity);
+            retirePooledBuffer(std::move(storage.buffer), std::move(storage.allocation));
+        }
+        storage.buffer = std::move(buffer);
+        storage.mapped = allocation->mappedPtr;
+        storage.allocation = std::move(allocation);
+        storage.capacity = capacity;
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create instance storage buffer: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Move an entity to a larger instance storage range; the old one goes once no frame reads it
+void Renderer::reserveInstanceRange(EntityResources& resources, uint32_t instanceCount) {
+    if (resources.instanceDirty.size() != MAX_FRAMES_IN_FLIGHT) {
+        resources.instanceDirty.resize(MAX_FRAMES_IN_FLIGHT);
+    }
+    if (resources.instanceCapacity >= instanceCount) {
+        return;
+    }
+
+    // Grow geometrically so instances added every frame do not move every frame
+    uint32_t capacity = std::max(instanceCount, resources.instanceCapacity * 2);
+    uint32_t first = 0;
+    {
+        std::lock_guard<std::mutex> lock(instanceRangeMutex);
+        if (!takeFreeRange(freeInstanceRanges, capacity, first)) {
+            first = instanceRangeEnd;
+            instanceRangeEnd += capacity;
+        }
+    }
+    if (resources.instanceCapacity > 0) {
+        deletionQueue.RetireWith(renderedFrameCount, [this, first = resources.firstInstance, count = resources.instanceCapacity]() {
+            std::lock_guard<std::mutex> lock(instanceRangeMutex);
+            returnFreeRange(freeInstanceRanges, instanceRangeEnd, first, count);
+        });
+    }
+    resources.firstInstance = first;
+    resources.instanceCapacity = capacity;
+    resources.MarkInstancesDirty(0, instanceCount);
+}
+
+// Frames recorded so far may still read the buffer; it goes back to the pool once they completed
+void Renderer::retirePooledBuffer(vk::raii::Buffer&& buffer, std::unique_ptr<MemoryPool::Allocation>&& allocation) {
+    deletionQueue.RetireWith(renderedFrameCount, [this, buffer = std::move(buffer), allocation = std::move(allocation)]() mutable {
+        buffer = nullptr;
+        if (memoryPool && allocation) {
+            memoryPool->deallocate(std::move(allocation));
+        }
+    });
+}
+
+// Create or grow the indirect command buffer of a frame in flight
+bool Renderer::ensureIndirectBufferCapacity(uint32_t frame, uint32_t commandCount) {
+    if (indirectBuffers.size() != MAX_FRAMES_IN_FLIGHT) {
+        indirectBuffers.clear();
+        indirectBufferAllocations.clear();
+        for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+            indirectBuffers.emplace_back(nullptr);
+            indirectBufferAllocations.emplace_back(nullptr);
+        }
+        indirectBufferCapacity.assign(MAX_FRAMES_IN_FLIGHT, 0);
+    }
+    if (indirectBufferCapacity[frame] >= commandCount) {
+        return true;
+    }
+
+    try {
+        // Grow geometrically so a growing scene does not reallocate every frame
+        uint32_t capacity = std::max({commandCount, indirectBufferCapacity[frame] * 2, 1024u});
+        auto [buffer, allocation] = createBufferPooled(
+            sizeof(vk::DrawIndexedIndirectCommand) * capacity,
+            vk::BufferUsageFlagBits::eIndirectBuffer,
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+        );
+        if (!allocation->mappedPtr) {
+            std::cerr << "Failed to map indirect draw buffer" << std::endl;
+            memoryPool->deallocate(std::move(allocation));
+            return false;
+        }
+        if (indirectBufferAllocations[frame]) {
+            retirePooledBuffer(std::move(indirectBuffers[frame]), std::move(indirectBufferAllocations[frame]));
+        }
+        indirectBuffers[frame] = std::move(buffer);
+        indirectBufferAllocations[frame] = std::move(allocation);
+        indirectBufferCapacity[frame] = capacity;
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create indirect draw buffer: " << e.what() << std::endl;
         return false;
     }
 }
@@ -915,64 +1309,25 @@ bool Renderer::createUniformBuffers(Entity* entity) {
             return true;
         }
 
-        // Create entity resources
+        // Create entity resources. Uniforms are shared per frame; the entity only owns a slot
+        // in the object storage buffers (slots of released entities are reused).
         EntityResources resources;
-
-        // Create uniform buffers using memory pool
-        vk::DeviceSize bufferSize = sizeof(UniformBufferObject);
-        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-            auto [buffer, bufferAllocation] = createBufferPooled(
-                bufferSize,
-                vk::BufferUsageFlagBits::eUniformBuffer,
-                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
-            );
-
-            // Use the memory pool's mapped pointer if available
-            void* mappedMemory = bufferAllocation->mappedPtr;
-            if (!mappedMemory) {
-                std::cerr << "Warning: Uniform buffer allocation is not mapped" << std::endl;
+        {
+            std::lock_guard<std::mutex> slotLock(objectSlotMutex);
+            if (!freeObjectSlots.empty()) {
+                resources.objectIndex = freeObjectSlots.back();
+                freeObjectSlots.pop_back();
+            } else {
+                resources.objectIndex = objectSlotCount.fetch_add(1);
             }
-
-            resources.uniformBuffers.emplace_back(std::move(buffer));
-            resources.uniformBufferAllocations.emplace_back(std::move(bufferAllocation));
-            resources.uniformBuffersMapped.emplace_back(mappedMemory);
         }
 
-        // Create instance buffer for all entities (shaders always expect instance data)
+        // Reserve the instance records for all entities (shaders always expect instance data);
+        // they are written by the frames that draw the entity
         auto* meshComponent = entity->GetComponent<MeshComponent>();
         if (meshComponent) {
-            std::vector<InstanceData> instanceData;
-
-            // CRITICAL FIX: Check if entity has any instance data first
-            if (meshComponent->GetInstanceCount() > 0) {
-                // Use existing instance data from GLTF loading (whether 1 or many instances)
-                instanceData = meshComponent->GetInstances();
-            } else {
-                // Create single instance data using IDENTITY matrix to avoid double-transform with UBO.model
-                InstanceData singleInstance;
-                singleInstance.setModelMatrix(glm::mat4(1.0f));
-                instanceData = {singleInstance};
-            }
-
-            vk::DeviceSize instanceBufferSize = sizeof(InstanceData) * instanceData.size();
-
-            auto [instanceBuffer, instanceBufferAllocation] = createBufferPooled(
-                instanceBufferSize,
-                vk::BufferUsageFlagBits::eVertexBuffer,
-                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
-            );
-
-            // Copy instance data to buffer
-            void* instanceMappedMemory = instanceBufferAllocation->mappedPtr;
-            if (instanceMappedMemory) {
-                std::memcpy(instanceMappedMemory, instanceData.data(), instanceBufferSize);
-            } else {
-                std::cerr << "Warning: Instance buffer allocation is not mapped" << std::endl;
-            }
-
-            resources.instanceBuffer = std::move(instanceBuffer);
-            resources.instanceBufferAllocation = std::move(instanceBufferAllocation);
-            resources.instanceBufferMapped = instanceMappedMemory;
+            resources.geometry = meshComponent->GetGeometry().get();
+            reserveInstanceRange(resources, static_cast<uint32_t>(std::max<size_t>(meshComponent->GetInstanceCount(), 1)));
         }
 
         // Add to entity resources map
@@ -988,36 +1343,24 @@ bool Renderer::createUniformBuffers(Entity* entity) {
 // Create descriptor pool
 bool Renderer::createDescriptorPool() {
     try {
-        // Calculate pool sizes for all Bistro materials plus additional entities
-        // The Bistro model creates many more entities than initially expected
-        // Each entity needs descriptor sets for both basic and PBR pipelines
-        // PBR pipeline needs 7 descriptors per set (1 UBO + 5 PBR textures + 1 shadow map array with 16 shadow maps)
-        // Basic pipeline needs 2 descriptors per set (1 UBO + 1 texture)
-        const uint32_t maxEntities = 20000; // Increased to 20k entities to handle large scenes like Bistro reliably
-        const uint32_t maxDescriptorSets = MAX_FRAMES_IN_FLIGHT * maxEntities * 2; // 2 pipeline types per entity
-
-        // Calculate descriptor counts
-        // UBO descriptors: 1 per descriptor set
-        const uint32_t uboDescriptors = maxDescriptorSets;
-        // Texture descriptors: Basic pipeline uses 1, PBR uses 21 (5 PBR textures + 16 shadow maps)
-        // Allocate for worst case: all entities using PBR (21 texture descriptors each)
-        const uint32_t textureDescriptors = MAX_FRAMES_IN_FLIGHT * maxEntities * 21;
-        // Storage buffer descriptors: PBR pipeline uses 1 light storage buffer per descriptor set
-        // Only PBR entities need storage buffers, so allocate for all entities using PBR
-        const uint32_t storageBufferDescriptors = MAX_FRAMES_IN_FLIGHT * maxEntities;
+        // Entities no longer own descriptor sets: every draw binds the per-frame global set,
+        // a scene color set and the bindless set, and selects its data through its instance records.
+        // The scene color sets are reallocated on swapchain recreation, so leave room for that.
+        const uint32_t maxDescriptorSets = MAX_FRAMES_IN_FLIGHT * 4;
 
         std::array<vk::DescriptorPoolSize, 3> poolSizes = {
             vk::DescriptorPoolSize{
                 .type = vk::DescriptorType::eUniformBuffer,
-                .descriptorCount = uboDescriptors
+                .descriptorCount = MAX_FRAMES_IN_FLIGHT
             },
             vk::DescriptorPoolSize{
                 .type = vk::DescriptorType::eCombinedImageSampler,
-                .descriptorCount = textureDescriptors
+                .descriptorCount = MAX_FRAMES_IN_FLIGHT * 2
             },
             vk::DescriptorPoolSize{
+                // Light and object storage buffers of the global sets
                 .type = vk::DescriptorType::eStorageBuffer,
-                .descriptorCount = storageBufferDescriptors
+                .descriptorCount = MAX_FRAMES_IN_FLIGHT * 2
             }
         };
 
@@ -1037,86 +1380,242 @@ bool Renderer::createDescriptorPool() {
     }
 }
 
-// Create descriptor sets
-bool Renderer::createDescriptorSets(Entity* entity, const std::string& texturePath, bool usePBR) {
-    // Resolve alias before taking the shared lock to avoid nested shared_lock on the same mutex
-    const std::string resolvedTexturePath = ResolveTextureId(texturePath);
-    std::shared_lock<std::shared_mutex> texLock(textureResourcesMutex);
+// Create the per-frame global and bindless descriptor sets
+bool Renderer::createBindlessDescriptorSets() {
     try {
-        auto entityIt = entityResources.find(entity);
-        if (entityIt == entityResources.end()) return false;
+        std::array<vk::DescriptorPoolSize, 2> poolSizes = {
+            vk::DescriptorPoolSize{
+                .type = vk::DescriptorType::eCombinedImageSampler,
+                .descriptorCount = MAX_FRAMES_IN_FLIGHT * bindlessTextureCapacity
+            },
+            vk::DescriptorPoolSize{
+                .type = vk::DescriptorType::eStorageBuffer,
+                .descriptorCount = MAX_FRAMES_IN_FLIGHT
+            }
+        };
+        vk::DescriptorPoolCreateInfo poolInfo{
+            .flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet | vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind,
+            .maxSets = MAX_FRAMES_IN_FLIGHT,
+            .poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
+            .pPoolSizes = poolSizes.data()
+        };
+        bindlessDescriptorPool = vk::raii::DescriptorPool(device, poolInfo);
 
-        vk::DescriptorSetLayout selectedLayout = usePBR ? *pbrDescriptorSetLayout : *descriptorSetLayout;
-        std::vector<vk::DescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, selectedLayout);
-        vk::DescriptorSetAllocateInfo allocInfo{ .descriptorPool = *descriptorPool, .descriptorSetCount = MAX_FRAMES_IN_FLIGHT, .pSetLayouts = layouts.data() };
+        std::vector<vk::DescriptorSetLayout> globalLayouts(MAX_FRAMES_IN_FLIGHT, *globalDescriptorSetLayout);
+        globalDescriptorSets = vk::raii::DescriptorSets(device, vk::DescriptorSetAllocateInfo{
+            .descriptorPool = *descriptorPool,
+            .descriptorSetCount = MAX_FRAMES_IN_FLIGHT,
+            .pSetLayouts = globalLayouts.data()
+        });
+        std::vector<vk::DescriptorSetLayout> bindlessLayouts(MAX_FRAMES_IN_FLIGHT, *bindlessDescriptorSetLayout);
+        bindlessDescriptorSets = vk::raii::DescriptorSets(device, vk::DescriptorSetAllocateInfo{
+            .descriptorPool = *bindlessDescriptorPool,
+            .descriptorSetCount = MAX_FRAMES_IN_FLIGHT,
+            .pSetLayouts = bindlessLayouts.data()
+        });
 
-        auto& targetDescriptorSets = usePBR ? entityIt->second.pbrDescriptorSets : entityIt->second.basicDescriptorSets;
-        if (targetDescriptorSets.empty()) {
-            targetDescriptorSets = vk::raii::DescriptorSets(device, allocInfo);
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            vk::DescriptorBufferInfo uniformBufferInfo{ .buffer = *globalUniformBuffers[i], .range = sizeof(UniformBufferObject) };
+            vk::DescriptorImageInfo defaultImageInfo{ .sampler = *defaultTextureResources.textureSampler, .imageView = *defaultTextureResources.textureImageView, .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal };
+            std::array<vk::WriteDescriptorSet, 2> descriptorWrites = {
+                vk::WriteDescriptorSet{ .dstSet = *globalDescriptorSets[i], .dstBinding = 0, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eUniformBuffer, .pBufferInfo = &uniformBufferInfo },
+                // Slot 0 is the default texture; materials fall back to it when the array is full
+                vk::WriteDescriptorSet{ .dstSet = *bindlessDescriptorSets[i], .dstBinding = 0, .dstArrayElement = 0, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eCombinedImageSampler, .pImageInfo = &defaultImageInfo }
+            };
+            device.updateDescriptorSets(descriptorWrites, {});
         }
+        updateAllDescriptorSetsWithNewLightBuffers();
+        updateAllDescriptorSetsWithNewObjectBuffers();
 
-        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-            vk::DescriptorBufferInfo bufferInfo{ .buffer = *entityIt->second.uniformBuffers[i], .range = sizeof(UniformBufferObject) };
-
-            if (usePBR) {
-                // PBR sets now only have 7 bindings (0-6)
-                std::array<vk::WriteDescriptorSet, 7> descriptorWrites;
-                std::array<vk::DescriptorImageInfo, 5> imageInfos;
-
-                descriptorWrites[0] = { .dstSet = *targetDescriptorSets[i], .dstBinding = 0, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eUniformBuffer, .pBufferInfo = &bufferInfo };
-
-                auto meshComponent = entity->GetComponent<MeshComponent>();
-                std::vector<std::string> pbrTexturePaths = { /* ... same as before ... */ };
-                // ... (logic to get texture paths is the same)
-                {
-                    const std::string legacyPath = (meshComponent ? meshComponent->GetTexturePath() : std::string());
-                    const std::string baseColorPath = (meshComponent && !meshComponent->GetBaseColorTexturePath().empty())
-                                                      ? meshComponent->GetBaseColorTexturePath()
-                                                      : (!legacyPath.empty() ? legacyPath : SHARED_DEFAULT_ALBEDO_ID);
-                    const std::string mrPath = (meshComponent && !meshComponent->GetMetallicRoughnessTexturePath().empty())
-                                               ? meshComponent->GetMetallicRoughnessTexturePath()
-                                               : SHARED_DEFAULT_METALLIC_ROUGHNESS_ID;
-                    const std::string normalPath = (meshComponent && !meshComponent->GetNormalTexturePath().empty())
-                                                   ? meshComponent->GetNormalTexturePath()
-                                                   : SHARED_DEFAULT_NORMAL_ID;
-                    const std::string occlusionPath = (meshComponent && !meshComponent->GetOcclusionTexturePath().empty())
-                                                      ? meshComponent->GetOcclusionTexturePath()
-                                                      : SHARED_DEFAULT_OCCLUSION_ID;
-                    const std::string emissivePath = (meshComponent && !meshComponent->GetEmissiveTexturePath().empty())
-                                                    ? meshComponent->GetEmissiveTexturePath()
-                                                    : SHARED_DEFAULT_EMISSIVE_ID;
-
-                    pbrTexturePaths = { baseColorPath, mrPath, normalPath, occlusionPath, emissivePath };
-                }
+        {
+            std::lock_guard<std::mutex> lock(bindlessMutex);
+            bindlessSlotTextureIds.assign(1, std::string());
+            pendingBindlessSlots.assign(MAX_FRAMES_IN_FLIGHT, {});
+        }
+        return createOrResizeMaterialBuffers(256);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create bindless descriptor sets: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Get the bindless slot of a texture, assigning one on first use
+uint32_t Renderer::getBindlessTextureSlot(const std::string& textureId) {
+    std::string canonicalId = ResolveTextureId(textureId);
+    if (canonicalId.empty()) {
+        canonicalId = textureId;
+    }
+
+    std::lock_guard<std::mutex> lock(bindlessMutex);
+    auto it = bindlessTextureSlots.find(canonicalId);
+    if (it != bindlessTextureSlots.end()) {
+        return it->second;
+    }
+    if (bindlessSlotTextureIds.size() >= bindlessTextureCapacity) {
+        if (!bindlessSlotsExhaustedWarned) {
+            std::cerr << "Warning: bindless texture array is full (" << bindlessTextureCapacity
+                      << " slots); further textures use the default texture" << std::endl;
+            bindlessSlotsExhaustedWarned = true;
+        }
+        return 0;
+    }
+
+    // The texture may already be resident; otherwise the slot shows the default texture
+    // until OnTextureUploaded queues it again
+    auto slot = static_cast<uint32_t>(bindlessSlotTextureIds.size());
+    bindlessSlotTextureIds.push_back(canonicalId);
+    bindlessTextureSlots.emplace(canonicalId, slot);
+    for (auto& pending : pendingBindlessSlots) {
+        pending.push_back(slot);
+    }
+    return slot;
+}
 
+// Build an entity's material and add it to the material table
+bool Renderer::createEntityMaterial(Entity* entity) {
+    try {
+        auto entityIt = entityResources.find(entity);
+        if (entityIt == entityResources.end()) return false;
+        auto meshComponent = entity->GetComponent<MeshComponent>();
 
-                for (int j = 0; j < 5; j++) {
-                    const auto resolvedBindingPath = ResolveTextureId(pbrTexturePaths[j]);
-                    auto textureIt = textureResources.find(resolvedBindingPath);
-                    TextureResources* texRes = (textureIt != textureResources.end()) ? &textureIt->second : &defaultTextureResources;
-                    imageInfos[j] = { .sampler = *texRes->textureSampler, .imageView = *texRes->textureImageView, .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal };
-                    descriptorWrites[j + 1] = { .dstSet = *targetDescriptorSets[i], .dstBinding = static_cast<uint32_t>(j + 1), .descriptorCount = 1, .descriptorType = vk::DescriptorType::eCombinedImageSampler, .pImageInfo = &imageInfos[j] };
+        // Texture IDs of the mesh (material fallbacks have been applied at load time)
+        const std::string legacyPath = (meshComponent ? meshComponent->GetTexturePath() : std::string());
+        const std::string baseColorPath = (meshComponent && !meshComponent->GetBaseColorTexturePath().empty())
+                                          ? meshComponent->GetBaseColorTexturePath()
+                                          : (!legacyPath.empty() ? legacyPath : SHARED_DEFAULT_ALBEDO_ID);
+        const std::string mrPath = (meshComponent && !meshComponent->GetMetallicRoughnessTexturePath().empty())
+                                   ? meshComponent->GetMetallicRoughnessTexturePath()
+                                   : SHARED_DEFAULT_METALLIC_ROUGHNESS_ID;
+        const std::string normalPath = (meshComponent && !meshComponent->GetNormalTexturePath().empty())
+                                       ? meshComponent->GetNormalTexturePath()
+                                       : SHARED_DEFAULT_NORMAL_ID;
+        const std::string occlusionPath = (meshComponent && !meshComponent->GetOcclusionTexturePath().empty())
+                                          ? meshComponent->GetOcclusionTexturePath()
+                                          : SHARED_DEFAULT_OCCLUSION_ID;
+        const std::string emissivePath = (meshComponent && !meshComponent->GetEmissiveTexturePath().empty())
+                                        ? meshComponent->GetEmissiveTexturePath()
+                                        : SHARED_DEFAULT_EMISSIVE_ID;
+
+        // Zero the padding as well: identical materials are found by their raw bytes
+        MaterialData material;
+        std::memset(&material, 0, sizeof(material));
+        // Sensible defaults for entities without explicit material
+        material.baseColorFactor = glm::vec4(1.0f);
+        material.metallicFactor = 0.0f;
+        material.roughnessFactor = 1.0f;
+        material.baseColorTextureSet = 0; // sample baseColor (falls back to shared default if none)
+        material.physicalDescriptorTextureSet = 0;
+        material.normalTextureSet = -1;
+        material.occlusionTextureSet = -1;
+        material.emissiveTextureSet = -1;
+        material.alphaMask = 0.0f;
+        material.alphaMaskCutoff = 0.5f;
+        material.emissiveFactor = glm::vec3(0.0f);
+        material.emissiveStrength = 1.0f;
+        material.transmissionFactor = 0.0f;
+        material.useSpecGlossWorkflow = 0;
+        material.glossinessFactor = 0.0f;
+        material.specularFactor = glm::vec3(1.0f);
+        material.ior = 1.5f;
+
+        Material* modelMaterial = nullptr;
+        if (modelLoader && entity->GetName().find("_Material_") != std::string::npos) {
+            std::string entityName = entity->GetName();
+            size_t tagPos = entityName.find("_Material_");
+            size_t afterTag = tagPos + std::string("_Material_").size();
+            if (afterTag < entityName.length()) {
+                // Entity name format: "modelName_Material_<index>_<materialName>"
+                std::string remainder = entityName.substr(afterTag);
+                size_t nextUnderscore = remainder.find('_');
+                if (nextUnderscore != std::string::npos && nextUnderscore + 1 < remainder.length()) {
+                    modelMaterial = modelLoader->GetMaterial(remainder.substr(nextUnderscore + 1));
                 }
+            }
+        }
+        if (modelMaterial) {
+            // Base factors
+            material.baseColorFactor = glm::vec4(modelMaterial->albedo, modelMaterial->alpha);
+            material.metallicFactor = modelMaterial->metallic;
+            material.roughnessFactor = modelMaterial->roughness;
+
+            // Texture set flags (-1 = no texture)
+            material.baseColorTextureSet = modelMaterial->albedoTexturePath.empty() ? -1 : 0;
+            // physical descriptor: MR or SpecGloss
+            if (modelMaterial->useSpecularGlossiness) {
+                material.useSpecGlossWorkflow = 1;
+                material.physicalDescriptorTextureSet = modelMaterial->specGlossTexturePath.empty() ? -1 : 0;
+                material.glossinessFactor = modelMaterial->glossinessFactor;
+                material.specularFactor = modelMaterial->specularFactor;
+            } else {
+                material.physicalDescriptorTextureSet = modelMaterial->metallicRoughnessTexturePath.empty() ? -1 : 0;
+            }
+            material.normalTextureSet = modelMaterial->normalTexturePath.empty() ? -1 : 0;
+            material.occlusionTextureSet = modelMaterial->occlusionTexturePath.empty() ? -1 : 0;
+            material.emissiveTextureSet = modelMaterial->emissiveTexturePath.empty() ? -1 : 0;
+
+            // Emissive and transmission/IOR
+            material.emissiveFactor = modelMaterial->emissive;
+            material.emissiveStrength = modelMaterial->emissiveStrength;
+            material.transmissionFactor = modelMaterial->transmissionFactor;
+            material.ior = modelMaterial->ior;
+
+            // Alpha mask handling
+            material.alphaMask = (modelMaterial->alphaMode == "MASK") ? 1.0f : 0.0f;
+            material.alphaMaskCutoff = modelMaterial->alphaCutoff;
+
+            // For bar liquids and similar volumes, we want the fill to be
+            // clearly visible rather than fully transmissive. For these
+            // materials, disable the transmission branch in the PBR shader
+            // and treat them as regular alpha-blended PBR surfaces.
+            if (modelMaterial->isLiquid) {
+                material.transmissionFactor = 0.0f;
+            }
+        }
 
-                vk::DescriptorBufferInfo lightBufferInfo{ .buffer = *lightStorageBuffers[i].buffer, .range = VK_WHOLE_SIZE };
-                descriptorWrites[6] = { .dstSet = *targetDescriptorSets[i], .dstBinding = 6, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eStorageBuffer, .pBufferInfo = &lightBufferInfo };
-
-                device.updateDescriptorSets(descriptorWrites, {});
-            } else { // Basic Pipeline
-                // ... (this part remains the same)
-                 auto textureIt = textureResources.find(resolvedTexturePath);
-                TextureResources* texRes = (textureIt != textureResources.end()) ? &textureIt->second : &defaultTextureResources;
-                vk::DescriptorImageInfo imageInfo{ .sampler = *texRes->textureSampler, .imageView = *texRes->textureImageView, .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal };
-                std::array<vk::WriteDescriptorSet, 2> descriptorWrites = {
-                    vk::WriteDescriptorSet{ .dstSet = *targetDescriptorSets[i], .dstBinding = 0, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eUniformBuffer, .pBufferInfo = &bufferInfo },
-                    vk::WriteDescriptorSet{ .dstSet = *targetDescriptorSets[i], .dstBinding = 1, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eCombinedImageSampler, .pImageInfo = &imageInfo }
-                };
-                device.updateDescriptorSets(descriptorWrites, {});
+        material.baseColorTexture = getBindlessTextureSlot(baseColorPath);
+        material.metallicRoughnessTexture = getBindlessTextureSlot(mrPath);
+        material.normalTexture = getBindlessTextureSlot(normalPath);
+        material.occlusionTexture = getBindlessTextureSlot(occlusionPath);
+        material.emissiveTexture = getBindlessTextureSlot(emissivePath);
+
+        // Held across the texture check so an upload cannot slip in before the hint slot is recorded
+        const std::string resolvedBase = ResolveTextureId(baseColorPath);
+        std::lock_guard<std::mutex> lock(bindlessMutex);
+
+        // If no explicit MASK from a material, infer it from the baseColor texture's alpha usage.
+        // Avoid inferring MASK from the shared default albedo (semi-transparent placeholder).
+        uint32_t alphaHintSlot = UINT32_MAX;
+        if (material.alphaMask < 0.5f && baseColorPath != SHARED_DEFAULT_ALBEDO_ID) {
+            std::shared_lock<std::shared_mutex> texLock(textureResourcesMutex);
+            auto itTex = textureResources.find(resolvedBase);
+            if (itTex == textureResources.end()) {
+                // Not uploaded yet: OnTextureUploaded applies the hint
+                alphaHintSlot = material.baseColorTexture;
+            } else if (itTex->second.alphaMaskedHint) {
+                material.alphaMask = 1.0f;
+                material.alphaMaskCutoff = 0.5f;
             }
         }
+
+        std::string key(reinterpret_cast<const char*>(&material), sizeof(material));
+        auto [it, inserted] = materialIndices.try_emplace(std::move(key), static_cast<uint32_t>(materials.size()));
+        if (inserted) {
+            materials.push_back(material);
+            materialAlphaHintSlots.push_back(alphaHintSlot);
+            for (auto& buffer : materialBuffers) {
+                size_t index = it->second;
+                buffer.dirtyBegin = buffer.dirtyBegin == buffer.dirtyEnd ? index : std::min(buffer.dirtyBegin, index);
+                buffer.dirtyEnd = std::max(buffer.dirtyEnd, index + 1);
+            }
+        }
+        // The material entry is part of the entity's instance records
+        if (entityIt->second.materialIndex != it->second) {
+            entityIt->second.materialIndex = it->second;
+            entityIt->second.MarkInstancesDirty(0, entityIt->second.instanceCapacity);
+        }
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "Failed to create descriptor sets for " << entity->GetName() << ": " << e.what() << std::endl;
+        std::cerr << "Failed to create material for " << entity->GetName() << ": " << e.what() << std::endl;
         return false;
     }
 }
@@ -1131,6 +1630,14 @@ bool Renderer::preAllocateEntityResources(Entity* entity) {
             return false;
         }
 
+        // An entity that already has resources already holds its mesh reference
+        const std::shared_ptr<const MeshGeometry>& geometry = meshComponent->GetGeometry();
+        const bool hadResources = entityResources.contains(entity);
+        std::vector<std::shared_ptr<const MeshGeometry>> uploaded;
+        if (!meshResources.contains(geometry.get())) {
+            uploaded.push_back(geometry);
+        }
+
         // 1. Create mesh resources (vertex/index buffers)
         if (!createMeshResources(meshComponent)) {
             std::cerr << "Failed to create mesh resources for entity: " << entity->GetName() << std::endl;
@@ -1140,30 +1647,21 @@ bool Renderer::preAllocateEntityResources(Entity* entity) {
         // 2. Create uniform buffers
         if (!createUniformBuffers(entity)) {
             std::cerr << "Failed to create uniform buffers for entity: " << entity->GetName() << std::endl;
+            rollBackEntityResources({}, uploaded);
             return false;
         }
 
 
-        // 3. Pre-allocate BOTH basic and PBR descriptor sets
-        std::string texturePath = meshComponent->GetTexturePath();
-        // Fallback: if legacy texturePath is empty, use PBR baseColor texture
-        if (texturePath.empty()) {
-            const std::string& baseColor = meshComponent->GetBaseColorTexturePath();
-            if (!baseColor.empty()) {
-                texturePath = baseColor;
-            }
-        }
-
-        // Create basic descriptor sets
-        if (!createDescriptorSets(entity, texturePath, false)) {
-            std::cerr << "Failed to create basic descriptor sets for entity: " << entity->GetName() << std::endl;
+        // 3. Add the entity's material to the bindless material table
+        if (!createEntityMaterial(entity)) {
+            std::cerr << "Failed to create material for entity: " << entity->GetName() << std::endl;
+            rollBackEntityResources(hadResources ? std::vector<Entity*>{} : std::vector<Entity*>{entity}, uploaded);
             return false;
         }
 
-        // Create PBR descriptor sets
-        if (!createDescriptorSets(entity, texturePath, true)) {
-            std::cerr << "Failed to create PBR descriptor sets for entity: " << entity->GetName() << std::endl;
-            return false;
+        // 4. Take the mesh reference now that nothing can fail anymore
+        if (!hadResources) {
+            meshResources.at(geometry.get()).references++;
         }
         return true;
 
@@ -1176,163 +1674,103 @@ bool Renderer::preAllocateEntityResources(Entity* entity) {
 // Pre-allocate Vulkan resources for a batch of entities, batching mesh uploads
 bool Renderer::preAllocateEntityResourcesBatch(const std::vector<Entity*>& entities) {
     ensureThreadLocalVulkanInit();
+    // Entities given resources and meshes uploaded by this call, undone if the batch fails
+    std::vector<Entity*> createdEntities;
+    std::vector<std::shared_ptr<const MeshGeometry>> newMeshes;
     try {
-        // --- 1. For all entities, create mesh resources with deferred uploads ---
-        std::vector<MeshComponent*> meshesNeedingUpload;
-        meshesNeedingUpload.reserve(entities.size());
+        // --- 1. Count the references the batch takes; nothing is committed until every entity succeeded ---
+        std::unordered_map<const MeshGeometry*, uint32_t> batchReferences;
+        std::unordered_set<Entity*> seen;
+        std::vector<Entity*> meshEntities;
+        meshEntities.reserve(entities.size());
 
         for (Entity* entity : entities) {
-            if (!entity) {
-                continue;
-            }
-
-            auto meshComponent = entity->GetComponent<MeshComponent>();
-            if (!meshComponent) {
+            auto meshComponent = entity ? entity->GetComponent<MeshComponent>() : nullptr;
+            if (!meshComponent || !seen.insert(entity).second) {
                 continue;
             }
-
-            if (!createMeshResources(meshComponent, true)) {
-                std::cerr << "Failed to create mesh resources for entity (batch): "
-                          << entity->GetName() << std::endl;
-                return false;
-            }
-
-            auto it = meshResources.find(meshComponent);
-            if (it == meshResources.end()) {
-                continue;
+            meshEntities.push_back(entity);
+            if (entityResources.contains(entity)) {
+                continue; // Already holds its reference
             }
-            MeshResources& res = it->second;
 
-            // Only schedule meshes that still have staged data pending upload
-            if (res.vertexBufferSizeBytes > 0 && res.indexBufferSizeBytes > 0) {
-                meshesNeedingUpload.push_back(meshComponent);
+            const std::shared_ptr<const MeshGeometry>& geometry = meshComponent->GetGeometry();
+            if (batchReferences[geometry.get()]++ == 0 && !meshResources.contains(geometry.get())) {
+                newMeshes.push_back(geometry);
             }
         }
 
-        // --- 2. Batch all buffer copies into a single command buffer submission ---
-        if (!meshesNeedingUpload.empty()) {
-            vk::CommandPoolCreateInfo poolInfo{
-                .flags = vk::CommandPoolCreateFlagBits::eTransient | vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
-                .queueFamilyIndex = queueFamilyIndices.transferFamily.value()
-            };
-            vk::raii::CommandPool tempPool(device, poolInfo);
-
-            vk::CommandBufferAllocateInfo allocInfo{
-                .commandPool = *tempPool,
-                .level = vk::CommandBufferLevel::ePrimary,
-                .commandBufferCount = 1
-            };
-            vk::raii::CommandBuffers commandBuffers(device, allocInfo);
-            vk::raii::CommandBuffer& commandBuffer = commandBuffers[0];
-
-            vk::CommandBufferBeginInfo beginInfo{
-                .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
-            };
-            commandBuffer.begin(beginInfo);
-
-            for (MeshComponent* meshComponent : meshesNeedingUpload) {
-                auto it = meshResources.find(meshComponent);
-                if (it == meshResources.end()) {
-                    continue;
-                }
-                MeshResources& res = it->second;
-
-                if (res.vertexBufferSizeBytes > 0) {
-                    vk::BufferCopy copyRegion{
-                        .srcOffset = 0,
-                        .dstOffset = 0,
-                        .size = res.vertexBufferSizeBytes
-                    };
-                    commandBuffer.copyBuffer(*res.stagingVertexBuffer, *res.vertexBuffer, copyRegion);
-                }
-
-                if (res.indexBufferSizeBytes > 0) {
-                    vk::BufferCopy copyRegion{
-                        .srcOffset = 0,
-                        .dstOffset = 0,
-                        .size = res.indexBufferSizeBytes
-                    };
-                    commandBuffer.copyBuffer(*res.stagingIndexBuffer, *res.indexBuffer, copyRegion);
-                }
-            }
-
-            commandBuffer.end();
-
-            vk::SubmitInfo submitInfo{
-                .commandBufferCount = 1,
-                .pCommandBuffers = &*commandBuffer
-            };
-
-            vk::raii::Fence fence(device, vk::FenceCreateInfo{});
-            {
-                std::lock_guard<std::mutex> lock(queueMutex);
-                transferQueue.submit(submitInfo, *fence);
-            }
-            [[maybe_unused]] auto fenceResult = device.waitForFences({*fence}, VK_TRUE, UINT64_MAX);
-
-            // After upload, staging buffers can be released (RAII will destroy them)
-            for (MeshComponent* meshComponent : meshesNeedingUpload) {
-                auto it = meshResources.find(meshComponent);
-                if (it == meshResources.end()) {
-                    continue;
-                }
-                MeshResources& res = it->second;
-                res.stagingVertexBuffer = nullptr;
-                res.stagingVertexBufferMemory = nullptr;
-                res.vertexBufferSizeBytes = 0;
-                res.stagingIndexBuffer = nullptr;
-                res.stagingIndexBufferMemory = nullptr;
-                res.indexBufferSizeBytes = 0;
-            }
+        // --- 2. Upload all new geometry with one staging buffer and one submission ---
+        if (!newMeshes.empty() && !uploadMeshes(newMeshes)) {
+            std::cerr << "Failed to create mesh resources for entity batch of " << meshEntities.size() << std::endl;
+            return false;
         }
 
-        // --- 3. Create uniform buffers and descriptor sets per entity ---
-        for (Entity* entity : entities) {
-            if (!entity) {
-                continue;
-            }
-
-            auto meshComponent = entity->GetComponent<MeshComponent>();
-            if (!meshComponent) {
-                continue;
-            }
-
+        // --- 3. Create object slots, instance ranges and materials per entity ---
+        // Instance ranges come from the shared instance storage, so this makes no Vulkan calls
+        for (Entity* entity : meshEntities) {
+            const bool hadResources = entityResources.contains(entity);
             if (!createUniformBuffers(entity)) {
                 std::cerr << "Failed to create uniform buffers for entity (batch): "
                           << entity->GetName() << std::endl;
+                rollBackEntityResources(createdEntities, newMeshes);
                 return false;
             }
-
-            std::string texturePath = meshComponent->GetTexturePath();
-            // Fallback: if legacy texturePath is empty, use PBR baseColor texture
-            if (texturePath.empty()) {
-                const std::string& baseColor = meshComponent->GetBaseColorTexturePath();
-                if (!baseColor.empty()) {
-                    texturePath = baseColor;
-                }
+            if (!hadResources) {
+                createdEntities.push_back(entity);
             }
 
-            if (!createDescriptorSets(entity, texturePath, false)) {
-                std::cerr << "Failed to create basic descriptor sets for entity (batch): "
+            if (!createEntityMaterial(entity)) {
+                std::cerr << "Failed to create material for entity (batch): "
                           << entity->GetName() << std::endl;
+                rollBackEntityResources(createdEntities, newMeshes);
                 return false;
             }
+        }
 
-            if (!createDescriptorSets(entity, texturePath, true)) {
-                std::cerr << "Failed to create PBR descriptor sets for entity (batch): "
-                          << entity->GetName() << std::endl;
-                return false;
-            }
+        // --- 4. Commit the references of the whole batch ---
+        for (const auto& [geometry, references] : batchReferences) {
+            meshResources.at(geometry).references += references;
         }
 
+        entityBatchStats.batches++;
+        entityBatchStats.entities += meshEntities.size();
         return true;
 
     } catch (const std::exception& e) {
         std::cerr << "Failed to batch pre-allocate resources for entities: " << e.what() << std::endl;
+        rollBackEntityResources(createdEntities, newMeshes);
         return false;
     }
 }
 
+void Renderer::rollBackEntityResources(const std::vector<Entity*>& createdEntities,
+                                       const std::vector<std::shared_ptr<const MeshGeometry>>& uploadedMeshes) {
+    for (Entity* entity : createdEntities) {
+        auto it = entityResources.find(entity);
+        if (it == entityResources.end()) {
+            continue;
+        }
+        // Give the entity the reference its release hands back
+        if (auto meshIt = meshResources.find(it->second.geometry); meshIt != meshResources.end()) {
+            meshIt->second.references++;
+        }
+        ReleaseEntityResources(entity);
+    }
+
+    // Uploaded for entities that never got their resources; no frame has recorded a draw from them
+    for (const auto& geometry : uploadedMeshes) {
+        auto meshIt = meshResources.find(geometry.get());
+        if (meshIt == meshResources.end() || meshIt->second.references > 0) {
+            continue;
+        }
+        const MeshResources& mesh = meshIt->second;
+        freeGeometry(vertexArenas, mesh.vertexArena, static_cast<uint32_t>(mesh.vertexOffset), mesh.vertexCount);
+        freeGeometry(indexArenas, mesh.indexArena, mesh.firstIndex, mesh.indexRangeCount);
+        meshResources.erase(meshIt);
+    }
+}
+
 // Create buffer using memory pool for efficient allocation
 std::pair<vk::raii::Buffer, std::unique_ptr<MemoryPool::Allocation>> Renderer::createBufferPooled(
     vk::DeviceSize size,
@@ -1505,7 +1943,7 @@ bool Renderer::createOpaqueSceneColorResources() {
 }
 
 // Copy buffer
-void Renderer::copyBuffer(vk::raii::Buffer& srcBuffer, vk::raii::Buffer& dstBuffer, vk::DeviceSize size) {
+void Renderer::copyBuffer(vk::raii::Buffer& srcBuffer, vk::raii::Buffer& dstBuffer, vk::DeviceSize size, vk::DeviceSize dstOffset) {
     ensureThreadLocalVulkanInit();
     try {
         // Create a temporary transient command pool and command buffer to isolate per-thread usage (transfer family)
@@ -1533,7 +1971,7 @@ void Renderer::copyBuffer(vk::raii::Buffer& srcBuffer, vk::raii::Buffer& dstBuff
         // Copy buffer
         vk::BufferCopy copyRegion{
             .srcOffset = 0,
-            .dstOffset = 0,
+            .dstOffset = dstOffset,
             .size = size
         };
 
@@ -1892,39 +2330,247 @@ bool Renderer::createOrResizeLightStorageBuffers(size_t lightCount) {
 // Update all existing descriptor sets with new light storage buffer references
 void Renderer::updateAllDescriptorSetsWithNewLightBuffers() {
     try {
-        // Iterate through all entity resources and update their PBR descriptor sets
-        for (auto& resources : entityResources | std::views::values) {
-            // Only update PBR descriptor sets (they have light buffer bindings)
-            if (!resources.pbrDescriptorSets.empty()) {
-                for (size_t i = 0; i < resources.pbrDescriptorSets.size() && i < lightStorageBuffers.size(); ++i) {
-                    if (i < lightStorageBuffers.size() && *lightStorageBuffers[i].buffer) {
-                        // Create descriptor write for light storage buffer (binding 7)
-                        vk::DescriptorBufferInfo lightBufferInfo{
-                            .buffer = *lightStorageBuffers[i].buffer,
-                            .offset = 0,
-                            .range = VK_WHOLE_SIZE
-                        };
-
-                        vk::WriteDescriptorSet descriptorWrite{
-                            .dstSet = *resources.pbrDescriptorSets[i],
-                            .dstBinding = 6,
-                            .dstArrayElement = 0,
-                            .descriptorCount = 1,
-                            .descriptorType = vk::DescriptorType::eStorageBuffer,
-                            .pBufferInfo = &lightBufferInfo
-                        };
-
-                        // Update the descriptor set
-                        device.updateDescriptorSets(descriptorWrite, {});
-                    }
-                }
-            }
+        // Only the global sets reference the light buffers (binding 1)
+        for (size_t i = 0; i < globalDescriptorSets.size() && i < lightStorageBuffers.size(); ++i) {
+            if (!*lightStorageBuffers[i].buffer) continue;
+            vk::DescriptorBufferInfo lightBufferInfo{
+                .buffer = *lightStorageBuffers[i].buffer,
+                .offset = 0,
+                .range = VK_WHOLE_SIZE
+            };
+
+            vk::WriteDescriptorSet descriptorWrite{
+                .dstSet = *globalDescriptorSets[i],
+                .dstBinding = 1,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
+                .pBufferInfo = &lightBufferInfo
+            };
+
+            // Update the descriptor set
+            device.updateDescriptorSets(descriptorWrite, {});
         }
     } catch (const std::exception& e) {
         std::cerr << "Failed to update descriptor sets with new light buffers: " << e.what() << std::endl;
     }
 }
 
+// Create the per-frame global uniform buffers and the initial object storage buffers
+bool Renderer::createGlobalUniformBuffers() {
+    try {
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+            auto [buffer, bufferAllocation] = createBufferPooled(
+                sizeof(UniformBufferObject),
+                vk::BufferUsageFlagBits::eUniformBuffer,
+                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+            );
+
+            // Use the memory pool's mapped pointer if available
+            void* mappedMemory = bufferAllocation->mappedPtr;
+            if (!mappedMemory) {
+                std::cerr << "Warning: Uniform buffer allocation is not mapped" << std::endl;
+            }
+
+            globalUniformBuffers.emplace_back(std::move(buffer));
+            globalUniformBufferAllocations.emplace_back(std::move(bufferAllocation));
+            globalUniformBuffersMapped.emplace_back(mappedMemory);
+        }
+
+        return createOrResizeObjectStorageBuffers(1);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create global uniform buffers: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Create or resize the object storage buffers to accommodate the given number of slots
+bool Renderer::createOrResizeObjectStorageBuffers(size_t objectCount) {
+    try {
+        if (objectStorageBuffers.size() != MAX_FRAMES_IN_FLIGHT) {
+            objectStorageBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        }
+        if (objectStorageBuffers.front().capacity >= objectCount) {
+            return true;
+        }
+
+        // Headroom so entities streaming in do not resize every frame
+        size_t newCapacity = std::max(objectCount * 2, static_cast<size_t>(1024));
+
+        // Every frame's descriptor sets reference these buffers
+        device.waitIdle();
+
+        std::lock_guard<std::mutex> lock(objectStorageBufferMutex);
+        for (auto& buffer : objectStorageBuffers) {
+            // The device is idle, so the old buffer goes back to the pool right away
+            buffer.buffer = nullptr;
+            if (buffer.allocation) {
+                memoryPool->deallocate(std::move(buffer.allocation));
+            }
+
+            auto [newBuffer, newAllocation] = createBufferPooled(
+                objectDataStride * newCapacity,
+                vk::BufferUsageFlagBits::eStorageBuffer,
+                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+            );
+            buffer.mapped = newAllocation->mappedPtr;
+            buffer.buffer = std::move(newBuffer);
+            buffer.allocation = std::move(newAllocation);
+            buffer.capacity = newCapacity;
+        }
+
+        updateAllDescriptorSetsWithNewObjectBuffers();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create or resize object storage buffers: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Update all existing descriptor sets with new object storage buffer references
+void Renderer::updateAllDescriptorSetsWithNewObjectBuffers() {
+    try {
+        // Only the global sets reference the object buffers (binding 2)
+        for (size_t i = 0; i < globalDescriptorSets.size() && i < objectStorageBuffers.size(); ++i) {
+            vk::DescriptorBufferInfo objectBufferInfo{
+                .buffer = *objectStorageBuffers[i].buffer,
+                .offset = 0,
+                .range = VK_WHOLE_SIZE
+            };
+
+            vk::WriteDescriptorSet descriptorWrite{
+                .dstSet = *globalDescriptorSets[i],
+                .dstBinding = 2,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
+                .pBufferInfo = &objectBufferInfo
+            };
+            device.updateDescriptorSets(descriptorWrite, {});
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to update descriptor sets with new object buffers: " << e.what() << std::endl;
+    }
+}
+
+// Create or resize the material buffers to accommodate the given number of materials
+bool Renderer::createOrResizeMaterialBuffers(size_t materialCount) {
+    try {
+        if (materialBuffers.size() != MAX_FRAMES_IN_FLIGHT) {
+            materialBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        }
+        if (materialBuffers.front().capacity >= materialCount) {
+            return true;
+        }
+
+        // Headroom so streamed-in materials do not resize every frame
+        size_t newCapacity = std::max(materialCount * 2, static_cast<size_t>(256));
+
+        // Every frame's bindless set references these buffers
+        device.waitIdle();
+
+        for (auto& buffer : materialBuffers) {
+            // The device is idle, so the old buffer goes back to the pool right away
+            buffer.buffer = nullptr;
+            if (buffer.allocation) {
+                memoryPool->deallocate(std::move(buffer.allocation));
+            }
+
+            auto [newBuffer, newAllocation] = createBufferPooled(
+                sizeof(MaterialData) * newCapacity,
+                vk::BufferUsageFlagBits::eStorageBuffer,
+                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+            );
+            buffer.mapped = newAllocation->mappedPtr;
+            buffer.buffer = std::move(newBuffer);
+            buffer.allocation = std::move(newAllocation);
+            buffer.capacity = newCapacity;
+            buffer.count = 0;
+            buffer.dirtyBegin = 0;
+            buffer.dirtyEnd = materialCount;
+        }
+
+        updateAllDescriptorSetsWithNewMaterialBuffers();
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to create or resize material buffers: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// Update the bindless descriptor sets with new material buffer references
+void Renderer::updateAllDescriptorSetsWithNewMaterialBuffers() {
+    try {
+        for (size_t i = 0; i < bindlessDescriptorSets.size() && i < materialBuffers.size(); ++i) {
+            vk::DescriptorBufferInfo materialBufferInfo{
+                .buffer = *materialBuffers[i].buffer,
+                .offset = 0,
+                .range = VK_WHOLE_SIZE
+            };
+
+            vk::WriteDescriptorSet descriptorWrite{
+                .dstSet = *bindlessDescriptorSets[i],
+                .dstBinding = 1,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = vk::DescriptorType::eStorageBuffer,
+                .pBufferInfo = &materialBufferInfo
+            };
+            device.updateDescriptorSets(descriptorWrite, {});
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to update descriptor sets with new material buffers: " << e.what() << std::endl;
+    }
+}
+
+// Write a frame's pending texture slots and material changes into its bindless set
+size_t Renderer::updateBindlessDescriptors(uint32_t frame) {
+    std::lock_guard<std::mutex> lock(bindlessMutex);
+    if (frame >= materialBuffers.size() || frame >= bindlessDescriptorSets.size()) {
+        return 0;
+    }
+
+    // Slots assigned or uploaded since this frame's set was last written
+    std::vector<uint32_t> slots;
+    slots.swap(pendingBindlessSlots[frame]);
+    if (!slots.empty()) {
+        std::ranges::sort(slots);
+        auto [first, last] = std::ranges::unique(slots);
+        slots.erase(first, last);
+
+        std::vector<vk::DescriptorImageInfo> imageInfos;
+        std::vector<vk::WriteDescriptorSet> descriptorWrites;
+        imageInfos.reserve(slots.size());
+        descriptorWrites.reserve(slots.size());
+        {
+            std::shared_lock<std::shared_mutex> texLock(textureResourcesMutex);
+            for (uint32_t slot : slots) {
+                auto textureIt = textureResources.find(bindlessSlotTextureIds[slot]);
+                const TextureResources* texRes = (textureIt != textureResources.end()) ? &textureIt->second : &defaultTextureResources;
+                imageInfos.push_back({ .sampler = *texRes->textureSampler, .imageView = *texRes->textureImageView, .imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal });
+                descriptorWrites.push_back({ .dstSet = *bindlessDescriptorSets[frame], .dstBinding = 0, .dstArrayElement = slot, .descriptorCount = 1, .descriptorType = vk::DescriptorType::eCombinedImageSampler, .pImageInfo = &imageInfos.back() });
+            }
+        }
+        device.updateDescriptorSets(descriptorWrites, {});
+    }
+
+    // Materials added or changed since this frame's buffer was last written
+    if (materialBuffers[frame].capacity < materials.size() && !createOrResizeMaterialBuffers(materials.size())) {
+        return 0;
+    }
+    MaterialBuffer& buffer = materialBuffers[frame];
+    if (buffer.dirtyBegin < buffer.dirtyEnd && buffer.mapped) {
+        size_t end = std::min(buffer.dirtyEnd, materials.size());
+        if (buffer.dirtyBegin < end) {
+            std::memcpy(static_cast<MaterialData*>(buffer.mapped) + buffer.dirtyBegin, materials.data() + buffer.dirtyBegin,
+                        (end - buffer.dirtyBegin) * sizeof(MaterialData));
+        }
+    }
+    buffer.dirtyBegin = buffer.dirtyEnd = 0;
+    buffer.count = materials.size();
+    return buffer.count;
+}
+
 // Update the light storage buffer with current light data
 bool Renderer::updateLightStorageBuffer(uint32_t frameIndex, const std::vector<ExtractedLight>& lights) {
     try {
@@ -2023,6 +2669,9 @@ std::future<bool> Renderer::LoadTextureAsync(const std::string& texturePath, boo
         job.priority = critical ? PendingTextureJob::Priority::Critical
                                 : PendingTextureJob::Priority::NonCritical;
         job.idOrPath = texturePath;
+        std::error_code ec;
+        uintmax_t fileSize = std::filesystem::file_size(texturePath, ec);
+        job.bytes = ec ? 0 : static_cast<uint64_t>(fileSize);
         {
             std::lock_guard<std::mutex> lk(pendingTextureJobsMutex);
             pendingTextureJobs.emplace_back(std::move(job));
@@ -2046,6 +2695,10 @@ std::future<bool> Renderer::LoadTextureFromMemoryAsync(const std::string& textur
     if (!imageData || textureId.empty() || width <= 0 || height <= 0 || channels <= 0) {
         return std::async(std::launch::deferred, [] { return false; });
     }
+    // Images identical to one already loaded or queued are not uploaded again
+    if (deduplicateTextureContent(textureId, imageData, width, height, channels)) {
+        return std::async(std::launch::deferred, [] { return true; });
+    }
     // Copy the source bytes so the caller can free/modify their buffer immediately
     size_t srcSize = static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(channels);
     std::vector<unsigned char> dataCopy(srcSize);
@@ -2063,6 +2716,7 @@ std::future<bool> Renderer::LoadTextureFromMemoryAsync(const std::string& textur
         job.width = width;
         job.height = height;
         job.channels = channels;
+        job.bytes = static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * 4;
         {
             std::lock_guard<std::mutex> lk(pendingTextureJobsMutex);
             pendingTextureJobs.emplace_back(std::move(job));
@@ -2096,108 +2750,426 @@ void Renderer::WaitForAllTextureTasks() {
     }
 }
 
-void Renderer::RegisterTextureUser(const std::string& textureId, Entity* entity) {
-    if (textureId.empty() || !entity) return;
-
-    // Always register under the canonical resolved ID so that lookups from
-    // descriptor creation and upload completion (which also use
-    // ResolveTextureId) are consistent.
+void Renderer::OnTextureUploaded(const std::string& textureId) {
+    // Resolve alias to the canonical ID the bindless slots are keyed by
     std::string canonicalId = ResolveTextureId(textureId);
     if (canonicalId.empty()) {
         canonicalId = textureId;
     }
 
-    std::lock_guard<std::mutex> lk(textureUsersMutex);
-    textureToEntities[canonicalId].push_back(entity);
+    bool alphaMaskedHint = false;
+    {
+        std::shared_lock<std::shared_mutex> texLock(textureResourcesMutex);
+        auto it = textureResources.find(canonicalId);
+        if (it == textureResources.end()) {
+            return;
+        }
+        alphaMaskedHint = it->second.alphaMaskedHint;
+    }
+
+    std::lock_guard<std::mutex> lock(bindlessMutex);
+    auto slotIt = bindlessTextureSlots.find(canonicalId);
+    if (slotIt == bindlessTextureSlots.end()) {
+        // No material references the texture yet; its slot is written when one does
+        return;
+    }
+    // Swap the slot from the default texture to the uploaded one in every frame's set
+    const uint32_t slot = slotIt->second;
+    for (auto& pending : pendingBindlessSlots) {
+        pending.push_back(slot);
+    }
+
+    // Materials whose base color texture was still streaming infer alpha masking now
+    for (size_t i = 0; i < materials.size(); ++i) {
+        if (materialAlphaHintSlots[i] != slot) continue;
+        materialAlphaHintSlots[i] = UINT32_MAX;
+        if (!alphaMaskedHint) continue;
+        materials[i].alphaMask = 1.0f;
+        materials[i].alphaMaskCutoff = 0.5f;
+        for (auto& buffer : materialBuffers) {
+            buffer.dirtyBegin = buffer.dirtyBegin == buffer.dirtyEnd ? i : std::min(buffer.dirtyBegin, i);
+            buffer.dirtyEnd = std::max(buffer.dirtyEnd, i + 1);
+        }
+    }
+}
+
+void Renderer::ReleaseEntityResources(Entity* entity) {
+    if (!entity) {
+        return;
+    }
+    // Frames up to the one recorded last may still draw the entity
+    const uint64_t lastUse = renderedFrameCount;
+
+    auto entityIt = entityResources.find(entity);
+    if (entityIt == entityResources.end()) {
+        return;
+    }
+    const EntityResources& resources = entityIt->second;
+    if (resources.instanceCapacity > 0) {
+        deletionQueue.RetireWith(lastUse, [this, first = resources.firstInstance, count = resources.instanceCapacity]() {
+            std::lock_guard<std::mutex> lock(instanceRangeMutex);
+            returnFreeRange(freeInstanceRanges, instanceRangeEnd, first, count);
+        });
+    }
+    // Material entries are shared by content and stay in the table
+    deletionQueue.RetireWith(lastUse, [this, objectIndex = resources.objectIndex]() {
+        std::lock_guard<std::mutex> slotLock(objectSlotMutex);
+        freeObjectSlots.push_back(objectIndex);
+    });
+
+    // Shared geometry stays resident until the last entity drawing it is gone. The key is the
+    // one the reference was taken on, even if the component has been given other geometry since.
+    auto meshIt = resources.geometry ? meshResources.find(resources.geometry) : meshResources.end();
+    entityResources.erase(entityIt);
+    if (meshIt != meshResources.end() && --meshIt->second.references == 0) {
+        const MeshResources& mesh = meshIt->second;
+        deletionQueue.RetireWith(lastUse, [this, vertexArena = mesh.vertexArena, vertexOffset = mesh.vertexOffset,
+                                           vertexCount = mesh.vertexCount, indexArena = mesh.indexArena,
+                                           firstIndex = mesh.firstIndex, indexRangeCount = mesh.indexRangeCount]() {
+            freeGeometry(vertexArenas, vertexArena, static_cast<uint32_t>(vertexOffset), vertexCount);
+            freeGeometry(indexArenas, indexArena, firstIndex, indexRangeCount);
+        });
+        meshResources.erase(meshIt);
+    }
 }
 
-void Renderer::OnTextureUploaded(const std::string& textureId) {
-    // Resolve alias to canonical ID used for tracking and descriptor
-    // creation. RegisterTextureUser also stores under this canonical ID.
-    std::string canonicalId = ResolveTextureId(textureId);
-    if (canonicalId.empty()) {
-        canonicalId = textureId;
+void Renderer::compactMemoryPool(uint32_t frame) {
+    if (!memoryPool) {
+        return;
     }
 
-    std::vector<Entity*> users;
-    {
-        std::lock_guard<std::mutex> lk(textureUsersMutex);
-        auto it = textureToEntities.find(canonicalId);
-        if (it == textureToEntities.end()) {
-            return;
+    vk::DeviceSize releasedBytes = memoryPool->releaseEmptyBlocks(renderedFrameCount);
+    if (releasedBytes > 0) {
+        memoryDefragmentationStats.bytesReleased += releasedBytes;
+        MemoryPool::FragmentationStats staging = memoryPool->getFragmentationStats(MemoryPool::PoolType::STAGING_BUFFER);
+        std::cout << "Memory pool: released " << releasedBytes / (1024 * 1024) << " MB of empty blocks; host-visible pool "
+                  << staging.blockCount << " blocks, " << staging.usedBytes / 1024 << " of " << staging.totalBytes / 1024
+                  << " KB used, largest free range " << staging.largestFreeRange / 1024 << " KB in "
+                  << staging.freeRangeCount << " ranges" << std::endl;
+    }
+
+    // Wait until the scene is parsed; its allocations are still settling until then
+    if (memoryDefragmentationBudget == 0 || renderedFrameCount < nextDefragmentationFrame || loadingFlag.load()) {
+        return;
+    }
+
+    // The slot's previous frame has completed, so its instance storage and indirect buffers
+    // are idle until it is recorded
+    struct MovableBuffer {
+        vk::raii::Buffer* buffer;
+        std::unique_ptr<MemoryPool::Allocation>* allocation;
+        void** mapped;              // Cached mapping to update, if the owner keeps one
+        vk::DeviceSize size;
+        vk::BufferUsageFlags usage;
+    };
+    std::vector<MovableBuffer> buffers;
+    if (frame < instanceStorageBuffers.size() && instanceStorageBuffers[frame].allocation) {
+        InstanceStorageBuffer& storage = instanceStorageBuffers[frame];
+        buffers.push_back({&storage.buffer, &storage.allocation, &storage.mapped, sizeof(InstanceRecord) * storage.capacity,
+                           vk::BufferUsageFlagBits::eVertexBuffer});
+    }
+    if (frame < indirectBufferAllocations.size() && indirectBufferAllocations[frame]) {
+        buffers.push_back({&indirectBuffers[frame], &indirectBufferAllocations[frame], nullptr,
+                           sizeof(vk::DrawIndexedIndirectCommand) * indirectBufferCapacity[frame],
+                           vk::BufferUsageFlagBits::eIndirectBuffer});
+    }
+    std::vector<MemoryPool::RelocationCandidate> candidates;
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        candidates.push_back({i, buffers[i].allocation->get(), buffers[i].buffer->getMemoryRequirements().alignment});
+    }
+
+    std::vector<MemoryPool::Relocation> relocations =
+        memoryPool->planRelocations(MemoryPool::PoolType::STAGING_BUFFER, candidates, memoryDefragmentationBudget);
+    if (relocations.empty()) {
+        nextDefragmentationFrame = renderedFrameCount + DEFRAGMENTATION_IDLE_FRAMES;
+        return;
+    }
+
+    try {
+        // Both buffers live in host-coherent memory, so the contents are copied between the
+        // persistent mappings and new buffers are bound at the reserved destinations
+        std::vector<vk::raii::Buffer> newBuffers;
+        newBuffers.reserve(relocations.size());
+        for (const auto& relocation : relocations) {
+            const MovableBuffer& source = buffers[relocation.id];
+            void* sourceMapped = (*source.allocation)->mappedPtr;
+            if (!sourceMapped || !relocation.destination->mappedPtr) {
+                throw std::runtime_error("relocated buffer is not mapped");
+            }
+            vk::BufferCreateInfo bufferInfo{
+                .size = source.size,
+                .usage = source.usage,
+                .sharingMode = vk::SharingMode::eExclusive
+            };
+            newBuffers.emplace_back(device, bufferInfo);
+            newBuffers.back().bindMemory(relocation.destination->memory, relocation.destination->offset);
+            std::memcpy(relocation.destination->mappedPtr, sourceMapped, source.size);
+        }
+
+        // No frame uses the old buffers, so they go right away
+        for (size_t i = 0; i < relocations.size(); ++i) {
+            const MovableBuffer& moved = buffers[relocations[i].id];
+            memoryDefragmentationStats.relocations++;
+            memoryDefragmentationStats.bytesMoved += relocations[i].destination->size;
+            *moved.buffer = std::move(newBuffers[i]);
+            if (moved.mapped) {
+                *moved.mapped = relocations[i].destination->mappedPtr;
+            }
+            memoryPool->deallocate(std::move(*moved.allocation));
+            *moved.allocation = std::move(relocations[i].destination);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to relocate per-frame buffers: " << e.what() << std::endl;
+        for (auto& relocation : relocations) {
+            memoryPool->deallocate(std::move(relocation.destination));
         }
-        users = it->second;
+        nextDefragmentationFrame = renderedFrameCount + DEFRAGMENTATION_IDLE_FRAMES;
     }
+}
 
-    for (Entity* entity : users) {
-        if (!entity) continue;
-        auto meshComponent = entity->GetComponent<MeshComponent>();
-        if (!meshComponent) continue;
+GeometrySharingStats Renderer::GetGeometrySharingStats() const {
+    GeometrySharingStats stats;
+    const vk::DeviceSize vertexStride = usePackedVertices ? sizeof(PackedVertex) : sizeof(Vertex);
+    for (const MeshResources& mesh : meshResources | std::views::values) {
+        uint64_t bytes = mesh.vertexCount * vertexStride + mesh.indexRangeCount * sizeof(uint32_t);
+        stats.residentMeshes++;
+        stats.meshReferences += mesh.references;
+        stats.deviceBytes += bytes;
+        stats.duplicateBytesAvoided += bytes * (mesh.references > 0 ? mesh.references - 1 : 0);
+    }
+    return stats;
+}
+
+// Track an uploaded texture in the residency policy (by bindless slot)
+void Renderer::registerTextureResidency(const std::string& textureId, vk::DeviceSize bytes, bool evictable) {
+    uint32_t slot = getBindlessTextureSlot(textureId);
+    if (slot == 0) {
+        // Default slot (array full); not tracked
+        return;
+    }
+    std::lock_guard<std::mutex> lock(bindlessMutex);
+    textureResidency.OnResident(slot, bytes, evictable, renderedFrameCount);
+}
+
+// Get the device memory textures may occupy
+uint64_t Renderer::queryTextureMemoryBudget() {
+    if (textureBudgetOverride > 0) {
+        return textureBudgetOverride;
+    }
+
+    vk::PhysicalDeviceMemoryProperties memoryProperties;
+    vk::PhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+    if (memoryBudgetSupported) {
+        auto chain = physicalDevice.getMemoryProperties2<vk::PhysicalDeviceMemoryProperties2, vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+        memoryProperties = chain.get<vk::PhysicalDeviceMemoryProperties2>().memoryProperties;
+        budgetProperties = chain.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+    } else {
+        memoryProperties = physicalDevice.getMemoryProperties();
+    }
+
+    // Budget and usage of the device-local heaps. Without VK_EXT_memory_budget the heap
+    // size stands in for the budget and the memory pool's blocks for the usage.
+    uint64_t heapBudget = 0;
+    uint64_t heapUsage = 0;
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i) {
+        if (!(memoryProperties.memoryHeaps[i].flags & vk::MemoryHeapFlagBits::eDeviceLocal)) continue;
+        heapBudget += memoryBudgetSupported ? budgetProperties.heapBudget[i] : memoryProperties.memoryHeaps[i].size;
+        heapUsage += memoryBudgetSupported ? budgetProperties.heapUsage[i] : 0;
+    }
+    if (!memoryBudgetSupported && memoryPool) {
+        heapUsage = memoryPool->getTotalMemoryUsage().second;
+    }
+
+    // Textures may use what the rest of the process leaves of 90% of the budget
+    uint64_t textureUsage = textureResidency.GetStats().residentBytes;
+    uint64_t otherUsage = heapUsage > textureUsage ? heapUsage - textureUsage : 0;
+    uint64_t available = heapBudget / 10 * 9;
+    return available > otherUsage ? available - otherUsage : 1;
+}
 
-        // Choose a primary texture path hint for basic pipeline; PBR
-        // descriptor creation will pull all PBR texture paths directly
-        // from the mesh component.
-        std::string basicTexPath = meshComponent->GetTexturePath();
-        if (basicTexPath.empty()) {
-            basicTexPath = meshComponent->GetBaseColorTexturePath();
+void Renderer::updateTextureResidency() {
+    const uint64_t frame = renderedFrameCount;
+
+    if (frame < lastResidencyUpdateFrame + RESIDENCY_UPDATE_INTERVAL) {
+        return;
+    }
+
+    uint64_t budget = queryTextureMemoryBudget();
+    std::vector<std::string> restreamIds;
+    std::vector<std::string> evictIds;
+    uint64_t residentBytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(bindlessMutex);
+
+        // Texture use since the last update, from the materials the draw loops recorded
+        size_t materialTotal = std::min(materialLastUsedFrame.size(), materials.size());
+        for (size_t i = 0; i < materialTotal; ++i) {
+            uint64_t usedFrame = materialLastUsedFrame[i];
+            if (usedFrame <= lastResidencyUpdateFrame) continue;
+            const MaterialData& material = materials[i];
+            for (uint32_t slot : { material.baseColorTexture, material.metallicRoughnessTexture, material.normalTexture,
+                                   material.occlusionTexture, material.emissiveTexture }) {
+                if (textureResidency.Touch(slot, usedFrame)) {
+                    restreamIds.push_back(bindlessSlotTextureIds[slot]);
+                }
+            }
         }
 
-        // Recreate/refresh descriptor sets for this entity so they now
-        // bind the just-uploaded texture instead of the default.
-        createDescriptorSets(entity, basicTexPath, false);
-        createDescriptorSets(entity, basicTexPath, true);
+        textureResidency.SetBudget(budget);
+        for (uint32_t slot : textureResidency.SelectEvictions(frame, RESIDENCY_MIN_IDLE_FRAMES)) {
+            evictIds.push_back(bindlessSlotTextureIds[slot]);
+            // Point the slot back at the default texture in every frame's set
+            for (auto& pending : pendingBindlessSlots) {
+                pending.push_back(slot);
+            }
+        }
+        residentBytes = textureResidency.GetStats().residentBytes;
+    }
+    lastResidencyUpdateFrame = frame;
+
+    if (!evictIds.empty()) {
+        std::unique_lock<std::shared_mutex> texLock(textureResourcesMutex);
+        for (const auto& id : evictIds) {
+            auto it = textureResources.find(id);
+            if (it == textureResources.end()) continue;
+            // The other frames' sets still reference the texture until their next bindless update
+            deletionQueue.RetireWith(frame + MAX_FRAMES_IN_FLIGHT - 1, [this, resources = std::move(it->second)]() mutable {
+                resources.textureSampler = nullptr;
+                resources.textureImageView = nullptr;
+                resources.textureImage = nullptr;
+                if (memoryPool && resources.textureImageAllocation) {
+                    memoryPool->deallocate(std::move(resources.textureImageAllocation));
+                }
+            });
+            textureResources.erase(it);
+        }
+    }
+    if (!evictIds.empty()) {
+        std::cout << "Texture residency: evicted " << evictIds.size() << " textures ("
+                  << residentBytes / (1024 * 1024) << " MB resident, budget " << budget / (1024 * 1024) << " MB)" << std::endl;
+    }
+
+    // Evicted textures that are drawn again go back through the streaming queue
+    for (const auto& id : restreamIds) {
+        LoadTextureAsync(id, false);
     }
 }
 
-void Renderer::ProcessPendingTextureJobs(uint32_t maxJobs,
+void Renderer::ProcessPendingTextureJobs(double budgetMs,
                                          bool includeCritical,
                                          bool includeNonCritical) {
+    PROFILE_SCOPE("Renderer::ProcessPendingTextureJobs");
     // Drain the pending job list under lock into a local vector, then
-    // perform a bounded number of texture loads (including Vulkan work)
-    // on this thread. This must be called from the main/render thread.
+    // perform the highest priority texture loads that fit the budget
+    // (including Vulkan work) on this thread. This must be called from
+    // the main/render thread.
     std::vector<PendingTextureJob> jobs;
     {
         std::lock_guard<std::mutex> lk(pendingTextureJobsMutex);
         if (pendingTextureJobs.empty()) {
+            lastTextureStreamingStats = { .budgetMs = budgetMs };
             return;
         }
         jobs.swap(pendingTextureJobs);
     }
 
-    std::vector<PendingTextureJob> remaining;
-    remaining.reserve(jobs.size());
-
-    uint32_t processed = 0;
-    for (auto& job : jobs) {
-        const bool isCritical = (job.priority == PendingTextureJob::Priority::Critical);
-        if (processed < maxJobs &&
-            ((isCritical && includeCritical) || (!isCritical && includeNonCritical))) {
-            switch (job.type) {
-                case PendingTextureJob::Type::FromFile:
-                    // LoadTexture will resolve aliases and perform full GPU upload
-                    LoadTexture(job.idOrPath);
-                    break;
-                case PendingTextureJob::Type::FromMemory:
-                    // LoadTextureFromMemory will create GPU resources for this ID
-                    LoadTextureFromMemory(job.idOrPath,
-                                          job.data.data(),
-                                          job.width,
-                                          job.height,
-                                          job.channels);
-                    break;
-            }
-            // Refresh descriptors for entities that use this texture so
-            // streaming uploads become visible in the scene.
-            OnTextureUploaded(job.idOrPath);
-            if (isCritical) {
-                criticalJobsOutstanding.fetch_sub(1, std::memory_order_relaxed);
+    // Requests for the jobs this call may process
+    std::vector<size_t> eligible;
+    std::vector<TextureStreamScheduler::Request> requests;
+    std::vector<std::string> resolvedIds;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const bool isCritical = (jobs[i].priority == PendingTextureJob::Priority::Critical);
+        if ((isCritical && includeCritical) || (!isCritical && includeNonCritical)) {
+            eligible.push_back(i);
+            requests.push_back({
+                .priority = 0.0f,
+                .bytes = jobs[i].bytes,
+                .source = jobs[i].type == PendingTextureJob::Type::FromFile ? TextureStreamScheduler::Source::File
+                                                                             : TextureStreamScheduler::Source::Memory,
+                .waitedFrames = jobs[i].waitedFrames
+            });
+            resolvedIds.push_back(ResolveTextureId(jobs[i].idOrPath));
+        }
+    }
+
+    // Priority: screen coverage of the entities drawn with each texture last frame. Critical
+    // jobs win ties, so textures nobody has drawn yet still load base colors first.
+    {
+        std::lock_guard<std::mutex> lock(bindlessMutex);
+        std::vector<float> slotCoverage(bindlessSlotTextureIds.size(), 0.0f);
+        size_t materialTotal = std::min(materialScreenCoverage.size(), materials.size());
+        for (size_t i = 0; i < materialTotal; ++i) {
+            float coverage = materialScreenCoverage[i];
+            if (coverage <= 0.0f) continue;
+            const MaterialData& material = materials[i];
+            for (uint32_t slot : { material.baseColorTexture, material.metallicRoughnessTexture, material.normalTexture,
+                                   material.occlusionTexture, material.emissiveTexture }) {
+                if (slot < slotCoverage.size()) {
+                    slotCoverage[slot] = std::max(slotCoverage[slot], coverage);
+                }
             }
-            uploadJobsCompleted.fetch_add(1, std::memory_order_relaxed);
-            ++processed;
-        } else {
-            remaining.emplace_back(std::move(job));
+        }
+        for (size_t k = 0; k < eligible.size(); ++k) {
+            auto slotIt = bindlessTextureSlots.find(resolvedIds[k]);
+            float coverage = slotIt != bindlessTextureSlots.end() && slotIt->second != 0 ? slotCoverage[slotIt->second] : 0.0f;
+            bool isCritical = jobs[eligible[k]].priority == PendingTextureJob::Priority::Critical;
+            requests[k].priority = coverage * 2.0f + (isCritical ? 1.0f : 0.0f);
+        }
+    }
+
+    std::vector<bool> done(jobs.size(), false);
+    TextureStreamingStats stats{ .budgetMs = budgetMs };
+    auto start = std::chrono::steady_clock::now();
+    for (size_t k : TextureStreamScheduler::Order(requests)) {
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!textureStreamScheduler.Fits(elapsedMs, requests[k], budgetMs, stats.uploads == 0)) {
+            break;
+        }
+
+        PendingTextureJob& job = jobs[eligible[k]];
+        auto jobStart = std::chrono::steady_clock::now();
+        switch (job.type) {
+            case PendingTextureJob::Type::FromFile:
+                // LoadTexture will resolve aliases and perform full GPU upload
+                LoadTexture(job.idOrPath);
+                break;
+            case PendingTextureJob::Type::FromMemory:
+                // Content was deduplicated when the job was queued; create GPU resources for this ID
+                createTextureFromMemory(job.idOrPath,
+                                        job.data.data(),
+                                        job.width,
+                                        job.height,
+                                        job.channels);
+                break;
+        }
+        textureStreamScheduler.RecordUpload(requests[k], std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - jobStart).count());
+
+        // Point the texture's bindless slot at the upload so
+        // streaming uploads become visible in the scene.
+        OnTextureUploaded(job.idOrPath);
+        if (job.priority == PendingTextureJob::Priority::Critical) {
+            criticalJobsOutstanding.fetch_sub(1, std::memory_order_relaxed);
+        }
+        uploadJobsCompleted.fetch_add(1, std::memory_order_relaxed);
+        done[eligible[k]] = true;
+        stats.uploads++;
+    }
+    stats.uploadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<PendingTextureJob> remaining;
+    remaining.reserve(jobs.size() - stats.uploads);
+    for (size_t k = 0; k < eligible.size(); ++k) {
+        if (!done[eligible[k]]) {
+            jobs[eligible[k]].waitedFrames++;
+        }
+    }
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        if (!done[i]) {
+            remaining.emplace_back(std::move(jobs[i]));
         }
     }
+    stats.pending = static_cast<uint32_t>(remaining.size());
+    lastTextureStreamingStats = stats;
 
     if (!remaining.empty()) {
         std::lock_guard<std::mutex> lk(pendingTextureJobsMutex);
@@ -2215,6 +3187,7 @@ void Renderer::uploadImageFromStaging(vk::Buffer staging,
                                       vk::Format format,
                                       const std::vector<vk::BufferImageCopy>& regions,
                                       uint32_t mipLevels) {
+    PROFILE_SCOPE("Renderer::uploadImageFromStaging");
     ensureThreadLocalVulkanInit();
     try {
         // Use a temporary transient command pool for the GRAPHICS queue family to avoid cross-queue races
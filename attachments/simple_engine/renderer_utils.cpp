@@ -131,9 +131,16 @@ QueueFamilyIndices Renderer::findQueueFamilies(const vk::raii::PhysicalDevice& d
         if ((qf.queueFlags & vk::QueueFlagBits::eCompute) && !indices.computeFamily.has_value()) {
             indices.computeFamily = i;
         }
-        // Check for present support
-        if (!indices.presentFamily.has_value() && device.getSurfaceSupportKHR(i, surface)) {
-            indices.presentFamily = i;
+        // Check for present support. Headless rendering never presents, so the
+        // graphics family stands in for the present family there.
+        if (!indices.presentFamily.has_value()) {
+            if (headless) {
+                if (qf.queueFlags & vk::QueueFlagBits::eGraphics) {
+                    indices.presentFamily = i;
+                }
+            } else if (device.getSurfaceSupportKHR(i, surface)) {
+                indices.presentFamily = i;
+            }
         }
         // Prefer a dedicated transfer queue (transfer bit set, but NOT graphics) if available
         if ((qf.queueFlags & vk::QueueFlagBits::eTransfer) && !(qf.queueFlags & vk::QueueFlagBits::eGraphics)) {
@@ -184,6 +191,9 @@ bool Renderer::checkDeviceExtensionSupport(vk::raii::PhysicalDevice& device) {
 
     // Check if all required extensions are supported
     std::set<std::string> requiredExtensionsSet(requiredDeviceExtensions.begin(), requiredDeviceExtensions.end());
+    if (headless) {
+        requiredExtensionsSet.erase(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    }
 
     for (const auto& extension : availableDeviceExtensions) {
         requiredExtensionsSet.erase(extension.extensionName);
@@ -219,15 +229,19 @@ bool Renderer::isDeviceSuitable(vk::raii::PhysicalDevice& device) {
     bool extensionsSupported = checkDeviceExtensionSupport(device);
 
     // Check swap chain support
-    bool swapChainAdequate = false;
-    if (extensionsSupported) {
+    bool swapChainAdequate = headless;
+    if (extensionsSupported && !headless) {
         SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device);
         swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
     }
 
     // Check for required features
-    auto features = device.template getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan13Features>();
-    bool supportsRequiredFeatures = features.template get<vk::PhysicalDeviceVulkan13Features>().dynamicRendering;
+    auto features = device.template getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan13Features, vk::PhysicalDeviceDescriptorIndexingFeatures>();
+    const auto& indexing = features.template get<vk::PhysicalDeviceDescriptorIndexingFeatures>();
+    bool supportsRequiredFeatures = features.template get<vk::PhysicalDeviceVulkan13Features>().dynamicRendering &&
+                                    indexing.runtimeDescriptorArray && indexing.descriptorBindingPartiallyBound &&
+                                    indexing.descriptorBindingSampledImageUpdateAfterBind &&
+                                    indexing.descriptorBindingStorageBufferUpdateAfterBind;
 
     return indices.isComplete() && extensionsSupported && swapChainAdequate && supportsRequiredFeatures;
 }
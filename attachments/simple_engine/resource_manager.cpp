@@ -1,6 +1,8 @@
 #include "resource_manager.h"
 
 #include <ranges>
+#include <chrono>
+#include <random>
 
 // Most of the ResourceManager class implementation is in the header file
 // This file is mainly for any methods that might need additional implementation
@@ -17,12 +19,210 @@ void Resource::Unload() {
     loaded = false;
 }
 
-void ResourceManager::UnloadAllResources() {
-    for (auto& val : resources | std::views::values) {
-        for (auto& loadedResource : val | std::views::values) {
-            loadedResource->Unload();
+uint32_t ResourcePool::Find(const std::string& id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = handlesById.find(id);
+    return it != handlesById.end() ? it->second : INVALID_HANDLE;
+}
+
+uint32_t ResourcePool::Insert(std::unique_ptr<Resource> resource, ResourceState state, bool& inserted) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = handlesById.find(resource->GetId());
+    if (it != handlesById.end()) {
+        inserted = false;
+        return it->second;
+    }
+
+    uint32_t index;
+    if (!freeIndices.empty()) {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    } else {
+        if (slotCount >= MAX_CHUNKS * CHUNK_SIZE) {
+            throw std::runtime_error("Too many resources of one type: " + resource->GetId());
+        }
+        index = slotCount++;
+        auto& chunk = chunks[index / CHUNK_SIZE];
+        if (!chunk) {
+            chunk = std::make_unique<Slot[]>(CHUNK_SIZE);
+        }
+    }
+
+    Slot& slot = slotAt(index);
+    const uint32_t handle = makeHandle(index, slot.generation.load(std::memory_order_relaxed));
+    handlesById.emplace(resource->GetId(), handle);
+    slot.owner = std::move(resource);
+    slot.resource.store(slot.owner.get(), std::memory_order_release);
+    slot.refCount.store(0, std::memory_order_relaxed);
+    slot.state.store(state, std::memory_order_release);
+    inserted = true;
+    return handle;
+}
+
+void ResourcePool::FinishLoad(uint32_t handle, bool success) {
+    if (Slot* slot = findSlot(handle)) {
+        slot->state.store(success ? ResourceState::Ready : ResourceState::Failed, std::memory_order_release);
+    }
+}
+
+const std::string& ResourcePool::GetId(uint32_t handle) const {
+    static const std::string empty;
+    const Slot* slot = findSlot(handle);
+    const Resource* resource = slot ? slot->resource.load(std::memory_order_acquire) : nullptr;
+    return resource ? resource->GetId() : empty;
+}
+
+void ResourcePool::freeSlot(uint32_t index) {
+    Slot& slot = slotAt(index);
+    handlesById.erase(slot.owner->GetId());
+    const bool wasReady = slot.state.load(std::memory_order_relaxed) == ResourceState::Ready;
+    // Handles stop resolving now; a Resolve() that raced past the generation check
+    // still holds a live pointer, so destruction and slot reuse wait for CollectRetired
+    uint32_t generation = (slot.generation.load(std::memory_order_relaxed) + 1) & GENERATION_MASK;
+    slot.generation.store(generation == 0 ? 1 : generation, std::memory_order_release);
+    slot.state.store(ResourceState::Empty, std::memory_order_release);
+    slot.resource.store(nullptr, std::memory_order_release);
+    retired.push_back({index, wasReady, std::move(slot.owner)});
+}
+
+bool ResourcePool::Unload(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = handlesById.find(id);
+    if (it == handlesById.end()) {
+        return false;
+    }
+    const uint32_t index = it->second & INDEX_MASK;
+    if (slotAt(index).state.load(std::memory_order_acquire) == ResourceState::Loading) {
+        return false;
+    }
+    freeSlot(index);
+    return true;
+}
+
+size_t ResourcePool::UnloadUnused() {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t unloaded = 0;
+    for (uint32_t index = 0; index < slotCount; ++index) {
+        Slot& slot = slotAt(index);
+        ResourceState state = slot.state.load(std::memory_order_acquire);
+        if (state == ResourceState::Empty || state == ResourceState::Loading ||
+            slot.refCount.load(std::memory_order_acquire) != 0) {
+            continue;
         }
-        val.clear();
+        freeSlot(index);
+        unloaded++;
     }
-    resources.clear();
+    return unloaded;
+}
+
+void ResourcePool::UnloadAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (uint32_t index = 0; index < slotCount; ++index) {
+        ResourceState state = slotAt(index).state.load(std::memory_order_acquire);
+        if (state != ResourceState::Empty && state != ResourceState::Loading) {
+            freeSlot(index);
+        }
+    }
+}
+
+size_t ResourcePool::CollectRetired() {
+    std::lock_guard<std::mutex> lock(mutex);
+    const size_t collected = retired.size();
+    for (RetiredSlot& entry : retired) {
+        if (entry.wasReady) {
+            entry.resource->Unload();
+        }
+        entry.resource.reset();
+        freeIndices.push_back(entry.index);
+    }
+    retired.clear();
+    return collected;
+}
+
+ThreadPool& ResourceManager::getLoadThreads() {
+    std::lock_guard<std::mutex> lock(loadThreadsMutex);
+    if (!loadThreads) {
+        loadThreads = std::make_unique<ThreadPool>(LOAD_THREAD_COUNT);
+    }
+    return *loadThreads;
+}
+
+size_t ResourceManager::UnloadUnusedResources() {
+    std::lock_guard<std::mutex> lock(poolsMutex);
+    size_t unloaded = 0;
+    for (auto& pool : pools | std::views::values) {
+        unloaded += pool->UnloadUnused();
+    }
+    return unloaded;
+}
+
+size_t ResourceManager::CollectRetiredResources() {
+    std::lock_guard<std::mutex> lock(poolsMutex);
+    size_t collected = 0;
+    for (auto& pool : pools | std::views::values) {
+        collected += pool->CollectRetired();
+    }
+    return collected;
+}
+
+void ResourceManager::UnloadAllResources() {
+    // Let in-flight loads finish; a new loader is created on the next async load
+    {
+        std::lock_guard<std::mutex> lock(loadThreadsMutex);
+        loadThreads.reset();
+    }
+    std::lock_guard<std::mutex> lock(poolsMutex);
+    for (auto& pool : pools | std::views::values) {
+        pool->UnloadAll();
+        pool->CollectRetired();
+    }
+}
+
+ResourceLookupBenchmark ResourceManager::BenchmarkLookups(size_t resourceCount, size_t lookupCount) {
+    ResourceLookupBenchmark result;
+    result.resourceCount = std::max<size_t>(resourceCount, 1);
+    result.lookupCount = std::max<size_t>(lookupCount, 1);
+
+    ResourceManager manager;
+    std::vector<std::string> ids;
+    std::vector<ResourceHandle<Resource>> handles;
+    std::unordered_map<std::type_index, std::unordered_map<std::string, std::unique_ptr<Resource>>> legacy;
+    auto& legacyResources = legacy[std::type_index(typeid(Resource))];
+    for (size_t i = 0; i < result.resourceCount; ++i) {
+        // Asset-path-like IDs, as the engine uses them
+        ids.push_back("assets/textures/material_" + std::to_string(i) + "_baseColor.ktx2");
+        handles.push_back(manager.LoadResource<Resource>(ids.back()));
+        legacyResources[ids.back()] = std::make_unique<Resource>(ids.back());
+    }
+
+    // The same random access pattern for every method
+    std::vector<uint32_t> order(result.lookupCount);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, result.resourceCount - 1);
+    for (auto& index : order) {
+        index = static_cast<uint32_t>(pick(rng));
+    }
+
+    auto timePerLookup = [&](auto&& lookup) {
+        size_t found = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t index : order) {
+            found += lookup(index) != nullptr ? 1 : 0;
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (found != order.size()) {
+            throw std::runtime_error("Resource lookup benchmark: missing resource");
+        }
+        return ns / static_cast<double>(order.size());
+    };
+
+    result.handleNs = timePerLookup([&](uint32_t index) { return handles[index].Get(); });
+    result.stringNs = timePerLookup([&](uint32_t index) { return manager.GetResource<Resource>(ids[index]); });
+    result.legacyStringNs = timePerLookup([&](uint32_t index) -> Resource* {
+        auto typeIt = legacy.find(std::type_index(typeid(Resource)));
+        if (typeIt == legacy.end()) return nullptr;
+        auto it = typeIt->second.find(ids[index]);
+        return it != typeIt->second.end() ? it->second.get() : nullptr;
+    });
+    return result;
 }
@@ -6,11 +6,18 @@
 #include <typeindex>
 #include <type_traits>
 #include <stdexcept>
+#include <atomic>
+#include <mutex>
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include "thread_pool.h"
 
 /**
  * @brief Base class for all resources.
  */
-class Resource final {
+class Resource {
 protected:
     std::string resourceId;
     bool loaded = false;
@@ -51,15 +58,192 @@ public:
     virtual void Unload();
 };
 
+/**
+ * @brief Loading state of a resource slot.
+ */
+enum class ResourceState : uint8_t {
+    Empty,   // No resource (never loaded, unloaded or stale handle)
+    Loading, // Queued or running on a loader thread
+    Ready,
+    Failed   // Load() returned false
+};
+
+/**
+ * @brief Slot-map storage for the resources of one type.
+ *
+ * Resources are addressed by 32-bit handles that pack a slot index and the
+ * generation of the slot. Unloading a resource bumps the generation, so old
+ * handles resolve to nullptr instead of to whatever reuses the slot. Slots live
+ * in fixed-size chunks that never move, so a handle is resolved with two array
+ * indexations and no lock. String IDs are only hashed when a resource is looked
+ * up by name.
+ *
+ * Unloading retires a resource rather than destroying it: its handles stop
+ * resolving at once, but the object stays alive, and its slot stays reserved,
+ * until CollectRetired(). Pointers returned by Resolve() therefore remain valid
+ * until the next CollectRetired(), which must run where none are in use (the
+ * engine calls it once per frame, before updating entities).
+ */
+class ResourcePool final {
+public:
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+    static constexpr uint32_t INVALID_HANDLE = 0; // Generations start at 1, so no live handle is 0
+
+    /**
+     * @brief Find the handle of a resource by ID.
+     * @param id The resource ID.
+     * @return The handle, or INVALID_HANDLE if the resource does not exist.
+     */
+    uint32_t Find(const std::string& id) const;
+
+    /**
+     * @brief Add a resource, or find the existing one with the same ID.
+     * @param resource The resource (not loaded yet).
+     * @param state The initial state of a new slot (Loading or Ready).
+     * @param inserted Set to true if the resource was added, false if the ID existed.
+     * @return The handle.
+     */
+    uint32_t Insert(std::unique_ptr<Resource> resource, ResourceState state, bool& inserted);
+
+    /**
+     * @brief Publish the result of a load started with Insert(..., Loading, ...).
+     * @param handle The handle.
+     * @param success The result of Load().
+     */
+    void FinishLoad(uint32_t handle, bool success);
+
+    /**
+     * @brief Resolve a handle.
+     * @param handle The handle.
+     * @return The resource if the handle is current and the resource is ready, nullptr otherwise.
+     */
+    Resource* Resolve(uint32_t handle) const {
+        const Slot* slot = findSlot(handle);
+        if (!slot || slot->state.load(std::memory_order_acquire) != ResourceState::Ready) {
+            return nullptr;
+        }
+        return slot->resource.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the state of a handle.
+     * @param handle The handle.
+     * @return The state; Empty for stale handles.
+     */
+    ResourceState GetState(uint32_t handle) const {
+        const Slot* slot = findSlot(handle);
+        return slot ? slot->state.load(std::memory_order_acquire) : ResourceState::Empty;
+    }
+
+    /**
+     * @brief Get the ID of a handle's resource.
+     * @param handle The handle.
+     * @return The ID, or an empty string for stale handles.
+     */
+    const std::string& GetId(uint32_t handle) const;
+
+    // Reference counting by ResourceHandle; stale handles are ignored
+    void AddRef(uint32_t handle) {
+        if (Slot* slot = findSlot(handle)) {
+            slot->refCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    void Release(uint32_t handle) {
+        if (Slot* slot = findSlot(handle)) {
+            slot->refCount.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    /**
+     * @brief Unload a resource and invalidate its handles.
+     *
+     * The resource is destroyed by the next CollectRetired().
+     * @param id The resource ID.
+     * @return True if the resource was unloaded, false if it does not exist or is still loading.
+     */
+    bool Unload(const std::string& id);
+
+    /**
+     * @brief Unload all resources no handle references anymore, under a single lock.
+     * @return The number of resources unloaded.
+     */
+    size_t UnloadUnused();
+
+    /**
+     * @brief Unload all resources that are not loading.
+     */
+    void UnloadAll();
+
+    /**
+     * @brief Destroy the resources unloaded since the last call and recycle their slots.
+     *
+     * Must not run while a pointer returned by Resolve() is in use.
+     *
+     * @return The number of resources destroyed.
+     */
+    size_t CollectRetired();
+
+private:
+    static constexpr uint32_t CHUNK_SIZE = 1024;
+    static constexpr uint32_t MAX_CHUNKS = (INDEX_MASK + 1) / CHUNK_SIZE;
+
+    struct Slot {
+        std::unique_ptr<Resource> owner;          // Guarded by the mutex
+        std::atomic<Resource*> resource{nullptr}; // What Resolve reads
+        std::atomic<uint32_t> generation{1};
+        std::atomic<uint32_t> refCount{0};
+        std::atomic<ResourceState> state{ResourceState::Empty};
+    };
+
+    mutable std::mutex mutex; // Guards allocation, the ID map and unloading; not taken by Resolve
+    std::array<std::unique_ptr<Slot[]>, MAX_CHUNKS> chunks;
+    uint32_t slotCount = 0;
+    std::vector<uint32_t> freeIndices;
+
+    // Unloaded resources and their slots, kept until CollectRetired
+    struct RetiredSlot {
+        uint32_t index;
+        bool wasReady; // Unload() runs at collection, not while the resource may be in use
+        std::unique_ptr<Resource> resource;
+    };
+    std::vector<RetiredSlot> retired;
+    std::unordered_map<std::string, uint32_t> handlesById;
+
+    static uint32_t makeHandle(uint32_t index, uint32_t generation) { return (generation << INDEX_BITS) | index; }
+
+    Slot& slotAt(uint32_t index) const { return chunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+
+    Slot* findSlot(uint32_t handle) const {
+        const uint32_t index = handle & INDEX_MASK;
+        if (handle == INVALID_HANDLE || index >= MAX_CHUNKS * CHUNK_SIZE || !chunks[index / CHUNK_SIZE]) {
+            return nullptr;
+        }
+        Slot& slot = slotAt(index);
+        return slot.generation.load(std::memory_order_acquire) == (handle >> INDEX_BITS) ? &slot : nullptr;
+    }
+
+    // Retire a slot with the mutex held
+    void freeSlot(uint32_t index);
+};
+
 /**
  * @brief Template class for resource handles.
+ *
+ * A handle is a 32-bit generational index into the pool of its resource type
+ * and holds a reference on the resource while it exists. Get() is O(1) and
+ * returns nullptr until an asynchronous load has finished, and after the
+ * resource was unloaded. The pointer stays valid until the pool's next
+ * CollectRetired(), so it must not be kept across frames.
+ *
  * @tparam T The type of resource.
  */
 template<typename T>
 class ResourceHandle {
 private:
-    std::string resourceId;
-    class ResourceManager* resourceManager = nullptr;
+    ResourcePool* pool = nullptr;
+    uint32_t handle = ResourcePool::INVALID_HANDLE;
 
 public:
     /**
@@ -68,30 +252,66 @@ public:
     ResourceHandle() = default;
 
     /**
-     * @brief Constructor with a resource ID and resource manager.
-     * @param id The resource ID.
-     * @param manager The resource manager.
+     * @brief Constructor with a pool and handle.
+     * @param pool The pool of the resource type.
+     * @param handle The generational handle.
      */
-    ResourceHandle(const std::string& id, class ResourceManager* manager)
-        : resourceId(id), resourceManager(manager) {}
+    ResourceHandle(ResourcePool* pool, uint32_t handle) : pool(pool), handle(handle) {
+        if (pool) pool->AddRef(handle);
+    }
+
+    ResourceHandle(const ResourceHandle& other) : ResourceHandle(other.pool, other.handle) {}
+    ResourceHandle(ResourceHandle&& other) noexcept : pool(other.pool), handle(other.handle) {
+        other.pool = nullptr;
+        other.handle = ResourcePool::INVALID_HANDLE;
+    }
+    ResourceHandle& operator=(ResourceHandle other) noexcept {
+        std::swap(pool, other.pool);
+        std::swap(handle, other.handle);
+        return *this;
+    }
+    ~ResourceHandle() {
+        if (pool) pool->Release(handle);
+    }
 
     /**
      * @brief Get the resource.
-     * @return A pointer to the resource, or nullptr if not found.
+     * @return A pointer to the resource, or nullptr if it is not ready or was unloaded.
      */
-    T* Get() const;
+    T* Get() const { return pool ? static_cast<T*>(pool->Resolve(handle)) : nullptr; }
 
     /**
      * @brief Check if the handle is valid.
-     * @return True if the handle is valid, false otherwise.
+     * @return True if the handle refers to a resource that is loading or loaded, false otherwise.
+     */
+    bool IsValid() const {
+        ResourceState state = GetState();
+        return state == ResourceState::Loading || state == ResourceState::Ready;
+    }
+
+    /**
+     * @brief Check if the resource has finished loading successfully.
+     * @return True if Get() returns the resource, false otherwise.
      */
-    bool IsValid() const;
+    bool IsReady() const { return GetState() == ResourceState::Ready; }
+
+    /**
+     * @brief Get the loading state of the resource.
+     * @return The state.
+     */
+    ResourceState GetState() const { return pool ? pool->GetState(handle) : ResourceState::Empty; }
 
     /**
      * @brief Get the resource ID.
-     * @return The resource ID.
+     * @return The resource ID, or an empty string if the handle is stale.
      */
-    const std::string& GetId() const { return resourceId; }
+    const std::string& GetId() const;
+
+    /**
+     * @brief Get the raw 32-bit handle.
+     * @return The handle.
+     */
+    uint32_t GetHandle() const { return handle; }
 
     /**
      * @brief Convenience operator for accessing the resource.
@@ -112,15 +332,59 @@ public:
     operator bool() const { return IsValid(); }
 };
 
+/**
+ * @brief Timing of resource lookups, see ResourceManager::BenchmarkLookups.
+ */
+struct ResourceLookupBenchmark {
+    size_t resourceCount = 0;
+    size_t lookupCount = 0;
+    double handleNs = 0.0;      // Per ResourceHandle::Get()
+    double stringNs = 0.0;      // Per GetResource<T>(id)
+    double legacyStringNs = 0.0; // Per lookup in the previous type -> ID -> resource map
+};
+
 /**
  * @brief Class for managing resources.
  *
  * This class implements the resource management system as described in the Engine_Architecture chapter:
  * @see en/Building_a_Simple_Engine/Engine_Architecture/04_resource_management.adoc
+ *
+ * Each resource type is stored in its own ResourcePool and handed out as
+ * generational handles. Resources can be loaded synchronously or on loader
+ * threads; resources no handle references are released in batches by
+ * UnloadUnusedResources().
  */
 class ResourceManager final {
 private:
-    std::unordered_map<std::type_index, std::unordered_map<std::string, std::unique_ptr<Resource>>> resources;
+    mutable std::mutex poolsMutex;
+    std::unordered_map<std::type_index, std::unique_ptr<ResourcePool>> pools;
+
+    // Loader threads for LoadResourceAsync, created on first use. Declared after the
+    // pools so in-flight loads finish before the pools are destroyed.
+    std::mutex loadThreadsMutex;
+    std::unique_ptr<ThreadPool> loadThreads;
+    std::atomic<uint32_t> loadsInFlight{0};
+
+    static constexpr size_t LOAD_THREAD_COUNT = 2;
+
+    template<typename T>
+    ResourcePool& getPool() {
+        std::lock_guard<std::mutex> lock(poolsMutex);
+        auto& pool = pools[std::type_index(typeid(T))];
+        if (!pool) {
+            pool = std::make_unique<ResourcePool>();
+        }
+        return *pool;
+    }
+
+    template<typename T>
+    ResourcePool* findPool() const {
+        std::lock_guard<std::mutex> lock(poolsMutex);
+        auto it = pools.find(std::type_index(typeid(T)));
+        return it != pools.end() ? it->second.get() : nullptr;
+    }
+
+    ThreadPool& getLoadThreads();
 
 public:
     /**
@@ -135,6 +399,10 @@ public:
 
     /**
      * @brief Load a resource.
+     *
+     * If the resource is already being loaded asynchronously, its handle is returned
+     * without waiting for the load.
+     *
      * @tparam T The type of resource.
      * @tparam Args The types of arguments to pass to the resource constructor.
      * @param id The resource ID.
@@ -146,10 +414,10 @@ public:
         static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
 
         // Check if the resource already exists
-        auto& typeResources = resources[std::type_index(typeid(T))];
-        auto it = typeResources.find(id);
-        if (it != typeResources.end()) {
-            return ResourceHandle<T>(id, this);
+        ResourcePool& pool = getPool<T>();
+        uint32_t handle = pool.Find(id);
+        if (handle != ResourcePool::INVALID_HANDLE) {
+            return ResourceHandle<T>(&pool, handle);
         }
 
         // Create and load the resource
@@ -158,33 +426,81 @@ public:
             throw std::runtime_error("Failed to load resource: " + id);
         }
 
-        // Store the resource
-        typeResources[id] = std::move(resource);
-        return ResourceHandle<T>(id, this);
+        // Store the resource (another thread may have stored the same ID meanwhile)
+        bool inserted = false;
+        handle = pool.Insert(std::move(resource), ResourceState::Ready, inserted);
+        return ResourceHandle<T>(&pool, handle);
     }
 
     /**
-     * @brief Get a resource.
+     * @brief Load a resource on a loader thread.
+     *
+     * The handle is returned immediately; Get() returns nullptr until the load
+     * has finished and GetState() reports Loading, Ready or Failed.
+     *
      * @tparam T The type of resource.
+     * @tparam Args The types of arguments to pass to the resource constructor.
      * @param id The resource ID.
-     * @return A pointer to the resource, or nullptr if not found.
+     * @param args The arguments to pass to the resource constructor.
+     * @return A handle to the resource.
      */
-    template<typename T>
-    T* GetResource(const std::string& id) {
+    template<typename T, typename... Args>
+    ResourceHandle<T> LoadResourceAsync(const std::string& id, Args&&... args) {
         static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
 
-        auto typeIt = resources.find(std::type_index(typeid(T)));
-        if (typeIt == resources.end()) {
-            return nullptr;
+        ResourcePool& pool = getPool<T>();
+        uint32_t handle = pool.Find(id);
+        if (handle != ResourcePool::INVALID_HANDLE) {
+            return ResourceHandle<T>(&pool, handle);
         }
 
-        auto& typeResources = typeIt->second;
-        auto resourceIt = typeResources.find(id);
-        if (resourceIt == typeResources.end()) {
-            return nullptr;
+        // The slot exists (in the Loading state) before the job runs, so the handle is usable right away
+        auto resource = std::make_unique<T>(id, std::forward<Args>(args)...);
+        Resource* loading = resource.get();
+        bool inserted = false;
+        handle = pool.Insert(std::move(resource), ResourceState::Loading, inserted);
+        ResourceHandle<T> result(&pool, handle);
+        if (inserted) {
+            loadsInFlight.fetch_add(1, std::memory_order_relaxed);
+            getLoadThreads().enqueue([this, &pool, handle, loading]() {
+                pool.FinishLoad(handle, loading->Load());
+                loadsInFlight.fetch_sub(1, std::memory_order_release);
+            });
         }
+        return result;
+    }
+
+    /**
+     * @brief Get the number of asynchronous loads that have not finished yet.
+     * @return The number of loads.
+     */
+    uint32_t GetLoadsInFlight() const { return loadsInFlight.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Get the handle of a loaded or loading resource.
+     * @tparam T The type of resource.
+     * @param id The resource ID.
+     * @return The handle, or an invalid handle if not found.
+     */
+    template<typename T>
+    ResourceHandle<T> GetHandle(const std::string& id) {
+        static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
+        ResourcePool* pool = findPool<T>();
+        uint32_t handle = pool ? pool->Find(id) : ResourcePool::INVALID_HANDLE;
+        return handle != ResourcePool::INVALID_HANDLE ? ResourceHandle<T>(pool, handle) : ResourceHandle<T>();
+    }
 
-        return static_cast<T*>(resourceIt->second.get());
+    /**
+     * @brief Get a resource.
+     * @tparam T The type of resource.
+     * @param id The resource ID.
+     * @return A pointer to the resource, or nullptr if not found or not loaded yet.
+     */
+    template<typename T>
+    T* GetResource(const std::string& id) {
+        static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
+        ResourcePool* pool = findPool<T>();
+        return pool ? static_cast<T*>(pool->Resolve(pool->Find(id))) : nullptr;
     }
 
     /**
@@ -196,57 +512,59 @@ public:
     template<typename T>
     bool HasResource(const std::string& id) {
         static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
-
-        auto typeIt = resources.find(std::type_index(typeid(T)));
-        if (typeIt == resources.end()) {
-            return false;
-        }
-
-        auto& typeResources = typeIt->second;
-        return typeResources.contains(id);
+        ResourcePool* pool = findPool<T>();
+        return pool && pool->Find(id) != ResourcePool::INVALID_HANDLE;
     }
 
     /**
-     * @brief Unload a resource.
+     * @brief Unload a resource. Outstanding handles to it become stale.
      * @tparam T The type of resource.
      * @param id The resource ID.
-     * @return True if the resource was unloaded, false otherwise.
+     * @return True if the resource was unloaded, false otherwise (including while it is loading).
      */
     template<typename T>
     bool UnloadResource(const std::string& id) {
         static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
+        ResourcePool* pool = findPool<T>();
+        return pool && pool->Unload(id);
+    }
 
-        auto typeIt = resources.find(std::type_index(typeid(T)));
-        if (typeIt == resources.end()) {
-            return false;
-        }
-
-        auto& typeResources = typeIt->second;
-        auto resourceIt = typeResources.find(id);
-        if (resourceIt == typeResources.end()) {
-            return false;
-        }
+    /**
+     * @brief Unload all resources of every type that no handle references anymore.
+     * @return The number of resources unloaded.
+     */
+    size_t UnloadUnusedResources();
 
-        resourceIt->second->Unload();
-        typeResources.erase(resourceIt);
-        return true;
-    }
+    /**
+     * @brief Destroy the resources of every type unloaded since the last call.
+     *
+     * Pointers returned by ResourceHandle::Get() or GetResource() for those
+     * resources dangle afterwards, so this must run where none are in use.
+     *
+     * @return The number of resources destroyed.
+     */
+    size_t CollectRetiredResources();
 
     /**
-     * @brief Unload all resources.
+     * @brief Unload and destroy all resources.
+     *
+     * Waits for asynchronous loads to finish first. Must not run while a pointer
+     * returned by Get() is in use.
      */
     void UnloadAllResources();
+
+    /**
+     * @brief Compare handle resolution with lookups by string ID.
+     * @param resourceCount The number of resources to create.
+     * @param lookupCount The number of lookups to time per method.
+     * @return The time per lookup of each method.
+     */
+    static ResourceLookupBenchmark BenchmarkLookups(size_t resourceCount, size_t lookupCount);
 };
 
 // Implementation of ResourceHandle methods
 template<typename T>
-T* ResourceHandle<T>::Get() const {
-    if (!resourceManager) return nullptr;
-    return resourceManager->GetResource<T>(resourceId);
-}
-
-template<typename T>
-bool ResourceHandle<T>::IsValid() const {
-    if (!resourceManager) return false;
-    return resourceManager->HasResource<T>(resourceId);
+const std::string& ResourceHandle<T>::GetId() const {
+    static const std::string empty;
+    return pool ? pool->GetId(handle) : empty;
 }
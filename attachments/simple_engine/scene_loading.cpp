@@ -13,14 +13,15 @@
  * @return The size of the bounding box (max - min for each axis).
  */
 glm::vec3 CalculateBoundingBoxSize(const MaterialMesh& materialMesh) {
-    if (materialMesh.vertices.empty()) {
+    const std::vector<Vertex>& vertices = materialMesh.GetVertices();
+    if (vertices.empty()) {
         return glm::vec3(0.0f);
     }
 
-    glm::vec3 minBounds = materialMesh.vertices[0].position;
-    glm::vec3 maxBounds = materialMesh.vertices[0].position;
+    glm::vec3 minBounds = vertices[0].position;
+    glm::vec3 maxBounds = vertices[0].position;
 
-    for (const auto& vertex : materialMesh.vertices) {
+    for (const auto& vertex : vertices) {
         minBounds = glm::min(minBounds, vertex.position);
         maxBounds = glm::max(maxBounds, vertex.position);
     }
@@ -29,7 +30,14 @@ glm::vec3 CalculateBoundingBoxSize(const MaterialMesh& materialMesh) {
 }
 
 /**
- * @brief Load a GLTF model synchronously on the main thread.
+ * @brief Load a GLTF model on the scene loader thread.
+ *
+ * Builds one entity per material mesh outside the scene as soon as the model
+ * loader has decoded that mesh and streams it to the engine, which uploads
+ * and activates the entities in per-frame batches while the rest of the model
+ * is still being parsed (see Engine::BeginSceneStreaming, which must be called
+ * first). The camera and lights are known only once the whole model is
+ * parsed; they are handed to the main thread as scene setup.
  * @return success or fail on loading the GLTF model.
  * @param engine The engine to create entities in.
  * @param modelPath The path to the GLTF model file.
@@ -39,6 +47,9 @@ glm::vec3 CalculateBoundingBoxSize(const MaterialMesh& materialMesh) {
  */
 bool LoadGLTFModel(Engine* engine, const std::string& modelPath,
                    const glm::vec3& position, const glm::vec3& rotation, const glm::vec3& scale) {
+    // Ensure the engine stops waiting for entities on any exit from this function
+    struct StreamingGuard { Engine* e; ~StreamingGuard(){ e->EndSceneStreaming(); } } streamingGuard{engine};
+
     // Get the model loader and renderer
     ModelLoader* modelLoader = engine->GetModelLoader();
     Renderer* renderer = engine->GetRenderer();
@@ -55,275 +66,270 @@ bool LoadGLTFModel(Engine* engine, const std::string& modelPath,
     std::filesystem::path modelFilePath(modelPath);
     std::string modelName = modelFilePath.stem().string(); // Get filename without extension
 
-    try {
-        // Load the complete GLTF model with all textures and lighting on the main thread
-        Model* loadedModel = modelLoader->LoadGLTF(modelPath);
-        if (!loadedModel) {
-            std::cerr << "Failed to load GLTF model: " << modelPath << std::endl;
-            return false;
-        }
-
-        std::cout << "Successfully loaded GLTF model with all textures and lighting: " << modelPath << std::endl;
-
-        // Extract lights from the model and transform them to world space
-        std::vector<ExtractedLight> extractedLights = modelLoader->GetExtractedLights(modelPath);
+    // Create a transformation matrix from position, rotation, and scale
+    glm::mat4 transformMatrix = glm::mat4(1.0f);
+    transformMatrix = glm::translate(transformMatrix, position);
+    transformMatrix = glm::rotate(transformMatrix, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    transformMatrix = glm::rotate(transformMatrix, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    transformMatrix = glm::rotate(transformMatrix, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    transformMatrix = glm::scale(transformMatrix, scale);
 
-        // Create a transformation matrix from position, rotation, and scale
-        glm::mat4 transformMatrix = glm::mat4(1.0f);
-        transformMatrix = glm::translate(transformMatrix, position);
-        transformMatrix = glm::rotate(transformMatrix, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
-        transformMatrix = glm::rotate(transformMatrix, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
-        transformMatrix = glm::rotate(transformMatrix, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
-        transformMatrix = glm::scale(transformMatrix, scale);
+    try {
+        size_t streamedCount = 0;
+        size_t geometryBytes = 0;
+        bool cancelled = false;
 
-        // Transform all light positions from local model space to world space
-        // Also transform the light direction (for directional lights)
-        glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(transformMatrix)));
-        for (auto& light : extractedLights) {
-            glm::vec4 worldPos = transformMatrix * glm::vec4(light.position, 1.0f);
-            light.position = glm::vec3(worldPos);
-            light.direction = glm::normalize(normalMatrix * light.direction);
-        }
+        // Called on this thread by the model loader for each material mesh as soon as it is decoded
+        auto streamMesh = [&](const MaterialMesh& materialMesh) -> bool {
+            // Create an entity name based on model and material
+            std::string entityName = modelName + "_Material_" + std::to_string(materialMesh.materialIndex) +
+                                    "_" + materialMesh.materialName;
 
-        renderer->SetStaticLights(extractedLights);
+            // Built outside the scene; the engine adds it once its buffers are uploaded
+            auto materialEntity = std::make_unique<Entity>(entityName);
+
+            // Add a transform component with provided parameters
+            auto* transform = materialEntity->AddComponent<TransformComponent>();
+            transform->SetPosition(position);
+            transform->SetRotation(glm::radians(rotation));
+            transform->SetScale(scale);
+
+            // Add a mesh component with material-specific data
+            auto* mesh = materialEntity->AddComponent<MeshComponent>();
+            mesh->SetGeometry(materialMesh.geometry);
+
+            if (materialMesh.GetInstanceCount() > 0) {
+                const std::vector<InstanceData>& instances = materialMesh.instances;
+                for (const auto& instanceData : instances) {
+                    // Reconstruct the transformation matrix from InstanceData column vectors
+                    glm::mat4 instanceMatrix = instanceData.getModelMatrix();
+                    mesh->AddInstance(instanceMatrix, static_cast<uint32_t>(materialMesh.materialIndex));
+                }
+            }
 
-        // Extract and apply cameras from the GLTF model
-        const std::vector<CameraData>& cameras = loadedModel->GetCameras();
-        if (!cameras.empty()) {
-            const CameraData& gltfCamera = cameras[0]; // Use the first camera
+            // Set ALL PBR texture paths for this material
+            // Set primary texture path for backward compatibility
+            if (!materialMesh.texturePath.empty()) {
+                mesh->SetTexturePath(materialMesh.texturePath);
+            }
 
-            // Find or create a camera entity to replace the default one
-            Entity* cameraEntity = engine->GetEntity("Camera");
-            if (!cameraEntity) {
-                // Create a new camera entity if none exists
-                cameraEntity = engine->CreateEntity("Camera");
-                if (cameraEntity) {
-                    cameraEntity->AddComponent<TransformComponent>();
-                    cameraEntity->AddComponent<CameraComponent>();
-                }
+            // Set all PBR texture paths
+            if (!materialMesh.baseColorTexturePath.empty()) {
+                mesh->SetBaseColorTexturePath(materialMesh.baseColorTexturePath);
+            }
+            if (!materialMesh.normalTexturePath.empty()) {
+                mesh->SetNormalTexturePath(materialMesh.normalTexturePath);
+            }
+            if (!materialMesh.metallicRoughnessTexturePath.empty()) {
+                mesh->SetMetallicRoughnessTexturePath(materialMesh.metallicRoughnessTexturePath);
+            }
+            if (!materialMesh.occlusionTexturePath.empty()) {
+                mesh->SetOcclusionTexturePath(materialMesh.occlusionTexturePath);
+            }
+            if (!materialMesh.emissiveTexturePath.empty()) {
+                mesh->SetEmissiveTexturePath(materialMesh.emissiveTexturePath);
             }
 
-            if (cameraEntity) {
-                // Update the camera transform with GLTF data
-                auto* cameraTransform = cameraEntity->GetComponent<TransformComponent>();
-                if (cameraTransform) {
-                    // Apply the transformation matrix to the camera position
-                    glm::vec4 worldPos = transformMatrix * glm::vec4(gltfCamera.position, 1.0f);
-                    cameraTransform->SetPosition(glm::vec3(worldPos));
-
-                    // Apply rotation from GLTF camera
-                    glm::vec3 eulerAngles = glm::eulerAngles(gltfCamera.rotation);
-                    cameraTransform->SetRotation(eulerAngles);
+            // Fallback: Use material DB (from ModelLoader) if any PBR texture is still missing
+            if (modelLoader) {
+                Material* mat = modelLoader->GetMaterial(materialMesh.materialName);
+                if (mat) {
+                    if (mesh->GetBaseColorTexturePath().empty() && !mat->albedoTexturePath.empty()) {
+                        mesh->SetBaseColorTexturePath(mat->albedoTexturePath);
+                    }
+                    if (mesh->GetNormalTexturePath().empty() && !mat->normalTexturePath.empty()) {
+                        mesh->SetNormalTexturePath(mat->normalTexturePath);
+                    }
+                    if (mesh->GetMetallicRoughnessTexturePath().empty() && !mat->metallicRoughnessTexturePath.empty()) {
+                        mesh->SetMetallicRoughnessTexturePath(mat->metallicRoughnessTexturePath);
+                    }
+                    if (mesh->GetOcclusionTexturePath().empty() && !mat->occlusionTexturePath.empty()) {
+                        mesh->SetOcclusionTexturePath(mat->occlusionTexturePath);
+                    }
+                    if (mesh->GetEmissiveTexturePath().empty() && !mat->emissiveTexturePath.empty()) {
+                        mesh->SetEmissiveTexturePath(mat->emissiveTexturePath);
+                    }
                 }
+            }
 
-                // Update the camera component with GLTF properties
-                auto* camera = cameraEntity->GetComponent<CameraComponent>();
-                if (camera) {
-                    camera->ForceViewMatrixUpdate(); // Only sets viewMatrixDirty flag, doesn't change camera orientation
-                    if (gltfCamera.isPerspective) {
-                        camera->SetFieldOfView(glm::degrees(gltfCamera.fov)); // Convert radians to degrees
-                        camera->SetClipPlanes(gltfCamera.nearPlane, gltfCamera.farPlane);
-                        if (gltfCamera.aspectRatio > 0.0f) {
-                            camera->SetAspectRatio(gltfCamera.aspectRatio);
+            // Create physics body for collision with balls, but only for geometry
+            // that is reasonably close to the ground plane. This avoids creating
+            // expensive mesh colliders for high-up roofs and distant details.
+            bool staticCollider = false;
+            if (engine->GetPhysicsSystem()) {
+                auto* mc = materialEntity->GetComponent<MeshComponent>();
+                if (mc && !mc->GetVertices().empty() && !mc->GetIndices().empty()) {
+                    // Compute a simple Y-range in WORLD space using the entity transform
+                    // and the mesh's local AABB if available; otherwise approximate from vertices.
+                    glm::vec3 minWS( std::numeric_limits<float>::max());
+                    glm::vec3 maxWS(-std::numeric_limits<float>::max());
+
+                    auto* xform = materialEntity->GetComponent<TransformComponent>();
+                    glm::mat4 model = xform ? xform->GetModelMatrix() : glm::mat4(1.0f);
+
+                    if (mc->HasLocalAABB()) {
+                        glm::vec3 localMin = mc->GetLocalAABBMin();
+                        glm::vec3 localMax = mc->GetLocalAABBMax();
+
+                        // Transform the 8 corners of the local AABB to world space
+                        for (int ix = 0; ix < 2; ++ix) {
+                            for (int iy = 0; iy < 2; ++iy) {
+                                for (int iz = 0; iz < 2; ++iz) {
+                                    glm::vec3 corner(
+                                        ix ? localMax.x : localMin.x,
+                                        iy ? localMax.y : localMin.y,
+                                        iz ? localMax.z : localMin.z
+                                    );
+                                    glm::vec3 cWS = glm::vec3(model * glm::vec4(corner, 1.0f));
+                                    minWS = glm::min(minWS, cWS);
+                                    maxWS = glm::max(maxWS, cWS);
+                                }
+                            }
                         }
                     } else {
-                        // Handle orthographic camera if needed
-                        camera->SetProjectionType(CameraComponent::ProjectionType::Orthographic);
-                        camera->SetOrthographicSize(gltfCamera.orthographicSize, gltfCamera.orthographicSize);
-                        camera->SetClipPlanes(gltfCamera.nearPlane, gltfCamera.farPlane);
+                        // Fallback: compute bounds directly from vertices in world space
+                        const auto& verts = mc->GetVertices();
+                        for (const auto& v : verts) {
+                            glm::vec3 pWS = glm::vec3(model * glm::vec4(v.position, 1.0f));
+                            minWS = glm::min(minWS, pWS);
+                            maxWS = glm::max(maxWS, pWS);
+                        }
                     }
 
-                    // Set this as the active camera
-                    engine->SetActiveCamera(camera);
+                    // If we have a valid Y range and the mesh comes within 6 meters of the ground,
+                    // create a physics body. Otherwise, skip it to save startup time and memory.
+                    const float groundY = 0.0f;
+                    const float maxDistanceFromGround = 6.0f;
+                    bool nearGround = (minWS.y <= groundY + maxDistanceFromGround);
+
+                    if (nearGround) {
+                        // Created by the engine when the entity is activated
+                        staticCollider = true;
+                        std::cout << "Queued physics body for near-ground geometry entity: " << entityName << std::endl;
+                    } else {
+                        std::cout << "Skipped physics body for high/remote entity: " << entityName
+                                  << " (minY=" << minWS.y << ")" << std::endl;
+                    }
+                } else {
+                    std::cerr << "Skipping physics body for entity (no geometry): " << entityName << std::endl;
                 }
             }
-        }
 
-        // Get the material meshes from the loaded model
-        const std::vector<MaterialMesh>& materialMeshes = modelLoader->GetMaterialMeshes(modelPath);
-        if (materialMeshes.empty()) {
-            std::cerr << "No material meshes found in loaded model: " << modelPath << std::endl;
+            geometryBytes += materialMesh.geometry ? materialMesh.geometry->GetMemoryBytes() : 0;
+
+            // Waits while the engine is a full hand-off behind
+            if (!engine->StreamSceneEntity(std::move(materialEntity), staticCollider)) {
+                cancelled = true;
+                return false;
+            }
+            streamedCount++;
+            return true;
+        };
+
+        // Parse the model; its entities are uploaded and activated while the rest is decoded
+        Model* loadedModel = modelLoader->LoadGLTF(modelPath, streamMesh);
+        if (cancelled) {
+            std::cerr << "Scene streaming cancelled: " << modelPath << std::endl;
+            return false;
+        }
+        if (!loadedModel) {
+            std::cerr << "Failed to load GLTF model: " << modelPath << std::endl;
             return false;
         }
 
-        // Collect all geometry entities so we can batch Vulkan uploads for their meshes
-        std::vector<Entity*> geometryEntities;
-        geometryEntities.reserve(materialMeshes.size());
-
-        for (const auto& materialMesh : materialMeshes) {
-            // Create an entity name based on model and material
-            std::string entityName = modelName + "_Material_" + std::to_string(materialMesh.materialIndex) +
-                                    "_" + materialMesh.materialName;
+        std::cout << "Successfully loaded GLTF model with all textures and lighting: " << modelPath << std::endl;
 
-            if (Entity* materialEntity = engine->CreateEntity(entityName)) {
-                // Add a transform component with provided parameters
-                auto* transform = materialEntity->AddComponent<TransformComponent>();
-                transform->SetPosition(position);
-                transform->SetRotation(glm::radians(rotation));
-                transform->SetScale(scale);
-
-                // Add a mesh component with material-specific data
-                auto* mesh = materialEntity->AddComponent<MeshComponent>();
-                mesh->SetVertices(materialMesh.vertices);
-                mesh->SetIndices(materialMesh.indices);
-
-                if (materialMesh.GetInstanceCount() > 0) {
-                    const std::vector<InstanceData>& instances = materialMesh.instances;
-                    for (const auto& instanceData : instances) {
-                        // Reconstruct the transformation matrix from InstanceData column vectors
-                        glm::mat4 instanceMatrix = instanceData.getModelMatrix();
-                        mesh->AddInstance(instanceMatrix, static_cast<uint32_t>(materialMesh.materialIndex));
-                    }
-                }
+        TextureDedupStats dedupStats = renderer->GetTextureDedupStats();
+        if (dedupStats.duplicateImages > 0) {
+            std::cout << "Texture deduplication: " << dedupStats.uniqueImages << " unique images, "
+                      << dedupStats.duplicateImages << " duplicates aliased ("
+                      << static_cast<double>(dedupStats.duplicateBytesAvoided) / (1024.0 * 1024.0)
+                      << " MB not uploaded)" << std::endl;
+        }
 
-                // Set ALL PBR texture paths for this material
-                // Set primary texture path for backward compatibility
-                if (!materialMesh.texturePath.empty()) {
-                    mesh->SetTexturePath(materialMesh.texturePath);
-                }
+        // Extract lights from the model and transform them to world space
+        std::vector<ExtractedLight> extractedLights = modelLoader->GetExtractedLights(modelPath);
 
-                // Set all PBR texture paths
-                if (!materialMesh.baseColorTexturePath.empty()) {
-                    mesh->SetBaseColorTexturePath(materialMesh.baseColorTexturePath);
-                }
-                if (!materialMesh.normalTexturePath.empty()) {
-                    mesh->SetNormalTexturePath(materialMesh.normalTexturePath);
-                }
-                if (!materialMesh.metallicRoughnessTexturePath.empty()) {
-                    mesh->SetMetallicRoughnessTexturePath(materialMesh.metallicRoughnessTexturePath);
-                }
-                if (!materialMesh.occlusionTexturePath.empty()) {
-                    mesh->SetOcclusionTexturePath(materialMesh.occlusionTexturePath);
-                }
-                if (!materialMesh.emissiveTexturePath.empty()) {
-                    mesh->SetEmissiveTexturePath(materialMesh.emissiveTexturePath);
-                }
+        // Transform all light positions from local model space to world space
+        // Also transform the light direction (for directional lights)
+        glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(transformMatrix)));
+        for (auto& light : extractedLights) {
+            glm::vec4 worldPos = transformMatrix * glm::vec4(light.position, 1.0f);
+            light.position = glm::vec3(worldPos);
+            light.direction = glm::normalize(normalMatrix * light.direction);
+        }
 
-                // Fallback: Use material DB (from ModelLoader) if any PBR texture is still missing
-                if (modelLoader) {
-                    Material* mat = modelLoader->GetMaterial(materialMesh.materialName);
-                    if (mat) {
-                        if (mesh->GetBaseColorTexturePath().empty() && !mat->albedoTexturePath.empty()) {
-                            mesh->SetBaseColorTexturePath(mat->albedoTexturePath);
-                        }
-                        if (mesh->GetNormalTexturePath().empty() && !mat->normalTexturePath.empty()) {
-                            mesh->SetNormalTexturePath(mat->normalTexturePath);
-                        }
-                        if (mesh->GetMetallicRoughnessTexturePath().empty() && !mat->metallicRoughnessTexturePath.empty()) {
-                            mesh->SetMetallicRoughnessTexturePath(mat->metallicRoughnessTexturePath);
-                        }
-                        if (mesh->GetOcclusionTexturePath().empty() && !mat->occlusionTexturePath.empty()) {
-                            mesh->SetOcclusionTexturePath(mat->occlusionTexturePath);
-                        }
-                        if (mesh->GetEmissiveTexturePath().empty() && !mat->emissiveTexturePath.empty()) {
-                            mesh->SetEmissiveTexturePath(mat->emissiveTexturePath);
-                        }
+        // The camera entity and the lights belong to the live scene, which only the main thread touches
+        std::vector<CameraData> cameras = loadedModel->GetCameras();
+        bool handedOff = engine->StreamSceneSetup([engine, renderer, transformMatrix, cameras = std::move(cameras),
+                                                   lights = std::move(extractedLights)]() {
+            renderer->SetStaticLights(lights);
+
+            if (!cameras.empty()) {
+                const CameraData& gltfCamera = cameras[0]; // Use the first camera
+
+                // Find or create a camera entity to replace the default one
+                Entity* cameraEntity = engine->GetEntity("Camera");
+                if (!cameraEntity) {
+                    // Create a new camera entity if none exists
+                    cameraEntity = engine->CreateEntity("Camera");
+                    if (cameraEntity) {
+                        cameraEntity->AddComponent<TransformComponent>();
+                        cameraEntity->AddComponent<CameraComponent>();
                     }
                 }
 
-                // Register all effective texture IDs this mesh uses so that when
-                // textures finish streaming in, the renderer can refresh
-                // descriptor sets for the appropriate entities. This must
-                // happen *after* material fallbacks so we see the final IDs.
-                if (renderer) {
-                    auto registerTex = [&](const std::string& texId) {
-                        if (!texId.empty()) {
-                            renderer->RegisterTextureUser(texId, materialEntity);
-                        }
-                    };
-
-                    registerTex(mesh->GetTexturePath());
-                    registerTex(mesh->GetBaseColorTexturePath());
-                    registerTex(mesh->GetNormalTexturePath());
-                    registerTex(mesh->GetMetallicRoughnessTexturePath());
-                    registerTex(mesh->GetOcclusionTexturePath());
-                    registerTex(mesh->GetEmissiveTexturePath());
-                }
+                if (cameraEntity) {
+                    // Update the camera transform with GLTF data
+                    auto* cameraTransform = cameraEntity->GetComponent<TransformComponent>();
+                    if (cameraTransform) {
+                        // Apply the transformation matrix to the camera position
+                        glm::vec4 worldPos = transformMatrix * glm::vec4(gltfCamera.position, 1.0f);
+                        cameraTransform->SetPosition(glm::vec3(worldPos));
+
+                        // Apply rotation from GLTF camera
+                        glm::vec3 eulerAngles = glm::eulerAngles(gltfCamera.rotation);
+                        cameraTransform->SetRotation(eulerAngles);
+                    }
 
-                // Track this entity for batched Vulkan resource pre-allocation later
-                geometryEntities.push_back(materialEntity);
-
-                // Create physics body for collision with balls, but only for geometry
-                // that is reasonably close to the ground plane. This avoids creating
-                // expensive mesh colliders for high-up roofs and distant details.
-                PhysicsSystem* physicsSystem = engine->GetPhysicsSystem();
-                if (physicsSystem) {
-                    auto* mc = materialEntity->GetComponent<MeshComponent>();
-                    if (mc && !mc->GetVertices().empty() && !mc->GetIndices().empty()) {
-                        // Compute a simple Y-range in WORLD space using the entity transform
-                        // and the mesh's local AABB if available; otherwise approximate from vertices.
-                        glm::vec3 minWS( std::numeric_limits<float>::max());
-                        glm::vec3 maxWS(-std::numeric_limits<float>::max());
-
-                        auto* xform = materialEntity->GetComponent<TransformComponent>();
-                        glm::mat4 model = xform ? xform->GetModelMatrix() : glm::mat4(1.0f);
-
-                        if (mc->HasLocalAABB()) {
-                            glm::vec3 localMin = mc->GetLocalAABBMin();
-                            glm::vec3 localMax = mc->GetLocalAABBMax();
-
-                            // Transform the 8 corners of the local AABB to world space
-                            for (int ix = 0; ix < 2; ++ix) {
-                                for (int iy = 0; iy < 2; ++iy) {
-                                    for (int iz = 0; iz < 2; ++iz) {
-                                        glm::vec3 corner(
-                                            ix ? localMax.x : localMin.x,
-                                            iy ? localMax.y : localMin.y,
-                                            iz ? localMax.z : localMin.z
-                                        );
-                                        glm::vec3 cWS = glm::vec3(model * glm::vec4(corner, 1.0f));
-                                        minWS = glm::min(minWS, cWS);
-                                        maxWS = glm::max(maxWS, cWS);
-                                    }
-                                }
+                    // Update the camera component with GLTF properties
+                    auto* camera = cameraEntity->GetComponent<CameraComponent>();
+                    if (camera) {
+                        camera->ForceViewMatrixUpdate(); // Only sets viewMatrixDirty flag, doesn't change camera orientation
+                        if (gltfCamera.isPerspective) {
+                            camera->SetFieldOfView(glm::degrees(gltfCamera.fov)); // Convert radians to degrees
+                            camera->SetClipPlanes(gltfCamera.nearPlane, gltfCamera.farPlane);
+                            if (gltfCamera.aspectRatio > 0.0f) {
+                                camera->SetAspectRatio(gltfCamera.aspectRatio);
                             }
                         } else {
-                            // Fallback: compute bounds directly from vertices in world space
-                            const auto& verts = mc->GetVertices();
-                            for (const auto& v : verts) {
-                                glm::vec3 pWS = glm::vec3(model * glm::vec4(v.position, 1.0f));
-                                minWS = glm::min(minWS, pWS);
-                                maxWS = glm::max(maxWS, pWS);
-                            }
+                            // Handle orthographic camera if needed
+                            camera->SetProjectionType(CameraComponent::ProjectionType::Orthographic);
+                            camera->SetOrthographicSize(gltfCamera.orthographicSize, gltfCamera.orthographicSize);
+                            camera->SetClipPlanes(gltfCamera.nearPlane, gltfCamera.farPlane);
                         }
 
-                        // If we have a valid Y range and the mesh comes within 6 meters of the ground,
-                        // create a physics body. Otherwise, skip it to save startup time and memory.
-                        const float groundY = 0.0f;
-                        const float maxDistanceFromGround = 6.0f;
-                        bool nearGround = (minWS.y <= groundY + maxDistanceFromGround);
-
-                        if (nearGround) {
-                            physicsSystem->EnqueueRigidBodyCreation(
-                                materialEntity,
-                                CollisionShape::Mesh,
-                                0.0f,            // mass 0 = static
-                                true,            // kinematic
-                                0.15f,           // restitution
-                                0.5f             // friction
-                            );
-                            std::cout << "Queued physics body for near-ground geometry entity: " << entityName << std::endl;
-                        } else {
-                            std::cout << "Skipped physics body for high/remote entity: " << entityName
-                                      << " (minY=" << minWS.y << ")" << std::endl;
-                        }
-                    } else {
-                        std::cerr << "Skipping physics body for entity (no geometry): " << entityName << std::endl;
+                        // Set this as the active camera
+                        engine->SetActiveCamera(camera);
                     }
                 }
-
-            } else {
-                std::cerr << "Failed to create entity for material " << materialMesh.materialName << std::endl;
             }
+        });
+        if (!handedOff) {
+            std::cerr << "Scene streaming cancelled: " << modelPath << std::endl;
+            return false;
         }
 
-        // Pre-allocate Vulkan resources for all geometry entities in a single batched pass
-        if (!geometryEntities.empty()) {
-            if (!renderer->preAllocateEntityResourcesBatch(geometryEntities)) {
-                std::cerr << "Failed to pre-allocate resources for one or more geometry entities in batch" << std::endl;
-                // For now, continue; individual entities may still be partially usable
-            }
+        // Everything is handed off; the loading screen stays up only for outstanding critical textures
+        renderer->SetLoading(false);
+
+        if (streamedCount == 0) {
+            std::cerr << "No material meshes found in loaded model: " << modelPath << std::endl;
+            return false;
         }
+        std::cout << "Mesh geometry: " << streamedCount << " meshes, " << geometryBytes / 1024
+                  << " KB in host memory (shared with the entities)" << std::endl;
+        std::cout << "Streamed " << streamedCount << " entities of " << modelPath << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Error loading GLTF model: " << e.what() << std::endl;
         return false;
@@ -10,7 +10,8 @@ class Engine;
 class ModelLoader;
 
 /**
- * @brief Load a GLTF model synchronously on the main thread.
+ * @brief Load a GLTF model on the scene loader thread and stream its entities to the engine.
+ * Call Engine::BeginSceneStreaming first; the entities are activated by Engine::Update.
  * @param engine The engine to create entities in.
  * @param modelPath The path to the GLTF model file.
  * @param position The position to place the model.
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "entity.h"
+
+/**
+ * @brief An entity built by the scene loader that is not part of the scene yet.
+ */
+struct StreamedEntity {
+    std::unique_ptr<Entity> entity;
+    bool staticCollider = false;   // Create a static mesh collider when activated
+};
+
+/**
+ * @brief Progress of the staged scene load, see Engine::BeginSceneStreaming.
+ */
+struct SceneStreamingStats {
+    size_t entitiesActivated = 0;
+    size_t entitiesDropped = 0;      // Entities whose GPU resources could not be created
+    size_t batches = 0;              // Frames that activated entities
+    double firstInteractiveMs = 0.0; // Until the first frame that updated the scene
+    double completeMs = 0.0;         // Until the last entity was activated
+};
+
+/**
+ * @brief Bounded hand-off of built entities from the scene loader thread to the main thread.
+ *
+ * The loader pushes entities as it builds them and blocks while the queue is
+ * full, so it never runs more than the capacity ahead of activation. The main
+ * thread pops a batch per frame without blocking. Scene setup that touches
+ * the live scene (camera, lights) is handed over the same way and run by the
+ * main thread. Closing the queue marks the
+ * end of the scene; cancelling it also wakes a blocked loader (shutdown) and
+ * drops the entities that were not activated.
+ */
+class SceneStreamQueue {
+public:
+    /**
+     * @brief Constructor.
+     * @param capacity The number of entities buffered at most.
+     */
+    explicit SceneStreamQueue(size_t capacity = 256) : capacity(capacity > 0 ? capacity : 1) {}
+
+    /**
+     * @brief Start a new scene (after a previous one was closed or cancelled).
+     */
+    void Open() {
+        std::lock_guard<std::mutex> lock(mutex);
+        entities.clear();
+        setups.clear();
+        open = true;
+    }
+
+    /**
+     * @brief Add an entity, waiting while the queue is full.
+     * @param entity The entity.
+     * @return False if the queue was cancelled or is not open (the entity is dropped).
+     */
+    bool Push(StreamedEntity entity) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return entities.size() < capacity || !open; });
+        if (!open) {
+            return false;
+        }
+        entities.push_back(std::move(entity));
+        return true;
+    }
+
+    /**
+     * @brief Add work for the main thread that does not wait for free capacity.
+     * @param setup The work, run once by whoever pops it.
+     * @return False if the queue was cancelled or is not open (the work is dropped).
+     */
+    bool PushSetup(std::function<void()> setup) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!open) {
+            return false;
+        }
+        setups.push_back(std::move(setup));
+        return true;
+    }
+
+    /**
+     * @brief Take all queued setup work without waiting.
+     * @return The work in push order.
+     */
+    std::vector<std::function<void()>> PopSetups() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::function<void()>> taken(std::make_move_iterator(setups.begin()), std::make_move_iterator(setups.end()));
+        setups.clear();
+        return taken;
+    }
+
+    /**
+     * @brief Take up to a number of entities without waiting.
+     * @param maxCount The number of entities to take at most (0 = all available).
+     * @return The entities in push order.
+     */
+    std::vector<StreamedEntity> PopBatch(size_t maxCount) {
+        std::vector<StreamedEntity> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            const size_t count = maxCount == 0 ? entities.size() : std::min(maxCount, entities.size());
+            batch.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                batch.push_back(std::move(entities.front()));
+                entities.pop_front();
+            }
+        }
+        if (!batch.empty()) {
+            notFull.notify_all();
+        }
+        return batch;
+    }
+
+    /**
+     * @brief Mark the end of the scene; entities already pushed are still popped.
+     */
+    void Close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        open = false;
+        notFull.notify_all();
+    }
+
+    /**
+     * @brief Stop the scene: wake a waiting loader and drop the buffered entities.
+     */
+    void Cancel() {
+        std::deque<StreamedEntity> dropped;
+        std::deque<std::function<void()>> droppedSetups;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            open = false;
+            dropped.swap(entities);
+            droppedSetups.swap(setups);
+        }
+        notFull.notify_all();
+    }
+
+    /**
+     * @brief Check whether entities are still to come or to be popped.
+     * @return True while the scene is open or entities or setup work are buffered.
+     */
+    bool IsActive() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return open || !entities.empty() || !setups.empty();
+    }
+
+private:
+    const size_t capacity;
+    mutable std::mutex mutex;
+    std::condition_variable notFull;
+    std::deque<StreamedEntity> entities;
+    std::deque<std::function<void()>> setups;
+    bool open = false;
+};
@@ -0,0 +1,84 @@
+#include "test_common.h"
+
+#include <memory>
+#include <vector>
+
+#include "../deletion_queue.h"
+
+namespace {
+    // Records its id in a shared log when destroyed, like a Vulkan RAII handle
+    struct Tracked {
+        std::shared_ptr<std::vector<int>> log;
+        int id = 0;
+
+        Tracked(std::shared_ptr<std::vector<int>> log, int id) : log(std::move(log)), id(id) {}
+        Tracked(Tracked&& other) noexcept : log(std::move(other.log)), id(other.id) {}
+        ~Tracked() {
+            if (log) log->push_back(id);
+        }
+    };
+}
+
+TEST_CASE(ReleasesOnlyCompletedSerials) {
+    auto log = std::make_shared<std::vector<int>>();
+    DeletionQueue queue;
+    queue.Retire(1, Tracked(log, 1));
+    queue.Retire(2, Tracked(log, 2));
+    queue.Retire(3, Tracked(log, 3));
+
+    EXPECT_EQ(queue.Collect(0), size_t{0});
+    EXPECT_TRUE(log->empty());
+    EXPECT_EQ(queue.Collect(2), size_t{2});
+    EXPECT_EQ(*log, (std::vector<int>{1, 2}));
+    EXPECT_EQ(queue.GetPendingCount(), size_t{1});
+
+    EXPECT_EQ(queue.Flush(), size_t{1});
+    EXPECT_EQ(*log, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(queue.GetReleasedTotal(), uint64_t{3});
+}
+
+TEST_CASE(LaterSerialHoldsBackEntriesRetiredAfterIt) {
+    auto log = std::make_shared<std::vector<int>>();
+    DeletionQueue queue;
+    queue.Retire(5, Tracked(log, 5));
+    queue.Retire(2, Tracked(log, 2));
+
+    // Never released early: the serial-2 entry waits for the serial-5 entry before it
+    EXPECT_EQ(queue.Collect(3), size_t{0});
+    EXPECT_EQ(queue.Collect(5), size_t{2});
+    EXPECT_EQ(*log, (std::vector<int>{5, 2}));
+}
+
+TEST_CASE(RunsReleaseFunctionsOnce) {
+    int released = 0;
+    DeletionQueue queue;
+
+    // Lvalue callables are copied into the queue, move-only ones are moved
+    auto release = [&released] { released++; };
+    queue.RetireWith(1, release);
+    auto owned = std::make_unique<int>(7);
+    queue.RetireWith(1, [&released, owned = std::move(owned)] { released += *owned; });
+
+    EXPECT_EQ(released, 0);
+    EXPECT_EQ(queue.Collect(1), size_t{2});
+    EXPECT_EQ(released, 8);
+    EXPECT_EQ(queue.Flush(), size_t{0});
+    EXPECT_EQ(released, 8);
+}
+
+TEST_CASE(ReleaseFunctionsMayRetireFurtherEntries) {
+    int released = 0;
+    DeletionQueue queue;
+    queue.RetireWith(1, [&] {
+        queue.RetireWith(2, [&released] { released++; });
+    });
+
+    EXPECT_EQ(queue.Collect(1), size_t{1});
+    EXPECT_EQ(queue.GetPendingCount(), size_t{1});
+    EXPECT_EQ(queue.Collect(2), size_t{1});
+    EXPECT_EQ(released, 1);
+}
+
+int main() {
+    return test::RunAll();
+}
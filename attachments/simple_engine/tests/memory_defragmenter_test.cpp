@@ -0,0 +1,241 @@
+#include "test_common.h"
+
+#include <algorithm>
+#include <random>
+
+#include "../memory_defragmenter.h"
+
+namespace {
+    using Allocation = DefragmentationPlanner::Allocation;
+    using Move = DefragmentationPlanner::Move;
+
+    uint64_t UsedUnits(const std::vector<bool>& block) {
+        return static_cast<uint64_t>(std::ranges::count(block, false));
+    }
+
+    /**
+     * Unit-granular stand-in for a MemoryPool: first-fit placement like
+     * MemoryPool::findSuitableBlock, and plans applied the way
+     * Renderer::compactMemoryPool does (copy everything, then free the sources).
+     */
+    struct FakePool {
+        std::vector<std::vector<bool>> blocks; // true = free
+        std::vector<Allocation> allocations;   // The relocatable ones
+
+        FakePool(size_t blockCount, uint64_t unitsPerBlock)
+            : blocks(blockCount, std::vector<bool>(unitsPerBlock, true)) {}
+
+        void Mark(uint32_t block, uint64_t first, uint64_t count, bool free) {
+            std::fill_n(blocks[block].begin() + static_cast<std::ptrdiff_t>(first), count, free);
+        }
+
+        bool IsFree(uint32_t block, uint64_t first, uint64_t count) const {
+            if (block >= blocks.size() || first + count > blocks[block].size()) return false;
+            return std::all_of(blocks[block].begin() + static_cast<std::ptrdiff_t>(first),
+                               blocks[block].begin() + static_cast<std::ptrdiff_t>(first + count), [](bool free) { return free; });
+        }
+
+        bool Allocate(uint64_t count, uint64_t alignment = 1) {
+            for (uint32_t b = 0; b < blocks.size(); ++b) {
+                for (uint64_t first = 0; first + count <= blocks[b].size(); first += alignment) {
+                    if (IsFree(b, first, count)) {
+                        Mark(b, first, count, false);
+                        allocations.push_back({b, first, count, alignment});
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        // Occupied by something the caller cannot move (not offered to the planner)
+        void Pin(uint32_t block, uint64_t first, uint64_t count) { Mark(block, first, count, false); }
+
+        // Fill with random sizes and alignments, then free most allocations at random
+        void Churn(std::mt19937& rng, double keepFraction) {
+            std::uniform_int_distribution<uint64_t> sizeDis(1, std::max<uint64_t>(blocks[0].size() / 32, 2));
+            std::uniform_int_distribution<uint32_t> alignDis(0, 3);
+            while (Allocate(sizeDis(rng), uint64_t(1) << alignDis(rng))) {}
+            std::ranges::shuffle(allocations, rng);
+            const size_t keep = static_cast<size_t>(static_cast<double>(allocations.size()) * keepFraction);
+            for (size_t i = keep; i < allocations.size(); ++i) {
+                Mark(allocations[i].block, allocations[i].firstUnit, allocations[i].unitCount, true);
+            }
+            allocations.resize(keep);
+        }
+
+        // Apply a plan; false if a move leaves its block, is misaligned or overlaps live data or another move
+        bool Apply(const std::vector<Move>& moves) {
+            std::vector<bool> moved(allocations.size(), false);
+            for (const Move& move : moves) {
+                if (move.allocation >= allocations.size() || moved[move.allocation]) return false;
+                const Allocation& allocation = allocations[move.allocation];
+                if (move.block == allocation.block || move.firstUnit % allocation.alignmentUnits != 0 ||
+                    !IsFree(move.block, move.firstUnit, allocation.unitCount)) {
+                    return false;
+                }
+                Mark(move.block, move.firstUnit, allocation.unitCount, false);
+                moved[move.allocation] = true;
+            }
+            for (const Move& move : moves) {
+                Allocation& allocation = allocations[move.allocation];
+                Mark(allocation.block, allocation.firstUnit, allocation.unitCount, true);
+                allocation.block = move.block;
+                allocation.firstUnit = move.firstUnit;
+            }
+            return true;
+        }
+
+        uint64_t TotalUsed() const {
+            uint64_t used = 0;
+            for (const auto& block : blocks) used += UsedUnits(block);
+            return used;
+        }
+
+        size_t EmptyBlocks() const {
+            return static_cast<size_t>(std::ranges::count_if(blocks, [](const auto& block) { return UsedUnits(block) == 0; }));
+        }
+    };
+
+    uint64_t PlannedUnits(const FakePool& pool, const std::vector<Move>& moves) {
+        uint64_t units = 0;
+        for (const Move& move : moves) units += pool.allocations[move.allocation].unitCount;
+        return units;
+    }
+}
+
+TEST_CASE(PlansNeverOverlapLiveData) {
+    for (uint32_t seed = 1; seed <= 20; ++seed) {
+        std::mt19937 rng(seed);
+        FakePool pool(6, 1024);
+        pool.Churn(rng, 0.3);
+        const uint64_t liveUnits = pool.TotalUsed();
+
+        for (int frame = 0; frame < 1000; ++frame) {
+            std::vector<Move> moves = DefragmentationPlanner::Plan(pool.blocks, pool.allocations, 64);
+            if (moves.empty()) break;
+            EXPECT_TRUE(pool.Apply(moves));
+            EXPECT_EQ(pool.TotalUsed(), liveUnits);
+        }
+    }
+}
+
+TEST_CASE(DestinationsRespectAlignment) {
+    // Block 0 only has free ranges starting at odd units
+    FakePool pool(2, 64);
+    pool.Pin(0, 0, 64);
+    pool.Mark(0, 3, 13, true);  // [3, 16): holds 8 units at 8, nothing at 16
+    pool.Mark(0, 17, 20, true); // [17, 37): holds 5 units at 32 only
+    pool.allocations = {{1, 0, 8, 8}, {1, 16, 5, 16}};
+    pool.Mark(1, 0, 8, false);
+    pool.Mark(1, 16, 5, false);
+
+    std::vector<Move> moves = DefragmentationPlanner::Plan(pool.blocks, pool.allocations, 1024);
+    EXPECT_EQ(moves.size(), 2u);
+    for (const Move& move : moves) {
+        EXPECT_EQ(move.firstUnit, move.allocation == 0 ? 8u : 32u);
+    }
+    EXPECT_TRUE(pool.Apply(moves));
+
+    // Randomized: every alignment up to 8 units
+    for (uint32_t seed = 100; seed < 110; ++seed) {
+        std::mt19937 rng(seed);
+        FakePool churned(4, 512);
+        churned.Churn(rng, 0.25);
+        std::vector<Move> plan;
+        for (int frame = 0; frame < 1000 && !(plan = DefragmentationPlanner::Plan(churned.blocks, churned.allocations, 32)).empty(); ++frame) {
+            for (const Move& move : plan) {
+                EXPECT_EQ(move.firstUnit % churned.allocations[move.allocation].alignmentUnits, 0u);
+            }
+            EXPECT_TRUE(churned.Apply(plan));
+        }
+    }
+}
+
+TEST_CASE(PlansStayWithinTheBudget) {
+    for (uint64_t budget : {8u, 32u, 128u}) {
+        std::mt19937 rng(7);
+        FakePool pool(6, 1024);
+        pool.Churn(rng, 0.3);
+        std::vector<Move> moves;
+        for (int frame = 0; frame < 1000 && !(moves = DefragmentationPlanner::Plan(pool.blocks, pool.allocations, budget)).empty(); ++frame) {
+            // Only an allocation larger than the whole budget may exceed it, and then alone
+            EXPECT_TRUE(PlannedUnits(pool, moves) <= budget || moves.size() == 1);
+            EXPECT_TRUE(pool.Apply(moves));
+        }
+    }
+
+    // An allocation larger than the budget still moves, on its own
+    FakePool pool(2, 256);
+    pool.Pin(0, 0, 128);
+    pool.allocations = {{1, 0, 40, 1}, {1, 40, 4, 1}};
+    pool.Mark(1, 0, 44, false);
+    std::vector<Move> moves = DefragmentationPlanner::Plan(pool.blocks, pool.allocations, 16);
+    EXPECT_EQ(moves.size(), 1u);
+    EXPECT_EQ(PlannedUnits(pool, moves), 40u);
+
+    EXPECT_TRUE(DefragmentationPlanner::Plan(pool.blocks, pool.allocations, 0).empty());
+}
+
+TEST_CASE(EvacuatedBlockEndsUpEmpty) {
+    // Block 0 holds data that cannot move; block 1 is sparse and fully relocatable
+    FakePool pool(3, 256);
+    pool.Pin(0, 0, 160);
+    for (uint64_t first = 0; first < 96; first += 12) {
+        pool.allocations.push_back({1, first, 6, 2});
+        pool.Mark(1, first, 6, false);
+    }
+    const size_t emptyBefore = pool.EmptyBlocks();
+
+    size_t frames = 0;
+    std::vector<Move> moves;
+    while (!(moves = DefragmentationPlanner::Plan(pool.blocks, pool.allocations, 12)).empty() && frames < 100) {
+        for (const Move& move : moves) {
+            // Never into the empty block 2: that gains nothing
+            EXPECT_EQ(move.block, 0u);
+        }
+        EXPECT_TRUE(pool.Apply(moves));
+        frames++;
+    }
+    EXPECT_EQ(frames, 4u); // 48 units at 12 per frame
+    EXPECT_EQ(UsedUnits(pool.blocks[1]), 0u);
+    EXPECT_EQ(UsedUnits(pool.blocks[0]), 160u + 48u);
+    EXPECT_EQ(pool.EmptyBlocks(), emptyBefore + 1);
+}
+
+TEST_CASE(BlocksWithPinnedDataAreNotEvacuated) {
+    FakePool pool(2, 256);
+    pool.Pin(0, 0, 200);
+    pool.Pin(1, 0, 1);
+    pool.allocations = {{1, 8, 16, 1}};
+    pool.Mark(1, 8, 16, false);
+    // Moving block 1's allocation would not free the block
+    EXPECT_TRUE(DefragmentationPlanner::Plan(pool.blocks, pool.allocations, 1024).empty());
+}
+
+TEST_CASE(DenseOrUnplaceableBlocksAreLeftAlone) {
+    // Both blocks more than half full: neither is a source
+    FakePool dense(2, 100);
+    dense.Allocate(60);
+    dense.Mark(1, 0, 60, false);
+    dense.allocations.push_back({1, 0, 60, 1});
+    EXPECT_TRUE(DefragmentationPlanner::Plan(dense.blocks, dense.allocations, 1024).empty());
+
+    // The other blocks lack the room for the whole source block
+    FakePool full(2, 100);
+    full.Pin(0, 0, 90);
+    full.allocations = {{1, 0, 20, 1}};
+    full.Mark(1, 0, 20, false);
+    EXPECT_TRUE(DefragmentationPlanner::Plan(full.blocks, full.allocations, 1024).empty());
+}
+
+TEST_CASE(SimulationFreesBlocks) {
+    DefragmentationSimulation result = DefragmentationPlanner::Simulate(8, 4096, 256, 42);
+    EXPECT_TRUE(result.frames > 0);
+    EXPECT_TRUE(result.emptyBlocksAfter > result.emptyBlocksBefore);
+    EXPECT_LE(result.freeRangesAfter, result.freeRangesBefore);
+}
+
+int main() {
+    return test::RunAll();
+}
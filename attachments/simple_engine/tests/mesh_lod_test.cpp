@@ -0,0 +1,186 @@
+#include "test_common.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../camera_component.h"
+#include "../mesh_optimizer.h"
+
+namespace {
+    struct Position {
+        float x, y, z;
+    };
+
+    struct TestMesh {
+        std::vector<Position> positions;
+        std::vector<uint32_t> indices;
+    };
+
+    // Grid of quads in the z = 0 plane, counter-clockwise when seen from +z
+    TestMesh MakeGrid(uint32_t quads) {
+        TestMesh mesh;
+        for (uint32_t y = 0; y <= quads; ++y) {
+            for (uint32_t x = 0; x <= quads; ++x) {
+                mesh.positions.push_back({static_cast<float>(x), static_cast<float>(y), 0.0f});
+            }
+        }
+        for (uint32_t y = 0; y < quads; ++y) {
+            for (uint32_t x = 0; x < quads; ++x) {
+                uint32_t v00 = y * (quads + 1) + x;
+                uint32_t v10 = v00 + 1;
+                uint32_t v01 = v00 + quads + 1;
+                uint32_t v11 = v01 + 1;
+                mesh.indices.insert(mesh.indices.end(), {v00, v10, v11, v00, v11, v01});
+            }
+        }
+        return mesh;
+    }
+
+    // UV sphere with outward-facing counter-clockwise triangles
+    TestMesh MakeSphere(uint32_t segments) {
+        TestMesh mesh;
+        for (uint32_t lat = 0; lat <= segments; ++lat) {
+            float theta = static_cast<float>(lat) * 3.14159265f / static_cast<float>(segments);
+            for (uint32_t lon = 0; lon <= segments; ++lon) {
+                float phi = static_cast<float>(lon) * 2.0f * 3.14159265f / static_cast<float>(segments);
+                mesh.positions.push_back({std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)});
+            }
+        }
+        for (uint32_t lat = 0; lat < segments; ++lat) {
+            for (uint32_t lon = 0; lon < segments; ++lon) {
+                uint32_t first = lat * (segments + 1) + lon;
+                uint32_t second = first + segments + 1;
+                if (lat != 0) mesh.indices.insert(mesh.indices.end(), {first, first + 1, second});
+                if (lat != segments - 1) mesh.indices.insert(mesh.indices.end(), {second, first + 1, second + 1});
+            }
+        }
+        return mesh;
+    }
+
+    SimplificationResult Simplify(const TestMesh& mesh, std::vector<uint32_t>& destination, size_t targetIndexCount, float targetError) {
+        return MeshOptimizer::SimplifyMesh(destination, mesh.indices.data(), mesh.indices.size(), mesh.positions.data(),
+                                           mesh.positions.size(), sizeof(Position), 0, targetIndexCount, targetError);
+    }
+
+    // Signed area of the triangles projected onto the z = 0 plane
+    float ProjectedArea(const TestMesh& mesh, const std::vector<uint32_t>& indices) {
+        float area = 0.0f;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            const Position& a = mesh.positions[indices[i]];
+            const Position& b = mesh.positions[indices[i + 1]];
+            const Position& c = mesh.positions[indices[i + 2]];
+            area += 0.5f * ((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y));
+        }
+        return area;
+    }
+
+    bool HasDegenerateTriangle(const std::vector<uint32_t>& indices) {
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            if (indices[i] == indices[i + 1] || indices[i + 1] == indices[i + 2] || indices[i] == indices[i + 2]) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+TEST_CASE(FlatGridSimplifiesWithoutError) {
+    TestMesh grid = MakeGrid(16);
+    std::vector<uint32_t> simplified;
+    SimplificationResult result = Simplify(grid, simplified, grid.indices.size() / 4, 0.01f);
+
+    EXPECT_LE(simplified.size(), grid.indices.size() / 4);
+    EXPECT_EQ(simplified.size() % 3, size_t{0});
+    EXPECT_TRUE(result.collapses > 0);
+    EXPECT_NEAR(result.relativeError, 0.0f, 1e-4f);
+    EXPECT_TRUE(!HasDegenerateTriangle(simplified));
+
+    // Borders only collapse along themselves and flips are rejected, so the plane stays covered
+    EXPECT_NEAR(ProjectedArea(grid, simplified), 256.0f, 1e-2f);
+}
+
+TEST_CASE(CurvedMeshStaysWithinTargetError) {
+    TestMesh sphere = MakeSphere(32);
+    constexpr float targetError = 0.02f;
+    std::vector<uint32_t> simplified;
+    SimplificationResult result = Simplify(sphere, simplified, 0, targetError);
+
+    EXPECT_TRUE(simplified.size() < sphere.indices.size());
+    EXPECT_LE(result.relativeError, targetError);
+    EXPECT_TRUE(!HasDegenerateTriangle(simplified));
+    EXPECT_TRUE(std::ranges::all_of(simplified, [&](uint32_t index) { return index < sphere.positions.size(); }));
+
+    // A tighter bound keeps more of the mesh
+    std::vector<uint32_t> tighter;
+    Simplify(sphere, tighter, 0, targetError * 0.1f);
+    EXPECT_TRUE(tighter.size() >= simplified.size());
+}
+
+TEST_CASE(StopsAtTargetIndexCount) {
+    TestMesh sphere = MakeSphere(32);
+    std::vector<uint32_t> simplified;
+    Simplify(sphere, simplified, sphere.indices.size(), 1.0f);
+    EXPECT_EQ(simplified, sphere.indices);
+}
+
+TEST_CASE(LodChainShrinksWithGrowingError) {
+    TestMesh sphere = MakeSphere(48);
+    std::vector<uint32_t> lodIndices;
+    MeshOptimizationStats stats;
+    std::vector<MeshLod> lods = MeshOptimizer::BuildLodChain(sphere.positions, sphere.indices, lodIndices, 0, SIZE_MAX, &stats);
+
+    EXPECT_TRUE(lods.size() > 1);
+    EXPECT_LE(lods.size(), static_cast<size_t>(MeshOptimizer::MAX_LOD_COUNT));
+    EXPECT_EQ(stats.lodCount, lods.size() - 1);
+    EXPECT_EQ(lods[0].firstIndex, 0u);
+    EXPECT_EQ(static_cast<size_t>(lods[0].indexCount), sphere.indices.size());
+    EXPECT_EQ(lods[0].error, 0.0f);
+
+    // Coarser levels follow the base indices back to back, each meaningfully smaller
+    auto expectedFirst = static_cast<uint32_t>(sphere.indices.size());
+    for (size_t level = 1; level < lods.size(); ++level) {
+        EXPECT_EQ(lods[level].firstIndex, expectedFirst);
+        EXPECT_LE(static_cast<float>(lods[level].indexCount),
+                  MeshOptimizer::LOD_MIN_REDUCTION * static_cast<float>(lods[level - 1].indexCount));
+        EXPECT_TRUE(lods[level].error >= lods[level - 1].error);
+        expectedFirst += lods[level].indexCount;
+    }
+    EXPECT_EQ(static_cast<size_t>(expectedFirst), sphere.indices.size() + lodIndices.size());
+    EXPECT_TRUE(std::ranges::all_of(lodIndices, [&](uint32_t index) { return index < sphere.positions.size(); }));
+    EXPECT_TRUE(!HasDegenerateTriangle(lodIndices));
+}
+
+TEST_CASE(EmptyMeshHasNoLods) {
+    std::vector<Position> vertices;
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> lodIndices = {1, 2, 3};
+    EXPECT_TRUE(MeshOptimizer::BuildLodChain(vertices, indices, lodIndices, 0).empty());
+    EXPECT_TRUE(lodIndices.empty());
+}
+
+TEST_CASE(PerspectiveErrorShrinksWithDistance) {
+    CameraComponent camera;
+    camera.SetFieldOfView(90.0f);
+    camera.SetClipPlanes(0.5f, 100.0f);
+
+    // A 90 degree view maps one unit at distance 1 to half the viewport height
+    EXPECT_NEAR(camera.GetScreenSpaceError(1.0f, 10.0f, 1000.0f), 50.0f, 1e-2f);
+    EXPECT_NEAR(camera.GetScreenSpaceError(1.0f, 20.0f, 1000.0f), 25.0f, 1e-2f);
+    EXPECT_NEAR(camera.GetScreenSpaceError(2.0f, 20.0f, 1000.0f), 50.0f, 1e-2f);
+
+    // Distances inside the near plane are clamped to it
+    EXPECT_NEAR(camera.GetScreenSpaceError(1.0f, 0.0f, 1000.0f), camera.GetScreenSpaceError(1.0f, 0.5f, 1000.0f), 1e-3f);
+}
+
+TEST_CASE(OrthographicErrorIgnoresDistance) {
+    CameraComponent camera;
+    camera.SetProjectionType(CameraComponent::ProjectionType::Orthographic);
+    camera.SetOrthographicSize(20.0f, 10.0f);
+
+    EXPECT_NEAR(camera.GetScreenSpaceError(1.0f, 5.0f, 1000.0f), 100.0f, 1e-3f);
+    EXPECT_NEAR(camera.GetScreenSpaceError(1.0f, 50.0f, 1000.0f), 100.0f, 1e-3f);
+}
+
+int main() {
+    return test::RunAll();
+}
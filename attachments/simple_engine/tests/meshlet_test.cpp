@@ -0,0 +1,185 @@
+#include "test_common.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <unordered_set>
+
+#include "../mesh_optimizer.h"
+
+namespace {
+    struct Position {
+        float x, y, z;
+    };
+
+    struct TestMesh {
+        std::vector<Position> positions;
+        std::vector<uint32_t> indices;
+    };
+
+    // Grid of quads in the z = 0 plane, counter-clockwise when seen from +z
+    TestMesh MakeGrid(uint32_t quads) {
+        TestMesh mesh;
+        for (uint32_t y = 0; y <= quads; ++y) {
+            for (uint32_t x = 0; x <= quads; ++x) {
+                mesh.positions.push_back({static_cast<float>(x), static_cast<float>(y), 0.0f});
+            }
+        }
+        for (uint32_t y = 0; y < quads; ++y) {
+            for (uint32_t x = 0; x < quads; ++x) {
+                uint32_t v00 = y * (quads + 1) + x;
+                uint32_t v10 = v00 + 1;
+                uint32_t v01 = v00 + quads + 1;
+                uint32_t v11 = v01 + 1;
+                mesh.indices.insert(mesh.indices.end(), {v00, v10, v11, v00, v11, v01});
+            }
+        }
+        return mesh;
+    }
+
+    // UV sphere with outward-facing counter-clockwise triangles
+    TestMesh MakeSphere(uint32_t segments) {
+        TestMesh mesh;
+        for (uint32_t lat = 0; lat <= segments; ++lat) {
+            float theta = static_cast<float>(lat) * 3.14159265f / static_cast<float>(segments);
+            for (uint32_t lon = 0; lon <= segments; ++lon) {
+                float phi = static_cast<float>(lon) * 2.0f * 3.14159265f / static_cast<float>(segments);
+                mesh.positions.push_back({std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)});
+            }
+        }
+        for (uint32_t lat = 0; lat < segments; ++lat) {
+            for (uint32_t lon = 0; lon < segments; ++lon) {
+                uint32_t first = lat * (segments + 1) + lon;
+                uint32_t second = first + segments + 1;
+                if (lat != 0) mesh.indices.insert(mesh.indices.end(), {first, first + 1, second});
+                if (lat != segments - 1) mesh.indices.insert(mesh.indices.end(), {second, first + 1, second + 1});
+            }
+        }
+        return mesh;
+    }
+
+    std::vector<Meshlet> Build(TestMesh& mesh, uint32_t maxVertices = MeshOptimizer::MAX_MESHLET_VERTICES,
+                               uint32_t maxTriangles = MeshOptimizer::MAX_MESHLET_TRIANGLES) {
+        return MeshOptimizer::BuildMeshlets(mesh.indices, mesh.positions.data(), mesh.positions.size(), sizeof(Position), 0,
+                                            maxVertices, maxTriangles);
+    }
+
+    // Triangles as rotation-invariant keys (the winding is kept, the starting corner may not be)
+    std::vector<std::array<uint32_t, 3>> SortedTriangles(const std::vector<uint32_t>& indices) {
+        std::vector<std::array<uint32_t, 3>> triangles;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            std::array<uint32_t, 3> t = {indices[i], indices[i + 1], indices[i + 2]};
+            std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+            triangles.push_back(t);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    void CheckLimitsAndCoverage(TestMesh mesh, uint32_t maxVertices, uint32_t maxTriangles) {
+        auto originalTriangles = SortedTriangles(mesh.indices);
+        auto meshlets = Build(mesh, maxVertices, maxTriangles);
+        EXPECT_TRUE(!meshlets.empty());
+
+        uint32_t expectedFirst = 0;
+        for (const Meshlet& meshlet : meshlets) {
+            // Back to back in the index buffer, whole triangles only
+            EXPECT_EQ(meshlet.firstIndex, expectedFirst);
+            EXPECT_EQ(meshlet.indexCount % 3, 0u);
+            EXPECT_TRUE(meshlet.indexCount > 0);
+            EXPECT_LE(meshlet.indexCount / 3, maxTriangles);
+            expectedFirst += meshlet.indexCount;
+
+            std::unordered_set<uint32_t> vertices(mesh.indices.begin() + meshlet.firstIndex,
+                                                  mesh.indices.begin() + meshlet.firstIndex + meshlet.indexCount);
+            EXPECT_EQ(meshlet.vertexCount, vertices.size());
+            EXPECT_LE(vertices.size(), static_cast<size_t>(maxVertices));
+        }
+        EXPECT_EQ(static_cast<size_t>(expectedFirst), mesh.indices.size());
+        EXPECT_TRUE(SortedTriangles(mesh.indices) == originalTriangles);
+    }
+
+    bool TriangleBackFacing(const TestMesh& mesh, const uint32_t* triangle, const float viewer[3]) {
+        const Position& p0 = mesh.positions[triangle[0]];
+        const Position& p1 = mesh.positions[triangle[1]];
+        const Position& p2 = mesh.positions[triangle[2]];
+        float e1[3] = {p1.x - p0.x, p1.y - p0.y, p1.z - p0.z};
+        float e2[3] = {p2.x - p0.x, p2.y - p0.y, p2.z - p0.z};
+        float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+        return n[0] * (p0.x - viewer[0]) + n[1] * (p0.y - viewer[1]) + n[2] * (p0.z - viewer[2]) >= 0.0f;
+    }
+}
+
+TEST_CASE(GridMeshletsRespectLimitsAndCoverAllTriangles) {
+    CheckLimitsAndCoverage(MakeGrid(40), MeshOptimizer::MAX_MESHLET_VERTICES, MeshOptimizer::MAX_MESHLET_TRIANGLES);
+}
+
+TEST_CASE(SphereMeshletsRespectLimitsAndCoverAllTriangles) {
+    CheckLimitsAndCoverage(MakeSphere(48), MeshOptimizer::MAX_MESHLET_VERTICES, MeshOptimizer::MAX_MESHLET_TRIANGLES);
+}
+
+TEST_CASE(SmallLimitsAreRespected) {
+    CheckLimitsAndCoverage(MakeGrid(12), 16, 8);
+    CheckLimitsAndCoverage(MakeSphere(16), 3, 1);
+}
+
+TEST_CASE(BoundingSpheresContainTheirVertices) {
+    TestMesh mesh = MakeSphere(32);
+    for (const Meshlet& meshlet : Build(mesh)) {
+        for (uint32_t i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; ++i) {
+            const Position& p = mesh.positions[mesh.indices[i]];
+            float d[3] = {p.x - meshlet.center[0], p.y - meshlet.center[1], p.z - meshlet.center[2]};
+            EXPECT_LE(std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]), meshlet.radius * 1.0001f + 1e-6f);
+        }
+    }
+}
+
+TEST_CASE(ConeRejectsFlatClustersSeenFromBehind) {
+    TestMesh mesh = MakeGrid(24);
+    auto meshlets = Build(mesh);
+    const float behind[3] = {12.0f, 12.0f, -5.0f};
+    const float front[3] = {12.0f, 12.0f, 5.0f};
+    const float farBehind[3] = {-100.0f, 40.0f, -0.5f};
+    for (const Meshlet& meshlet : meshlets) {
+        EXPECT_TRUE(meshlet.coneCutoff < 1.0f);
+        EXPECT_TRUE(MeshOptimizer::IsMeshletBackFacing(meshlet, behind));
+        EXPECT_TRUE(MeshOptimizer::IsMeshletBackFacing(meshlet, farBehind));
+        EXPECT_TRUE(!MeshOptimizer::IsMeshletBackFacing(meshlet, front));
+    }
+}
+
+TEST_CASE(ConeRejectionIsConservativeOnClosedMesh) {
+    TestMesh mesh = MakeSphere(48);
+    auto meshlets = Build(mesh);
+    const float viewers[][3] = {{0.0f, 0.0f, 3.0f}, {2.5f, -1.0f, 0.5f}, {0.0f, 10.0f, 0.0f}, {1.2f, 0.0f, 0.0f}};
+    for (const auto& viewer : viewers) {
+        size_t rejected = 0;
+        for (const Meshlet& meshlet : meshlets) {
+            if (!MeshOptimizer::IsMeshletBackFacing(meshlet, viewer)) {
+                continue;
+            }
+            rejected++;
+            // Every triangle of a rejected meshlet must face away from the viewer
+            for (uint32_t i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; i += 3) {
+                EXPECT_TRUE(TriangleBackFacing(mesh, &mesh.indices[i], viewer));
+            }
+        }
+        // The far side of the sphere is culled
+        EXPECT_TRUE(rejected > 0);
+    }
+}
+
+TEST_CASE(ClustersWithOpposingFacesAreNeverRejected) {
+    // Two triangles facing +z and -z share an edge: no viewer sees both from behind
+    TestMesh mesh;
+    mesh.positions = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}};
+    mesh.indices = {0, 1, 2, 1, 2, 3};
+    auto meshlets = Build(mesh);
+    EXPECT_EQ(meshlets.size(), 1u);
+    const float viewer[3] = {0.5f, 0.5f, -4.0f};
+    EXPECT_TRUE(!MeshOptimizer::IsMeshletBackFacing(meshlets[0], viewer));
+}
+
+int main() {
+    return test::RunAll();
+}
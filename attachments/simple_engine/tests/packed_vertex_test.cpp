@@ -0,0 +1,100 @@
+#include "test_common.h"
+
+#include <cfloat>
+#include <random>
+
+#include "../mesh_component.h"
+
+namespace {
+    // Float rounding of offset + normalized * scale on top of the quantization step
+    float PositionTolerance(const VertexQuantization& quantization, int axis) {
+        float magnitude = std::abs(quantization.positionOffset[axis]) + std::abs(quantization.positionScale[axis]);
+        return quantization.positionScale[axis] / 131070.0f + 4.0f * FLT_EPSILON * magnitude;
+    }
+
+    std::vector<glm::vec3> TestDirections() {
+        std::vector<glm::vec3> directions = {
+            {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, -1.0f, 0.0f},
+            {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}, glm::normalize(glm::vec3(1.0f, 1.0f, 1.0f)),
+            glm::normalize(glm::vec3(-1.0f, 1.0f, -1.0f)), glm::normalize(glm::vec3(0.3f, -0.9f, -0.01f))
+        };
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+        while (directions.size() < 20000) {
+            glm::vec3 v(coordinate(rng), coordinate(rng), coordinate(rng));
+            if (glm::length(v) > 1e-3f) {
+                directions.push_back(glm::normalize(v));
+            }
+        }
+        return directions;
+    }
+}
+
+TEST_CASE(PositionsWithinHalfQuantizationStep) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> x(-3.0f, 7.0f), y(0.0f, 0.5f), z(100.0f, 101.0f);
+    std::vector<Vertex> vertices(5000);
+    for (auto& vertex : vertices) {
+        vertex.position = glm::vec3(x(rng), y(rng), z(rng));
+    }
+
+    VertexQuantization quantization = PackedVertex::ComputeQuantization(vertices);
+    for (const auto& vertex : vertices) {
+        Vertex decoded = PackedVertex::Encode(vertex, quantization).Decode(quantization);
+        for (int axis = 0; axis < 3; ++axis) {
+            EXPECT_NEAR(decoded.position[axis], vertex.position[axis], PositionTolerance(quantization, axis));
+        }
+    }
+}
+
+TEST_CASE(FlatAxisKeepsItsCoordinate) {
+    std::vector<Vertex> vertices(3);
+    vertices[0].position = glm::vec3(0.0f, 0.0f, 2.0f);
+    vertices[1].position = glm::vec3(1.0f, 0.0f, 2.0f);
+    vertices[2].position = glm::vec3(0.0f, 1.0f, 2.0f);
+
+    VertexQuantization quantization = PackedVertex::ComputeQuantization(vertices);
+    for (const auto& vertex : vertices) {
+        Vertex decoded = PackedVertex::Encode(vertex, quantization).Decode(quantization);
+        EXPECT_NEAR(decoded.position.z, 2.0f, PositionTolerance(quantization, 2));
+    }
+}
+
+TEST_CASE(NormalsAndTangentsWithinDirectionError) {
+    VertexQuantization quantization;
+    for (const glm::vec3& direction : TestDirections()) {
+        Vertex vertex{};
+        vertex.normal = direction;
+        vertex.tangent = glm::vec4(glm::vec3(direction.y, direction.z, direction.x), direction.x < 0.0f ? -1.0f : 1.0f);
+
+        Vertex decoded = PackedVertex::Encode(vertex, quantization).Decode(quantization);
+        EXPECT_LE(glm::length(decoded.normal - vertex.normal), PackedVertex::MAX_DIRECTION_ERROR);
+        EXPECT_LE(glm::length(glm::vec3(decoded.tangent) - glm::vec3(vertex.tangent)), PackedVertex::MAX_DIRECTION_ERROR);
+        EXPECT_EQ(decoded.tangent.w, vertex.tangent.w);
+    }
+}
+
+TEST_CASE(TexCoordsWithinHalfPrecision) {
+    std::vector<float> values = {0.0f, 1.0f, 0.5f, -1.0f, 0.25f, 1.0f / 3.0f, 1e-5f};
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> coordinate(-8.0f, 8.0f);
+    while (values.size() < 20000) {
+        values.push_back(coordinate(rng));
+    }
+
+    VertexQuantization quantization;
+    for (size_t i = 0; i + 1 < values.size(); i += 2) {
+        Vertex vertex{};
+        vertex.texCoord = glm::vec2(values[i], values[i + 1]);
+        Vertex decoded = PackedVertex::Encode(vertex, quantization).Decode(quantization);
+        for (int k = 0; k < 2; ++k) {
+            // Below the smallest normal half (2^-14) the spacing stays that of the subnormal range
+            float magnitude = std::max(std::abs(vertex.texCoord[k]), 1.0f / 16384.0f);
+            EXPECT_LE(std::abs(decoded.texCoord[k] - vertex.texCoord[k]), magnitude * PackedVertex::MAX_TEXCOORD_RELATIVE_ERROR);
+        }
+    }
+}
+
+int main() {
+    return test::RunAll();
+}
@@ -0,0 +1,78 @@
+#include "test_common.h"
+
+#include <array>
+#include <cstring>
+
+#include "../pipeline_cache_header.h"
+
+namespace {
+    constexpr uint32_t VENDOR_ID = 0x10de;
+    constexpr uint32_t DEVICE_ID = 0x2684;
+    constexpr std::array<uint8_t, VK_UUID_SIZE> CACHE_UUID = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+    // Cache data as vkGetPipelineCacheData writes it: the header followed by driver data
+    std::vector<uint8_t> MakeCacheData(size_t payloadBytes = 64) {
+        VkPipelineCacheHeaderVersionOne header{};
+        header.headerSize = sizeof(header);
+        header.headerVersion = VK_PIPELINE_CACHE_HEADER_VERSION_ONE;
+        header.vendorID = VENDOR_ID;
+        header.deviceID = DEVICE_ID;
+        std::memcpy(header.pipelineCacheUUID, CACHE_UUID.data(), VK_UUID_SIZE);
+
+        std::vector<uint8_t> data(sizeof(header) + payloadBytes, 0xab);
+        std::memcpy(data.data(), &header, sizeof(header));
+        return data;
+    }
+
+    VkPipelineCacheHeaderVersionOne& Header(std::vector<uint8_t>& data) {
+        return *reinterpret_cast<VkPipelineCacheHeaderVersionOne*>(data.data());
+    }
+
+    bool Matches(const std::vector<uint8_t>& data) {
+        return PipelineCacheHeader::Matches(data.data(), data.size(), VENDOR_ID, DEVICE_ID, CACHE_UUID.data());
+    }
+}
+
+TEST_CASE(AcceptsDataFromTheSameDevice) {
+    EXPECT_TRUE(Matches(MakeCacheData()));
+    EXPECT_TRUE(Matches(MakeCacheData(0)));
+}
+
+TEST_CASE(RejectsOtherDevicesAndDrivers) {
+    std::vector<uint8_t> vendor = MakeCacheData();
+    Header(vendor).vendorID = 0x1002;
+    EXPECT_TRUE(!Matches(vendor));
+
+    std::vector<uint8_t> device = MakeCacheData();
+    Header(device).deviceID = DEVICE_ID + 1;
+    EXPECT_TRUE(!Matches(device));
+
+    // A driver update changes the UUID
+    std::vector<uint8_t> driver = MakeCacheData();
+    Header(driver).pipelineCacheUUID[VK_UUID_SIZE - 1] ^= 0xff;
+    EXPECT_TRUE(!Matches(driver));
+}
+
+TEST_CASE(RejectsMalformedHeaders) {
+    std::vector<uint8_t> version = MakeCacheData();
+    Header(version).headerVersion = static_cast<VkPipelineCacheHeaderVersion>(2);
+    EXPECT_TRUE(!Matches(version));
+
+    std::vector<uint8_t> shortHeader = MakeCacheData();
+    Header(shortHeader).headerSize = sizeof(VkPipelineCacheHeaderVersionOne) - 1;
+    EXPECT_TRUE(!Matches(shortHeader));
+
+    std::vector<uint8_t> oversizedHeader = MakeCacheData(8);
+    Header(oversizedHeader).headerSize = static_cast<uint32_t>(oversizedHeader.size() + 1);
+    EXPECT_TRUE(!Matches(oversizedHeader));
+}
+
+TEST_CASE(RejectsTruncatedData) {
+    std::vector<uint8_t> data = MakeCacheData();
+    EXPECT_TRUE(!PipelineCacheHeader::Matches(data.data(), sizeof(VkPipelineCacheHeaderVersionOne) - 1, VENDOR_ID, DEVICE_ID, CACHE_UUID.data()));
+    EXPECT_TRUE(!PipelineCacheHeader::Matches(nullptr, 0, VENDOR_ID, DEVICE_ID, CACHE_UUID.data()));
+}
+
+int main() {
+    return test::RunAll();
+}
@@ -0,0 +1,91 @@
+#include "test_common.h"
+
+#include "../resource_manager.h"
+
+namespace {
+    // Counts Unload() calls and destructions
+    struct TrackedResource : Resource {
+        int* unloads;
+        int* destroyed;
+        TrackedResource(const std::string& id, int* unloads, int* destroyed)
+            : Resource(id), unloads(unloads), destroyed(destroyed) {}
+        ~TrackedResource() override { ++*destroyed; }
+        void Unload() override {
+            ++*unloads;
+            Resource::Unload();
+        }
+    };
+}
+
+TEST_CASE(UnloadedResourceLivesUntilCollected) {
+    int unloads = 0;
+    int destroyed = 0;
+    ResourceManager manager;
+    ResourceHandle<TrackedResource> handle = manager.LoadResource<TrackedResource>("a", &unloads, &destroyed);
+    TrackedResource* resource = handle.Get();
+    EXPECT_TRUE(resource != nullptr);
+
+    EXPECT_TRUE(manager.UnloadResource<TrackedResource>("a"));
+    // The handle is stale at once, but a pointer obtained earlier is still usable
+    EXPECT_TRUE(handle.Get() == nullptr);
+    EXPECT_TRUE(!handle.IsValid());
+    EXPECT_EQ(destroyed, 0);
+    EXPECT_EQ(unloads, 0);
+    EXPECT_EQ(resource->GetId(), std::string("a"));
+
+    EXPECT_EQ(manager.CollectRetiredResources(), 1u);
+    EXPECT_EQ(unloads, 1);
+    EXPECT_EQ(destroyed, 1);
+    EXPECT_EQ(manager.CollectRetiredResources(), 0u);
+}
+
+TEST_CASE(RetiredSlotIsNotReusedBeforeCollection) {
+    int unloads = 0;
+    int destroyed = 0;
+    ResourceManager manager;
+    ResourceHandle<TrackedResource> first = manager.LoadResource<TrackedResource>("a", &unloads, &destroyed);
+    const uint32_t firstIndex = first.GetHandle() & ResourcePool::INDEX_MASK;
+    manager.UnloadResource<TrackedResource>("a");
+
+    ResourceHandle<TrackedResource> second = manager.LoadResource<TrackedResource>("b", &unloads, &destroyed);
+    EXPECT_TRUE((second.GetHandle() & ResourcePool::INDEX_MASK) != firstIndex);
+    EXPECT_TRUE(first.Get() == nullptr);
+
+    // After collection the slot comes back under a new generation
+    manager.CollectRetiredResources();
+    ResourceHandle<TrackedResource> third = manager.LoadResource<TrackedResource>("c", &unloads, &destroyed);
+    EXPECT_EQ(third.GetHandle() & ResourcePool::INDEX_MASK, firstIndex);
+    EXPECT_TRUE(third.GetHandle() != first.GetHandle());
+    EXPECT_TRUE(first.Get() == nullptr);
+    EXPECT_EQ(third->GetId(), std::string("c"));
+}
+
+TEST_CASE(UnloadUnusedRetiresUnreferencedResources) {
+    int unloads = 0;
+    int destroyed = 0;
+    ResourceManager manager;
+    ResourceHandle<TrackedResource> kept = manager.LoadResource<TrackedResource>("kept", &unloads, &destroyed);
+    manager.LoadResource<TrackedResource>("dropped", &unloads, &destroyed);
+
+    EXPECT_EQ(manager.UnloadUnusedResources(), 1u);
+    EXPECT_TRUE(!manager.HasResource<TrackedResource>("dropped"));
+    EXPECT_EQ(destroyed, 0);
+    manager.CollectRetiredResources();
+    EXPECT_EQ(destroyed, 1);
+    EXPECT_TRUE(kept.Get() != nullptr);
+}
+
+TEST_CASE(UnloadAllDestroysEverything) {
+    int unloads = 0;
+    int destroyed = 0;
+    ResourceManager manager;
+    manager.LoadResource<TrackedResource>("a", &unloads, &destroyed);
+    manager.LoadResource<TrackedResource>("b", &unloads, &destroyed);
+    manager.UnloadAllResources();
+    EXPECT_EQ(unloads, 2);
+    EXPECT_EQ(destroyed, 2);
+}
+
+int main() {
+    return test::RunAll();
+}
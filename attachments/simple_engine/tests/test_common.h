@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief Minimal harness for the CPU unit tests.
+ *
+ * Each test executable registers its cases with TEST_CASE and returns
+ * test::RunAll() from main. Failed expectations are reported with their
+ * location and make the executable exit with a non-zero status for CTest.
+ */
+namespace test {
+    struct Case {
+        const char* name;
+        void (*function)();
+    };
+
+    inline std::vector<Case>& Registry() {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    inline int& FailureCount() {
+        static int failures = 0;
+        return failures;
+    }
+
+    struct Registrar {
+        Registrar(const char* name, void (*function)()) { Registry().push_back({name, function}); }
+    };
+
+    inline void Fail(const char* file, int line, const char* expression) {
+        std::cerr << file << ":" << line << ": expectation failed: " << expression << std::endl;
+        FailureCount()++;
+    }
+
+    /**
+     * @brief Run every registered case.
+     * @return 0 if all expectations held, 1 otherwise.
+     */
+    inline int RunAll() {
+        for (const Case& testCase : Registry()) {
+            int failuresBefore = FailureCount();
+            testCase.function();
+            std::cout << (FailureCount() == failuresBefore ? "[PASS] " : "[FAIL] ") << testCase.name << std::endl;
+        }
+        return FailureCount() == 0 ? 0 : 1;
+    }
+}
+
+#define TEST_CASE(name) \
+    static void name(); \
+    static const test::Registrar name##Registrar(#name, name); \
+    static void name()
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) test::Fail(__FILE__, __LINE__, #condition); \
+    } while (0)
+
+#define EXPECT_EQ(actual, expected) EXPECT_TRUE((actual) == (expected))
+
+#define EXPECT_LE(actual, bound) EXPECT_TRUE((actual) <= (bound))
+
+#define EXPECT_NEAR(actual, expected, tolerance) EXPECT_TRUE(std::abs((actual) - (expected)) <= (tolerance))
@@ -0,0 +1,123 @@
+#include "test_common.h"
+
+#include <algorithm>
+
+#include "../texture_residency.h"
+
+namespace {
+    constexpr uint64_t MB = 1024 * 1024;
+    constexpr uint64_t IDLE_FRAMES = 120; // Renderer::RESIDENCY_MIN_IDLE_FRAMES
+
+    // Slots 1..count, 1 MB each, uploaded at frame 0 and last used at frame (slot * 10)
+    TextureResidency MakeResidentSet(uint32_t count, uint64_t budget) {
+        TextureResidency residency;
+        residency.SetBudget(budget);
+        for (uint32_t slot = 1; slot <= count; ++slot) {
+            residency.OnResident(slot, MB, true, 0);
+            residency.Touch(slot, slot * 10);
+        }
+        return residency;
+    }
+}
+
+TEST_CASE(EvictsLeastRecentlyUsedFirst) {
+    TextureResidency residency = MakeResidentSet(8, 5 * MB);
+
+    std::vector<uint32_t> evictions = residency.SelectEvictions(1000, IDLE_FRAMES);
+    EXPECT_EQ(evictions, (std::vector<uint32_t>{1, 2, 3}));
+    for (uint32_t slot : evictions) {
+        EXPECT_TRUE(residency.GetState(slot) == TextureResidency::State::Evicted);
+    }
+    EXPECT_TRUE(residency.GetState(4) == TextureResidency::State::Resident);
+}
+
+TEST_CASE(StopsAtTheBudget) {
+    TextureResidency residency = MakeResidentSet(8, 5 * MB);
+    residency.SelectEvictions(1000, IDLE_FRAMES);
+
+    const TextureResidencyStats& stats = residency.GetStats();
+    EXPECT_EQ(stats.residentBytes, 5 * MB);
+    EXPECT_EQ(stats.residentCount, 5u);
+    EXPECT_EQ(stats.evictedCount, 3u);
+    EXPECT_EQ(stats.totalEvictions, 3u);
+
+    // Within the budget nothing more goes
+    EXPECT_TRUE(residency.SelectEvictions(2000, IDLE_FRAMES).empty());
+}
+
+TEST_CASE(UnlimitedBudgetNeverEvicts) {
+    TextureResidency residency = MakeResidentSet(8, 0);
+    EXPECT_TRUE(residency.SelectEvictions(1000, IDLE_FRAMES).empty());
+    EXPECT_EQ(residency.GetStats().residentBytes, 8 * MB);
+}
+
+TEST_CASE(RecentlyUsedTexturesAreKept) {
+    // Slots last used at frames 10..80; at frame 150 only slots 1-3 are idle for 120 frames
+    TextureResidency residency = MakeResidentSet(8, 2 * MB);
+
+    std::vector<uint32_t> evictions = residency.SelectEvictions(150, IDLE_FRAMES);
+    EXPECT_EQ(evictions, (std::vector<uint32_t>{1, 2, 3}));
+    // Short of the budget rather than evicting textures still in use
+    EXPECT_EQ(residency.GetStats().residentBytes, 5 * MB);
+}
+
+TEST_CASE(NonEvictableTexturesAreKept) {
+    TextureResidency residency;
+    residency.SetBudget(1 * MB);
+    residency.OnResident(1, 4 * MB, false, 0);
+    residency.OnResident(2, 2 * MB, true, 0);
+
+    std::vector<uint32_t> evictions = residency.SelectEvictions(1000, IDLE_FRAMES);
+    EXPECT_EQ(evictions, (std::vector<uint32_t>{2}));
+    EXPECT_TRUE(residency.GetState(1) == TextureResidency::State::Resident);
+    EXPECT_EQ(residency.GetStats().residentBytes, 4 * MB);
+}
+
+TEST_CASE(RestreamedTextureIsNotEvictedAgainRightAway) {
+    TextureResidency residency = MakeResidentSet(4, 3 * MB);
+    EXPECT_EQ(residency.SelectEvictions(1000, IDLE_FRAMES), (std::vector<uint32_t>{1}));
+
+    // Drawn again: requested once, then uploaded
+    EXPECT_TRUE(residency.Touch(1, 1001));
+    EXPECT_TRUE(residency.GetState(1) == TextureResidency::State::Restreaming);
+    EXPECT_TRUE(!residency.Touch(1, 1002));
+    residency.OnResident(1, MB, true, 1003);
+    EXPECT_EQ(residency.GetStats().totalRestreams, 1u);
+    EXPECT_EQ(residency.GetStats().evictedCount, 0u);
+
+    // Over budget again: the idle textures go, the restreamed one stays until it is idle itself
+    std::vector<uint32_t> evictions = residency.SelectEvictions(1003 + IDLE_FRAMES - 1, IDLE_FRAMES);
+    EXPECT_EQ(evictions, (std::vector<uint32_t>{2}));
+    EXPECT_TRUE(residency.GetState(1) == TextureResidency::State::Resident);
+}
+
+TEST_CASE(NoThrashingUnderSteadyUse) {
+    // Six textures drawn every frame against a budget for four: nothing is ever idle long enough
+    TextureResidency residency;
+    residency.SetBudget(4 * MB);
+    for (uint32_t slot = 1; slot <= 6; ++slot) {
+        residency.OnResident(slot, MB, true, 0);
+    }
+    for (uint64_t frame = 1; frame <= 1000; ++frame) {
+        for (uint32_t slot = 1; slot <= 6; ++slot) {
+            residency.Touch(slot, frame);
+        }
+        if (frame % 10 == 0) {
+            EXPECT_TRUE(residency.SelectEvictions(frame, IDLE_FRAMES).empty());
+        }
+    }
+    EXPECT_EQ(residency.GetStats().totalEvictions, 0u);
+}
+
+TEST_CASE(ReuploadReplacesTheAccountedSize) {
+    TextureResidency residency;
+    residency.SetBudget(8 * MB);
+    residency.OnResident(1, 2 * MB, true, 0);
+    residency.OnResident(1, 3 * MB, true, 5);
+    EXPECT_EQ(residency.GetStats().residentBytes, 3 * MB);
+    EXPECT_EQ(residency.GetStats().residentCount, 1u);
+}
+
+int main() {
+    return test::RunAll();
+}
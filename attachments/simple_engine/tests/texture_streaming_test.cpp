@@ -0,0 +1,163 @@
+#include "test_common.h"
+
+#include "../texture_streaming.h"
+
+namespace {
+    using Request = TextureStreamScheduler::Request;
+    using Source = TextureStreamScheduler::Source;
+
+    constexpr uint64_t KB = 1024;
+    constexpr uint64_t MB = 1024 * 1024;
+
+    // Upload costs of a simulated device, different from the scheduler's initial guesses
+    double TrueMs(const Request& request) {
+        double msPerMegabyte = request.source == Source::File ? 20.0 : 1.0;
+        return 0.25 + static_cast<double>(request.bytes) / MB * msPerMegabyte;
+    }
+
+    struct Frame {
+        double elapsedMs = 0.0;
+        std::vector<Request> uploaded;
+    };
+
+    // One frame of Renderer::ProcessPendingTextureJobs against the simulated costs
+    Frame RunFrame(TextureStreamScheduler& scheduler, std::vector<Request>& pending, double budgetMs) {
+        Frame frame;
+        std::vector<bool> done(pending.size(), false);
+        for (size_t k : TextureStreamScheduler::Order(pending)) {
+            if (!scheduler.Fits(frame.elapsedMs, pending[k], budgetMs, frame.uploaded.empty())) {
+                break;
+            }
+            double ms = TrueMs(pending[k]);
+            scheduler.RecordUpload(pending[k], ms);
+            frame.elapsedMs += ms;
+            frame.uploaded.push_back(pending[k]);
+            done[k] = true;
+        }
+        std::vector<Request> remaining;
+        for (size_t i = 0; i < pending.size(); ++i) {
+            if (!done[i]) {
+                pending[i].waitedFrames++;
+                remaining.push_back(pending[i]);
+            }
+        }
+        pending.swap(remaining);
+        return frame;
+    }
+}
+
+TEST_CASE(OrdersByPriorityThenSize) {
+    std::vector<Request> requests = {
+        {.priority = 1.0f, .bytes = 4 * MB},
+        {.priority = 5.0f, .bytes = 1 * MB},
+        {.priority = 1.0f, .bytes = 1 * MB},
+        {.priority = 3.0f, .bytes = 8 * MB},
+    };
+    EXPECT_EQ(TextureStreamScheduler::Order(requests), (std::vector<size_t>{1, 3, 2, 0}));
+}
+
+TEST_CASE(StarvingRequestsGoFirst) {
+    std::vector<Request> requests = {
+        {.priority = 9.0f, .bytes = 1 * MB},
+        {.priority = 0.0f, .bytes = 1 * MB, .waitedFrames = TextureStreamScheduler::STARVATION_FRAMES},
+        {.priority = 0.0f, .bytes = 1 * MB, .waitedFrames = TextureStreamScheduler::STARVATION_FRAMES + 5},
+        {.priority = 1.0f, .bytes = 1 * MB, .waitedFrames = TextureStreamScheduler::STARVATION_FRAMES - 1},
+    };
+    EXPECT_EQ(TextureStreamScheduler::Order(requests), (std::vector<size_t>{2, 1, 0, 3}));
+}
+
+TEST_CASE(LearnsTheUploadRate) {
+    TextureStreamScheduler scheduler;
+    Request file{.bytes = 2 * MB, .source = Source::File};
+    Request memory{.bytes = 4 * MB, .source = Source::Memory};
+    for (int i = 0; i < 50; ++i) {
+        scheduler.RecordUpload(file, TrueMs(file));
+        scheduler.RecordUpload(memory, TrueMs(memory));
+    }
+    EXPECT_NEAR(scheduler.GetMsPerMegabyte(Source::File), 20.0, 0.01);
+    EXPECT_NEAR(scheduler.GetMsPerMegabyte(Source::Memory), 1.0, 0.01);
+    EXPECT_NEAR(scheduler.PredictMs(file), TrueMs(file), 0.05);
+
+    // Tiny uploads are dominated by the fixed cost and leave the rate alone
+    scheduler.RecordUpload({.bytes = 4 * KB, .source = Source::File}, 50.0);
+    EXPECT_NEAR(scheduler.GetMsPerMegabyte(Source::File), 20.0, 0.01);
+}
+
+TEST_CASE(FramesStayWithinTheBudget) {
+    constexpr double budgetMs = 2.0;
+    TextureStreamScheduler scheduler;
+    std::vector<Request> pending;
+    for (uint32_t i = 0; i < 400; ++i) {
+        pending.push_back({
+            .priority = static_cast<float>(i % 7),
+            .bytes = (64 + (i * 37) % 512) * KB,
+            .source = i % 3 == 0 ? Source::File : Source::Memory
+        });
+    }
+
+    // The first frames run on the initial guesses; after that the learned rates hold the budget
+    int frames = 0;
+    for (; !pending.empty() && frames < 1000; ++frames) {
+        Frame frame = RunFrame(scheduler, pending, budgetMs);
+        EXPECT_TRUE(!frame.uploaded.empty());
+        if (frames >= 10 && frame.uploaded.size() > 1) {
+            EXPECT_LE(frame.elapsedMs, budgetMs * 1.01);
+        }
+    }
+    EXPECT_TRUE(pending.empty());
+}
+
+TEST_CASE(UploadsWithinAFrameFollowPriority) {
+    TextureStreamScheduler scheduler;
+    std::vector<Request> pending;
+    for (uint32_t i = 0; i < 40; ++i) {
+        pending.push_back({.priority = static_cast<float>((i * 13) % 40), .bytes = 256 * KB, .source = Source::Memory});
+    }
+
+    float lastPriority = 1e9f;
+    while (!pending.empty()) {
+        for (const Request& request : RunFrame(scheduler, pending, 1.0).uploaded) {
+            EXPECT_LE(request.priority, lastPriority);
+            lastPriority = request.priority;
+        }
+    }
+}
+
+TEST_CASE(OversizedTextureDoesNotStall) {
+    TextureStreamScheduler scheduler;
+    // Predicted far above the budget, but nothing else is pending
+    std::vector<Request> pending = {{.priority = 1.0f, .bytes = 16 * MB, .source = Source::File}};
+    Frame frame = RunFrame(scheduler, pending, 2.0);
+    EXPECT_EQ(frame.uploaded.size(), 1u);
+    EXPECT_TRUE(pending.empty());
+
+    // Behind a smaller request it goes first in the next frame
+    pending = {{.priority = 2.0f, .bytes = 64 * KB, .source = Source::Memory},
+               {.priority = 1.0f, .bytes = 16 * MB, .source = Source::File}};
+    EXPECT_EQ(RunFrame(scheduler, pending, 2.0).uploaded.size(), 1u);
+    EXPECT_EQ(RunFrame(scheduler, pending, 2.0).uploaded.size(), 1u);
+    EXPECT_TRUE(pending.empty());
+}
+
+TEST_CASE(LowPriorityRequestIsNotStarved) {
+    TextureStreamScheduler scheduler;
+    std::vector<Request> pending = {{.priority = 0.0f, .bytes = 256 * KB, .source = Source::Memory}};
+
+    // Every frame brings more high-priority work than the budget takes
+    uint32_t frame = 0;
+    bool lowUploaded = false;
+    for (; frame <= TextureStreamScheduler::STARVATION_FRAMES + 1 && !lowUploaded; ++frame) {
+        for (int i = 0; i < 8; ++i) {
+            pending.push_back({.priority = 10.0f, .bytes = 512 * KB, .source = Source::Memory});
+        }
+        for (const Request& request : RunFrame(scheduler, pending, 1.0).uploaded) {
+            lowUploaded = lowUploaded || request.priority == 0.0f;
+        }
+    }
+    EXPECT_TRUE(lowUploaded);
+    EXPECT_LE(frame, TextureStreamScheduler::STARVATION_FRAMES + 1);
+}
+
+int main() {
+    return test::RunAll();
+}
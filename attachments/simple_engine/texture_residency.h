@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Residency statistics of the texture set.
+ */
+struct TextureResidencyStats {
+    uint64_t budgetBytes = 0;      // Memory textures may occupy (0 = unlimited)
+    uint64_t residentBytes = 0;    // Memory of the resident textures
+    uint32_t residentCount = 0;
+    uint32_t evictedCount = 0;     // Textures currently evicted to the fallback
+    uint64_t totalEvictions = 0;   // Evictions since startup
+    uint64_t totalRestreams = 0;   // Reloads of evicted textures since startup
+};
+
+/**
+ * @brief Least-recently-used residency policy for streamed textures.
+ *
+ * Textures are identified by their bindless slot. The renderer reports uploads,
+ * marks the slots used by each frame's draws and asks which textures to evict
+ * when the resident set exceeds the budget. The policy holds no Vulkan objects,
+ * so it can be driven with a simulated budget.
+ *
+ * Not thread safe; the renderer serializes access.
+ */
+class TextureResidency {
+public:
+    enum class State : uint8_t {
+        Unknown,    // Never uploaded (or not tracked)
+        Resident,
+        Evicted,    // Released; the slot samples the fallback texture
+        Restreaming // Evicted and requested again
+    };
+
+    /**
+     * @brief Set the memory textures may occupy.
+     * @param bytes The budget in bytes (0 = unlimited).
+     */
+    void SetBudget(uint64_t bytes) { stats.budgetBytes = bytes; }
+
+    /**
+     * @brief Record a texture upload.
+     * @param slot The bindless slot of the texture.
+     * @param bytes The device memory of the texture.
+     * @param evictable False for textures that cannot be reloaded (defaults, embedded images).
+     * @param frame The current frame number.
+     */
+    void OnResident(uint32_t slot, uint64_t bytes, bool evictable, uint64_t frame) {
+        Entry& entry = getEntry(slot);
+        if (entry.state == State::Resident) {
+            stats.residentBytes -= entry.bytes;
+            stats.residentCount--;
+        } else if (entry.state == State::Evicted || entry.state == State::Restreaming) {
+            stats.evictedCount--;
+            if (entry.state == State::Restreaming) {
+                stats.totalRestreams++;
+            }
+        }
+        entry.state = State::Resident;
+        entry.bytes = bytes;
+        entry.evictable = evictable;
+        entry.lastUsedFrame = std::max(entry.lastUsedFrame, frame);
+        stats.residentBytes += bytes;
+        stats.residentCount++;
+    }
+
+    /**
+     * @brief Mark a texture as used by the given frame.
+     * @param slot The bindless slot.
+     * @param frame The frame number.
+     * @return True if the texture is evicted and should be streamed again, false otherwise.
+     */
+    bool Touch(uint32_t slot, uint64_t frame) {
+        if (slot >= entries.size()) {
+            return false;
+        }
+        Entry& entry = entries[slot];
+        entry.lastUsedFrame = std::max(entry.lastUsedFrame, frame);
+        if (entry.state == State::Evicted) {
+            entry.state = State::Restreaming;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Select the textures to evict so the resident set fits the budget.
+     *
+     * Candidates are evictable textures that have not been used for at least
+     * minIdleFrames, released least recently used first. The selection may fall
+     * short of the budget if too few textures are idle.
+     *
+     * @param frame The current frame number.
+     * @param minIdleFrames Frames a texture must be unused before it may be evicted.
+     * @return The slots to release; they are already accounted as evicted.
+     */
+    std::vector<uint32_t> SelectEvictions(uint64_t frame, uint64_t minIdleFrames) {
+        std::vector<uint32_t> evictions;
+        if (stats.budgetBytes == 0 || stats.residentBytes <= stats.budgetBytes) {
+            return evictions;
+        }
+
+        std::vector<uint32_t> candidates;
+        for (uint32_t slot = 0; slot < entries.size(); ++slot) {
+            const Entry& entry = entries[slot];
+            if (entry.state == State::Resident && entry.evictable && entry.lastUsedFrame + minIdleFrames <= frame) {
+                candidates.push_back(slot);
+            }
+        }
+        std::ranges::sort(candidates, [this](uint32_t a, uint32_t b) {
+            return entries[a].lastUsedFrame < entries[b].lastUsedFrame;
+        });
+
+        for (uint32_t slot : candidates) {
+            if (stats.residentBytes <= stats.budgetBytes) {
+                break;
+            }
+            Entry& entry = entries[slot];
+            entry.state = State::Evicted;
+            stats.residentBytes -= entry.bytes;
+            stats.residentCount--;
+            stats.evictedCount++;
+            stats.totalEvictions++;
+            evictions.push_back(slot);
+        }
+        return evictions;
+    }
+
+    /**
+     * @brief Get the residency state of a texture.
+     * @param slot The bindless slot.
+     * @return The state.
+     */
+    State GetState(uint32_t slot) const {
+        return slot < entries.size() ? entries[slot].state : State::Unknown;
+    }
+
+    /**
+     * @brief Get the residency statistics.
+     * @return The statistics.
+     */
+    const TextureResidencyStats& GetStats() const { return stats; }
+
+private:
+    struct Entry {
+        uint64_t bytes = 0;
+        uint64_t lastUsedFrame = 0;
+        State state = State::Unknown;
+        bool evictable = false;
+    };
+
+    std::vector<Entry> entries; // Indexed by bindless slot
+    TextureResidencyStats stats;
+
+    Entry& getEntry(uint32_t slot) {
+        if (slot >= entries.size()) {
+            entries.resize(static_cast<size_t>(slot) + 1);
+        }
+        return entries[slot];
+    }
+};
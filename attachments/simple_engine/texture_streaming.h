@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+/**
+ * @brief Texture streaming work of the last frame.
+ */
+struct TextureStreamingStats {
+    uint32_t uploads = 0;       // Textures uploaded this frame
+    uint32_t pending = 0;       // Jobs left in the queue afterwards
+    double uploadMs = 0.0;      // Time spent uploading
+    double budgetMs = 0.0;      // Budget the uploads were scheduled against
+};
+
+/**
+ * @brief Orders pending texture uploads and fits them into a per-frame time budget.
+ *
+ * Requests are taken in descending priority (projected screen coverage of the
+ * entities using the texture). The cost of an upload is predicted from its size
+ * with a per-source rate that is learned from the measured upload times, so the
+ * budget holds for both small and large textures. The first upload of a frame
+ * always runs, so streaming cannot stall behind a texture larger than the budget.
+ * Requests passed over for STARVATION_FRAMES frames go ahead of all others, so
+ * a steady stream of high-priority requests cannot starve the rest.
+ *
+ * Holds no Vulkan objects, so it can be driven with simulated upload costs.
+ */
+class TextureStreamScheduler {
+public:
+    enum class Source : uint8_t {
+        File,   // Decoded from disk on the render thread (bytes = file size)
+        Memory  // Already decoded (bytes = RGBA size)
+    };
+
+    struct Request {
+        float priority = 0.0f;
+        uint64_t bytes = 0;
+        Source source = Source::File;
+        uint32_t waitedFrames = 0;  // Frames the request was left pending
+    };
+
+    static constexpr uint32_t STARVATION_FRAMES = 120;
+
+    /**
+     * @brief Order requests by descending priority; smaller textures first on ties.
+     * Starving requests come first, longest waiting first.
+     * @param requests The pending requests.
+     * @return Indices into requests in upload order.
+     */
+    static std::vector<size_t> Order(const std::vector<Request>& requests) {
+        std::vector<size_t> order(requests.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::ranges::stable_sort(order, [&requests](size_t a, size_t b) {
+            bool starvingA = requests[a].waitedFrames >= STARVATION_FRAMES;
+            bool starvingB = requests[b].waitedFrames >= STARVATION_FRAMES;
+            if (starvingA != starvingB) {
+                return starvingA;
+            }
+            if (starvingA && requests[a].waitedFrames != requests[b].waitedFrames) {
+                return requests[a].waitedFrames > requests[b].waitedFrames;
+            }
+            if (requests[a].priority != requests[b].priority) {
+                return requests[a].priority > requests[b].priority;
+            }
+            return requests[a].bytes < requests[b].bytes;
+        });
+        return order;
+    }
+
+    /**
+     * @brief Predict the upload time of a request.
+     * @param request The request.
+     * @return The predicted time in milliseconds.
+     */
+    double PredictMs(const Request& request) const {
+        return FIXED_MS + static_cast<double>(request.bytes) / BYTES_PER_MB * msPerMegabyte[static_cast<size_t>(request.source)];
+    }
+
+    /**
+     * @brief Check if a request still fits into the frame's budget.
+     * @param elapsedMs Time already spent on uploads this frame.
+     * @param request The request.
+     * @param budgetMs The frame's budget in milliseconds.
+     * @param firstOfFrame True if nothing has been uploaded this frame yet.
+     * @return True if the request should be uploaded now.
+     */
+    bool Fits(double elapsedMs, const Request& request, double budgetMs, bool firstOfFrame) const {
+        return firstOfFrame || elapsedMs + PredictMs(request) <= budgetMs;
+    }
+
+    /**
+     * @brief Update the cost model with a measured upload.
+     * @param request The uploaded request.
+     * @param ms The measured upload time in milliseconds.
+     */
+    void RecordUpload(const Request& request, double ms) {
+        // Tiny uploads are dominated by the fixed submission cost and say little about the rate
+        if (request.bytes < MIN_SAMPLE_BYTES) {
+            return;
+        }
+        double rate = std::max(0.0, ms - FIXED_MS) / (static_cast<double>(request.bytes) / BYTES_PER_MB);
+        double& current = msPerMegabyte[static_cast<size_t>(request.source)];
+        current += RATE_SMOOTHING * (rate - current);
+    }
+
+    /**
+     * @brief Get the learned upload rate of a source.
+     * @param source The source.
+     * @return Milliseconds per megabyte.
+     */
+    double GetMsPerMegabyte(Source source) const { return msPerMegabyte[static_cast<size_t>(source)]; }
+
+private:
+    static constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+    static constexpr double FIXED_MS = 0.25;              // Command buffer submission and fence wait
+    static constexpr double RATE_SMOOTHING = 0.2;         // Exponential moving average weight of a new sample
+    static constexpr uint64_t MIN_SAMPLE_BYTES = 64 * 1024;
+
+    // Initial guesses until uploads have been measured: file textures include decoding
+    double msPerMegabyte[2] = { 8.0, 2.0 };
+};
@@ -12,6 +12,8 @@
 #include <utility>
 #include <atomic>
 
+#include "profiler.h"
+
 // Generic reusable thread pool for background tasks (texture uploads, geometry processing, etc.)
 class ThreadPool {
 public:
@@ -65,6 +67,7 @@ public:
 
 private:
     void workerLoop() {
+        PROFILE_THREAD_NAME("Worker");
         for (;;) {
             std::function<void()> task;
             {